@@ -101,7 +101,9 @@ target_link_libraries(fboss_types
 )
 
 add_library(core
+  fboss/agent/AclClassifier.cpp
   fboss/agent/AclNexthopHandler.cpp
+  fboss/agent/AclPriorityAllocator.cpp
   fboss/agent/ApplyThriftConfig.cpp
   fboss/agent/ArpCache.cpp
   fboss/agent/ArpHandler.cpp
@@ -133,19 +135,24 @@ add_library(core
   fboss/agent/NeighborUpdater.cpp
   fboss/agent/NeighborUpdaterImpl.cpp
   fboss/agent/NeighborUpdaterNoopImpl.cpp
+  fboss/agent/PortStatusChangeTracker.cpp
   fboss/agent/PortUpdateHandler.cpp
   fboss/agent/ResolvedNexthopMonitor.cpp
   fboss/agent/ResolvedNexthopProbe.cpp
   fboss/agent/ResolvedNexthopProbeScheduler.cpp
   fboss/agent/RestartTimeTracker.cpp
+  fboss/agent/RouteEventTracer.cpp
+  fboss/agent/RouteProgrammingLatency.cpp
   fboss/agent/RouteUpdateLogger.cpp
   fboss/agent/RouteUpdateLoggingPrefixTracker.cpp
   fboss/agent/RouteUpdateWrapper.cpp
+  fboss/agent/StateUpdateProfiler.cpp
   fboss/agent/StaticL2ForNeighborObserver.cpp
   fboss/agent/StaticL2ForNeighborUpdater.cpp
   fboss/agent/StaticL2ForNeighborSwSwitchUpdater.cpp
   fboss/agent/SwSwitch.cpp
   fboss/agent/SwSwitchRouteUpdateWrapper.cpp
+  fboss/agent/SwitchStateChangePublisher.cpp
   fboss/agent/ThreadHeartbeat.cpp
   fboss/agent/TunIntf.cpp
   fboss/agent/TunManager.cpp
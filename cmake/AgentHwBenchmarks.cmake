@@ -38,6 +38,15 @@ target_link_libraries(hw_stats_collection_speed
   Folly::follybenchmark
 )
 
+add_library(hw_route_scale_benchmark_helpers
+  fboss/agent/hw/benchmarks/HwRouteScaleBenchmarkHelpers.cpp
+)
+
+target_link_libraries(hw_route_scale_benchmark_helpers
+  hw_switch_ensemble
+  Folly::folly
+)
+
 add_library(hw_fsw_scale_route_add_speed
   fboss/agent/hw/benchmarks/HwFswScaleRouteAddBenchmark.cpp
 )
@@ -47,6 +56,7 @@ target_link_libraries(hw_fsw_scale_route_add_speed
   hw_packet_utils
   ecmp_helper
   hw_benchmark_main
+  hw_route_scale_benchmark_helpers
   function_call_time_reporter
   Folly::folly
 )
@@ -60,6 +70,7 @@ target_link_libraries(hw_fsw_scale_route_del_speed
   hw_packet_utils
   ecmp_helper
   hw_benchmark_main
+  hw_route_scale_benchmark_helpers
   function_call_time_reporter
   Folly::folly
 )
@@ -73,6 +84,7 @@ target_link_libraries(hw_th_alpm_scale_route_add_speed
   hw_packet_utils
   ecmp_helper
   hw_benchmark_main
+  hw_route_scale_benchmark_helpers
   function_call_time_reporter
   Folly::folly
 )
@@ -86,6 +98,7 @@ target_link_libraries(hw_th_alpm_scale_route_del_speed
   hw_packet_utils
   ecmp_helper
   hw_benchmark_main
+  hw_route_scale_benchmark_helpers
   function_call_time_reporter
   Folly::folly
 )
@@ -99,6 +112,7 @@ target_link_libraries(hw_hgrid_du_scale_route_add_speed
   hw_packet_utils
   ecmp_helper
   hw_benchmark_main
+  hw_route_scale_benchmark_helpers
   function_call_time_reporter
   Folly::folly
 )
@@ -112,6 +126,7 @@ target_link_libraries(hw_hgrid_du_scale_route_del_speed
   hw_packet_utils
   ecmp_helper
   hw_benchmark_main
+  hw_route_scale_benchmark_helpers
   function_call_time_reporter
   Folly::folly
 )
@@ -125,6 +140,7 @@ target_link_libraries(hw_hgrid_uu_scale_route_add_speed
   hw_packet_utils
   ecmp_helper
   hw_benchmark_main
+  hw_route_scale_benchmark_helpers
   function_call_time_reporter
   Folly::folly
 )
@@ -138,6 +154,7 @@ target_link_libraries(hw_hgrid_uu_scale_route_del_speed
   hw_packet_utils
   ecmp_helper
   hw_benchmark_main
+  hw_route_scale_benchmark_helpers
   function_call_time_reporter
   Folly::folly
 )
@@ -269,6 +286,7 @@ target_link_libraries(hw_anticipated_scale_route_add_speed
   hw_packet_utils
   ecmp_helper
   hw_benchmark_main
+  hw_route_scale_benchmark_helpers
   function_call_time_reporter
   Folly::folly
 )
@@ -282,6 +300,7 @@ target_link_libraries(hw_anticipated_scale_route_del_speed
   hw_packet_utils
   ecmp_helper
   hw_benchmark_main
+  hw_route_scale_benchmark_helpers
   function_call_time_reporter
   Folly::folly
 )
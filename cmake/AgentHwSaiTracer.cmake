@@ -24,6 +24,7 @@ add_library(sai_tracer
   fboss/agent/hw/sai/tracer/QueueApiTracer.cpp
   fboss/agent/hw/sai/tracer/RouteApiTracer.cpp
   fboss/agent/hw/sai/tracer/RouterInterfaceApiTracer.cpp
+  fboss/agent/hw/sai/tracer/SaiBinaryTrace.cpp
   fboss/agent/hw/sai/tracer/SaiTracer.cpp
   fboss/agent/hw/sai/tracer/SamplePacketApiTracer.cpp
   fboss/agent/hw/sai/tracer/SchedulerApiTracer.cpp
@@ -31,6 +31,23 @@ endfunction()
 
 BUILD_SAI_REPLAYER("fake" fake_sai)
 
+# Converts binary SAI traces (--enable_binary_log) to replayer source
+add_executable(sai_trace_converter
+  fboss/agent/hw/sai/tracer/run/SaiTraceConverter.cpp
+)
+
+target_link_libraries(sai_trace_converter
+  sai_tracer
+  fake_sai
+  Folly::folly
+)
+
+set_target_properties(sai_trace_converter PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
+
 # If libsai_impl is provided, build sai replayer linking with it
 find_library(SAI_IMPL sai_impl)
 message(STATUS "SAI_IMPL: ${SAI_IMPL}")
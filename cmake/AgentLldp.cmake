@@ -12,3 +12,13 @@ target_link_libraries(lldp
   fboss_types
   Folly::folly
 )
+
+add_executable(lldp_neighbor_db_benchmark
+  fboss/agent/lldp/test/LinkNeighborDBBenchmark.cpp
+)
+
+target_link_libraries(lldp_neighbor_db_benchmark
+  lldp
+  Folly::folly
+  Folly::follybenchmark
+)
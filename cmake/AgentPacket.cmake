@@ -15,6 +15,7 @@ add_library(packet
   fboss/agent/packet/MPLSHdr.cpp
   fboss/agent/packet/NDP.cpp
   fboss/agent/packet/NDPRouterAdvertisement.cpp
+  fboss/agent/packet/PktHeaderInfo.cpp
   fboss/agent/packet/PktUtil.cpp
   fboss/agent/packet/PTPHeader.cpp
   fboss/agent/packet/TCPHeader.cpp
@@ -55,3 +56,14 @@ target_link_libraries(packet_factory
   switch_config_cpp2
   Folly::folly
 )
+
+add_executable(pkt_header_info_benchmark
+  fboss/agent/packet/test/PktHeaderInfoBenchmark.cpp
+)
+
+target_link_libraries(pkt_header_info_benchmark
+  packet
+  pktutil
+  Folly::folly
+  Folly::follybenchmark
+)
@@ -13,12 +13,22 @@ target_link_libraries(qsfp_service_client
     thrift_service_client
 )
 
+add_library(transceiver_info_delta
+    fboss/qsfp_service/lib/TransceiverInfoDelta.cpp
+)
+
+target_link_libraries(transceiver_info_delta
+    transceiver_cpp2
+    Folly::folly
+)
+
 add_library(qsfp_cache
     fboss/qsfp_service/lib/QsfpCache.cpp
 )
 
 target_link_libraries(qsfp_cache
     qsfp_service_client
+    transceiver_info_delta
     ctrl_cpp2
     transceiver_cpp2
     alert_logger
@@ -83,6 +83,38 @@ target_link_libraries(async_logger_test
 
 gtest_discover_tests(async_logger_test)
 
+add_executable(async_logger_benchmark
+  fboss/agent/test/AsyncLoggerBenchmark.cpp
+)
+
+target_link_libraries(async_logger_benchmark
+  async_logger
+  Folly::folly
+  Folly::follybenchmark
+)
+
+add_executable(acl_classifier_benchmark
+  fboss/agent/test/AclClassifierBenchmark.cpp
+)
+
+target_link_libraries(acl_classifier_benchmark
+  core
+  Folly::folly
+  Folly::follybenchmark
+)
+
+add_executable(config_apply_benchmark
+  fboss/agent/test/ConfigApplyBenchmark.cpp
+)
+
+target_link_libraries(config_apply_benchmark
+  agent_test_utils
+  core
+  hw_mock
+  Folly::folly
+  Folly::follybenchmark
+)
+
 add_library(agent_test_lib
   fboss/agent/test/AgentTest.cpp
 )
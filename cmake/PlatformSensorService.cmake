@@ -22,6 +22,7 @@ target_link_libraries(sensor_service_lib
   sensor_config_cpp2
   Folly::folly
   FBThrift::thriftcpp2
+  fb303::fb303
 )
 
 add_executable(sensor_service
@@ -32,3 +33,13 @@ target_link_libraries(sensor_service
   sensor_service_lib
   fb303::fb303
 )
+
+add_executable(sensor_service_benchmark
+  fboss/platform/sensor_service/benchmarks/SensorServiceBenchmark.cpp
+)
+
+target_link_libraries(sensor_service_benchmark
+  sensor_service_lib
+  Folly::folly
+  Folly::follybenchmark
+)
@@ -22,6 +22,7 @@ target_link_libraries(qsfp_lib
     fb303::fb303
     FBThrift::thriftcpp2
     qsfp_service_client
+    transceiver_info_delta
     fsdb_stream_client
     fsdb_pub_sub
     fsdb_flags
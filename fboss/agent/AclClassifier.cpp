@@ -0,0 +1,379 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/AclClassifier.h"
+
+#include "fboss/agent/state/AclEntry.h"
+#include "fboss/agent/state/AclMap.h"
+
+#include <algorithm>
+
+namespace {
+
+/*
+ * Layout of the packed key, most significant bits first:
+ *
+ *   0, 1: source IP (IPv4 as IPv4 mapped IPv6 address)
+ *   2, 3: destination IP
+ *   4: protocol, TCP flags, ICMP type, ICMP code, DSCP, TTL, IP type bits,
+ *      fragment bits (8 bits each)
+ *   5: source port, destination port, L4 source port, L4 destination port
+ *   6: destination MAC, ethertype
+ *   7: VLAN, L2/neighbor/route lookup classes, packet lookup result
+ */
+constexpr int kSrcIpWord = 0;
+constexpr int kDstIpWord = 2;
+constexpr int kL3Word = 4;
+constexpr int kPortWord = 5;
+constexpr int kL2Word = 6;
+constexpr int kMetadataWord = 7;
+
+// IP type bits, IP4 and IP6 packets also have the IP bit set
+constexpr uint64_t kIpTypeIp = 0x1;
+constexpr uint64_t kIpTypeIp4 = 0x2;
+constexpr uint64_t kIpTypeIp6 = 0x4;
+
+// Fragment bits, a non first fragment has both bits set
+constexpr uint64_t kFragmented = 0x1;
+constexpr uint64_t kNotFirstFragment = 0x2;
+
+// Entries per block, the unit matched at once
+constexpr size_t kBlockSize = 64;
+// Packets matched against each block of entries while it is in cache
+constexpr size_t kPacketBatchSize = 16;
+
+void setIp(uint64_t* words, const folly::IPAddress& ip) {
+  if (ip.empty()) {
+    return;
+  }
+  if (ip.isV4()) {
+    words[0] = 0;
+    words[1] = 0xffff00000000ULL | ip.asV4().toLongHBO();
+    return;
+  }
+  const auto* bytes = ip.bytes();
+  words[0] = words[1] = 0;
+  for (auto i = 0; i < 8; i++) {
+    words[0] = (words[0] << 8) | bytes[i];
+    words[1] = (words[1] << 8) | bytes[i + 8];
+  }
+}
+
+uint64_t prefixMask(int length) {
+  if (length <= 0) {
+    return 0;
+  }
+  return length >= 64 ? ~0ULL : ~0ULL << (64 - length);
+}
+
+void setNetwork(
+    uint64_t* values,
+    uint64_t* masks,
+    const folly::CIDRNetwork& network) {
+  setIp(values, network.first);
+  int length = network.first.isV4() ? 96 + network.second : network.second;
+  masks[0] = prefixMask(length);
+  masks[1] = prefixMask(length - 64);
+  values[0] &= masks[0];
+  values[1] &= masks[1];
+}
+
+uint64_t packLookupClass(
+    const std::optional<facebook::fboss::cfg::AclLookupClass>& lookupClass) {
+  return lookupClass ? static_cast<uint64_t>(*lookupClass) & 0xff : 0;
+}
+
+} // namespace
+
+namespace facebook::fboss {
+
+AclClassifier::AclClassifier(const AclMap& acls) {
+  for (const auto& entry : acls) {
+    entries_.push_back(entry);
+  }
+  std::stable_sort(
+      entries_.begin(),
+      entries_.end(),
+      [](const auto& lhs, const auto& rhs) {
+        return lhs->getPriority() < rhs->getPriority();
+      });
+
+  auto numPadded = (entries_.size() + kBlockSize - 1) / kBlockSize * kBlockSize;
+  for (auto word = 0; word < kKeyWords; word++) {
+    values_[word].reserve(numPadded);
+    masks_[word].reserve(numPadded);
+  }
+  for (const auto& entry : entries_) {
+    auto [value, mask] = packEntry(*entry);
+    for (auto word = 0; word < kKeyWords; word++) {
+      values_[word].push_back(value[word]);
+      masks_[word].push_back(mask[word]);
+    }
+  }
+  // A value bit outside of the mask never matches
+  for (auto word = 0; word < kKeyWords; word++) {
+    values_[word].resize(numPadded, 1);
+    masks_[word].resize(numPadded, 0);
+  }
+}
+
+AclClassifier::Key AclClassifier::packPacket(const AclPacket& packet) {
+  Key key{};
+  uint64_t ipType = 0;
+  if (!packet.dstIp.empty()) {
+    setIp(&key[kSrcIpWord], packet.srcIp);
+    setIp(&key[kDstIpWord], packet.dstIp);
+    ipType = kIpTypeIp | (packet.dstIp.isV4() ? kIpTypeIp4 : kIpTypeIp6);
+  }
+  uint64_t fragment = 0;
+  switch (packet.fragment) {
+    case AclPacket::Fragment::NOT_FRAGMENTED:
+      break;
+    case AclPacket::Fragment::FIRST_FRAGMENT:
+      fragment = kFragmented;
+      break;
+    case AclPacket::Fragment::NOT_FIRST_FRAGMENT:
+      fragment = kFragmented | kNotFirstFragment;
+      break;
+  }
+  key[kL3Word] = static_cast<uint64_t>(packet.proto) << 56 |
+      static_cast<uint64_t>(packet.tcpFlags) << 48 |
+      static_cast<uint64_t>(packet.icmpType) << 40 |
+      static_cast<uint64_t>(packet.icmpCode) << 32 |
+      static_cast<uint64_t>(packet.dscp) << 24 |
+      static_cast<uint64_t>(packet.ttl) << 16 | ipType << 8 | fragment;
+  key[kPortWord] = static_cast<uint64_t>(packet.srcPort) << 48 |
+      static_cast<uint64_t>(packet.dstPort) << 32 |
+      static_cast<uint64_t>(packet.l4SrcPort) << 16 | packet.l4DstPort;
+  key[kL2Word] = packet.dstMac.u64HBO() << 16 | packet.etherType;
+  key[kMetadataWord] = static_cast<uint64_t>(packet.vlanID) << 32 |
+      packLookupClass(packet.lookupClassL2) << 24 |
+      packLookupClass(packet.lookupClassNeighbor) << 16 |
+      packLookupClass(packet.lookupClassRoute) << 8 |
+      (packet.packetLookupResult
+           ? static_cast<uint64_t>(*packet.packetLookupResult) & 0xff
+           : 0);
+  return key;
+}
+
+std::pair<AclClassifier::Key, AclClassifier::Key> AclClassifier::packEntry(
+    const AclEntry& entry) {
+  Key value{};
+  Key mask{};
+  // Match the fieldMask bits of the field at shift in word to fieldValue
+  auto setField =
+      [&](int word, int shift, uint64_t fieldMask, uint64_t fieldValue) {
+        mask[word] |= fieldMask << shift;
+        value[word] |= (fieldValue & fieldMask) << shift;
+      };
+
+  uint64_t ipTypeBits = 0;
+  auto setNetworkField = [&](int word, const folly::CIDRNetwork& network) {
+    if (network.first.empty()) {
+      return;
+    }
+    setNetwork(&value[word], &mask[word], network);
+    ipTypeBits |= network.first.isV4() ? kIpTypeIp4 : kIpTypeIp6;
+  };
+  setNetworkField(kSrcIpWord, entry.getSrcIp());
+  setNetworkField(kDstIpWord, entry.getDstIp());
+
+  if (auto proto = entry.getProto()) {
+    setField(kL3Word, 56, 0xff, *proto);
+  }
+  if (auto tcpFlags = entry.getTcpFlagsBitMap()) {
+    setField(kL3Word, 48, 0xff, *tcpFlags);
+  }
+  if (auto icmpType = entry.getIcmpType()) {
+    setField(kL3Word, 40, 0xff, *icmpType);
+  }
+  if (auto icmpCode = entry.getIcmpCode()) {
+    setField(kL3Word, 32, 0xff, *icmpCode);
+  }
+  if (auto dscp = entry.getDscp()) {
+    setField(kL3Word, 24, 0xff, *dscp);
+  }
+  if (auto ttl = entry.getTtl()) {
+    setField(kL3Word, 16, ttl->getMask(), ttl->getValue());
+  }
+  if (auto ipType = entry.getIpType()) {
+    switch (*ipType) {
+      case cfg::IpType::ANY:
+        break;
+      case cfg::IpType::IP:
+        ipTypeBits |= kIpTypeIp;
+        break;
+      case cfg::IpType::IP4:
+        ipTypeBits |= kIpTypeIp4;
+        break;
+      case cfg::IpType::IP6:
+        ipTypeBits |= kIpTypeIp6;
+        break;
+    }
+  }
+  if (auto ipFrag = entry.getIpFrag()) {
+    // Only IP packets are fragments
+    ipTypeBits |= kIpTypeIp;
+    switch (*ipFrag) {
+      case cfg::IpFragMatch::MATCH_NOT_FRAGMENTED:
+        setField(kL3Word, 0, kFragmented, 0);
+        break;
+      case cfg::IpFragMatch::MATCH_FIRST_FRAGMENT:
+        setField(kL3Word, 0, kFragmented | kNotFirstFragment, kFragmented);
+        break;
+      case cfg::IpFragMatch::MATCH_NOT_FRAGMENTED_OR_FIRST_FRAGMENT:
+        setField(kL3Word, 0, kNotFirstFragment, 0);
+        break;
+      case cfg::IpFragMatch::MATCH_NOT_FIRST_FRAGMENT:
+        setField(kL3Word, 0, kNotFirstFragment, kNotFirstFragment);
+        break;
+      case cfg::IpFragMatch::MATCH_ANY_FRAGMENT:
+        setField(kL3Word, 0, kFragmented, kFragmented);
+        break;
+    }
+  }
+  // An entry for both IPv4 and IPv6 packets (e.g. IPv4 source and IPv6
+  // destination) never matches, as no packet has both bits set
+  setField(kL3Word, 8, ipTypeBits, ipTypeBits);
+
+  if (auto srcPort = entry.getSrcPort()) {
+    setField(kPortWord, 48, 0xffff, *srcPort);
+  }
+  if (auto dstPort = entry.getDstPort()) {
+    setField(kPortWord, 32, 0xffff, *dstPort);
+  }
+  if (auto l4SrcPort = entry.getL4SrcPort()) {
+    setField(kPortWord, 16, 0xffff, *l4SrcPort);
+  }
+  if (auto l4DstPort = entry.getL4DstPort()) {
+    setField(kPortWord, 0, 0xffff, *l4DstPort);
+  }
+
+  if (auto dstMac = entry.getDstMac()) {
+    setField(kL2Word, 16, 0xffffffffffffULL, dstMac->u64HBO());
+  }
+  if (auto etherType = entry.getEtherType()) {
+    if (*etherType != cfg::EtherType::ANY) {
+      setField(kL2Word, 0, 0xffff, static_cast<uint64_t>(*etherType));
+    }
+  }
+
+  if (auto vlanID = entry.getVlanID()) {
+    setField(kMetadataWord, 32, 0xffffffff, *vlanID);
+  }
+  if (auto lookupClassL2 = entry.getLookupClassL2()) {
+    setField(kMetadataWord, 24, 0xff, packLookupClass(lookupClassL2));
+  }
+  if (auto lookupClassNeighbor = entry.getLookupClassNeighbor()) {
+    setField(kMetadataWord, 16, 0xff, packLookupClass(lookupClassNeighbor));
+  }
+  if (auto lookupClassRoute = entry.getLookupClassRoute()) {
+    setField(kMetadataWord, 8, 0xff, packLookupClass(lookupClassRoute));
+  }
+  if (auto packetLookupResult = entry.getPacketLookupResult()) {
+    setField(
+        kMetadataWord, 0, 0xff, static_cast<uint64_t>(*packetLookupResult));
+  }
+  return std::make_pair(value, mask);
+}
+
+int AclClassifier::matchBlock(const Key& key, size_t block) const {
+  // Kept branch free so that it vectorizes
+  std::array<uint64_t, kBlockSize> miss{};
+  for (auto word = 0; word < kKeyWords; word++) {
+    const auto* values = values_[word].data() + block;
+    const auto* masks = masks_[word].data() + block;
+    auto keyWord = key[word];
+    for (size_t i = 0; i < kBlockSize; i++) {
+      miss[i] |= (keyWord & masks[i]) ^ values[i];
+    }
+  }
+  for (size_t i = 0; i < kBlockSize; i++) {
+    if (!miss[i]) {
+      return static_cast<int>(block + i);
+    }
+  }
+  return kNoMatch;
+}
+
+int AclClassifier::match(const Key& key) const {
+  for (size_t block = 0; block < values_[0].size(); block += kBlockSize) {
+    auto index = matchBlock(key, block);
+    if (index != kNoMatch) {
+      return index;
+    }
+  }
+  return kNoMatch;
+}
+
+int AclClassifier::classify(const AclPacket& packet) const {
+  return match(packPacket(packet));
+}
+
+std::vector<int> AclClassifier::classify(
+    const std::vector<AclPacket>& packets) const {
+  std::vector<Key> keys;
+  keys.reserve(packets.size());
+  for (const auto& packet : packets) {
+    keys.push_back(packPacket(packet));
+  }
+
+  std::vector<int> matches(packets.size(), kNoMatch);
+  for (size_t first = 0; first < keys.size(); first += kPacketBatchSize) {
+    auto last = std::min(first + kPacketBatchSize, keys.size());
+    auto unmatched = last - first;
+    for (size_t block = 0; block < values_[0].size() && unmatched;
+         block += kBlockSize) {
+      for (auto packet = first; packet < last; packet++) {
+        if (matches[packet] != kNoMatch) {
+          continue;
+        }
+        matches[packet] = matchBlock(keys[packet], block);
+        if (matches[packet] != kNoMatch) {
+          unmatched--;
+        }
+      }
+    }
+  }
+  return matches;
+}
+
+std::vector<std::pair<std::shared_ptr<AclEntry>, std::shared_ptr<AclEntry>>>
+AclClassifier::findShadowedEntries() const {
+  std::vector<std::pair<std::shared_ptr<AclEntry>, std::shared_ptr<AclEntry>>>
+      shadowed;
+  std::array<uint64_t, kBlockSize> uncovered;
+  for (size_t entry = 1; entry < entries_.size(); entry++) {
+    // An earlier entry shadows this one if it matches on a subset of the
+    // bits, with the same values
+    for (size_t block = 0; block < entry; block += kBlockSize) {
+      uncovered.fill(0);
+      for (auto word = 0; word < kKeyWords; word++) {
+        const auto* values = values_[word].data() + block;
+        const auto* masks = masks_[word].data() + block;
+        auto entryValue = values_[word][entry];
+        auto entryMask = masks_[word][entry];
+        for (size_t i = 0; i < kBlockSize; i++) {
+          uncovered[i] |=
+              (masks[i] & ~entryMask) | ((entryValue & masks[i]) ^ values[i]);
+        }
+      }
+      auto end = std::min(kBlockSize, entry - block);
+      auto it = std::find(uncovered.begin(), uncovered.begin() + end, 0);
+      if (it != uncovered.begin() + end) {
+        shadowed.emplace_back(
+            entries_[entry], entries_[block + (it - uncovered.begin())]);
+        break;
+      }
+    }
+  }
+  return shadowed;
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/gen-cpp2/switch_config_types.h"
+
+#include <folly/IPAddress.h>
+#include <folly/MacAddress.h>
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace facebook::fboss {
+
+class AclEntry;
+class AclMap;
+
+/*
+ * The packet fields ACL entries can qualify on, for AclClassifier.
+ *
+ * srcIp and dstIp stay empty for non IP packets.
+ */
+struct AclPacket {
+  enum class Fragment : uint8_t {
+    NOT_FRAGMENTED,
+    FIRST_FRAGMENT,
+    NOT_FIRST_FRAGMENT,
+  };
+
+  folly::IPAddress srcIp;
+  folly::IPAddress dstIp;
+  uint8_t proto{0};
+  uint8_t tcpFlags{0};
+  // Logical ports the packet is received on and sent out of
+  uint16_t srcPort{0};
+  uint16_t dstPort{0};
+  uint16_t l4SrcPort{0};
+  uint16_t l4DstPort{0};
+  Fragment fragment{Fragment::NOT_FRAGMENTED};
+  uint8_t icmpType{0};
+  uint8_t icmpCode{0};
+  uint8_t dscp{0};
+  uint8_t ttl{0};
+  folly::MacAddress dstMac;
+  uint16_t etherType{0};
+  uint32_t vlanID{0};
+  std::optional<cfg::AclLookupClass> lookupClassL2;
+  std::optional<cfg::AclLookupClass> lookupClassNeighbor;
+  std::optional<cfg::AclLookupClass> lookupClassRoute;
+  std::optional<cfg::PacketLookupResultType> packetLookupResult;
+};
+
+/*
+ * AclClassifier evaluates an AclMap in software, the way the ACL TCAM does:
+ * a packet hits the matching entry with the lowest priority number.
+ *
+ * Every entry is packed into a fixed width ternary key (value and mask
+ * words), stored one array per key word across all entries. Matching a
+ * packet is then the same few AND/XOR/OR operations over contiguous arrays
+ * for every entry, which the compiler vectorizes.
+ *
+ * This allows validating ACL changes before they are programmed, e.g. by
+ * classifying the same packets against the current and the new AclMap, and
+ * finding entries which can never be hit.
+ *
+ * The classifier keeps a snapshot of the entries it is built from.
+ */
+class AclClassifier {
+ public:
+  static constexpr int kNoMatch = -1;
+
+  explicit AclClassifier(const AclMap& acls);
+
+  /*
+   * Index, into getEntries(), of the entry each packet hits, or kNoMatch.
+   */
+  std::vector<int> classify(const std::vector<AclPacket>& packets) const;
+  int classify(const AclPacket& packet) const;
+
+  /*
+   * Entries which can never be hit, as every packet they match hits an entry
+   * with a lower priority number. Returned as (shadowed entry, first entry
+   * shadowing it) pairs, ordered by priority.
+   *
+   * Only entries shadowed by a single other entry are found, not those
+   * covered by the union of several entries.
+   */
+  std::vector<std::pair<std::shared_ptr<AclEntry>, std::shared_ptr<AclEntry>>>
+  findShadowedEntries() const;
+
+  // Entries ordered by priority
+  const std::vector<std::shared_ptr<AclEntry>>& getEntries() const {
+    return entries_;
+  }
+
+ private:
+  // Number of 64 bit words in the packed key, see AclClassifier.cpp
+  static constexpr int kKeyWords = 8;
+  using Key = std::array<uint64_t, kKeyWords>;
+
+  static Key packPacket(const AclPacket& packet);
+  static std::pair<Key, Key> packEntry(const AclEntry& entry);
+
+  int match(const Key& key) const;
+  int matchBlock(const Key& key, size_t block) const;
+
+  std::vector<std::shared_ptr<AclEntry>> entries_;
+  // Per key word, the (masked) value and the mask of every entry. Padded
+  // with entries which never match to a multiple of the block size.
+  std::array<std::vector<uint64_t>, kKeyWords> values_;
+  std::array<std::vector<uint64_t>, kKeyWords> masks_;
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/AclPriorityAllocator.h"
+
+#include "fboss/agent/FbossError.h"
+
+#include <algorithm>
+
+namespace facebook::fboss {
+
+AclPriorityAllocator::AclPriorityAllocator(
+    int minPriority,
+    int maxPriority,
+    int gap)
+    : minPriority_(minPriority), maxPriority_(maxPriority), gap_(gap) {
+  if (minPriority_ > maxPriority_ || gap_ < 1) {
+    throw FbossError(
+        "Invalid ACL priority range [",
+        minPriority_,
+        ", ",
+        maxPriority_,
+        "] or gap ",
+        gap_);
+  }
+}
+
+std::optional<int> AclPriorityAllocator::getStep(
+    std::optional<int> previous,
+    std::optional<int> next,
+    size_t count) const {
+  int64_t step = gap_;
+  if (previous) {
+    // Spread the entries evenly between previous and next, or leave the gap
+    // after previous up to maxPriority
+    auto room = next ? (int64_t(*next) - *previous) / int64_t(count + 1)
+                     : (int64_t(maxPriority_) - *previous) / int64_t(count);
+    step = std::min(step, room);
+  } else {
+    // Start at minPriority, the last entry must come before next
+    int64_t highest = next ? int64_t(*next) - 1 : maxPriority_;
+    if (highest < minPriority_) {
+      return std::nullopt;
+    }
+    if (count > 1) {
+      step = std::min<int64_t>(
+          step, (highest - minPriority_) / int64_t(count - 1));
+    }
+  }
+  if (step < 1) {
+    return std::nullopt;
+  }
+  return static_cast<int>(step);
+}
+
+std::vector<int> AclPriorityAllocator::allocate(
+    const std::vector<std::optional<int>>& currentPriorities) const {
+  auto numEntries = currentPriorities.size();
+  auto keepable = [&](size_t entry) {
+    const auto& priority = currentPriorities[entry];
+    return priority && *priority >= minPriority_ && *priority <= maxPriority_;
+  };
+
+  // Longest strictly increasing subsequence of the current priorities.
+  // tails[n] is the entry ending the subsequence of length n + 1 with the
+  // lowest priority found so far.
+  std::vector<size_t> tails;
+  std::vector<std::optional<size_t>> predecessor(numEntries);
+  for (size_t entry = 0; entry < numEntries; entry++) {
+    if (!keepable(entry)) {
+      continue;
+    }
+    auto it = std::lower_bound(
+        tails.begin(),
+        tails.end(),
+        *currentPriorities[entry],
+        [&](size_t tail, int priority) {
+          return *currentPriorities[tail] < priority;
+        });
+    if (it != tails.begin()) {
+      predecessor[entry] = *(it - 1);
+    }
+    if (it == tails.end()) {
+      tails.push_back(entry);
+    } else {
+      *it = entry;
+    }
+  }
+  std::vector<bool> kept(numEntries, false);
+  if (!tails.empty()) {
+    for (std::optional<size_t> entry = tails.back(); entry;
+         entry = predecessor[*entry]) {
+      kept[*entry] = true;
+    }
+  }
+
+  std::vector<int> priorities(numEntries);
+  std::optional<int> previous;
+  size_t entry = 0;
+  while (entry < numEntries) {
+    if (kept[entry]) {
+      previous = priorities[entry] = *currentPriorities[entry];
+      entry++;
+      continue;
+    }
+    // Place the entries up to the next kept one, moving that one as well
+    // while they don't fit in front of it
+    auto end = entry;
+    std::optional<int> step;
+    while (true) {
+      while (end < numEntries && !kept[end]) {
+        end++;
+      }
+      auto next = end < numEntries ? currentPriorities[end] : std::nullopt;
+      step = getStep(previous, next, end - entry);
+      if (step) {
+        break;
+      }
+      if (end == numEntries) {
+        throw FbossError(
+            numEntries,
+            " ACL entries do not fit in priorities [",
+            minPriority_,
+            ", ",
+            maxPriority_,
+            "]");
+      }
+      kept[end] = false;
+    }
+    for (; entry < end; entry++) {
+      previous = priorities[entry] =
+          previous ? *previous + *step : minPriority_;
+    }
+  }
+  return priorities;
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <optional>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * AclPriorityAllocator assigns priorities, i.e. ACL TCAM positions, to an
+ * ordered list of ACL entries.
+ *
+ * ACL entries are programmed by priority, so an entry getting a new priority
+ * is removed from and added to the hardware again. To move as few entries as
+ * possible, the largest set of existing entries whose priorities are already
+ * in the right order keeps its priorities. Only the other entries get new
+ * priorities, in the gaps between the kept ones. An entry in the way is only
+ * moved as well if a gap is too small.
+ *
+ * New entries are spaced gap priorities apart where there is room, so that
+ * entries inserted later fit in between.
+ */
+class AclPriorityAllocator {
+ public:
+  AclPriorityAllocator(int minPriority, int maxPriority, int gap);
+
+  /*
+   * currentPriorities holds, in the new order of the entries, the priority
+   * each entry has now, or std::nullopt for new entries. Returns the new
+   * priority of each entry, increasing.
+   *
+   * Throws FbossError if the entries do not fit in the priority range.
+   */
+  std::vector<int> allocate(
+      const std::vector<std::optional<int>>& currentPriorities) const;
+
+ private:
+  // Spacing of count entries placed between the priorities of the entries
+  // around them, if they fit
+  std::optional<int> getStep(
+      std::optional<int> previous,
+      std::optional<int> next,
+      size_t count) const;
+
+  const int minPriority_;
+  const int maxPriority_;
+  const int gap_;
+};
+
+} // namespace facebook::fboss
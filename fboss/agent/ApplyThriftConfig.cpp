@@ -9,18 +9,28 @@
  */
 #include "fboss/agent/ApplyThriftConfig.h"
 
+#include <fb303/ServiceData.h>
+#include <folly/ExceptionWrapper.h>
 #include <folly/FileUtil.h>
+#include <folly/Indestructible.h>
+#include <folly/String.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <folly/gen/Base.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 #include <memory>
 #include <optional>
 #include <string>
 
+#include "fboss/agent/AclClassifier.h"
+#include "fboss/agent/AclPriorityAllocator.h"
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/LacpTypes.h"
 #include "fboss/agent/LoadBalancerConfigApplier.h"
 #include "fboss/agent/Platform.h"
 #include "fboss/agent/RouteUpdateWrapper.h"
+#include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/if/gen-cpp2/mpls_types.h"
 #include "fboss/agent/normalization/Normalizer.h"
 #include "fboss/agent/rib/RoutingInformationBase.h"
@@ -35,6 +45,7 @@
 #include "fboss/agent/state/BufferPoolConfig.h"
 #include "fboss/agent/state/BufferPoolConfigMap.h"
 #include "fboss/agent/state/ControlPlane.h"
+#include "fboss/agent/state/DeltaFunctions.h"
 #include "fboss/agent/state/Interface.h"
 #include "fboss/agent/state/InterfaceMap.h"
 #include "fboss/agent/state/LabelForwardingInformationBase.h"
@@ -58,7 +69,9 @@
 #include <boost/container/flat_set.hpp>
 #include <folly/Range.h>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <functional>
 #include <utility>
 #include <vector>
 
@@ -84,6 +97,31 @@ DEFINE_bool(
     false,
     "Allow multiple acl tables (acl table group)");
 
+DEFINE_bool(
+    incremental_config_apply,
+    true,
+    "Skip config sections which did not change since the previous config");
+
+DEFINE_int32(
+    config_apply_threads,
+    4,
+    "Number of threads to build independent config sections on. "
+    "Sections are built on the applying thread if less than 2");
+
+DEFINE_bool(
+    log_shadowed_acls,
+    false,
+    "Log ACL entries which can never be hit as entries with a higher "
+    "priority match all their packets");
+
+DEFINE_int32(
+    acl_priority_gap,
+    1,
+    "Spacing between the priorities of newly added ACL entries. Entries "
+    "inserted later take priorities in the gaps instead of moving the "
+    "entries after them. With the default of 1 there are no gaps, so an "
+    "entry inserted before the others moves all the entries after it");
+
 namespace {
 
 const uint8_t kV6LinkLocalAddrMask{64};
@@ -110,6 +148,99 @@ std::shared_ptr<facebook::fboss::SwitchState> updateFibFromConfig(
   return *nextStatePtr;
 }
 
+// Shared by all config applies, which are serialized by the state update
+// thread.
+folly::Executor* configApplyExecutor() {
+  if (FLAGS_config_apply_threads < 2) {
+    return nullptr;
+  }
+  static folly::Indestructible<folly::CPUThreadPoolExecutor> executor(
+      FLAGS_config_apply_threads,
+      std::make_shared<folly::NamedThreadFactory>("ConfigApply"));
+  return &*executor;
+}
+
+// Estimate of the hardware ACL entries removed and added to get from oldAcls
+// to newAcls, counted from the priority keyed state delta which the switches
+// program. A changed entry counts as a removal and an addition.
+int estimateAclHwOperations(
+    const std::shared_ptr<facebook::fboss::AclMap>& oldAcls,
+    const std::shared_ptr<facebook::fboss::AclMap>& newAcls) {
+  auto oldPrioAcls = std::make_unique<facebook::fboss::PrioAclMap>();
+  if (oldAcls) {
+    oldPrioAcls->addAcls(oldAcls);
+  }
+  auto newPrioAcls = std::make_unique<facebook::fboss::PrioAclMap>();
+  newPrioAcls->addAcls(newAcls);
+  int operations = 0;
+  facebook::fboss::DeltaFunctions::forEachChanged(
+      facebook::fboss::AclMapDelta(
+          std::move(oldPrioAcls), std::move(newPrioAcls)),
+      [&](const auto& /* oldAcl */, const auto& /* newAcl */) {
+        operations += 2;
+      },
+      [&](const auto& /* newAcl */) { ++operations; },
+      [&](const auto& /* oldAcl */) { ++operations; });
+  return operations;
+}
+
+template <typename Ref>
+bool optionalFieldChanged(Ref prev, Ref cur) {
+  return prev.has_value() != cur.has_value() ||
+      (cur.has_value() && *prev != *cur);
+}
+
+/*
+ * Config sections whose SwitchState nodes are built only from the config
+ * fields compared here and from the same nodes in the original state. When
+ * none of their fields changed since the previously applied config, applying
+ * them again can only reproduce the original nodes, so they are skipped.
+ *
+ * Ports, VLANs, interfaces and routes are always applied, as they fill in
+ * the port/VLAN/interface maps the later sections depend on.
+ */
+struct ChangedConfigSections {
+  bool qcm{true};
+  bool bufferPools{true};
+  bool aggregatePorts{true};
+  bool mirrors{true};
+  bool acls{true};
+  bool qosPolicies{true};
+  bool sflowCollectors{true};
+  bool loadBalancers{true};
+};
+
+ChangedConfigSections diffConfigSections(
+    const facebook::fboss::cfg::SwitchConfig* prev,
+    const facebook::fboss::cfg::SwitchConfig& cur) {
+  ChangedConfigSections changed;
+  if (!prev) {
+    return changed;
+  }
+  changed.qcm = optionalFieldChanged(prev->qcmConfig(), cur.qcmConfig());
+  changed.bufferPools =
+      optionalFieldChanged(prev->bufferPoolConfigs(), cur.bufferPoolConfigs());
+  changed.aggregatePorts = *prev->aggregatePorts() != *cur.aggregatePorts() ||
+      optionalFieldChanged(prev->lacp(), cur.lacp());
+  // Mirrors refer to their egress ports by name
+  changed.mirrors =
+      *prev->mirrors() != *cur.mirrors() || *prev->ports() != *cur.ports();
+  // ACLs are checked against the mirrors they use
+  changed.acls = changed.mirrors || *prev->acls() != *cur.acls() ||
+      *prev->trafficCounters() != *cur.trafficCounters() ||
+      optionalFieldChanged(prev->aclTableGroup(), cur.aclTableGroup()) ||
+      optionalFieldChanged(prev->cpuTrafficPolicy(), cur.cpuTrafficPolicy()) ||
+      optionalFieldChanged(
+          prev->dataPlaneTrafficPolicy(), cur.dataPlaneTrafficPolicy());
+  changed.qosPolicies = *prev->qosPolicies() != *cur.qosPolicies() ||
+      optionalFieldChanged(
+          prev->dataPlaneTrafficPolicy(), cur.dataPlaneTrafficPolicy());
+  changed.sflowCollectors =
+      *prev->sFlowCollectors() != *cur.sFlowCollectors();
+  changed.loadBalancers = *prev->loadBalancers() != *cur.loadBalancers();
+  return changed;
+}
+
 } // anonymous namespace
 
 namespace facebook::fboss {
@@ -127,15 +258,22 @@ class ThriftConfigApplier {
       const std::shared_ptr<SwitchState>& orig,
       const cfg::SwitchConfig* config,
       const Platform* platform,
-      RoutingInformationBase* rib)
-      : orig_(orig), cfg_(config), platform_(platform), rib_(rib) {}
+      RoutingInformationBase* rib,
+      const cfg::SwitchConfig* prevConfig)
+      : orig_(orig),
+        cfg_(config),
+        prevCfg_(prevConfig),
+        platform_(platform),
+        rib_(rib) {}
   ThriftConfigApplier(
       const std::shared_ptr<SwitchState>& orig,
       const cfg::SwitchConfig* config,
       const Platform* platform,
-      RouteUpdateWrapper* routeUpdater)
+      RouteUpdateWrapper* routeUpdater,
+      const cfg::SwitchConfig* prevConfig)
       : orig_(orig),
         cfg_(config),
+        prevCfg_(prevConfig),
         platform_(platform),
         routeUpdater_(routeUpdater) {}
 
@@ -356,9 +494,55 @@ class ThriftConfigApplier {
       const std::vector<cfg::StaticMplsRouteNoNextHops>& staticMplsRoutesToNull,
       const std::vector<cfg::StaticMplsRouteNoNextHops>& staticMplsRoutesToCPU);
 
+  // Record the time spent applying one section of the config
+  void sectionApplied(
+      folly::StringPiece section,
+      std::chrono::steady_clock::time_point start);
+  void reportSectionTimes() const;
+
+  /*
+   * Each section of the config is built from cfg_, orig_ and the sections it
+   * depends on. Building must not modify new_: it returns the function which
+   * merges the section into new_, returning whether new_ changed. Sections
+   * which do not depend on each other are built in parallel, then merged one
+   * at a time on the applying thread.
+   */
+  using SectionMerge = std::function<bool()>;
+  struct ConfigSection {
+    folly::StringPiece name;
+    // One more than the highest level of the sections it depends on
+    size_t level;
+    bool skipped;
+    std::function<SectionMerge()> build;
+    SectionMerge merge;
+    std::chrono::microseconds time{0};
+  };
+  void addSection(
+      folly::StringPiece name,
+      std::vector<folly::StringPiece> deps,
+      bool skipped,
+      std::function<SectionMerge()> build);
+  // Build and merge all the sections, returning whether new_ changed
+  bool applySections();
+
+  template <typename Node, typename Reset>
+  SectionMerge resetIfChanged(std::shared_ptr<Node> node, Reset reset) {
+    return [this, node = std::move(node), reset]() {
+      if (!node) {
+        return false;
+      }
+      (new_.get()->*reset)(node);
+      return true;
+    };
+  }
+
+  bool updateRoutes();
+
   std::shared_ptr<SwitchState> orig_;
   std::shared_ptr<SwitchState> new_;
   const cfg::SwitchConfig* cfg_{nullptr};
+  // The config orig_ was last configured with, if known
+  const cfg::SwitchConfig* prevCfg_{nullptr};
   const Platform* platform_{nullptr};
   RoutingInformationBase* rib_{nullptr};
   RouteUpdateWrapper* routeUpdater_{nullptr};
@@ -380,169 +564,135 @@ class ThriftConfigApplier {
   flat_map<PortID, Port::VlanMembership> portVlans_;
   flat_map<VlanID, Vlan::MemberPorts> vlanPorts_;
   flat_map<VlanID, VlanInterfaceInfo> vlanInterfaces_;
+
+  std::vector<std::pair<folly::StringPiece, std::chrono::microseconds>>
+      sectionTimes_;
+  std::vector<folly::StringPiece> skippedSections_;
+  std::vector<ConfigSection> sections_;
+  // Hardware ACL entry removals and additions estimated from the ACL delta
+  int aclHwOperationsEstimate_{0};
 };
 
 shared_ptr<SwitchState> ThriftConfigApplier::run() {
+  auto applyStart = std::chrono::steady_clock::now();
   new_ = orig_->clone();
-  bool changed = false;
+  auto changedSections = diffConfigSections(
+      FLAGS_incremental_config_apply ? prevCfg_ : nullptr, *cfg_);
 
-  {
-    auto newSwitchSettings = updateSwitchSettings();
-    if (newSwitchSettings) {
-      new_->resetSwitchSettings(std::move(newSwitchSettings));
-      changed = true;
-    }
-  }
+  // Sections must be added after the sections they depend on
+  addSection("switch_settings", {}, false, [this]() {
+    return resetIfChanged(
+        updateSwitchSettings(), &SwitchState::resetSwitchSettings);
+  });
 
-  {
+  addSection("qcm", {}, !changedSections.qcm, [this]() {
     bool qcmChanged = false;
     auto newQcmConfig = updateQcmCfg(&qcmChanged);
-    if (qcmChanged) {
-      new_->resetQcmCfg(newQcmConfig);
-      changed = true;
-    }
-  }
-
-  {
-    auto newControlPlane = updateControlPlane();
-    if (newControlPlane) {
-      new_->resetControlPlane(std::move(newControlPlane));
-      changed = true;
-    }
-  }
-
-  processVlanPorts();
-
-  {
+    return SectionMerge([this, qcmChanged, newQcmConfig]() {
+      if (qcmChanged) {
+        new_->resetQcmCfg(newQcmConfig);
+      }
+      return qcmChanged;
+    });
+  });
+
+  addSection("control_plane", {}, false, [this]() {
+    return resetIfChanged(
+        updateControlPlane(), &SwitchState::resetControlPlane);
+  });
+
+  // Fills in portVlans_ and vlanPorts_
+  addSection("vlan_ports", {}, false, [this]() {
+    processVlanPorts();
+    return SectionMerge([]() { return false; });
+  });
+
+  addSection("buffer_pools", {}, !changedSections.bufferPools, [this]() {
     bool bufferPoolConfigChanged = false;
     auto newBufferPoolCfg = updateBufferPoolConfigs(&bufferPoolConfigChanged);
-    if (bufferPoolConfigChanged) {
-      new_->resetBufferPoolCfgs(newBufferPoolCfg);
-      changed = true;
-    }
-  }
-
-  {
-    auto newPorts = updatePorts(new_->getTransceivers());
-    if (newPorts) {
-      new_->resetPorts(std::move(newPorts));
-      changed = true;
-    }
-  }
-
-  {
-    auto newAggPorts = updateAggregatePorts();
-    if (newAggPorts) {
-      new_->resetAggregatePorts(std::move(newAggPorts));
-      changed = true;
-    }
-  }
+    return SectionMerge(
+        [this, bufferPoolConfigChanged, newBufferPoolCfg]() {
+          if (bufferPoolConfigChanged) {
+            new_->resetBufferPoolCfgs(newBufferPoolCfg);
+          }
+          return bufferPoolConfigChanged;
+        });
+  });
+
+  // Ports check their PG configs against the new buffer pools
+  addSection("ports", {"vlan_ports", "buffer_pools"}, false, [this]() {
+    return resetIfChanged(
+        updatePorts(new_->getTransceivers()), &SwitchState::resetPorts);
+  });
+
+  addSection(
+      "aggregate_ports", {}, !changedSections.aggregatePorts, [this]() {
+        return resetIfChanged(
+            updateAggregatePorts(), &SwitchState::resetAggregatePorts);
+      });
 
   // updateMirrors must be called after updatePorts, mirror needs ports!
-  {
-    auto newMirrors = updateMirrors();
-    if (newMirrors) {
-      new_->resetMirrors(std::move(newMirrors));
-      changed = true;
-    }
-  }
+  addSection("mirrors", {"ports"}, !changedSections.mirrors, [this]() {
+    return resetIfChanged(updateMirrors(), &SwitchState::resetMirrors);
+  });
 
   // updateAcls must be called after updateMirrors, acls may need mirror!
-  {
+  addSection("acls", {"mirrors"}, !changedSections.acls, [this]() {
     if (FLAGS_enable_acl_table_group) {
-      auto newAclTableGroups = updateAclTableGroups();
-      if (newAclTableGroups) {
-        new_->resetAclTableGroups(std::move(newAclTableGroups));
-        changed = true;
-      }
-    } else {
-      auto newAcls = updateAcls(cfg::AclStage::INGRESS, *cfg_->acls());
-      if (newAcls) {
-        new_->resetAcls(std::move(newAcls));
-        changed = true;
-      }
+      return resetIfChanged(
+          updateAclTableGroups(), &SwitchState::resetAclTableGroups);
     }
-  }
-
-  {
-    auto newQosPolicies = updateQosPolicies();
-    if (newQosPolicies) {
-      new_->resetQosPolicies(std::move(newQosPolicies));
-      changed = true;
-    }
-  }
+    return resetIfChanged(
+        updateAcls(cfg::AclStage::INGRESS, *cfg_->acls()),
+        &SwitchState::resetAcls);
+  });
 
-  // reset the default qos policy
-  {
+  addSection("qos_policies", {}, !changedSections.qosPolicies, [this]() {
+    auto mergeQosPolicies =
+        resetIfChanged(updateQosPolicies(), &SwitchState::resetQosPolicies);
     auto newDefaultQosPolicy = updateDataplaneDefaultQosPolicy();
-    if (new_->getDefaultDataPlaneQosPolicy() != newDefaultQosPolicy) {
-      new_->setDefaultDataPlaneQosPolicy(newDefaultQosPolicy);
-      changed = true;
-    }
-  }
-
-  {
-    auto newIntfs = updateInterfaces();
-    if (newIntfs) {
-      new_->resetIntfs(std::move(newIntfs));
-      changed = true;
-    }
-  }
-
-  // Note: updateInterfaces() must be called before updateVlans(),
-  // as updateInterfaces() populates the vlanInterfaces_ data structure.
-  {
-    auto newVlans = updateVlans();
-    if (newVlans) {
-      new_->resetVlans(std::move(newVlans));
-      changed = true;
-    }
-  }
-
-  if (routeUpdater_) {
-    routeUpdater_->setRoutesToConfig(
-        intfRouteTables_,
-        *cfg_->staticRoutesWithNhops(),
-        *cfg_->staticRoutesToNull(),
-        *cfg_->staticRoutesToCPU(),
-        *cfg_->staticIp2MplsRoutes(),
-        *cfg_->staticMplsRoutesWithNhops(),
-        *cfg_->staticMplsRoutesToNull(),
-        *cfg_->staticMplsRoutesToCPU());
-  } else if (rib_) {
-    auto newFibs = updateForwardingInformationBaseContainers();
-    if (newFibs) {
-      new_->resetForwardingInformationBases(newFibs);
-      changed = true;
-    }
+    return SectionMerge([this, mergeQosPolicies, newDefaultQosPolicy]() {
+      bool qosChanged = mergeQosPolicies();
+      // reset the default qos policy
+      if (new_->getDefaultDataPlaneQosPolicy() != newDefaultQosPolicy) {
+        new_->setDefaultDataPlaneQosPolicy(newDefaultQosPolicy);
+        qosChanged = true;
+      }
+      return qosChanged;
+    });
+  });
+
+  // Fills in vlanInterfaces_ and intfRouteTables_
+  addSection("interfaces", {}, false, [this]() {
+    return resetIfChanged(updateInterfaces(), &SwitchState::resetIntfs);
+  });
+
+  addSection("vlans", {"vlan_ports", "interfaces"}, false, [this]() {
+    return resetIfChanged(updateVlans(), &SwitchState::resetVlans);
+  });
+
+  // The RIB updates new_ as it reconfigures, so routes are applied in the
+  // merge, on the applying thread.
+  addSection("routes", {"interfaces"}, false, [this]() {
+    return SectionMerge([this]() { return updateRoutes(); });
+  });
+
+  addSection(
+      "sflow_collectors", {}, !changedSections.sflowCollectors, [this]() {
+        return resetIfChanged(
+            updateSflowCollectors(), &SwitchState::resetSflowCollectors);
+      });
 
-    rib_->reconfigure(
-        intfRouteTables_,
-        *cfg_->staticRoutesWithNhops(),
-        *cfg_->staticRoutesToNull(),
-        *cfg_->staticRoutesToCPU(),
-        *cfg_->staticIp2MplsRoutes(),
-        *cfg_->staticMplsRoutesWithNhops(),
-        *cfg_->staticMplsRoutesToNull(),
-        *cfg_->staticMplsRoutesToCPU(),
-        &updateFibFromConfig,
-        static_cast<void*>(&new_));
-  } else {
-    // switch state UTs don't necessary care about RIB updates
-    XLOG(WARNING)
-        << " Ignoring config updates to rib, should never happen outside of tests";
-  }
+  addSection(
+      "load_balancers", {}, !changedSections.loadBalancers, [this]() {
+        LoadBalancerConfigApplier loadBalancerConfigApplier(
+            orig_->getLoadBalancers(), cfg_->get_loadBalancers(), platform_);
+        return resetIfChanged(
+            loadBalancerConfigApplier.updateLoadBalancers(),
+            &SwitchState::resetLoadBalancers);
+      });
 
-  // resolving mpls next hops may need interfaces to be setup
-  // process static mpls routes after processing interfaces
-  auto labelFib = updateStaticMplsRoutes(
-      *cfg_->staticMplsRoutesWithNhops(),
-      *cfg_->staticMplsRoutesToNull(),
-      *cfg_->staticMplsRoutesToNull());
-  if (labelFib) {
-    new_->resetLabelForwardingInformationBase(labelFib);
-    changed = true;
-  }
+  bool changed = applySections();
 
   auto newVlans = new_->getVlans();
   VlanID dfltVlan(*cfg_->defaultVlan());
@@ -651,25 +801,6 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     changed = true;
   }
 
-  // Add sFlow collectors
-  {
-    auto newCollectors = updateSflowCollectors();
-    if (newCollectors) {
-      new_->resetSflowCollectors(std::move(newCollectors));
-      changed = true;
-    }
-  }
-
-  {
-    LoadBalancerConfigApplier loadBalancerConfigApplier(
-        orig_->getLoadBalancers(), cfg_->get_loadBalancers(), platform_);
-    auto newLoadBalancers = loadBalancerConfigApplier.updateLoadBalancers();
-    if (newLoadBalancers) {
-      new_->resetLoadBalancers(std::move(newLoadBalancers));
-      changed = true;
-    }
-  }
-
   // normalizer to refresh counter tags
   if (auto normalizer = Normalizer::getInstance()) {
     normalizer->reloadCounterTags(*cfg_);
@@ -678,12 +809,178 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
         << "Normalizer failed to initialize, skipping loading counter tags";
   }
 
+  sectionApplied("total", applyStart);
+  reportSectionTimes();
+  fb303::fbData->setCounter(
+      folly::to<std::string>(
+          SwitchStats::kCounterPrefix, "config_apply.acl_hw_ops_estimate"),
+      aclHwOperationsEstimate_);
+  XLOG(INFO) << "Estimated config ACL hardware operations: "
+             << aclHwOperationsEstimate_;
+
   if (!changed) {
     return nullptr;
   }
   return new_;
 }
 
+void ThriftConfigApplier::sectionApplied(
+    folly::StringPiece section,
+    std::chrono::steady_clock::time_point start) {
+  sectionTimes_.emplace_back(
+      section,
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start));
+}
+
+void ThriftConfigApplier::reportSectionTimes() const {
+  std::string times;
+  for (const auto& [section, duration] : sectionTimes_) {
+    folly::toAppend(section, "=", duration.count(), "us ", &times);
+    fb303::fbData->setCounter(
+        folly::to<std::string>(
+            SwitchStats::kCounterPrefix, "config_apply.", section, ".us"),
+        duration.count());
+  }
+  XLOG(INFO) << "Config section apply times: " << times
+             << "skipped unchanged: " << folly::join(",", skippedSections_);
+}
+
+void ThriftConfigApplier::addSection(
+    folly::StringPiece name,
+    std::vector<folly::StringPiece> deps,
+    bool skipped,
+    std::function<SectionMerge()> build) {
+  size_t level = 0;
+  for (auto dep : deps) {
+    auto it = std::find_if(
+        sections_.begin(), sections_.end(), [dep](const auto& section) {
+          return section.name == dep;
+        });
+    if (it == sections_.end()) {
+      throw FbossError(
+          "Config section ", name, " depends on unknown section ", dep);
+    }
+    level = std::max(level, it->level + 1);
+  }
+  sections_.push_back(ConfigSection{name, level, skipped, std::move(build)});
+}
+
+bool ThriftConfigApplier::applySections() {
+  size_t numLevels = 0;
+  for (const auto& section : sections_) {
+    numLevels = std::max(numLevels, section.level + 1);
+  }
+  auto* executor = configApplyExecutor();
+  bool changed = false;
+  for (size_t level = 0; level < numLevels; ++level) {
+    std::vector<ConfigSection*> toBuild;
+    for (auto& section : sections_) {
+      if (section.level != level) {
+        continue;
+      }
+      if (section.skipped) {
+        skippedSections_.push_back(section.name);
+      } else {
+        toBuild.push_back(&section);
+      }
+    }
+
+    // Build the sections of this level, which only read cfg_, orig_ and
+    // what lower levels merged into new_.
+    std::vector<folly::exception_wrapper> errors(toBuild.size());
+    auto buildSection = [&toBuild, &errors](size_t i) {
+      auto section = toBuild[i];
+      auto start = std::chrono::steady_clock::now();
+      try {
+        section->merge = section->build();
+      } catch (...) {
+        errors[i] = folly::exception_wrapper(std::current_exception());
+      }
+      section->time = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start);
+    };
+    if (!executor || toBuild.size() < 2) {
+      for (size_t i = 0; i < toBuild.size(); ++i) {
+        buildSection(i);
+      }
+    } else {
+      std::vector<folly::Future<folly::Unit>> builds;
+      for (size_t i = 0; i < toBuild.size(); ++i) {
+        builds.push_back(
+            folly::via(executor, [&buildSection, i]() { buildSection(i); }));
+      }
+      folly::collectAll(std::move(builds)).get();
+    }
+
+    // Merge in the order the sections are listed, failing with the error of
+    // the first one which failed, as applying them one by one would.
+    for (size_t i = 0; i < toBuild.size(); ++i) {
+      if (errors[i]) {
+        errors[i].throw_exception();
+      }
+      auto section = toBuild[i];
+      auto start = std::chrono::steady_clock::now();
+      if (section->merge()) {
+        changed = true;
+      }
+      section->time += std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start);
+      sectionTimes_.emplace_back(section->name, section->time);
+    }
+  }
+  return changed;
+}
+
+bool ThriftConfigApplier::updateRoutes() {
+  bool changed = false;
+  if (routeUpdater_) {
+    routeUpdater_->setRoutesToConfig(
+        intfRouteTables_,
+        *cfg_->staticRoutesWithNhops(),
+        *cfg_->staticRoutesToNull(),
+        *cfg_->staticRoutesToCPU(),
+        *cfg_->staticIp2MplsRoutes(),
+        *cfg_->staticMplsRoutesWithNhops(),
+        *cfg_->staticMplsRoutesToNull(),
+        *cfg_->staticMplsRoutesToCPU());
+  } else if (rib_) {
+    auto newFibs = updateForwardingInformationBaseContainers();
+    if (newFibs) {
+      new_->resetForwardingInformationBases(newFibs);
+      changed = true;
+    }
+
+    rib_->reconfigure(
+        intfRouteTables_,
+        *cfg_->staticRoutesWithNhops(),
+        *cfg_->staticRoutesToNull(),
+        *cfg_->staticRoutesToCPU(),
+        *cfg_->staticIp2MplsRoutes(),
+        *cfg_->staticMplsRoutesWithNhops(),
+        *cfg_->staticMplsRoutesToNull(),
+        *cfg_->staticMplsRoutesToCPU(),
+        &updateFibFromConfig,
+        static_cast<void*>(&new_));
+  } else {
+    // switch state UTs don't necessary care about RIB updates
+    XLOG(WARNING)
+        << " Ignoring config updates to rib, should never happen outside of tests";
+  }
+
+  // resolving mpls next hops may need interfaces to be setup
+  // process static mpls routes after processing interfaces
+  auto labelFib = updateStaticMplsRoutes(
+      *cfg_->staticMplsRoutesWithNhops(),
+      *cfg_->staticMplsRoutesToNull(),
+      *cfg_->staticMplsRoutesToNull());
+  if (labelFib) {
+    new_->resetLabelForwardingInformationBase(labelFib);
+    changed = true;
+  }
+  return changed;
+}
+
 void ThriftConfigApplier::processVlanPorts() {
   // Build the Port --> Vlan mappings
   //
@@ -2114,8 +2411,65 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls(
   AclMap::NodeContainer newAcls;
   bool changed = false;
   int numExistingProcessed = 0;
-  int priority = kAclStartPriority;
-  int cpuPriority = 1;
+
+  // Let's get a map of acls to name so we don't have to search the acl list
+  // for every new use
+  flat_map<std::string, const cfg::AclEntry*> aclByName;
+  folly::gen::from(configEntries) |
+      folly::gen::map([](const cfg::AclEntry& acl) {
+        return std::make_pair(*acl.name(), &acl);
+      }) |
+      folly::gen::appendTo(aclByName);
+
+  // Allocate the priorities of the DROP and dataPlane acls, and of the
+  // controlPlane acls, in the order they are added below. Existing acls keep
+  // their priorities where the new order allows, so that only the acls which
+  // changed get reprogrammed.
+  auto origAcls = tableName.has_value()
+      ? orig_->getAclsForTable(aclStage, tableName.value())
+      : orig_->getAcls();
+  auto origPriority = [&](const std::string& name) -> std::optional<int> {
+    if (origAcls) {
+      if (auto origAcl = origAcls->getEntryIf(name)) {
+        return origAcl->getPriority();
+      }
+    }
+    return std::nullopt;
+  };
+  auto appendOrigPriorities = [&](const cfg::TrafficPolicyConfig& policy,
+                                  std::vector<std::optional<int>>* prios) {
+    for (const auto& mta : *policy.matchToAction()) {
+      auto a = aclByName.find(*mta.matcher());
+      if (a != aclByName.end() &&
+          *a->second->actionType() != cfg::AclActionType::DENY) {
+        prios->push_back(origPriority(*mta.matcher()));
+      }
+    }
+  };
+  std::vector<std::optional<int>> origPriorities;
+  for (const auto& entry : configEntries) {
+    if (*entry.actionType() == cfg::AclActionType::DENY) {
+      origPriorities.push_back(origPriority(*entry.name()));
+    }
+  }
+  if (auto dataPlaneTrafficPolicy = cfg_->dataPlaneTrafficPolicy()) {
+    appendOrigPriorities(*dataPlaneTrafficPolicy, &origPriorities);
+  }
+  std::vector<std::optional<int>> origCpuPriorities;
+  if (cfg_->cpuTrafficPolicy() && cfg_->cpuTrafficPolicy()->trafficPolicy()) {
+    appendOrigPriorities(
+        *cfg_->cpuTrafficPolicy()->trafficPolicy(), &origCpuPriorities);
+  }
+  auto priorities = AclPriorityAllocator(
+                        kAclStartPriority,
+                        platform_->getMaxAclEntryPriority(),
+                        FLAGS_acl_priority_gap)
+                        .allocate(origPriorities);
+  auto cpuPriorities =
+      AclPriorityAllocator(1, kAclStartPriority - 1, FLAGS_acl_priority_gap)
+          .allocate(origCpuPriorities);
+  size_t nextPriority = 0;
+  size_t nextCpuPriority = 0;
 
   // Start with the DROP acls, these should have highest priority
   auto acls = folly::gen::from(configEntries) |
@@ -2126,7 +2480,7 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls(
                 auto acl = updateAcl(
                     aclStage,
                     entry,
-                    priority++,
+                    priorities[nextPriority++],
                     &numExistingProcessed,
                     &changed,
                     tableName);
@@ -2134,15 +2488,6 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls(
               }) |
       folly::gen::appendTo(newAcls);
 
-  // Let's get a map of acls to name so we don't have to search the acl list
-  // for every new use
-  flat_map<std::string, const cfg::AclEntry*> aclByName;
-  folly::gen::from(configEntries) |
-      folly::gen::map([](const cfg::AclEntry& acl) {
-        return std::make_pair(*acl.name(), &acl);
-      }) |
-      folly::gen::appendTo(aclByName);
-
   flat_map<std::string, const cfg::TrafficCounter*> counterByName;
   folly::gen::from(*cfg_->trafficCounters()) |
       folly::gen::map([](const cfg::TrafficCounter& counter) {
@@ -2200,7 +2545,8 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls(
         auto acl = updateAcl(
             aclStage,
             aclCfg,
-            isCoppAcl ? cpuPriority++ : priority++,
+            isCoppAcl ? cpuPriorities[nextCpuPriority++]
+                      : priorities[nextPriority++],
             &numExistingProcessed,
             &changed,
             tableName,
@@ -2256,13 +2602,25 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls(
     return nullptr;
   }
 
+  std::shared_ptr<AclMap> newAclMap;
   if (tableName.has_value() &&
       orig_->getAclsForTable(aclStage, tableName.value())) {
-    return orig_->getAclsForTable(aclStage, tableName.value())
-        ->clone(std::move(newAcls));
+    newAclMap = orig_->getAclsForTable(aclStage, tableName.value())
+                    ->clone(std::move(newAcls));
+  } else {
+    newAclMap = orig_->getAcls()->clone(std::move(newAcls));
   }
 
-  return orig_->getAcls()->clone(std::move(newAcls));
+  aclHwOperationsEstimate_ += estimateAclHwOperations(origAcls, newAclMap);
+
+  if (FLAGS_log_shadowed_acls) {
+    for (const auto& [shadowed, by] :
+         AclClassifier(*newAclMap).findShadowedEntries()) {
+      XLOG(WARNING) << "ACL " << shadowed->getID() << " is never hit, "
+                    << by->getID() << " matches all its packets";
+    }
+  }
+  return newAclMap;
 }
 
 std::shared_ptr<AclEntry> ThriftConfigApplier::updateAcl(
@@ -3443,17 +3801,21 @@ shared_ptr<SwitchState> applyThriftConfig(
     const shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
-    RoutingInformationBase* rib) {
+    RoutingInformationBase* rib,
+    const cfg::SwitchConfig* prevConfig) {
   cfg::SwitchConfig emptyConfig;
-  return ThriftConfigApplier(state, config, platform, rib).run();
+  return ThriftConfigApplier(state, config, platform, rib, prevConfig).run();
 }
 shared_ptr<SwitchState> applyThriftConfig(
     const shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
-    RouteUpdateWrapper* routeUpdater) {
+    RouteUpdateWrapper* routeUpdater,
+    const cfg::SwitchConfig* prevConfig) {
   cfg::SwitchConfig emptyConfig;
-  return ThriftConfigApplier(state, config, platform, routeUpdater).run();
+  return ThriftConfigApplier(
+             state, config, platform, routeUpdater, prevConfig)
+      .run();
 }
 
 } // namespace facebook::fboss
@@ -8,6 +8,7 @@
  *
  */
 
+#include <array>
 #include <cstdlib>
 #include <exception>
 #include <fstream>
@@ -19,6 +20,7 @@
 
 #include <fb303/ServiceData.h>
 #include <folly/FileUtil.h>
+#include <folly/logging/xlog.h>
 #include <gflags/gflags.h>
 
 DEFINE_bool(
@@ -26,11 +28,18 @@ DEFINE_bool(
     false,
     "Flag to indicate whether to disable async logging and directly write into the file");
 
-enum BufferToWrite { BUFFER0, BUFFER1 };
+DEFINE_bool(
+    async_logger_drop_on_overflow,
+    false,
+    "Drop log records which do not fit in the async logger buffer instead of "
+    "waiting for the buffer to be flushed");
 
 static std::string exitFilePath;
-static uint32_t offset = 0;
-static BufferToWrite currentBuffer = BUFFER0;
+// Index of the buffer producers append to in the upper 32 bits, offset of the
+// next record in that buffer in the lower 32 bits. Updated with CAS only.
+static std::atomic<uint64_t> bufferState{0};
+// Bytes copied into each buffer by producers since it became active
+static std::array<std::atomic<uint32_t>, 2> committedBytes{};
 static std::array<char, facebook::fboss::AsyncLogger::kBufferSize> buffer0;
 static std::array<char, facebook::fboss::AsyncLogger::kBufferSize> buffer1;
 
@@ -41,7 +50,25 @@ namespace {
 constexpr auto kBuildRevision = "build_revision";
 constexpr auto kSdkVersion = "SDK Version";
 
+uint64_t packBufferState(uint32_t buffer, uint32_t offset) {
+  return (static_cast<uint64_t>(buffer) << 32) | offset;
+}
+
+uint32_t getBuffer(uint64_t state) {
+  return state >> 32;
+}
+
+uint32_t getOffset(uint64_t state) {
+  return state & 0xffffffff;
+}
+
+char* getBufferData(uint32_t buffer) {
+  return buffer == 0 ? buffer0.data() : buffer1.data();
+}
+
 void terminateHandler() {
+  auto state = bufferState.load();
+  auto offset = getOffset(state);
   if (offset > 0) {
     // Use standard library instead of folly because in unclean exit, folly
     // library could be inaccessible so there's a higher chance of writing into
@@ -49,11 +76,7 @@ void terminateHandler() {
     std::ofstream logfile;
     logfile.open(exitFilePath, std::ofstream::app);
 
-    if (currentBuffer == BUFFER0) {
-      logfile.write(buffer0.data(), offset);
-    } else {
-      logfile.write(buffer1.data(), offset);
-    }
+    logfile.write(getBufferData(getBuffer(state)), offset);
     std::cerr << "Async logger exit with " << offset
               << " bytes written to file " << std::endl;
   }
@@ -83,9 +106,6 @@ AsyncLogger::AsyncLogger(
   openLogFile(filePath);
 
   if (!FLAGS_disable_async_logger) {
-    logBuffer_ = buffer0.data();
-    flushBuffer_ = buffer1.data();
-
     exitFilePath = filePath;
 
     logTimeout_ = std::chrono::milliseconds(logTimeout);
@@ -104,33 +124,48 @@ void AsyncLogger::setBootType(bool canWarmBoot) {
 }
 
 void AsyncLogger::worker_thread() {
+  uint64_t lastDroppedCount = 0;
   while (enableLogging_) {
-    std::unique_lock<std::mutex> lock(latch_);
-
-    // Wait for either 1. Timeout 2. Force flush or full flush
-    cv_.wait_for(lock, logTimeout_, [this] {
-      return this->forceFlush_ || this->fullFlush_;
-    });
-
-    // Swap log buffer and flush buffer
-    char* writeBuffer = logBuffer_;
-    uint32_t currSize = offset;
-    offset = 0;
-    currentBuffer = ((currentBuffer == BUFFER0) ? BUFFER1 : BUFFER0);
-    logBuffer_ = flushBuffer_;
+    uint64_t state;
+    bool forceFlush;
+    {
+      std::unique_lock<std::mutex> lock(latch_);
+
+      // Wait for either 1. Timeout 2. Force flush or full flush
+      cv_.wait_for(lock, logTimeout_, [this] {
+        return this->forceFlush_ || this->fullFlush_;
+      });
 
-    if (fullFlush_) {
+      // Swap log buffer and flush buffer. The flush buffer was written out by
+      // the previous iteration, so producers can fill it right away.
+      // A force flush requested after the swap is served by the next round,
+      // its caller's records may be in the new log buffer
+      forceFlush = forceFlush_;
       fullFlush_ = false;
+      state = bufferState.load();
+      while (!bufferState.compare_exchange_weak(
+          state, packBufferState(getBuffer(state) ^ 1, 0))) {
+      }
     }
-
-    lock.unlock();
-    cv_.notify_one();
+    // Wake up producers waiting for room in the log buffer
+    cv_.notify_all();
+
+    // Producers which reserved their record before the swap may still be
+    // copying it in. This is a memcpy at most, so just spin.
+    auto writeBuffer = getBuffer(state);
+    auto currSize = getOffset(state);
+    while (committedBytes[writeBuffer].load(std::memory_order_acquire) !=
+           currSize) {
+      std::this_thread::yield();
+    }
+    committedBytes[writeBuffer] = 0;
 
     // Write content in swap buffer to file
     if (currSize > 0) {
       flushCount_++;
       auto bytesWritten = logFile_.withWLock([&](auto& lockedFile) {
-        return folly::writeFull(lockedFile.fd(), writeBuffer, currSize);
+        return folly::writeFull(
+            lockedFile.fd(), getBufferData(writeBuffer), currSize);
       });
 
       if (bytesWritten < 0) {
@@ -139,11 +174,16 @@ void AsyncLogger::worker_thread() {
       }
     }
 
-    memset(writeBuffer, 0, bufferSize_);
-    flushBuffer_ = writeBuffer;
+    auto droppedCount = droppedCount_.load();
+    if (droppedCount != lastDroppedCount) {
+      XLOG(WARN) << "[Async Logger] Dropped "
+                 << droppedCount - lastDroppedCount
+                 << " log records which did not fit in the buffer";
+      lastDroppedCount = droppedCount;
+    }
 
     // Notify force flush that write completes
-    if (forceFlush_) {
+    if (forceFlush) {
       forceFlush_ = false;
       promise_.set_value(0);
       promise_ = std::promise<int>();
@@ -163,7 +203,12 @@ void AsyncLogger::startFlushThread() {
 
 void AsyncLogger::stopFlushThread() {
   if (!FLAGS_disable_async_logger && enableLogging_) {
-    enableLogging_ = false;
+    {
+      std::lock_guard<std::mutex> lock(latch_);
+      enableLogging_ = false;
+    }
+    // Producers blocked on overflow give up on their record
+    cv_.notify_all();
     flushThread_->join();
     delete flushThread_;
   }
@@ -174,7 +219,7 @@ void AsyncLogger::forceFlush() {
     future_ = promise_.get_future();
 
     forceFlush_ = true;
-    cv_.notify_one();
+    cv_.notify_all();
 
     // Wait for flush to complete
     future_.get();
@@ -197,35 +242,67 @@ void AsyncLogger::appendLog(const char* logRecord, size_t logSize) {
     return;
   }
 
-  // Acquire the lock and check if there's enough space in the buffer
-  latch_.lock();
-
-  if (logSize + offset >= bufferSize_) {
-    // Release the lock and notify worker thread to flush logs
-    fullFlush_ = true;
-    latch_.unlock();
-    cv_.notify_one();
+  if (logSize > bufferSize_) {
+    // Would never fit, even in an empty buffer
+    overflowCount_++;
+    droppedCount_++;
+    XLOG_EVERY_MS(ERR, 1000) << "[Async Logger] Dropping " << logSize
+                             << " bytes log record larger than the buffer";
+    return;
+  }
 
-    // Wait for worker to finish
-    std::unique_lock<std::mutex> lock(latch_);
-    cv_.wait(lock, [logSize] {
-      return logSize + offset < AsyncLogger::kBufferSize;
-    });
+  auto reservation = reserve(logSize);
+  if (!reservation) {
+    overflowCount_++;
+    if (FLAGS_async_logger_drop_on_overflow) {
+      droppedCount_++;
+      requestFullFlush();
+      return;
+    }
+    do {
+      waitForFlush(logSize);
+      if (!enableLogging_) {
+        droppedCount_++;
+        return;
+      }
+    } while (!(reservation = reserve(logSize)));
+  }
 
-    // Write to buffer
-    memcpy(logBuffer_ + offset, logRecord, logSize);
-    offset += logSize;
+  auto [buffer, offset] = *reservation;
+  memcpy(getBufferData(buffer) + offset, logRecord, logSize);
+  committedBytes[buffer].fetch_add(logSize, std::memory_order_release);
+}
 
-    lock.unlock();
-  } else {
-    // Directly write to buffer
-    memcpy(logBuffer_ + offset, logRecord, logSize);
-    offset += logSize;
+std::optional<std::pair<uint32_t, uint32_t>> AsyncLogger::reserve(
+    size_t logSize) {
+  auto state = bufferState.load();
+  do {
+    if (getOffset(state) + logSize > bufferSize_) {
+      return std::nullopt;
+    }
+  } while (!bufferState.compare_exchange_weak(
+      state, packBufferState(getBuffer(state), getOffset(state) + logSize)));
+  return std::make_pair(getBuffer(state), getOffset(state));
+}
 
-    latch_.unlock();
+void AsyncLogger::requestFullFlush() {
+  // Lock free, so the flush thread may miss the notification if it is just
+  // about to wait. It then picks up fullFlush_ on its next timeout.
+  if (!fullFlush_.exchange(true)) {
+    cv_.notify_all();
   }
 }
 
+void AsyncLogger::waitForFlush(size_t logSize) {
+  std::unique_lock<std::mutex> lock(latch_);
+  fullFlush_ = true;
+  cv_.notify_all();
+  cv_.wait(lock, [this, logSize] {
+    return !enableLogging_ ||
+        getOffset(bufferState.load()) + logSize <= bufferSize_;
+  });
+}
+
 void AsyncLogger::openLogFile(std::string& filePath) {
   // By default, async logger opens log file under /var/facebook/logs/fboss/sdk/
   // However, the directory /var/facebook/logs/fboss/sdk/ might not exist for
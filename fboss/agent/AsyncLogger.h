@@ -10,16 +10,35 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <future>
 #include <mutex>
+#include <optional>
+#include <utility>
 
 #include <folly/File.h>
 #include <folly/Synchronized.h>
 
 namespace facebook::fboss {
 
+/*
+ * Double buffered logger used by the SAI replayer and BCM cinter to trace
+ * every SDK call.
+ *
+ * Producers append to the active buffer without taking any lock: a record is
+ * placed by reserving its range of the buffer with a CAS on the buffer
+ * offset, and marked done by bumping the buffer's committed byte count once
+ * it is copied in. The flush thread swaps the buffers with the same CAS,
+ * waits for the in flight copies into the old buffer to be committed and
+ * writes it out, so producers never wait on the disk.
+ *
+ * A record which does not fit in the active buffer is an overflow. Producers
+ * then either wait for the flush thread to swap the buffers (the default, a
+ * replayer log with holes in it is of no use) or drop the record when
+ * --async_logger_drop_on_overflow is set.
+ */
 class AsyncLogger {
  public:
   enum LoggerSrcType { BCM_CINTER, SAI_REPLAYER };
@@ -60,25 +79,44 @@ class AsyncLogger {
     return flushCount_;
   }
 
+  // Number of records which did not fit in the active buffer
+  uint64_t getOverflowCount() const {
+    return overflowCount_;
+  }
+
+  // Number of records dropped, either on overflow with
+  // --async_logger_drop_on_overflow or because they exceed kBufferSize
+  uint64_t getDroppedCount() const {
+    return droppedCount_;
+  }
+
  private:
   std::atomic_uint32_t flushCount_{0};
   void worker_thread();
   void openLogFile(std::string& file_path);
   void writeNewBootHeader();
 
+  // Reserve logSize bytes in the active buffer. Returns the buffer and the
+  // offset of the reserved range, or std::nullopt if the record does not fit
+  std::optional<std::pair<uint32_t, uint32_t>> reserve(size_t logSize);
+  void requestFullFlush();
+  void waitForFlush(size_t logSize);
+
   std::atomic_bool forceFlush_{false};
-  bool fullFlush_{false};
+  std::atomic_bool fullFlush_{false};
   std::atomic_bool enableLogging_{false};
 
   uint32_t bufferSize_;
 
-  char* logBuffer_;
-  char* flushBuffer_;
+  std::atomic_uint64_t overflowCount_{0};
+  std::atomic_uint64_t droppedCount_{0};
 
   LoggerSrcType srcType_;
 
   std::promise<int> promise_;
   std::future<int> future_;
+  // Only guards the waits of the flush thread and of producers blocked on
+  // overflow, never the buffers themselves
   std::mutex latch_;
   std::thread* flushThread_;
   std::condition_variable cv_;
@@ -152,6 +152,12 @@ bool DHCPv4Handler::isDHCPv4Packet(const UDPHeader& udpHdr) {
       (dstPort == kBootPCPort || dstPort == kBootPSPort);
 }
 
+bool DHCPv4Handler::isDHCPv4Packet(const PktHeaderInfo& headers) {
+  return headers.isUdp() &&
+      (headers.srcPort == kBootPCPort || headers.srcPort == kBootPSPort ||
+       headers.dstPort == kBootPCPort || headers.dstPort == kBootPSPort);
+}
+
 void DHCPv4Handler::handlePacket(
     SwSwitch* sw,
     std::unique_ptr<RxPacket> pkt,
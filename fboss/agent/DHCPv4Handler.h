@@ -20,6 +20,7 @@ namespace facebook::fboss {
 class SwSwitch;
 class RxPacket;
 class UDPHeader;
+struct PktHeaderInfo;
 class DHCPv4Packet;
 class TxPacket;
 class IPv4Hdr;
@@ -38,6 +39,7 @@ class DHCPv4Handler {
   static constexpr uint16_t kBootPSPort = 67;
   static constexpr uint16_t kBootPCPort = 68;
   static bool isDHCPv4Packet(const UDPHeader& udpHdr);
+  static bool isDHCPv4Packet(const PktHeaderInfo& headers);
   static void handlePacket(
       SwSwitch* sw,
       std::unique_ptr<RxPacket> pkt,
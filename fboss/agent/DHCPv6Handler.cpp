@@ -124,6 +124,11 @@ bool DHCPv6Handler::isForDHCPv6RelayOrServer(const UDPHeader& udpHdr) {
   return (udpHdr.dstPort == DHCPv6Packet::DHCP6_SERVERAGENT_UDPPORT);
 }
 
+bool DHCPv6Handler::isForDHCPv6RelayOrServer(const PktHeaderInfo& headers) {
+  return headers.isUdp() &&
+      headers.dstPort == DHCPv6Packet::DHCP6_SERVERAGENT_UDPPORT;
+}
+
 void DHCPv6Handler::handlePacket(
     SwSwitch* sw,
     std::unique_ptr<RxPacket> pkt,
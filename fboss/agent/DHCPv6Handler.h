@@ -21,6 +21,7 @@ namespace facebook::fboss {
 class SwSwitch;
 class RxPacket;
 class UDPHeader;
+struct PktHeaderInfo;
 class DHCPv6Packet;
 class TxPacket;
 class IPv6Hdr;
@@ -30,6 +31,7 @@ class DHCPv6Handler {
   enum { MAX_RELAY_HOPCOUNT = 10 };
 
   static bool isForDHCPv6RelayOrServer(const UDPHeader& udpHdr);
+  static bool isForDHCPv6RelayOrServer(const PktHeaderInfo& headers);
 
   static void handlePacket(
       SwSwitch* sw,
@@ -22,6 +22,8 @@
 #include <folly/IPAddress.h>
 
 #include <memory>
+#include <optional>
+#include <type_traits>
 
 namespace facebook::fboss {
 
@@ -60,6 +62,114 @@ void forAllRoutes(const std::shared_ptr<SwitchState>& state, Func func) {
   }
 }
 
+/*
+ * Position in the forAllRoutes() order: VRFs in ascending order, and within
+ * a VRF the v6 routes followed by the v4 routes, each sorted by prefix.
+ */
+struct RouteCursor {
+  RouterID rid;
+  folly::CIDRNetwork prefix;
+};
+
+namespace detail {
+
+template <typename AddrT, typename Func>
+bool forRoutesInFibAfter(
+    RouterID rid,
+    const ForwardingInformationBase<AddrT>& fib,
+    const std::optional<RoutePrefix<AddrT>>& after,
+    const std::optional<RoutePrefix<AddrT>>& filter,
+    Func& func) {
+  const auto& routes = fib.getAllNodes();
+  auto it = after ? routes.upper_bound(*after) : routes.begin();
+  while (it != routes.end()) {
+    const auto& prefix = it->first;
+    if (!filter ||
+        (prefix.mask >= filter->mask &&
+         prefix.network.mask(filter->mask) == filter->network)) {
+      if (!func(rid, it->second)) {
+        return false;
+      }
+      ++it;
+      continue;
+    }
+    // Routes are sorted by mask length first, so the routes covered by the
+    // filter form one contiguous range per mask length. Seek to the next one
+    // instead of scanning the routes in between.
+    RoutePrefix<AddrT> rangeStart{
+        filter->network, std::max(prefix.mask, filter->mask)};
+    if (prefix < rangeStart) {
+      it = routes.lower_bound(rangeStart);
+    } else if (prefix.mask < AddrT::bitCount()) {
+      it = routes.lower_bound(RoutePrefix<AddrT>{
+          filter->network, static_cast<uint8_t>(prefix.mask + 1)});
+    } else {
+      break;
+    }
+  }
+  return true;
+}
+
+template <typename AddrT>
+std::optional<RoutePrefix<AddrT>> toRoutePrefixIf(
+    const std::optional<folly::CIDRNetwork>& prefix) {
+  constexpr bool isV4 = std::is_same_v<AddrT, folly::IPAddressV4>;
+  if (!prefix || prefix->first.isV4() != isV4) {
+    return std::nullopt;
+  }
+  AddrT network;
+  if constexpr (isV4) {
+    network = prefix->first.asV4();
+  } else {
+    network = prefix->first.asV6();
+  }
+  return RoutePrefix<AddrT>{network.mask(prefix->second), prefix->second};
+}
+
+} // namespace detail
+
+/*
+ * Same as forAllRoutes(), but only visit the routes strictly after `after` and
+ * covered by `filter` (all the routes if unset), and stop as soon as func
+ * returns false. Lets callers walk a large route table in bounded chunks, each
+ * one resuming from where the previous one stopped.
+ */
+template <typename Func>
+void forAllRoutesAfter(
+    const std::shared_ptr<SwitchState>& state,
+    const std::optional<RouteCursor>& after,
+    const std::optional<folly::CIDRNetwork>& filter,
+    Func func) {
+  auto filterV6 = detail::toRoutePrefixIf<folly::IPAddressV6>(filter);
+  auto filterV4 = detail::toRoutePrefixIf<folly::IPAddressV4>(filter);
+  for (const auto& fibContainer : *state->getFibs()) {
+    auto rid = fibContainer->getID();
+    std::optional<folly::CIDRNetwork> resumeFrom;
+    if (after) {
+      if (rid < after->rid) {
+        continue;
+      } else if (rid == after->rid) {
+        resumeFrom = after->prefix;
+      }
+    }
+    auto afterV6 = detail::toRoutePrefixIf<folly::IPAddressV6>(resumeFrom);
+    auto afterV4 = detail::toRoutePrefixIf<folly::IPAddressV4>(resumeFrom);
+    // A v4 cursor means all the v6 routes of this VRF were already visited
+    bool visitV6 = !afterV4 && (!filter || filterV6);
+    if (visitV6 &&
+        !detail::forRoutesInFibAfter(
+            rid, *fibContainer->getFibV6(), afterV6, filterV6, func)) {
+      return;
+    }
+    bool visitV4 = !filter || filterV4;
+    if (visitV4 &&
+        !detail::forRoutesInFibAfter(
+            rid, *fibContainer->getFibV4(), afterV4, filterV4, func)) {
+      return;
+    }
+  }
+}
+
 template <
     typename AddrT,
     typename ChangedFn,
@@ -148,7 +148,11 @@ void IPv4Handler::handlePacket(
     return;
   }
 
-  if (v4Hdr.protocol == static_cast<uint8_t>(IP_PROTO::IP_PROTO_UDP)) {
+  // Only parse the UDP header if it may be DHCP. The header info only lacks
+  // the ports if they are not in the packet, which the parser reports.
+  const auto& headers = pkt->getHeaderInfo();
+  if (v4Hdr.protocol == static_cast<uint8_t>(IP_PROTO::IP_PROTO_UDP) &&
+      (!headers.isUdp() || DHCPv4Handler::isDHCPv4Packet(headers))) {
     Cursor udpCursor(cursor);
     UDPHeader udpHdr;
     udpHdr.parse(&udpCursor, sw_->portStats(port));
@@ -154,7 +154,10 @@ void IPv6Handler::handlePacket(
 
   // NOTE: DHCPv6 solicit packet from client has hoplimit set to 1,
   // we need to handle it before send the ICMPv6 TTL exceeded
-  if (ipv6.nextHeader == static_cast<uint8_t>(IP_PROTO::IP_PROTO_UDP)) {
+  const auto& headers = pkt->getHeaderInfo();
+  if (ipv6.nextHeader == static_cast<uint8_t>(IP_PROTO::IP_PROTO_UDP) &&
+      (!headers.isUdp() ||
+       DHCPv6Handler::isForDHCPv6RelayOrServer(headers))) {
     Cursor udpCursor(cursor);
     UDPHeader udpHdr;
     udpHdr.parse(&udpCursor, sw_->portStats(port));
@@ -173,6 +173,10 @@ void LacpController::ntt() {
   tx_.ntt(LACPDU(actorInfo(), partnerInfo()));
 }
 
+void LacpController::transmitted(const LACPDU& lacpdu) {
+  tx_.transmitted(lacpdu);
+}
+
 PortID LacpController::portID() const {
   return portID_;
 }
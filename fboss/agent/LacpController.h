@@ -71,6 +71,8 @@ class LacpController : public std::enable_shared_from_this<LacpController> {
   void setActorState(LacpState state);
 
   void ntt();
+  // Invoked from the LacpServicerIf once it sent a LACPDU it queued
+  void transmitted(const LACPDU& lacpdu);
   void selected();
   void selected(folly::Range<std::vector<PortID>::const_iterator> ports);
 
@@ -139,12 +139,16 @@ std::ostream& operator<<(std::ostream& out, MuxMachine::MuxState s) {
   return (out << stateAsString);
 }
 
+void LacpTimeout::scheduleTimeout(std::chrono::milliseconds timeout) {
+  evb_->timer().scheduleTimeout(this, timeout);
+}
+
 ReceiveMachine::ReceiveMachine(
     LacpController& controller,
     folly::EventBase* evb,
     LacpServicerIf* servicer,
     uint16_t holdTimerMultiplier)
-    : folly::AsyncTimeout(evb),
+    : LacpTimeout(evb),
       controller_(controller),
       servicer_(servicer),
       slowEpochSeconds_(std::chrono::seconds(30 * holdTimerMultiplier)),
@@ -409,7 +413,7 @@ const std::chrono::seconds PeriodicTransmissionMachine::LONG_PERIOD(30);
 PeriodicTransmissionMachine::PeriodicTransmissionMachine(
     LacpController& controller,
     folly::EventBase* evb)
-    : folly::AsyncTimeout(evb), controller_(controller) {}
+    : LacpTimeout(evb), controller_(controller) {}
 
 PeriodicTransmissionMachine::~PeriodicTransmissionMachine() {}
 
@@ -500,7 +504,7 @@ TransmitMachine::TransmitMachine(
     LacpController& controller,
     folly::EventBase* evb,
     LacpServicerIf* servicer)
-    : folly::AsyncTimeout(evb), controller_(controller), servicer_(servicer) {}
+    : LacpTimeout(evb), controller_(controller), servicer_(servicer) {}
 
 TransmitMachine::~TransmitMachine() {}
 
@@ -534,14 +538,18 @@ void TransmitMachine::ntt(LACPDU lacpdu) {
   }
 
   auto outPort = controller_.portID();
-  if (!servicer_->transmit(lacpdu, outPort)) {
-    return;
+  if (servicer_->transmit(lacpdu, outPort)) {
+    transmitted(lacpdu);
   }
+}
+
+void TransmitMachine::transmitted(const LACPDU& lacpdu) {
+  CHECK(controller_.evb()->inRunningEventBaseThread());
 
   XLOG(DBG4) << "TransmitMachine[" << controller_.portID() << "]: "
              << "TX(" << lacpdu.describe() << ")";
 
-  --transmissionsLeft_;
+  transmissionsLeft_ = std::max(transmissionsLeft_ - 1, 0);
   XLOG(DBG4) << transmissionsLeft_ << " transmissions left";
 }
 
@@ -550,7 +558,7 @@ MuxMachine::MuxMachine(
     LacpController& controller,
     folly::EventBase* evb,
     LacpServicerIf* servicer)
-    : AsyncTimeout(evb), controller_(controller), servicer_(servicer) {}
+    : LacpTimeout(evb), controller_(controller), servicer_(servicer) {}
 
 MuxMachine::~MuxMachine() {}
 
@@ -9,7 +9,7 @@
  */
 #pragma once
 
-#include <folly/io/async/AsyncTimeout.h>
+#include <folly/io/async/HHWheelTimer.h>
 #include <optional>
 
 #include <boost/container/flat_map.hpp>
@@ -20,17 +20,40 @@
 
 #include <iosfwd>
 
+namespace folly {
+class EventBase;
+}
+
 namespace facebook::fboss {
 
 class AggregatePort;
 class LacpController;
 class LacpServicerIf;
 
+/*
+ * A timeout on the timer wheel of the LACP EventBase. All machines of all
+ * members share the wheel rather than each adding its own event to the
+ * EventBase, so that (re)scheduling and expiring timers stays cheap with
+ * hundreds of members in fast timeout mode.
+ */
+class LacpTimeout : public folly::HHWheelTimer::Callback {
+ public:
+  explicit LacpTimeout(folly::EventBase* evb) : evb_(evb) {}
+
+  void scheduleTimeout(std::chrono::milliseconds timeout);
+
+ private:
+  // The wheel is only destroyed along with the EventBase
+  void callbackCanceled() noexcept override {}
+
+  folly::EventBase* evb_{nullptr};
+};
+
 /*
  * See IEEE 802.3AD-2000 43.4.3 for an overview of each state machine
  */
 
-class ReceiveMachine : private folly::AsyncTimeout {
+class ReceiveMachine : private LacpTimeout {
  public:
   explicit ReceiveMachine(
       LacpController& controller,
@@ -98,7 +121,7 @@ class ReceiveMachine : private folly::AsyncTimeout {
 void toAppend(ReceiveMachine::ReceiveState state, std::string* result);
 std::ostream& operator<<(std::ostream& out, ReceiveMachine::ReceiveState s);
 
-class PeriodicTransmissionMachine : private folly::AsyncTimeout {
+class PeriodicTransmissionMachine : private LacpTimeout {
  public:
   explicit PeriodicTransmissionMachine(
       LacpController& controller,
@@ -132,7 +155,7 @@ void toAppend(
     PeriodicTransmissionMachine::PeriodicState state,
     std::string* result);
 
-class TransmitMachine : private folly::AsyncTimeout {
+class TransmitMachine : private LacpTimeout {
  public:
   TransmitMachine(
       LacpController& controller,
@@ -141,6 +164,8 @@ class TransmitMachine : private folly::AsyncTimeout {
   ~TransmitMachine() override;
 
   void ntt(LACPDU lacpdu);
+  // Counts a LACPDU against the transmissions left once it is sent
+  void transmitted(const LACPDU& lacpdu);
 
   void start();
   void stop();
@@ -159,7 +184,7 @@ class TransmitMachine : private folly::AsyncTimeout {
   LacpServicerIf* servicer_{nullptr};
 };
 
-class MuxMachine : private folly::AsyncTimeout {
+class MuxMachine : private LacpTimeout {
  public:
   MuxMachine(
       LacpController& controller,
@@ -101,7 +101,10 @@ std::ostream& operator<<(
 }
 
 LinkAggregationManager::LinkAggregationManager(SwSwitch* sw)
-    : portToController_(), sw_(sw) {
+    : portToController_(),
+      sw_(sw),
+      pendingForwardingStates_(
+          std::make_shared<folly::Synchronized<PendingForwardingStates>>()) {
   sw_->registerStateObserver(this, "LinkAggregationManager");
 }
 
@@ -321,35 +324,58 @@ void LinkAggregationManager::populatePartnerPairs(
 bool LinkAggregationManager::transmit(LACPDU lacpdu, PortID portID) {
   CHECK(sw_->getLacpEvb()->inRunningEventBaseThread());
 
-  auto pkt = sw_->allocatePacket(LACPDU::LENGTH);
-  if (!pkt) {
-    XLOG(DBG4) << "Failed to allocate tx packet for LACPDU transmission";
-    return false;
+  if (pendingTransmissions_.empty()) {
+    sw_->getLacpEvb()->runInLoop(this);
   }
+  pendingTransmissions_.insert_or_assign(portID, std::move(lacpdu));
+  // Not sent yet, see runLoopCallback()
+  return false;
+}
 
-  folly::io::RWPrivateCursor writer(pkt->buf());
+void LinkAggregationManager::runLoopCallback() noexcept {
+  std::map<PortID, LACPDU> transmissions;
+  transmissions.swap(pendingTransmissions_);
 
   folly::MacAddress cpuMac = sw_->getPlatform()->getLocalMac();
+  auto ports = sw_->getState()->getPorts();
+
+  std::vector<std::pair<PortID, LACPDU>> sent;
+  for (auto& [portID, lacpdu] : transmissions) {
+    auto pkt = sw_->allocatePacket(LACPDU::LENGTH);
+    if (!pkt) {
+      XLOG(DBG4) << "Failed to allocate tx packet for LACPDU transmission";
+      continue;
+    }
 
-  auto port = sw_->getState()->getPorts()->getPortIf(portID);
-  CHECK(port);
+    folly::io::RWPrivateCursor writer(pkt->buf());
 
-  TxPacket::writeEthHeader(
-      &writer,
-      LACPDU::kSlowProtocolsDstMac(),
-      cpuMac,
-      port->getIngressVlan(),
-      LACPDU::EtherType::SLOW_PROTOCOLS);
+    auto port = ports->getPortIf(portID);
+    CHECK(port);
 
-  writer.writeBE<uint8_t>(LACPDU::EtherSubtype::LACP);
+    TxPacket::writeEthHeader(
+        &writer,
+        LACPDU::kSlowProtocolsDstMac(),
+        cpuMac,
+        port->getIngressVlan(),
+        LACPDU::EtherType::SLOW_PROTOCOLS);
 
-  lacpdu.to(&writer);
+    writer.writeBE<uint8_t>(LACPDU::EtherSubtype::LACP);
 
-  // TODO(joseph5wu) Actually LACP should be multicast pkt, and using
-  // OutOfPacket will actually send the packet to unicast queue.
-  sw_->sendNetworkControlPacketAsync(std::move(pkt), PortDescriptor(portID));
+    lacpdu.to(&writer);
+
+    // TODO(joseph5wu) Actually LACP should be multicast pkt, and using
+    // OutOfPacket will actually send the packet to unicast queue.
+    sw_->sendNetworkControlPacketAsync(std::move(pkt), PortDescriptor(portID));
+    sent.emplace_back(portID, lacpdu);
+  }
 
-  return true;
+  folly::SharedMutexWritePriority::ReadHolder g(&controllersLock_);
+  for (const auto& [portID, lacpdu] : sent) {
+    auto it = portToController_.find(portID);
+    if (it != portToController_.end()) {
+      it->second->transmitted(lacpdu);
+    }
+  }
 }
 
 void LinkAggregationManager::enableForwardingAndSetPartnerState(
@@ -358,11 +384,10 @@ void LinkAggregationManager::enableForwardingAndSetPartnerState(
     const AggregatePort::PartnerState& partnerState) {
   CHECK(sw_->getLacpEvb()->inRunningEventBaseThread());
 
-  auto enableFwdStateFn = ProgramForwardingAndPartnerState(
-      portID, aggPortID, AggregatePort::Forwarding::ENABLED, partnerState);
-
-  sw_->updateStateNoCoalescing(
-      "AggregatePort ForwardingAndPartnerState", std::move(enableFwdStateFn));
+  programForwardingAndPartnerState(
+      portID,
+      ProgramForwardingAndPartnerState(
+          portID, aggPortID, AggregatePort::Forwarding::ENABLED, partnerState));
 }
 
 void LinkAggregationManager::disableForwardingAndSetPartnerState(
@@ -371,11 +396,52 @@ void LinkAggregationManager::disableForwardingAndSetPartnerState(
     const ParticipantInfo& partnerState) {
   CHECK(sw_->getLacpEvb()->inRunningEventBaseThread());
 
-  auto disableFwdStateFn = ProgramForwardingAndPartnerState(
-      portID, aggPortID, AggregatePort::Forwarding::DISABLED, partnerState);
+  programForwardingAndPartnerState(
+      portID,
+      ProgramForwardingAndPartnerState(
+          portID,
+          aggPortID,
+          AggregatePort::Forwarding::DISABLED,
+          partnerState));
+}
+
+void LinkAggregationManager::programForwardingAndPartnerState(
+    PortID portID,
+    ProgramForwardingAndPartnerState programFn) {
+  {
+    auto pending = pendingForwardingStates_->wlock();
+    pending->members.insert_or_assign(portID, std::move(programFn));
+    if (pending->scheduled) {
+      return;
+    }
+    pending->scheduled = true;
+  }
 
+  auto updateFn = [pending = pendingForwardingStates_](
+                      const std::shared_ptr<SwitchState>& state) {
+    return applyForwardingAndPartnerStates(pending, state);
+  };
   sw_->updateStateNoCoalescing(
-      "AggregatePort ForwardingAndPartnerState", std::move(disableFwdStateFn));
+      "AggregatePort ForwardingAndPartnerState", std::move(updateFn));
+}
+
+std::shared_ptr<SwitchState>
+LinkAggregationManager::applyForwardingAndPartnerStates(
+    const PendingForwardingStatesPtr& pending,
+    const std::shared_ptr<SwitchState>& state) {
+  PendingForwardingStates forwardingStates;
+  {
+    // Changes made from now on schedule another update
+    auto locked = pending->wlock();
+    std::swap(forwardingStates, *locked);
+  }
+  std::shared_ptr<SwitchState> nextState(state);
+  for (auto& [portID, programFn] : forwardingStates.members) {
+    if (auto programmedState = programFn(nextState)) {
+      nextState = programmedState;
+    }
+  }
+  return nextState;
 }
 
 void LinkAggregationManager::recordLacpTimeout() {
@@ -414,6 +480,9 @@ LinkAggregationManager::~LinkAggregationManager() {
   for (auto controller : portToController_) {
     controller.second->stopMachines();
   }
+  // Drop LACPDUs not yet sent
+  sw_->getLacpEvb()->runInEventBaseThreadAndWait(
+      [this]() { cancelLoopCallback(); });
   sw_->unregisterStateObserver(this);
 }
 
@@ -17,9 +17,13 @@
 #include <boost/container/flat_map.hpp>
 
 #include <folly/SharedMutex.h>
+#include <folly/Synchronized.h>
 #include <folly/io/Cursor.h>
+#include <folly/io/async/EventBase.h>
 
+#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace facebook::fboss {
@@ -34,6 +38,10 @@ struct LacpServicerIf {
   LacpServicerIf() {}
   virtual ~LacpServicerIf() {}
 
+  /*
+   * Returns true if the LACPDU was sent. A servicer which sends it later
+   * returns false, and calls LacpController::transmitted() once it is sent.
+   */
   virtual bool transmit(LACPDU lacpdu, PortID portID) = 0;
   virtual void enableForwardingAndSetPartnerState(
       PortID portID,
@@ -68,7 +76,9 @@ class ProgramForwardingAndPartnerState {
   AggregatePort::PartnerState partnerState_;
 };
 
-class LinkAggregationManager : public StateObserver, public LacpServicerIf {
+class LinkAggregationManager : public StateObserver,
+                               public LacpServicerIf,
+                               private folly::EventBase::LoopCallback {
  public:
   explicit LinkAggregationManager(SwSwitch* sw);
   ~LinkAggregationManager() override;
@@ -115,6 +125,36 @@ class LinkAggregationManager : public StateObserver, public LacpServicerIf {
       const std::shared_ptr<AggregatePort>& oldAggPort,
       const std::shared_ptr<AggregatePort>& newAggPort);
 
+  /*
+   * LACPDUs transmitted during one iteration of the LACP EventBase loop,
+   * e.g. by all members whose periodic timers expired on the same tick of
+   * the timer wheel, are built and sent together at the end of the
+   * iteration, against one snapshot of the switch state. Only the last
+   * LACPDU of each member is sent, and only sent LACPDUs are counted
+   * against the transmission limit of the member.
+   */
+  void runLoopCallback() noexcept override;
+
+  /*
+   * Forwarding and partner state changes waiting for their state update.
+   * Changes made while an update is queued join it, so that members which
+   * converge together are programmed by one update. Only the last change of
+   * each member is kept, as it is what the LACP machines ended up with.
+   */
+  struct PendingForwardingStates {
+    std::map<PortID, ProgramForwardingAndPartnerState> members;
+    bool scheduled{false};
+  };
+  using PendingForwardingStatesPtr =
+      std::shared_ptr<folly::Synchronized<PendingForwardingStates>>;
+
+  void programForwardingAndPartnerState(
+      PortID portID,
+      ProgramForwardingAndPartnerState programFn);
+  static std::shared_ptr<SwitchState> applyForwardingAndPartnerStates(
+      const PendingForwardingStatesPtr& pending,
+      const std::shared_ptr<SwitchState>& state);
+
   // Forbidden copy constructor and assignment operator
   LinkAggregationManager(LinkAggregationManager const&) = delete;
   LinkAggregationManager& operator=(LinkAggregationManager const&) = delete;
@@ -128,6 +168,10 @@ class LinkAggregationManager : public StateObserver, public LacpServicerIf {
   PortIDToController portToController_;
   mutable folly::SharedMutexWritePriority controllersLock_;
   SwSwitch* sw_{nullptr};
+  // Only accessed from the LACP EventBase
+  std::map<PortID, LACPDU> pendingTransmissions_;
+  // Shared with the scheduled state update, which may outlive us
+  PendingForwardingStatesPtr pendingForwardingStates_;
 };
 
 } // namespace facebook::fboss
@@ -92,14 +92,26 @@ void LldpManager::handlePacket(
 
   sw_->stats()->LldpRecvdPkt();
 
-  bool ret = neighbor.parseLldpPdu(
-      pkt->getSrcPort(), pkt->getSrcVlan(), src, ETHERTYPE_LLDP, &cursor);
-
-  if (!ret) {
-    // LinkNeighbor will have already logged a message about the error.
-    // Just ignore the packet.
-    sw_->stats()->LldpBadPkt();
-    return;
+  // Neighbors keep sending the same PDU, only parse it when it changed.
+  // PDUs spanning several buffers are rare, just parse those.
+  auto pdu = cursor.peekBytes();
+  if (cursor.totalLength() != pdu.size()) {
+    pdu = ByteRange();
+  }
+  auto unchanged = db_.refreshIfUnchanged(
+      pkt->getSrcPort(), pkt->getSrcVlan(), src, pdu);
+  if (unchanged) {
+    neighbor = std::move(*unchanged);
+  } else {
+    bool ret = neighbor.parseLldpPdu(
+        pkt->getSrcPort(), pkt->getSrcVlan(), src, ETHERTYPE_LLDP, &cursor);
+
+    if (!ret) {
+      // LinkNeighbor will have already logged a message about the error.
+      // Just ignore the packet.
+      sw_->stats()->LldpBadPkt();
+      return;
+    }
   }
 
   XLOG(DBG4) << "got LLDP packet: local_port=" << pkt->getSrcPort()
@@ -135,7 +147,9 @@ void LldpManager::handlePacket(
     }
     XLOG(DBG4) << "LLDP expected/recvd value mismatch!";
   }
-  db_.update(neighbor);
+  if (!unchanged) {
+    db_.update(neighbor, pdu);
+  }
 }
 
 void LldpManager::timeoutExpired() noexcept {
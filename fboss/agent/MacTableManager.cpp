@@ -12,23 +12,119 @@
 #include "fboss/agent/L2Entry.h"
 #include "fboss/agent/MacTableUtils.h"
 #include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/state/SwitchState.h"
 
+#include <vector>
+
 namespace facebook::fboss {
 
-MacTableManager::MacTableManager(SwSwitch* sw) : sw_(sw) {}
+MacTableManager::MacTableManager(SwSwitch* sw)
+    : sw_(sw),
+      pending_(std::make_shared<folly::Synchronized<PendingL2Updates>>()) {}
 
 void MacTableManager::handleL2LearningUpdate(
     L2Entry l2Entry,
     L2EntryUpdateType l2EntryUpdateType) {
+  addL2Update(
+      sw_, pending_, std::move(l2Entry), l2EntryUpdateType, false /* readd */);
+}
+
+void MacTableManager::addL2Update(
+    SwSwitch* sw,
+    const PendingL2UpdatesPtr& pending,
+    L2Entry l2Entry,
+    L2EntryUpdateType l2EntryUpdateType,
+    bool readd) {
+  bool schedule = false;
+  {
+    auto locked = pending->wlock();
+    auto key = std::make_pair(l2Entry.getVlanID(), l2Entry.getMac());
+    auto it = locked->entries.find(key);
+    if (it == locked->entries.end()) {
+      it = locked->entries
+               .emplace(
+                   key,
+                   PendingL2Update{
+                       l2Entry, l2EntryUpdateType, std::nullopt, readd})
+               .first;
+    } else if (readd) {
+      // Events which arrived since the entry was removed are newer
+      return;
+    } else {
+      it->second.l2Entry = l2Entry;
+      it->second.l2EntryUpdateType = l2EntryUpdateType;
+      it->second.readd = false;
+    }
+    if (l2EntryUpdateType == L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_DELETE) {
+      it->second.lastDelete = std::move(l2Entry);
+    }
+    if (!readd) {
+      ++locked->numEvents;
+    }
+    schedule = !locked->scheduled;
+    locked->scheduled = true;
+  }
+  if (!schedule) {
+    return;
+  }
+
   auto updateMacTableFn =
-      [l2Entry, l2EntryUpdateType](const std::shared_ptr<SwitchState>& state) {
-        return MacTableUtils::updateMacTable(state, l2Entry, l2EntryUpdateType);
+      [sw, pending](const std::shared_ptr<SwitchState>& state) {
+        return applyL2Updates(sw, pending, state);
       };
+  sw->updateState(
+      "Programming L2 learning updates", std::move(updateMacTableFn));
+}
 
-  sw_->updateState(
-      folly::to<std::string>("Programming : ", l2Entry.str()),
-      std::move(updateMacTableFn));
+std::shared_ptr<SwitchState> MacTableManager::applyL2Updates(
+    SwSwitch* sw,
+    const PendingL2UpdatesPtr& pending,
+    const std::shared_ptr<SwitchState>& state) {
+  PendingL2Updates updates;
+  {
+    // Events arriving from now on schedule another update
+    auto locked = pending->wlock();
+    std::swap(updates, *locked);
+  }
+  // Entries are ordered by VLAN, and each VLAN's MAC table is only cloned
+  // by its first update
+  std::shared_ptr<SwitchState> newState{state};
+  std::vector<L2Entry> readds;
+  uint64_t numApplied = 0;
+  for (const auto& [key, update] : updates.entries) {
+    if (update.lastDelete &&
+        update.l2EntryUpdateType ==
+            L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD) {
+      auto removedState = MacTableUtils::updateMacTable(
+          newState,
+          *update.lastDelete,
+          L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_DELETE);
+      if (removedState != newState) {
+        // Add it back in the next update, so that the removal is not
+        // coalesced away
+        newState = removedState;
+        readds.push_back(update.l2Entry);
+        numApplied += 2;
+        continue;
+      }
+    }
+    newState = MacTableUtils::updateMacTable(
+        newState, update.l2Entry, update.l2EntryUpdateType);
+    if (!update.readd) {
+      ++numApplied;
+    }
+  }
+  sw->stats()->l2LearningUpdatesApplied(updates.numEvents, numApplied);
+  for (auto& l2Entry : readds) {
+    addL2Update(
+        sw,
+        pending,
+        std::move(l2Entry),
+        L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD,
+        true /* readd */);
+  }
+  return newState;
 }
 
 } // namespace facebook::fboss
@@ -9,11 +9,21 @@
  */
 #pragma once
 
+#include <folly/MacAddress.h>
+#include <folly/Synchronized.h>
+
 #include "fboss/agent/L2Entry.h"
+#include "fboss/agent/types.h"
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
 
 namespace facebook::fboss {
 
 class SwSwitch;
+class SwitchState;
 
 class MacTableManager {
  public:
@@ -28,7 +38,48 @@ class MacTableManager {
   MacTableManager(MacTableManager const&) = delete;
   MacTableManager& operator=(MacTableManager const&) = delete;
 
+  /*
+   * Last learning event for a MAC. A MAC aged and relearned by the hardware
+   * is removed and added again in the state, as for separate events, so that
+   * its hardware entry is reprogrammed and its classID recomputed. The last
+   * delete is kept for that.
+   */
+  struct PendingL2Update {
+    L2Entry l2Entry;
+    L2EntryUpdateType l2EntryUpdateType;
+    std::optional<L2Entry> lastDelete;
+    // Add carried over from a previous update, which removed the entry
+    bool readd{false};
+  };
+
+  /*
+   * Learning events waiting for their state update. Events which arrive
+   * while a state update is queued join it, so a burst of events is applied
+   * as one update, with one MAC table clone per VLAN. Only the last event
+   * for each MAC is kept, as it is what the hardware ended up with.
+   */
+  struct PendingL2Updates {
+    std::map<std::pair<VlanID, folly::MacAddress>, PendingL2Update> entries;
+    uint64_t numEvents{0};
+    bool scheduled{false};
+  };
+  using PendingL2UpdatesPtr =
+      std::shared_ptr<folly::Synchronized<PendingL2Updates>>;
+
+  static void addL2Update(
+      SwSwitch* sw,
+      const PendingL2UpdatesPtr& pending,
+      L2Entry l2Entry,
+      L2EntryUpdateType l2EntryUpdateType,
+      bool readd);
+  static std::shared_ptr<SwitchState> applyL2Updates(
+      SwSwitch* sw,
+      const PendingL2UpdatesPtr& pending,
+      const std::shared_ptr<SwitchState>& state);
+
   SwSwitch* sw_{nullptr};
+  // Shared with the scheduled state update, which may outlive us
+  PendingL2UpdatesPtr pending_;
 };
 
 } // namespace facebook::fboss
@@ -242,4 +242,9 @@ uint32_t Platform::getMMUCellBytes() const {
   throw FbossError("MMU Cell bytes not defined for this platform");
 }
 
+int Platform::getMaxAclEntryPriority() const {
+  // BCM programs priority p as hardware priority 1000000 - p
+  return 1000000;
+}
+
 } // namespace facebook::fboss
@@ -287,6 +287,12 @@ class Platform {
 
   virtual uint32_t getMMUCellBytes() const;
 
+  /*
+   * Highest SwitchState ACL entry priority which can be programmed. Smaller
+   * SwitchState priorities are programmed as higher hardware priorities.
+   */
+  virtual int getMaxAclEntryPriority() const;
+
   virtual uint64_t getIntrCount() {
     return 0;
   }
@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/PortStatusChangeTracker.h"
+
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/state/DeltaFunctions.h"
+#include "fboss/agent/state/Port.h"
+#include "fboss/agent/state/PortMap.h"
+#include "fboss/agent/state/SwitchState.h"
+
+#include <folly/logging/xlog.h>
+
+using std::chrono::duration_cast;
+using std::chrono::milliseconds;
+using std::chrono::system_clock;
+
+namespace facebook::fboss {
+
+PortStatusChangeTracker::PortStatusChangeTracker(SwSwitch* sw)
+    : sw_(sw),
+      // Start from the wall clock time so that generations handed out by a
+      // previous agent instance are always older than ours
+      initialGeneration_(
+          duration_cast<milliseconds>(system_clock::now().time_since_epoch())
+              .count()),
+      generation_(initialGeneration_) {
+  sw_->registerStateObserver(this, "PortStatusChangeTracker");
+}
+
+PortStatusChangeTracker::~PortStatusChangeTracker() {
+  sw_->unregisterStateObserver(this);
+  stop();
+}
+
+void PortStatusChangeTracker::stateUpdated(const StateDelta& delta) {
+  std::map<int32_t, std::optional<PortStatus>> updates;
+  DeltaFunctions::forEachChanged(
+      delta.getPortsDelta(),
+      [&](const std::shared_ptr<Port>& /* oldPort */,
+          const std::shared_ptr<Port>& newPort) {
+        updates[newPort->getID()] = sw_->getPortStatus(*newPort);
+      },
+      [&](const std::shared_ptr<Port>& newPort) {
+        updates[newPort->getID()] = sw_->getPortStatus(*newPort);
+      },
+      [&](const std::shared_ptr<Port>& oldPort) {
+        updates[oldPort->getID()] = std::nullopt;
+      });
+  if (updates.empty()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  // Most port changes (e.g. counters, neighbor learning) don't affect the
+  // PortStatus, so only bump the generation for the ones that do
+  bool changed = false;
+  for (auto& [portID, status] : updates) {
+    auto it = ports_.find(portID);
+    if (it != ports_.end() && it->second.status == status) {
+      continue;
+    }
+    if (!changed) {
+      ++generation_;
+      changed = true;
+    }
+    ports_[portID] = {std::move(status), generation_};
+  }
+  if (changed) {
+    XLOG(DBG3) << "Port status changed, generation=" << generation_;
+    notifyChangedLocked();
+  }
+}
+
+void PortStatusChangeTracker::configApplied(
+    const ConfigAppliedInfo& configAppliedInfo) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  configAppliedInfo_ = configAppliedInfo;
+  ++generation_;
+  notifyChangedLocked();
+}
+
+void PortStatusChangeTracker::notifyChangedLocked() {
+  changed_.setValue();
+  changed_ = folly::SharedPromise<folly::Unit>();
+}
+
+folly::SemiFuture<PortStatusChanges> PortStatusChangeTracker::waitForChanges(
+    int64_t sinceGeneration,
+    milliseconds timeout) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  // Only an up to date client needs to wait
+  if (stopped_ || sinceGeneration != generation_) {
+    PortStatusChanges changes;
+    getChangesLocked(sinceGeneration, changes);
+    return folly::makeSemiFuture(std::move(changes));
+  }
+  return changed_.getSemiFuture().within(timeout).defer(
+      [this, sinceGeneration](folly::Try<folly::Unit>&& /* changed */) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        PortStatusChanges changes;
+        getChangesLocked(sinceGeneration, changes);
+        return changes;
+      });
+}
+
+void PortStatusChangeTracker::getChangesLocked(
+    int64_t sinceGeneration,
+    PortStatusChanges& changes) const {
+  changes.generation() = generation_;
+  changes.configAppliedInfo() = configAppliedInfo_;
+  bool fullSync =
+      sinceGeneration < initialGeneration_ || sinceGeneration > generation_;
+  changes.fullSync() = fullSync;
+  for (const auto& [portID, entry] : ports_) {
+    if (!fullSync && entry.generation <= sinceGeneration) {
+      continue;
+    }
+    if (entry.status) {
+      changes.portStatus()->emplace(portID, *entry.status);
+    } else if (!fullSync) {
+      changes.removedPorts()->push_back(portID);
+    }
+  }
+}
+
+void PortStatusChangeTracker::stop() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (!stopped_) {
+    stopped_ = true;
+    changed_.setValue();
+  }
+}
+
+} // namespace facebook::fboss
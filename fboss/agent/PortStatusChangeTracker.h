@@ -0,0 +1,78 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/StateObserver.h"
+#include "fboss/agent/if/gen-cpp2/ctrl_types.h"
+
+#include <folly/futures/Future.h>
+#include <folly/futures/SharedPromise.h>
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <optional>
+
+namespace facebook::fboss {
+class SwSwitch;
+
+/*
+ * Tracks the PortStatus of every port and the ConfigAppliedInfo, bumping a
+ * generation whenever any of them changes, so that clients such as
+ * qsfp_service can long-poll for changes (waitForPortStatusChanges) instead of
+ * fetching the full port status on every refresh.
+ */
+class PortStatusChangeTracker : public StateObserver {
+ public:
+  explicit PortStatusChangeTracker(SwSwitch* sw);
+  ~PortStatusChangeTracker() override;
+
+  void stateUpdated(const StateDelta& delta) override;
+
+  void configApplied(const ConfigAppliedInfo& configAppliedInfo);
+
+  /*
+   * Completes once something changed after sinceGeneration, or after
+   * timeout. sinceGeneration outside of the generations of this instance
+   * (e.g. 0 or one from a previous agent instance) gets a full snapshot right
+   * away. No thread is blocked while waiting.
+   */
+  folly::SemiFuture<PortStatusChanges> waitForChanges(
+      int64_t sinceGeneration,
+      std::chrono::milliseconds timeout);
+
+  // Complete all the waiters and stop making new ones wait
+  void stop();
+
+ private:
+  struct PortStatusEntry {
+    // Unset once the port is removed
+    std::optional<PortStatus> status;
+    int64_t generation;
+  };
+
+  void getChangesLocked(int64_t sinceGeneration, PortStatusChanges& changes)
+      const;
+  // Complete the current waiters
+  void notifyChangedLocked();
+
+  SwSwitch* sw_;
+
+  std::mutex mutex_;
+  // Fulfilled, and replaced, whenever generation_ changes
+  folly::SharedPromise<folly::Unit> changed_;
+  bool stopped_{false};
+  const int64_t initialGeneration_;
+  int64_t generation_;
+  std::map<int32_t, PortStatusEntry> ports_;
+  ConfigAppliedInfo configAppliedInfo_;
+};
+
+} // namespace facebook::fboss
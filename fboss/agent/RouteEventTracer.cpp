@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RouteEventTracer.h"
+
+#include <folly/hash/Hash.h>
+
+namespace facebook::fboss {
+
+RouteEventTracer::RouteEventTracer(size_t capacity) : capacity_(capacity) {
+  ring_.wlock()->events.resize(capacity_);
+}
+
+void RouteEventTracer::record(const std::vector<RouteEvent>& events) {
+  if (!enabled() || events.empty()) {
+    return;
+  }
+  auto ring = ring_.wlock();
+  for (const auto& event : events) {
+    ring->events[ring->next] = event;
+    if (++ring->next == capacity_) {
+      ring->next = 0;
+      ring->full = true;
+    }
+  }
+}
+
+std::vector<RouteEvent> RouteEventTracer::getEvents() const {
+  auto ring = ring_.rlock();
+  if (!ring->full) {
+    return std::vector<RouteEvent>(
+        ring->events.begin(), ring->events.begin() + ring->next);
+  }
+  std::vector<RouteEvent> events;
+  events.reserve(capacity_);
+  events.insert(
+      events.end(), ring->events.begin() + ring->next, ring->events.end());
+  events.insert(
+      events.end(), ring->events.begin(), ring->events.begin() + ring->next);
+  return events;
+}
+
+uint64_t RouteEventTracer::nexthopsHash(const RouteNextHopEntry& fwd) {
+  auto hash = folly::hash::hash_combine(static_cast<int>(fwd.getAction()));
+  // The nexthop set is sorted, so equal sets hash the same
+  for (const auto& nhop : fwd.getNextHopSet()) {
+    hash = folly::hash::hash_combine(
+        hash,
+        nhop.addr().hash(),
+        nhop.intfID() ? static_cast<int64_t>(*nhop.intfID()) : -1,
+        nhop.weight());
+  }
+  return hash;
+}
+
+} // namespace facebook::fboss
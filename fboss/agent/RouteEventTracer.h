@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/IPAddress.h>
+#include <folly/Synchronized.h>
+
+#include "fboss/agent/state/RouteNextHopEntry.h"
+#include "fboss/agent/types.h"
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * A route programmed to the FIB, with the time it reached each stage of
+ * programming. Events are fixed size and hold no strings, so that recording
+ * one is only a copy into the ring.
+ */
+struct RouteEvent {
+  enum class Type : uint8_t { ADD, CHANGE, DELETE };
+  using Clock = std::chrono::system_clock;
+
+  folly::IPAddress network;
+  uint8_t mask{0};
+  Type type{Type::ADD};
+  // Client with the best entry for the route, or the last one for deletes.
+  // Unset for routes without client entries, e.g. interface routes.
+  std::optional<ClientID> client;
+  // Hash of the forwarding action and resolved nexthops
+  uint64_t nexthopsHash{0};
+  // When the RIB handed the resolved routes to the FIB. Unset for route
+  // changes which did not come from the RIB.
+  std::optional<Clock::time_point> ribTime;
+  // When the new SwitchState with the route was computed
+  std::optional<Clock::time_point> switchStateTime;
+  // When the SwitchState was programmed to the hardware
+  Clock::time_point hwTime;
+};
+
+/*
+ * Fixed size in-memory ring of the most recent route events. The oldest
+ * events are overwritten once the ring is full.
+ *
+ * Events are recorded by the state update thread, one batch per state
+ * update, and may be read from any thread.
+ */
+class RouteEventTracer {
+ public:
+  explicit RouteEventTracer(size_t capacity);
+
+  bool enabled() const {
+    return capacity_ > 0;
+  }
+
+  // Add the events of one state update
+  void record(const std::vector<RouteEvent>& events);
+
+  // All the events in the ring, oldest first
+  std::vector<RouteEvent> getEvents() const;
+
+  static uint64_t nexthopsHash(const RouteNextHopEntry& fwd);
+
+ private:
+  struct Ring {
+    std::vector<RouteEvent> events;
+    // Index of the slot the next event goes in
+    size_t next{0};
+    bool full{false};
+  };
+
+  const size_t capacity_;
+  folly::Synchronized<Ring> ring_;
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RouteProgrammingLatency.h"
+
+#include <folly/lang/Bits.h>
+
+#include <algorithm>
+
+namespace facebook::fboss {
+
+folly::StringPiece routeProgrammingStageName(RouteProgrammingStage stage) {
+  switch (stage) {
+    case RouteProgrammingStage::RIB_RESOLUTION:
+      return "rib_resolution";
+    case RouteProgrammingStage::FIB_UPDATE:
+      return "fib_update";
+    case RouteProgrammingStage::UPDATE_QUEUE:
+      return "update_queue";
+    case RouteProgrammingStage::HW_PROGRAMMING:
+      return "hw_programming";
+    case RouteProgrammingStage::STATE_OBSERVERS:
+      return "state_observers";
+  }
+  return "unknown";
+}
+
+void RouteProgrammingLatency::addSample(
+    RouteProgrammingStage stage,
+    std::chrono::microseconds us) {
+  auto value = static_cast<uint64_t>(std::max<int64_t>(us.count(), 0));
+  auto bucket = std::min<size_t>(folly::findLastSet(value), kNumBuckets - 1);
+  auto histograms = histograms_.wlock();
+  auto& histogram = (*histograms)[static_cast<size_t>(stage)];
+  ++histogram.count;
+  histogram.total += us;
+  histogram.max = std::max(histogram.max, us);
+  ++histogram.buckets[bucket];
+}
+
+std::vector<RouteProgrammingStageLatency>
+RouteProgrammingLatency::getLatencies() const {
+  std::vector<RouteProgrammingStageLatency> latencies;
+  latencies.reserve(kNumRouteProgrammingStages);
+  auto histograms = histograms_.rlock();
+  for (size_t i = 0; i < kNumRouteProgrammingStages; ++i) {
+    const auto& histogram = (*histograms)[i];
+    RouteProgrammingStageLatency latency;
+    latency.stage = static_cast<RouteProgrammingStage>(i);
+    latency.count = histogram.count;
+    latency.total = histogram.total;
+    latency.max = histogram.max;
+    latency.p50 = percentile(histogram, 0.5);
+    latency.p90 = percentile(histogram, 0.9);
+    latency.p99 = percentile(histogram, 0.99);
+    latencies.push_back(latency);
+  }
+  return latencies;
+}
+
+void RouteProgrammingLatency::clear() {
+  histograms_.wlock()->fill(Histogram());
+}
+
+std::chrono::microseconds RouteProgrammingLatency::percentile(
+    const Histogram& histogram,
+    double pct) {
+  if (histogram.count == 0) {
+    return std::chrono::microseconds(0);
+  }
+  // Rank of the sample at the percentile, counting from 1
+  auto rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(histogram.count * pct + 0.5));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    seen += histogram.buckets[i];
+    if (seen >= rank) {
+      auto upperBound = i == 0 ? 0 : (uint64_t(1) << i) - 1;
+      return std::min(
+          histogram.max,
+          std::chrono::microseconds(static_cast<int64_t>(upperBound)));
+    }
+  }
+  return histogram.max;
+}
+
+} // namespace facebook::fboss
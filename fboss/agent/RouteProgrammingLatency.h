@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/Range.h>
+#include <folly/Synchronized.h>
+
+#include <array>
+#include <chrono>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * Stages a route update goes through between a client handing routes to the
+ * RIB and the routes being in the hardware.
+ */
+enum class RouteProgrammingStage : uint8_t {
+  // Resolving nexthops and updating the RIB, excluding FIB_UPDATE
+  RIB_RESOLUTION,
+  // Building the new SwitchState with the resolved routes
+  FIB_UPDATE,
+  // Waiting in the SwSwitch update queue behind other state updates
+  UPDATE_QUEUE,
+  // Computing the StateDelta and programming it to the HwSwitch
+  HW_PROGRAMMING,
+  // Notifying the state observers of the new routes
+  STATE_OBSERVERS,
+};
+
+constexpr size_t kNumRouteProgrammingStages = 5;
+
+folly::StringPiece routeProgrammingStageName(RouteProgrammingStage stage);
+
+struct RouteProgrammingStageLatency {
+  RouteProgrammingStage stage;
+  uint64_t count{0};
+  std::chrono::microseconds total{0};
+  std::chrono::microseconds max{0};
+  // Percentiles are upper bounds, to within a factor of 2
+  std::chrono::microseconds p50{0};
+  std::chrono::microseconds p90{0};
+  std::chrono::microseconds p99{0};
+};
+
+/*
+ * Latency histograms of each route programming stage, over the lifetime of
+ * the process or since the last clear(). Buckets are powers of 2 so that
+ * both single route updates and full FIB syncs fit without tuning.
+ *
+ * These back the thrift call and the benchmark breakdown; the fb303
+ * histograms in SwitchStats are fed the same samples.
+ */
+class RouteProgrammingLatency {
+ public:
+  void addSample(RouteProgrammingStage stage, std::chrono::microseconds us);
+
+  // One entry per stage, in stage order
+  std::vector<RouteProgrammingStageLatency> getLatencies() const;
+
+  void clear();
+
+ private:
+  // Bucket 0 holds 0us, bucket i holds [2^(i-1), 2^i) us
+  static constexpr size_t kNumBuckets = 40;
+
+  struct Histogram {
+    uint64_t count{0};
+    std::chrono::microseconds total{0};
+    std::chrono::microseconds max{0};
+    std::array<uint64_t, kNumBuckets> buckets{};
+  };
+  using Histograms = std::array<Histogram, kNumRouteProgrammingStages>;
+
+  static std::chrono::microseconds percentile(
+      const Histogram& histogram,
+      double pct);
+
+  folly::Synchronized<Histograms> histograms_;
+};
+
+} // namespace facebook::fboss
@@ -12,46 +12,96 @@
 #include "fboss/agent/FibHelpers.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/state/DeltaFunctions.h"
+#include "fboss/agent/state/SwitchState.h"
+
+#include <gflags/gflags.h>
+#include <algorithm>
+
+DEFINE_int32(
+    route_event_trace_size,
+    16384,
+    "Number of most recent route programming events kept in memory for "
+    "getRouteEvents. 0 disables route event tracing");
 
 namespace facebook::fboss {
 
 namespace {
+/*
+ * What to do with the routes of one state update. tracker is null if no
+ * prefixes are tracked, and events is null if route events are not traced.
+ */
+struct RouteDeltaContext {
+  const RouteUpdateLoggingPrefixTracker* tracker;
+  std::vector<RouteEvent>* events;
+  std::optional<RouteEvent::Clock::time_point> ribTime;
+  std::optional<RouteEvent::Clock::time_point> switchStateTime;
+  RouteEvent::Clock::time_point hwTime;
+};
+
+template <typename AddrT>
+void addRouteEvent(
+    const RouteDeltaContext& ctx,
+    RouteEvent::Type type,
+    const std::shared_ptr<Route<AddrT>>& route) {
+  if (!ctx.events) {
+    return;
+  }
+  RouteEvent event;
+  event.network = folly::IPAddress(route->prefix().network);
+  event.mask = route->prefix().mask;
+  event.type = type;
+  if (!route->hasNoEntry()) {
+    event.client = route->getBestEntry().first;
+  }
+  if (type != RouteEvent::Type::DELETE) {
+    event.nexthopsHash =
+        RouteEventTracer::nexthopsHash(route->getForwardInfo());
+  }
+  event.ribTime = ctx.ribTime;
+  event.switchStateTime = ctx.switchStateTime;
+  event.hwTime = ctx.hwTime;
+  ctx.events->push_back(event);
+}
+
 template <typename AddrT>
 void handleChangedRoute(
-    const RouteUpdateLoggingPrefixTracker& tracker,
+    const RouteDeltaContext& ctx,
     const std::unique_ptr<RouteLogger<AddrT>>& logger,
     RouterID /*rid*/,
     const std::shared_ptr<Route<AddrT>>& oldRoute,
     const std::shared_ptr<Route<AddrT>>& newRoute) {
+  addRouteEvent(ctx, RouteEvent::Type::CHANGE, newRoute);
   std::vector<std::string> matchedIdentifiers;
   auto prefix = oldRoute->prefix();
-  if (tracker.tracking(prefix, matchedIdentifiers)) {
+  if (ctx.tracker && ctx.tracker->tracking(prefix, matchedIdentifiers)) {
     logger->logChangedRoute(oldRoute, newRoute, matchedIdentifiers);
   }
 }
 
 template <typename AddrT>
 void handleRemovedRoute(
-    const RouteUpdateLoggingPrefixTracker& tracker,
+    const RouteDeltaContext& ctx,
     const std::unique_ptr<RouteLogger<AddrT>>& logger,
     RouterID /*rid*/,
     const std::shared_ptr<Route<AddrT>>& oldRoute) {
+  addRouteEvent(ctx, RouteEvent::Type::DELETE, oldRoute);
   std::vector<std::string> matchedIdentifiers;
   auto prefix = oldRoute->prefix();
-  if (tracker.tracking(prefix, matchedIdentifiers)) {
+  if (ctx.tracker && ctx.tracker->tracking(prefix, matchedIdentifiers)) {
     logger->logRemovedRoute(oldRoute, matchedIdentifiers);
   }
 }
 
 template <typename AddrT>
 void handleAddedRoute(
-    const RouteUpdateLoggingPrefixTracker& tracker,
+    const RouteDeltaContext& ctx,
     const std::unique_ptr<RouteLogger<AddrT>>& logger,
     RouterID /*rid*/,
     const std::shared_ptr<Route<AddrT>>& newRoute) {
+  addRouteEvent(ctx, RouteEvent::Type::ADD, newRoute);
   std::vector<std::string> matchedIdentifiers;
   auto prefix = newRoute->prefix();
-  if (tracker.tracking(prefix, matchedIdentifiers)) {
+  if (ctx.tracker && ctx.tracker->tracking(prefix, matchedIdentifiers)) {
     logger->logAddedRoute(newRoute, matchedIdentifiers);
   }
 }
@@ -72,31 +122,62 @@ RouteUpdateLogger::RouteUpdateLogger(
     : swSwitch_(sw),
       routeLoggerV4_(std::move(routeLoggerV4)),
       routeLoggerV6_(std::move(routeLoggerV6)),
-      mplsRouteLogger_(std::move(mplsRouteLogger)) {
+      mplsRouteLogger_(std::move(mplsRouteLogger)),
+      routeEventTracer_(std::max(FLAGS_route_event_trace_size, 0)) {
   swSwitch_->registerStateObserver(this, "RouteUpdateLogger");
 }
 RouteUpdateLogger::~RouteUpdateLogger() {
   swSwitch_->unregisterStateObserver(this);
 }
+void RouteUpdateLogger::fibUpdated(
+    const SwitchState& newState,
+    RouteEvent::Clock::time_point ribTime) {
+  fibUpdateTimes_ = FibUpdateTimes{
+      newState.getGeneration(), ribTime, RouteEvent::Clock::now()};
+}
+
 void RouteUpdateLogger::stateUpdated(const StateDelta& delta) {
-  forEachChangedRoute<folly::IPAddressV4>(
-      delta,
-      &handleChangedRoute<folly::IPAddressV4>,
-      &handleAddedRoute<folly::IPAddressV4>,
-      &handleRemovedRoute<folly::IPAddressV4>,
-      prefixTracker_,
-      routeLoggerV4_);
-  forEachChangedRoute<folly::IPAddressV6>(
-      delta,
-      &handleChangedRoute<folly::IPAddressV6>,
-      &handleAddedRoute<folly::IPAddressV6>,
-      &handleRemovedRoute<folly::IPAddressV6>,
-      prefixTracker_,
-      routeLoggerV6_);
+  std::optional<FibUpdateTimes> fibUpdateTimes;
+  fibUpdateTimes.swap(fibUpdateTimes_);
+
+  bool logging = !prefixTracker_.empty();
+  if (logging || routeEventTracer_.enabled()) {
+    std::vector<RouteEvent> events;
+    RouteDeltaContext ctx{
+        logging ? &prefixTracker_ : nullptr,
+        routeEventTracer_.enabled() ? &events : nullptr,
+        std::nullopt,
+        std::nullopt,
+        RouteEvent::Clock::now()};
+    // Stage times of an update which failed to program are dropped
+    if (fibUpdateTimes &&
+        fibUpdateTimes->generation == delta.newState()->getGeneration()) {
+      ctx.ribTime = fibUpdateTimes->ribTime;
+      ctx.switchStateTime = fibUpdateTimes->switchStateTime;
+    }
+    forEachChangedRoute<folly::IPAddressV4>(
+        delta,
+        &handleChangedRoute<folly::IPAddressV4>,
+        &handleAddedRoute<folly::IPAddressV4>,
+        &handleRemovedRoute<folly::IPAddressV4>,
+        ctx,
+        routeLoggerV4_);
+    forEachChangedRoute<folly::IPAddressV6>(
+        delta,
+        &handleChangedRoute<folly::IPAddressV6>,
+        &handleAddedRoute<folly::IPAddressV6>,
+        &handleRemovedRoute<folly::IPAddressV6>,
+        ctx,
+        routeLoggerV6_);
+    routeEventTracer_.record(events);
+  }
 
   auto* mplsRouteLogger = mplsRouteLogger_.get();
   CHECK(mplsRouteLogger);
   const auto labelTracker = labelTracker_.rlock();
+  if (labelTracker->empty()) {
+    return;
+  }
 
   DeltaFunctions::forEachChanged(
       delta.getLabelForwardingInformationBaseDelta(),
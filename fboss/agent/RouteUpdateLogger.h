@@ -11,6 +11,7 @@
 
 #include <folly/IPAddress.h>
 #include <folly/logging/xlog.h>
+#include "fboss/agent/RouteEventTracer.h"
 #include "fboss/agent/RouteUpdateLoggingPrefixTracker.h"
 #include "fboss/agent/StateObserver.h"
 #include "fboss/agent/state/Route.h"
@@ -18,10 +19,12 @@
 #include "fboss/agent/state/StateDelta.h"
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace facebook::fboss {
 class SwSwitch;
+class SwitchState;
 
 template <typename RouteT>
 class RouteLoggerBase {
@@ -134,6 +137,9 @@ class LabelsTracker {
   void untrack(Label label, const std::string& identifier);
   void untrack(const std::string& identifier);
   TrackedLabelsInfo getTrackedLabelsInfo() const;
+  bool empty() const {
+    return label2Ids_.empty();
+  }
 
   void getIdentifiersForLabel(Label label, std::set<std::string>& identifiers)
       const;
@@ -148,6 +154,11 @@ class LabelsTracker {
  * (or more specific location with that prefix) is added, removed, or
  * changes, log that information. The logger is pluggable, but by default
  * we use GLOG.
+ *
+ * Independently of the subscriptions, every FIB change is recorded in a ring
+ * of RouteEvents with the time it reached each programming stage, unless
+ * --route_event_trace_size is 0. Nothing is scanned when nothing is logged
+ * or traced.
  */
 class RouteUpdateLogger : public StateObserver {
   // TODO(pshaikh): rename RouteUpdateLogger to FibUpdateObserver
@@ -176,6 +187,19 @@ class RouteUpdateLogger : public StateObserver {
 
   LabelsTracker::TrackedLabelsInfo gettTrackedLabels() const;
 
+  /*
+   * Called from the state update which applies routes from the RIB, with the
+   * SwitchState it produced and the time the RIB handed over the routes. The
+   * events of the update are stamped with both once it is programmed.
+   */
+  void fibUpdated(
+      const SwitchState& newState,
+      RouteEvent::Clock::time_point ribTime);
+
+  std::vector<RouteEvent> getRouteEvents() const {
+    return routeEventTracer_.getEvents();
+  }
+
   RouteLogger<folly::IPAddressV4>* getRouteLoggerV4() const {
     return routeLoggerV4_.get();
   }
@@ -188,12 +212,22 @@ class RouteUpdateLogger : public StateObserver {
   }
 
  private:
+  struct FibUpdateTimes {
+    // Generation of the SwitchState the times are for
+    uint32_t generation;
+    RouteEvent::Clock::time_point ribTime;
+    RouteEvent::Clock::time_point switchStateTime;
+  };
+
   SwSwitch* swSwitch_;
   RouteUpdateLoggingPrefixTracker prefixTracker_;
   folly::Synchronized<LabelsTracker> labelTracker_;
   std::unique_ptr<RouteLogger<folly::IPAddressV4>> routeLoggerV4_;
   std::unique_ptr<RouteLogger<folly::IPAddressV6>> routeLoggerV6_;
   std::unique_ptr<MplsRouteLogger> mplsRouteLogger_;
+  RouteEventTracer routeEventTracer_;
+  // Only accessed from the state update thread
+  std::optional<FibUpdateTimes> fibUpdateTimes_;
 };
 
 } // namespace facebook::fboss
@@ -48,6 +48,9 @@ void RouteUpdateLoggingPrefixTracker::stopTracking(
       return;
     }
     itr->second.erase(prefix.network, prefix.mask);
+    if (itr->second.size() == 0) {
+      trackedPrefixes_.erase(itr);
+    }
   }
 }
 
@@ -82,6 +85,10 @@ bool RouteUpdateLoggingPrefixTracker::trackingImpl(
   return (identifiers.size() > 0);
 }
 
+bool RouteUpdateLoggingPrefixTracker::empty() const {
+  return trackedPrefixes_.rlock()->empty();
+}
+
 std::vector<RouteUpdateLoggingInstance>
 RouteUpdateLoggingPrefixTracker::getTrackedPrefixes() const {
   std::vector<RouteUpdateLoggingInstance> allPrefixes;
@@ -60,6 +60,8 @@ class RouteUpdateLoggingPrefixTracker {
   // Stop tracking all the prefixes tracked with this identifier
   void stopTracking(const std::string& identifier);
   std::vector<RouteUpdateLoggingInstance> getTrackedPrefixes() const;
+  // Whether no prefixes are tracked at all
+  bool empty() const;
 
   /* Returns whether or not the prefix is tracked for logging.
    * Will also populate identifiers with all of the identifiers that
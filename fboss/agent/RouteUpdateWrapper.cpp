@@ -134,7 +134,9 @@ void RouteUpdateWrapper::printStats(const UpdateStatistics& stats) const {
   XLOG(DBG0) << " Routes added: " << stats.v4RoutesAdded + stats.v6RoutesAdded
              << " Routes deleted: "
              << stats.v4RoutesDeleted + stats.v6RoutesDeleted << " Duration "
-             << stats.duration.count() << " us ";
+             << stats.duration.count() << " us "
+             << " RIB resolution " << stats.ribResolutionDuration.count()
+             << " us FIB update " << stats.fibUpdateDuration.count() << " us ";
 }
 
 void RouteUpdateWrapper::printMplsStats(const UpdateStatistics& stats) const {
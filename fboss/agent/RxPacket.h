@@ -10,8 +10,10 @@
 #pragma once
 
 #include "fboss/agent/Packet.h"
+#include "fboss/agent/packet/PktHeaderInfo.h"
 #include "fboss/agent/types.h"
 
+#include <optional>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -60,6 +62,19 @@ class RxPacket : public Packet {
     // TODO: only vrf 0 now
     return RouterID(0);
   }
+  /*
+   * Get the ethernet, IP and L4 header fields of the packet.
+   *
+   * The headers are classified the first time this is called, and shared by
+   * everything that looks at the packet after that. The packet data must not
+   * be modified once this has been called.
+   */
+  const PktHeaderInfo& getHeaderInfo() const {
+    if (!headerInfo_) {
+      headerInfo_ = classifyPktHeaders(buf());
+    }
+    return *headerInfo_;
+  }
 
   /*
    * Return a human-readable string describing additional detailed information
@@ -100,6 +115,9 @@ class RxPacket : public Packet {
   AggregatePortID srcAggregatePort_{0};
   VlanID srcVlan_{0};
   uint32_t len_{0};
+
+ private:
+  mutable std::optional<PktHeaderInfo> headerInfo_;
 };
 
 } // namespace facebook::fboss
@@ -0,0 +1,46 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/StateUpdateProfiler.h"
+
+#include <algorithm>
+
+namespace facebook::fboss {
+
+void StateUpdateProfiler::updateApplied(
+    const std::string& name,
+    std::chrono::microseconds queueWait,
+    std::chrono::microseconds apply) {
+  auto profiles = profiles_.wlock();
+  auto it = profiles->find(name);
+  if (it == profiles->end()) {
+    std::string key = profiles->size() < kMaxNames ? name : kOtherName;
+    it = profiles->try_emplace(key).first;
+    it->second.name = key;
+  }
+  auto& profile = it->second;
+  ++profile.count;
+  profile.totalQueueWait += queueWait;
+  profile.maxQueueWait = std::max(profile.maxQueueWait, queueWait);
+  profile.totalApply += apply;
+  profile.maxApply = std::max(profile.maxApply, apply);
+}
+
+std::vector<StateUpdateProfiler::Profile> StateUpdateProfiler::getProfiles()
+    const {
+  std::vector<Profile> result;
+  auto profiles = profiles_.rlock();
+  result.reserve(profiles->size());
+  for (const auto& entry : *profiles) {
+    result.push_back(entry.second);
+  }
+  return result;
+}
+
+} // namespace facebook::fboss
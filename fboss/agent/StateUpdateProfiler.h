@@ -0,0 +1,55 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/Synchronized.h>
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * Per update name totals of how long state updates waited in the SwSwitch
+ * update queue and how long their update functions took to run.
+ *
+ * Some update names embed the object they update, so the number of names
+ * tracked is bounded. Updates with names beyond the bound are counted under
+ * kOtherName.
+ */
+class StateUpdateProfiler {
+ public:
+  struct Profile {
+    std::string name;
+    uint64_t count{0};
+    std::chrono::microseconds totalQueueWait{0};
+    std::chrono::microseconds maxQueueWait{0};
+    std::chrono::microseconds totalApply{0};
+    std::chrono::microseconds maxApply{0};
+  };
+
+  static constexpr size_t kMaxNames = 1024;
+  static constexpr auto kOtherName = "<other>";
+
+  void updateApplied(
+      const std::string& name,
+      std::chrono::microseconds queueWait,
+      std::chrono::microseconds apply);
+
+  // Profiles in no particular order
+  std::vector<Profile> getProfiles() const;
+
+ private:
+  folly::Synchronized<std::unordered_map<std::string, Profile>> profiles_;
+};
+
+} // namespace facebook::fboss
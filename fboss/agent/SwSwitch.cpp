@@ -41,6 +41,7 @@
 #include "fboss/agent/PhySnapshotManager-defs.h"
 #include "fboss/agent/Platform.h"
 #include "fboss/agent/PortStats.h"
+#include "fboss/agent/PortStatusChangeTracker.h"
 #include "fboss/agent/PortUpdateHandler.h"
 #include "fboss/agent/ResolvedNexthopMonitor.h"
 #include "fboss/agent/ResolvedNexthopProbeScheduler.h"
@@ -49,6 +50,7 @@
 #include "fboss/agent/RxPacket.h"
 #include "fboss/agent/StaticL2ForNeighborObserver.h"
 #include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
+#include "fboss/agent/SwitchStateChangePublisher.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/ThriftHandler.h"
 #include "fboss/agent/TunManager.h"
@@ -135,6 +137,13 @@ DEFINE_int32(
     fsdbStatsStreamIntervalSeconds,
     5,
     "Interval at which stats subscriptions are served");
+
+DEFINE_int32(
+    link_up_hold_ms,
+    0,
+    "Time to hold a link up before applying it, so that link ups arriving "
+    "meanwhile are applied by the same state update. With 0, link ups are "
+    "only batched while their state update is queued");
 namespace {
 
 /**
@@ -198,6 +207,7 @@ SwSwitch::SwSwitch(std::unique_ptr<Platform> platform)
       mplsHandler_(new MPLSHandler(this)),
       packetLogger_(new PacketLogger(this)),
       routeUpdateLogger_(new RouteUpdateLogger(this)),
+      routeProgrammingLatency_(new RouteProgrammingLatency()),
       resolvedNexthopMonitor_(new ResolvedNexthopMonitor(this)),
       resolvedNexthopProbeScheduler_(new ResolvedNexthopProbeScheduler(this)),
       portUpdateHandler_(new PortUpdateHandler(this)),
@@ -207,7 +217,9 @@ SwSwitch::SwSwitch(std::unique_ptr<Platform> platform)
       macTableManager_(new MacTableManager(this)),
       phySnapshotManager_(
           new PhySnapshotManager<kIphySnapshotIntervalSeconds>()),
-      aclNexthopHandler_(new AclNexthopHandler(this)) {
+      aclNexthopHandler_(new AclNexthopHandler(this)),
+      portStatusChangeTracker_(new PortStatusChangeTracker(this)),
+      stateChangePublisher_(new SwitchStateChangePublisher(this)) {
   // Create the platform-specific state directories if they
   // don't exist already.
   utilCreateDir(platform_->getVolatileStateDir());
@@ -282,6 +294,10 @@ void SwSwitch::stop(bool revertToMinAlpmState) {
     rib_->stop();
   }
 
+  // Release thrift threads long-polling for port status changes
+  portStatusChangeTracker_->stop();
+  // End the switch state change streams
+  stateChangePublisher_->stop();
   lookupClassUpdater_.reset();
   lookupClassRouteUpdater_.reset();
   macTableManager_.reset();
@@ -768,9 +784,11 @@ bool SwSwitch::updateState(unique_ptr<StateUpdate> update) {
                << " since exit already started";
     return false;
   }
+  update->enqueueTime_ = std::chrono::steady_clock::now();
   {
-    std::unique_lock guard(pendingUpdatesLock_);
+    auto guard = lockPendingUpdates();
     pendingUpdates_.push_back(*update.release());
+    ++numPendingUpdates_;
   }
 
   // Signal the update thread that updates are pending.
@@ -820,6 +838,33 @@ void SwSwitch::updateStateBlockingImpl(
   }
 }
 
+std::unique_lock<folly::SpinLock> SwSwitch::lockPendingUpdates() {
+  std::unique_lock guard(pendingUpdatesLock_, std::try_to_lock);
+  if (!guard.owns_lock()) {
+    auto start = std::chrono::steady_clock::now();
+    guard.lock();
+    stats()->pendingUpdatesLockContended(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start));
+  }
+  return guard;
+}
+
+std::vector<std::pair<std::string, std::chrono::microseconds>>
+SwSwitch::getPendingUpdates() {
+  std::vector<std::pair<std::string, std::chrono::microseconds>> pending;
+  auto now = std::chrono::steady_clock::now();
+  auto guard = lockPendingUpdates();
+  pending.reserve(numPendingUpdates_);
+  for (const auto& update : pendingUpdates_) {
+    pending.emplace_back(
+        update.getName(),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            now - update.enqueueTime_));
+  }
+  return pending;
+}
+
 void SwSwitch::handlePendingUpdatesHelper(SwSwitch* sw) {
   sw->handlePendingUpdates();
 }
@@ -832,8 +877,11 @@ void SwSwitch::handlePendingUpdates() {
   // might also end up finding 0 updates to process if a previous
   // handlePendingUpdates() call processed multiple updates.
   StateUpdateList updates;
+  size_t numUpdates = 0;
+  size_t queueDepth = 0;
   {
-    std::unique_lock guard(pendingUpdatesLock_);
+    auto guard = lockPendingUpdates();
+    queueDepth = numPendingUpdates_;
     // When deciding how many elements to pull off the pendingUpdates_
     // list, we pull as many as we can, subject to the following conditions
     // - Non coalescing updates are executed by themselves
@@ -845,6 +893,7 @@ void SwSwitch::handlePendingUpdates() {
           // First update is non coalescing, splice it onto the updates list
           // and apply transaction by itself
           ++iter;
+          ++numUpdates;
           break;
         } else {
           // Splice all updates upto this non coalescing update, we will
@@ -853,9 +902,11 @@ void SwSwitch::handlePendingUpdates() {
         }
       }
       ++iter;
+      ++numUpdates;
     }
     updates.splice(
         updates.begin(), pendingUpdates_, pendingUpdates_.begin(), iter);
+    numPendingUpdates_ -= numUpdates;
   }
 
   // handlePendingUpdates() is invoked once for each update, but a previous
@@ -864,6 +915,7 @@ void SwSwitch::handlePendingUpdates() {
   if (updates.empty()) {
     return;
   }
+  stats()->stateUpdatesDequeued(numUpdates, queueDepth);
 
   // Non coalescing updates should be applied individually
   bool isNonCoalescing = updates.begin()->isNonCoalescing();
@@ -891,6 +943,11 @@ void SwSwitch::handlePendingUpdates() {
 
     shared_ptr<SwitchState> intermediateState;
     XLOG(INFO) << "preparing state update " << update->getName();
+    // The update is deleted if it fails, so keep what we profile it by
+    auto name = update->getName();
+    auto start = std::chrono::steady_clock::now();
+    auto queueWait = std::chrono::duration_cast<std::chrono::microseconds>(
+        start - update->enqueueTime_);
     try {
       intermediateState = update->applyUpdate(newDesiredState);
     } catch (const std::exception& ex) {
@@ -900,6 +957,12 @@ void SwSwitch::handlePendingUpdates() {
       update->onError(ex);
       delete update;
     }
+    stats()->stateUpdateQueueWait(queueWait);
+    stateUpdateProfiler_.updateApplied(
+        name,
+        queueWait,
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start));
     // We have applied the update to software switch state, so call success
     // on the update.
     if (intermediateState) {
@@ -972,6 +1035,13 @@ void SwSwitch::handlePendingUpdates() {
   }
 }
 
+void SwSwitch::routeProgrammingStage(
+    RouteProgrammingStage stage,
+    std::chrono::microseconds us) {
+  routeProgrammingLatency_->addSample(stage, us);
+  stats()->routeProgrammingStage(stage, us);
+}
+
 void SwSwitch::updatePtpTcCounter() {
   // update fb303 counter to reflect current state of PTP
   // should be invoked post update
@@ -1024,6 +1094,7 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
   // take a non-trivial amount of time, and blocking other users seems
   // undesirable.  So far I don't think this brief discrepancy should cause
   // major issues.
+  auto hwStart = std::chrono::steady_clock::now();
   try {
     newAppliedState = isTransaction ? hw_->stateChangedTransaction(delta)
                                     : hw_->stateChanged(delta);
@@ -1040,6 +1111,8 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
                 << folly::exceptionStr(ex);
   }
 
+  auto hwEnd = std::chrono::steady_clock::now();
+
   setStateInternal(newAppliedState);
 
   // Notifies all observers of the current state update.
@@ -1049,6 +1122,16 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
   auto duration =
       std::chrono::duration_cast<std::chrono::microseconds>(end - start);
   stats()->stateUpdate(duration);
+  // StateDelta computes the changes lazily, as HwSwitch walks them, so its
+  // cost is part of the hardware programming time.
+  if (oldState->getFibs() != newState->getFibs()) {
+    routeProgrammingStage(
+        RouteProgrammingStage::HW_PROGRAMMING,
+        std::chrono::duration_cast<std::chrono::microseconds>(hwEnd - hwStart));
+    routeProgrammingStage(
+        RouteProgrammingStage::STATE_OBSERVERS,
+        std::chrono::duration_cast<std::chrono::microseconds>(end - hwEnd));
+  }
 
   XLOG(DBG0) << "Update state took " << duration.count() << "us";
   return newAppliedState;
@@ -1129,6 +1212,10 @@ PortStatus SwSwitch::getPortStatus(PortID portID) {
   return fillInPortStatus(*port, this);
 }
 
+PortStatus SwSwitch::getPortStatus(const Port& port) const {
+  return fillInPortStatus(port, this);
+}
+
 SwitchStats* SwSwitch::createSwitchStats() {
   SwitchStats* s = new SwitchStats();
   stats_.reset(s);
@@ -1193,16 +1280,21 @@ void SwSwitch::handlePacket(std::unique_ptr<RxPacket> pkt) {
     return;
   }
 
-  // Parse the source and destination MAC, as well as the ethertype.
-  Cursor c(pkt->buf());
-  auto dstMac = PktUtil::readMac(&c);
-  auto srcMac = PktUtil::readMac(&c);
-  auto ethertype = c.readBE<uint16_t>();
-  if (ethertype == 0x8100) {
-    // 802.1Q
-    c += 2; // Advance over the VLAN tag.  We ignore it for now
-    ethertype = c.readBE<uint16_t>();
+  // The source and destination MAC, as well as the ethertype, were
+  // classified along with the rest of the headers. We ignore the VLAN tag for
+  // now.
+  const auto& headers = pkt->getHeaderInfo();
+  if (headers.l3Offset == 0) {
+    // Counted as an error, like the failed read of the truncated header
+    portStats(port)->pktError();
+    XLOG(ERR) << "error processing trapped packet: truncated ethernet header";
+    return;
   }
+  auto dstMac = headers.dstMac;
+  auto srcMac = headers.srcMac;
+  auto ethertype = headers.etherType;
+  Cursor c(pkt->buf());
+  c += headers.l3Offset;
 
   std::stringstream ss;
   ss << "trapped packet: src_port=" << pkt->getSrcPort() << " srcAggPort="
@@ -1305,34 +1397,106 @@ void SwSwitch::linkStateChanged(
     return;
   }
 
-  // Schedule an update for port's operational status
-  auto updateOperStateFn = [=](const std::shared_ptr<SwitchState>& state) {
-    std::shared_ptr<SwitchState> newState(state);
-    auto* port = newState->getPorts()->getPortIf(portId).get();
-
-    if (port) {
-      if (port->isUp() != up) {
-        XLOG(INFO) << "SW Link state changed: " << port->getName() << " ["
-                   << (port->isUp() ? "UP" : "DOWN") << "->"
-                   << (up ? "UP" : "DOWN") << "]";
-        port = port->modify(&newState);
-        port->setOperState(up);
-        if (iPhyFaultStatus) {
-          port->setIPhyLinkFaultStatus(*iPhyFaultStatus);
-        }
-        // Log event and update counters if there is a change
-        logLinkStateEvent(portId, up);
-        setPortStatusCounter(portId, up);
-        portStats(portId)->linkStateChange(up);
+  if (up) {
+    std::shared_ptr<LinkUpBatch> newBatch;
+    {
+      auto pending = pendingLinkUps_.wlock();
+      if (!pending->openBatch) {
+        newBatch = std::make_shared<LinkUpBatch>();
+        pending->openBatch = newBatch;
       }
+      pending->openBatch->ports.insert_or_assign(portId, iPhyFaultStatus);
+      ++pending->openBatch->numEvents;
     }
+    if (!newBatch) {
+      return;
+    }
+    if (FLAGS_link_up_hold_ms <= 0) {
+      scheduleLinkUpUpdate(std::move(newBatch));
+      return;
+    }
+    backgroundEventBase_.runInEventBaseThread([this, newBatch]() {
+      backgroundEventBase_.runAfterDelay(
+          [this, newBatch]() { scheduleLinkUpUpdate(newBatch); },
+          FLAGS_link_up_hold_ms);
+    });
+    return;
+  }
 
+  // Link downs are not held back, as ECMP groups must shrink ASAP. A link
+  // up of the port still waiting is superseded by the link down. The batch
+  // is closed, as its update may be queued ahead of this one: a later link
+  // up of the port joining it would be undone by this link down.
+  {
+    auto pending = pendingLinkUps_.wlock();
+    if (pending->openBatch) {
+      pending->openBatch->ports.erase(portId);
+      pending->openBatch.reset();
+    }
+  }
+  // Schedule an update for port's operational status
+  auto updateOperStateFn = [=](const std::shared_ptr<SwitchState>& state) {
+    std::shared_ptr<SwitchState> newState(state);
+    updatePortOperState(&newState, portId, up, iPhyFaultStatus);
     return newState;
   };
   updateStateNoCoalescing(
       "Port OperState Update", std::move(updateOperStateFn));
 }
 
+void SwSwitch::scheduleLinkUpUpdate(std::shared_ptr<LinkUpBatch> batch) {
+  auto updateOperStateFn =
+      [this, batch = std::move(batch)](
+          const std::shared_ptr<SwitchState>& state) {
+        return applyLinkUps(state, batch);
+      };
+  updateStateNoCoalescing(
+      "Port OperState Update: link up", std::move(updateOperStateFn));
+}
+
+std::shared_ptr<SwitchState> SwSwitch::applyLinkUps(
+    const std::shared_ptr<SwitchState>& state,
+    const std::shared_ptr<LinkUpBatch>& batch) {
+  LinkUpBatch linkUps;
+  {
+    // Link ups arriving from now on schedule another update
+    auto pending = pendingLinkUps_.wlock();
+    if (pending->openBatch == batch) {
+      pending->openBatch.reset();
+    }
+    std::swap(linkUps, *batch);
+  }
+  std::shared_ptr<SwitchState> newState(state);
+  for (const auto& [portId, iPhyFaultStatus] : linkUps.ports) {
+    updatePortOperState(&newState, portId, true, iPhyFaultStatus);
+  }
+  stats()->linkUpsApplied(linkUps.numEvents, linkUps.ports.size());
+  return newState;
+}
+
+void SwSwitch::updatePortOperState(
+    std::shared_ptr<SwitchState>* state,
+    PortID portId,
+    bool up,
+    const std::optional<phy::LinkFaultStatus>& iPhyFaultStatus) {
+  auto* port = (*state)->getPorts()->getPortIf(portId).get();
+  if (!port || port->isUp() == up) {
+    return;
+  }
+  XLOG(INFO) << "SW Link state changed: " << port->getName() << " ["
+             << (port->isUp() ? "UP" : "DOWN") << "->"
+             << (up ? "UP" : "DOWN") << "]";
+  port = port->modify(state);
+  port->setOperState(up);
+  if (iPhyFaultStatus) {
+    port->setIPhyLinkFaultStatus(*iPhyFaultStatus);
+  }
+  // Log event and update counters if there is a change
+  logLinkStateEvent(portId, up);
+  setPortStatusCounter(portId, up);
+  portStats(portId)->linkStateChange(up);
+}
+
 void SwSwitch::startThreads() {
   backgroundThread_.reset(new std::thread(
       [=] { this->threadLoop("fbossBgThread", &backgroundEventBase_); }));
@@ -1405,7 +1569,7 @@ void SwSwitch::stopThreads() {
   do {
     handlePendingUpdates();
     {
-      std::unique_lock guard(pendingUpdatesLock_);
+      auto guard = lockPendingUpdates();
       updatesDrained = pendingUpdates_.empty();
     }
   } while (!updatesDrained);
@@ -1738,10 +1902,24 @@ void SwSwitch::applyConfig(
           XLOG(WARN) << "Current platform doesn't have QsfpCache. "
                      << "No need to build TransceiverMap";
         }
+        // Unchanged config sections are only skipped relative to a config
+        // which was actually applied to the state, not before the first
+        // apply (e.g. after warmboot).
+        const cfg::SwitchConfig* prevConfig =
+            curConfigApplied_ ? &curConfig_ : nullptr;
         auto newState = rib_
             ? applyThriftConfig(
-                  originalState, &newConfig, getPlatform(), &routeUpdater)
-            : applyThriftConfig(originalState, &newConfig, getPlatform());
+                  originalState,
+                  &newConfig,
+                  getPlatform(),
+                  &routeUpdater,
+                  prevConfig)
+            : applyThriftConfig(
+                  originalState,
+                  &newConfig,
+                  getPlatform(),
+                  rib_.get(),
+                  prevConfig);
 
         if (newState && !isValidStateUpdate(StateDelta(state, newState))) {
           throw FbossError("Invalid config passed in, skipping");
@@ -1750,6 +1928,7 @@ void SwSwitch::applyConfig(
         // Update config cached in SwSwitch. Update this even if the config did
         // not change (as this might be during warmboot).
         curConfig_ = newConfig;
+        curConfigApplied_ = true;
         curConfigStr_ =
             apache::thrift::SimpleJSONSerializer::serialize<std::string>(
                 newConfig);
@@ -1809,6 +1988,7 @@ void SwSwitch::updateConfigAppliedInfo() {
              << (lockedConfigAppliedInfo->lastColdbootAppliedInMs()
                      ? *lockedConfigAppliedInfo->lastColdbootAppliedInMs()
                      : 0);
+  portStatusChangeTracker_->configApplied(*lockedConfigAppliedInfo);
 }
 
 bool SwSwitch::isValidStateUpdate(const StateDelta& delta) const {
@@ -12,6 +12,8 @@
 #include "fboss/agent/HwSwitch.h"
 #include "fboss/agent/PacketObserver.h"
 #include "fboss/agent/RestartTimeTracker.h"
+#include "fboss/agent/RouteProgrammingLatency.h"
+#include "fboss/agent/StateUpdateProfiler.h"
 #include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
 #include "fboss/agent/ThreadHeartbeat.h"
 #include "fboss/agent/Utils.h"
@@ -26,12 +28,14 @@
 #include <folly/IntrusiveList.h>
 #include <folly/Range.h>
 #include <folly/SpinLock.h>
+#include <folly/Synchronized.h>
 #include <folly/ThreadLocal.h>
 #include <folly/io/async/EventBase.h>
 #include <optional>
 
 #include <atomic>
 #include <chrono>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -65,6 +69,8 @@ class MirrorManager;
 template <size_t interval>
 class PhySnapshotManager;
 class AclNexthopHandler;
+class PortStatusChangeTracker;
+class SwitchStateChangePublisher;
 class LookupClassUpdater;
 class LookupClassRouteUpdater;
 class MacTableManager;
@@ -289,6 +295,20 @@ class SwSwitch : public HwSwitch::Callback {
       folly::StringPiece name,
       StateUpdateFn fn);
 
+  /*
+   * Names of the state updates waiting to be applied, oldest first, with
+   * how long each has been waiting
+   */
+  std::vector<std::pair<std::string, std::chrono::microseconds>>
+  getPendingUpdates();
+
+  /*
+   * Per update name queue wait and apply times of the updates applied so far
+   */
+  std::vector<StateUpdateProfiler::Profile> getStateUpdateProfiles() const {
+    return stateUpdateProfiler_.getProfiles();
+  }
+
   /**
    * Apply config from the config file (specified in 'config' flag).
    *
@@ -413,6 +433,11 @@ class SwSwitch : public HwSwitch::Callback {
    */
   PortStatus getPortStatus(PortID port);
 
+  /*
+   * Get PortStatus of the given port, e.g. one from a StateDelta.
+   */
+  PortStatus getPortStatus(const Port& port) const;
+
   /*
    * Get Product Information.
    */
@@ -623,6 +648,21 @@ class SwSwitch : public HwSwitch::Callback {
     return routeUpdateLogger_.get();
   }
 
+  /*
+   * Get the per stage route programming latencies
+   */
+  const RouteProgrammingLatency* getRouteProgrammingLatency() const {
+    return routeProgrammingLatency_.get();
+  }
+
+  /*
+   * Record the time a route update spent in one stage of programming, in
+   * both the fb303 histograms and getRouteProgrammingLatency()
+   */
+  void routeProgrammingStage(
+      RouteProgrammingStage stage,
+      std::chrono::microseconds us);
+
   LinkAggregationManager* getLagManager() {
     return lagManager_.get();
   }
@@ -635,6 +675,14 @@ class SwSwitch : public HwSwitch::Callback {
     return lookupClassUpdater_.get();
   }
 
+  PortStatusChangeTracker* getPortStatusChangeTracker() {
+    return portStatusChangeTracker_.get();
+  }
+
+  SwitchStateChangePublisher* getStateChangePublisher() {
+    return stateChangePublisher_.get();
+  }
+
   LookupClassRouteUpdater* getLookupClassRouteUpdater() {
     return lookupClassRouteUpdater_.get();
   }
@@ -797,6 +845,8 @@ class SwSwitch : public HwSwitch::Callback {
   void updatePtpTcCounter();
   static void handlePendingUpdatesHelper(SwSwitch* sw);
   void handlePendingUpdates();
+  // Lock pendingUpdatesLock_, counting the times it was contended
+  std::unique_lock<folly::SpinLock> lockPendingUpdates();
   std::shared_ptr<SwitchState> applyUpdate(
       const std::shared_ptr<SwitchState>& oldState,
       const std::shared_ptr<SwitchState>& newState,
@@ -830,6 +880,33 @@ class SwSwitch : public HwSwitch::Callback {
 
   void logLinkStateEvent(PortID port, bool up);
 
+  /*
+   * Link ups waiting for their state update. Link ups which arrive within
+   * --link_up_hold_ms of the first one, or while its update is queued, are
+   * applied by the same update, so that e.g. a line card coming back
+   * rewrites each ECMP group once rather than once per port.
+   *
+   * A link down closes the open batch, so that link ups after it are
+   * applied by an update queued after the link down.
+   */
+  struct LinkUpBatch {
+    std::map<PortID, std::optional<phy::LinkFaultStatus>> ports;
+    uint64_t numEvents{0};
+  };
+  struct PendingLinkUps {
+    // Batch new link ups join, null once applied or closed
+    std::shared_ptr<LinkUpBatch> openBatch;
+  };
+  void scheduleLinkUpUpdate(std::shared_ptr<LinkUpBatch> batch);
+  std::shared_ptr<SwitchState> applyLinkUps(
+      const std::shared_ptr<SwitchState>& state,
+      const std::shared_ptr<LinkUpBatch>& batch);
+  void updatePortOperState(
+      std::shared_ptr<SwitchState>* state,
+      PortID portId,
+      bool up,
+      const std::optional<phy::LinkFaultStatus>& iPhyFaultStatus);
+
   void logSwitchRunStateChange(
       SwitchRunState oldState,
       SwitchRunState newState);
@@ -843,6 +920,8 @@ class SwSwitch : public HwSwitch::Callback {
 
   std::string curConfigStr_;
   cfg::SwitchConfig curConfig_;
+  // Whether curConfig_ has been applied to the state since startup
+  bool curConfigApplied_{false};
 
   // The HwSwitch object.  This object is owned by the Platform.
   HwSwitch* hw_;
@@ -860,6 +939,9 @@ class SwSwitch : public HwSwitch::Callback {
    */
   folly::SpinLock pendingUpdatesLock_;
   StateUpdateList pendingUpdates_;
+  // Size of pendingUpdates_, whose size() is linear
+  size_t numPendingUpdates_{0};
+  StateUpdateProfiler stateUpdateProfiler_;
 
   /*
    * The current switch state represented as :  appliedState,
@@ -953,6 +1035,7 @@ class SwSwitch : public HwSwitch::Callback {
   std::unique_ptr<MPLSHandler> mplsHandler_;
   std::unique_ptr<PacketLogger> packetLogger_;
   std::unique_ptr<RouteUpdateLogger> routeUpdateLogger_;
+  std::unique_ptr<RouteProgrammingLatency> routeProgrammingLatency_;
   std::unique_ptr<LinkAggregationManager> lagManager_;
   std::unique_ptr<ResolvedNexthopMonitor> resolvedNexthopMonitor_;
   std::unique_ptr<ResolvedNexthopProbeScheduler> resolvedNexthopProbeScheduler_;
@@ -976,9 +1059,12 @@ class SwSwitch : public HwSwitch::Callback {
   std::unique_ptr<PhySnapshotManager<kIphySnapshotIntervalSeconds>>
       phySnapshotManager_;
   std::unique_ptr<AclNexthopHandler> aclNexthopHandler_;
+  std::unique_ptr<PortStatusChangeTracker> portStatusChangeTracker_;
+  std::unique_ptr<SwitchStateChangePublisher> stateChangePublisher_;
   std::unique_ptr<FsdbSyncer> fsdbSyncer_;
 
   folly::Synchronized<ConfigAppliedInfo> configAppliedInfo_;
+  folly::Synchronized<PendingLinkUps> pendingLinkUps_;
   std::optional<std::chrono::time_point<std::chrono::steady_clock>>
       publishedStatsToFsdbAt_;
 };
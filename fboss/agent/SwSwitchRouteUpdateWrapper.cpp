@@ -10,6 +10,7 @@
 
 #include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
 
+#include "fboss/agent/RouteUpdateLogger.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/Utils.h"
@@ -17,6 +18,7 @@
 
 #include "fboss/agent/state/SwitchState.h"
 
+#include <chrono>
 #include <memory>
 
 namespace facebook::fboss {
@@ -31,7 +33,27 @@ std::shared_ptr<SwitchState> swSwitchFibUpdate(
       vrf, v4NetworkToRoute, v6NetworkToRoute, labelToRoute);
 
   auto sw = static_cast<facebook::fboss::SwSwitch*>(cookie);
-  sw->updateStateWithHwFailureProtection("", std::move(fibUpdater));
+  auto ribTime = RouteEvent::Clock::now();
+  auto enqueueTime = std::chrono::steady_clock::now();
+  sw->updateStateWithHwFailureProtection(
+      "",
+      [sw, ribTime, enqueueTime, fibUpdater = std::move(fibUpdater)](
+          const std::shared_ptr<SwitchState>& state) mutable {
+        auto start = std::chrono::steady_clock::now();
+        auto newState = fibUpdater(state);
+        auto end = std::chrono::steady_clock::now();
+        sw->routeProgrammingStage(
+            RouteProgrammingStage::UPDATE_QUEUE,
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                start - enqueueTime));
+        sw->routeProgrammingStage(
+            RouteProgrammingStage::FIB_UPDATE,
+            std::chrono::duration_cast<std::chrono::microseconds>(end - start));
+        if (newState) {
+          sw->getRouteUpdateLogger()->fibUpdated(*newState, ribTime);
+        }
+        return newState;
+      });
   return sw->getState();
 }
 
@@ -50,6 +72,8 @@ void SwSwitchRouteUpdateWrapper::updateStats(
   sw_->stats()->addRoutesV6(stats.v6RoutesAdded);
   sw_->stats()->delRoutesV4(stats.v4RoutesDeleted);
   sw_->stats()->delRoutesV6(stats.v6RoutesDeleted);
+  sw_->routeProgrammingStage(
+      RouteProgrammingStage::RIB_RESOLUTION, stats.ribResolutionDuration);
 }
 
 AdminDistance SwSwitchRouteUpdateWrapper::clientIdToAdminDistance(
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/SwitchStateChangePublisher.h"
+
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/state/StateDelta.h"
+#include "fboss/agent/state/SwitchState.h"
+
+#include <folly/logging/xlog.h>
+
+#include <algorithm>
+
+namespace facebook::fboss {
+
+folly::coro::Task<std::shared_ptr<SwitchState>>
+SwitchStateChangePublisher::Subscription::next() {
+  while (true) {
+    co_await newState_;
+    newState_.reset();
+    if (stopped_.load()) {
+      co_return nullptr;
+    }
+    // A publish() racing with the reset above leaves the baton posted with
+    // nothing pending, hence the loop
+    if (auto state = pendingState_.exchange(nullptr)) {
+      co_return state;
+    }
+  }
+}
+
+void SwitchStateChangePublisher::Subscription::publish(
+    std::shared_ptr<SwitchState> state) {
+  // Replaces the pending state if the subscriber did not get to it yet
+  pendingState_.exchange(std::move(state));
+  newState_.post();
+}
+
+void SwitchStateChangePublisher::Subscription::stop() {
+  stopped_.store(true);
+  newState_.post();
+}
+
+SwitchStateChangePublisher::SwitchStateChangePublisher(SwSwitch* sw)
+    : sw_(sw) {
+  // Observers get the initial state as a delta from an empty one
+  subscriptions_.wlock()->state = std::make_shared<SwitchState>();
+  sw_->registerStateObserver(this, "SwitchStateChangePublisher");
+}
+
+SwitchStateChangePublisher::~SwitchStateChangePublisher() {
+  sw_->unregisterStateObserver(this);
+  stop();
+}
+
+void SwitchStateChangePublisher::stateUpdated(const StateDelta& delta) {
+  auto locked = subscriptions_.wlock();
+  locked->state = delta.newState();
+  auto& subscriptions = locked->subscriptions;
+  subscriptions.erase(
+      std::remove_if(
+          subscriptions.begin(),
+          subscriptions.end(),
+          [&](const auto& weakSubscription) {
+            auto subscription = weakSubscription.lock();
+            if (!subscription) {
+              return true;
+            }
+            subscription->publish(locked->state);
+            return false;
+          }),
+      subscriptions.end());
+}
+
+std::shared_ptr<SwitchStateChangePublisher::Subscription>
+SwitchStateChangePublisher::subscribe() {
+  auto subscription = std::make_shared<Subscription>();
+  auto locked = subscriptions_.wlock();
+  if (locked->stopped) {
+    subscription->stop();
+  } else {
+    // Take the state under the same lock as stateUpdated() so that no
+    // update is missed or applied twice on top of this snapshot
+    subscription->publish(locked->state);
+    locked->subscriptions.push_back(subscription);
+  }
+  XLOG(DBG2) << "New switch state subscription, "
+             << locked->subscriptions.size() << " subscriptions";
+  return subscription;
+}
+
+void SwitchStateChangePublisher::stop() {
+  auto locked = subscriptions_.wlock();
+  locked->stopped = true;
+  for (const auto& weakSubscription : locked->subscriptions) {
+    if (auto subscription = weakSubscription.lock()) {
+      subscription->stop();
+    }
+  }
+  locked->subscriptions.clear();
+}
+
+size_t SwitchStateChangePublisher::numSubscriptions() const {
+  auto locked = subscriptions_.rlock();
+  return std::count_if(
+      locked->subscriptions.begin(),
+      locked->subscriptions.end(),
+      [](const auto& subscription) { return !subscription.expired(); });
+}
+
+} // namespace facebook::fboss
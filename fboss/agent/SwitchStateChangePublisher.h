@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/StateObserver.h"
+
+#include <folly/Synchronized.h>
+#include <folly/experimental/coro/Baton.h>
+#include <folly/experimental/coro/Task.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace facebook::fboss {
+class SwSwitch;
+class SwitchState;
+
+/*
+ * Hands out new SwitchState versions to the thrift change streams
+ * (subscribeToSwitchStateChanges).
+ *
+ * A subscription only holds on to the newest state it has not consumed yet,
+ * never a queue of them: a subscriber which falls behind diffs the state it
+ * last sent against whatever is newest when it catches up, so back to back
+ * updates coalesce into a single delta and a slow client costs at most one
+ * extra SwitchState.
+ */
+class SwitchStateChangePublisher : public StateObserver {
+ public:
+  class Subscription {
+   public:
+    /*
+     * Wait for a state newer than the one previously returned. The first call
+     * returns the latest state right away. Returns nullptr once the publisher
+     * is stopped.
+     */
+    folly::coro::Task<std::shared_ptr<SwitchState>> next();
+
+   private:
+    friend class SwitchStateChangePublisher;
+
+    void publish(std::shared_ptr<SwitchState> state);
+    void stop();
+
+    folly::coro::Baton newState_;
+    folly::Synchronized<std::shared_ptr<SwitchState>> pendingState_;
+    std::atomic<bool> stopped_{false};
+  };
+
+  explicit SwitchStateChangePublisher(SwSwitch* sw);
+  ~SwitchStateChangePublisher() override;
+
+  void stateUpdated(const StateDelta& delta) override;
+
+  std::shared_ptr<Subscription> subscribe();
+
+  // Wake up all the subscriptions and end them
+  void stop();
+
+  size_t numSubscriptions() const;
+
+ private:
+  struct Subscriptions {
+    // Last state we were notified of
+    std::shared_ptr<SwitchState> state;
+    std::vector<std::weak_ptr<Subscription>> subscriptions;
+    bool stopped{false};
+  };
+
+  SwSwitch* sw_;
+  folly::Synchronized<Subscriptions> subscriptions_;
+};
+
+} // namespace facebook::fboss
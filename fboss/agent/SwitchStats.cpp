@@ -80,7 +80,90 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
           SUM,
           RATE),
       updateState_(map, kCounterPrefix + "state_update.us", 50000, 0, 1000000),
+      stateUpdateQueueWait_(
+          map,
+          kCounterPrefix + "state_update.queue_wait.us",
+          50000,
+          0,
+          1000000),
+      stateUpdatesCoalesced_(
+          map,
+          kCounterPrefix + "state_update.coalesced",
+          1,
+          0,
+          20),
+      stateUpdateQueueDepth_(
+          map,
+          kCounterPrefix + "state_update.queue_depth",
+          10,
+          0,
+          200),
+      pendingUpdatesLockContended_(
+          map,
+          kCounterPrefix + "state_update.lock_contended",
+          SUM,
+          RATE),
+      pendingUpdatesLockWait_(
+          map,
+          kCounterPrefix + "state_update.lock_wait.us",
+          10,
+          0,
+          1000),
       routeUpdate_(map, kCounterPrefix + "route_update.us", 50, 0, 500),
+      routeRibResolution_(
+          map,
+          kCounterPrefix + "route_update.rib_resolution.us",
+          50000,
+          0,
+          1000000),
+      routeFibUpdate_(
+          map,
+          kCounterPrefix + "route_update.fib_update.us",
+          50000,
+          0,
+          1000000),
+      routeUpdateQueue_(
+          map,
+          kCounterPrefix + "route_update.update_queue.us",
+          50000,
+          0,
+          1000000),
+      routeHwProgramming_(
+          map,
+          kCounterPrefix + "route_update.hw_programming.us",
+          50000,
+          0,
+          1000000),
+      routeStateObservers_(
+          map,
+          kCounterPrefix + "route_update.state_observers.us",
+          50000,
+          0,
+          1000000),
+      l2LearningEvents_(map, kCounterPrefix + "l2_learning.events", SUM, RATE),
+      l2LearningEventsSuppressed_(
+          map,
+          kCounterPrefix + "l2_learning.suppressed",
+          SUM,
+          RATE),
+      l2LearningBatchSize_(
+          map,
+          kCounterPrefix + "l2_learning.batch_size",
+          100,
+          0,
+          10000),
+      linkUpEvents_(map, kCounterPrefix + "link_up.events", SUM, RATE),
+      linkUpEventsSuppressed_(
+          map,
+          kCounterPrefix + "link_up.suppressed",
+          SUM,
+          RATE),
+      linkUpBatchSize_(
+          map,
+          kCounterPrefix + "link_up.batch_size",
+          1,
+          0,
+          1000),
       bgHeartbeatDelay_(
           map,
           kCounterPrefix + "bg_heartbeat_delay.ms",
@@ -231,6 +314,28 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
           kCounterPrefix + "thread_heartbeat_miss",
           SUM) {}
 
+void SwitchStats::routeProgrammingStage(
+    RouteProgrammingStage stage,
+    std::chrono::microseconds us) {
+  switch (stage) {
+    case RouteProgrammingStage::RIB_RESOLUTION:
+      routeRibResolution_.addValue(us.count());
+      break;
+    case RouteProgrammingStage::FIB_UPDATE:
+      routeFibUpdate_.addValue(us.count());
+      break;
+    case RouteProgrammingStage::UPDATE_QUEUE:
+      routeUpdateQueue_.addValue(us.count());
+      break;
+    case RouteProgrammingStage::HW_PROGRAMMING:
+      routeHwProgramming_.addValue(us.count());
+      break;
+    case RouteProgrammingStage::STATE_OBSERVERS:
+      routeStateObservers_.addValue(us.count());
+      break;
+  }
+}
+
 PortStats* FOLLY_NULLABLE SwitchStats::port(PortID portID) {
   auto it = ports_.find(portID);
   if (it != ports_.end()) {
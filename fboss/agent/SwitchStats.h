@@ -16,6 +16,7 @@
 #include "fboss/agent/AggregatePortStats.h"
 #include "fboss/agent/InterfaceStats.h"
 #include "fboss/agent/PortStats.h"
+#include "fboss/agent/RouteProgrammingLatency.h"
 #include "fboss/agent/gen-cpp2/agent_stats_types.h"
 #include "fboss/agent/types.h"
 
@@ -248,6 +249,20 @@ class SwitchStats : public boost::noncopyable {
     updateState_.addValue(us.count());
   }
 
+  void stateUpdateQueueWait(std::chrono::microseconds us) {
+    stateUpdateQueueWait_.addValue(us.count());
+  }
+
+  void stateUpdatesDequeued(uint64_t dequeued, uint64_t queueDepth) {
+    stateUpdatesCoalesced_.addValue(dequeued);
+    stateUpdateQueueDepth_.addValue(queueDepth);
+  }
+
+  void pendingUpdatesLockContended(std::chrono::microseconds wait) {
+    pendingUpdatesLockContended_.addValue(1);
+    pendingUpdatesLockWait_.addValue(wait.count());
+  }
+
   void routeUpdate(std::chrono::microseconds us, uint64_t routes) {
     // As syncFib() could include no routes.
     if (routes == 0) {
@@ -257,6 +272,22 @@ class SwitchStats : public boost::noncopyable {
     routeUpdate_.addRepeatedValue(us.count() / routes, routes);
   }
 
+  void routeProgrammingStage(
+      RouteProgrammingStage stage,
+      std::chrono::microseconds us);
+
+  void l2LearningUpdatesApplied(uint64_t events, uint64_t entries) {
+    l2LearningEvents_.addValue(events);
+    l2LearningEventsSuppressed_.addValue(events - entries);
+    l2LearningBatchSize_.addValue(events);
+  }
+
+  void linkUpsApplied(uint64_t events, uint64_t ports) {
+    linkUpEvents_.addValue(events);
+    linkUpEventsSuppressed_.addValue(events - ports);
+    linkUpBatchSize_.addValue(ports);
+  }
+
   void bgHeartbeatDelay(int delay) {
     bgHeartbeatDelay_.addValue(delay);
   }
@@ -476,11 +507,63 @@ class SwitchStats : public boost::noncopyable {
    */
   TLHistogram updateState_;
 
+  /**
+   * Histogram for time state updates wait in the update queue (in
+   * microsecond)
+   */
+  TLHistogram stateUpdateQueueWait_;
+
+  /**
+   * Histogram for the number of state updates applied together
+   */
+  TLHistogram stateUpdatesCoalesced_;
+
+  /**
+   * Histogram for the number of queued state updates when the update thread
+   * takes its next batch
+   */
+  TLHistogram stateUpdateQueueDepth_;
+
+  /**
+   * Times the pending state update lock was already held, and the time
+   * spent waiting for it (in microsecond)
+   */
+  TLTimeseries pendingUpdatesLockContended_;
+  TLHistogram pendingUpdatesLockWait_;
+
   /**
    * Histogram for time used for route update (in microsecond)
    */
   TLHistogram routeUpdate_;
 
+  /**
+   * Histograms for time spent in each stage of route programming, see
+   * RouteProgrammingStage (in microsecond)
+   */
+  TLHistogram routeRibResolution_;
+  TLHistogram routeFibUpdate_;
+  TLHistogram routeUpdateQueue_;
+  TLHistogram routeHwProgramming_;
+  TLHistogram routeStateObservers_;
+
+  /**
+   * L2 learn and age events from the hardware, the events superseded by a
+   * later event for the same MAC before being applied, and the number of
+   * events applied by each state update
+   */
+  TLTimeseries l2LearningEvents_;
+  TLTimeseries l2LearningEventsSuppressed_;
+  TLHistogram l2LearningBatchSize_;
+
+  /**
+   * Link up events from the hardware, the events superseded by a later
+   * event for the same port before being applied, and the number of ports
+   * brought up by each state update
+   */
+  TLTimeseries linkUpEvents_;
+  TLTimeseries linkUpEventsSuppressed_;
+  TLHistogram linkUpBatchSize_;
+
   /**
    * Background thread heartbeat delay (ms)
    */
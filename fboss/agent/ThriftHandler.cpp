@@ -19,9 +19,12 @@
 #include "fboss/agent/LinkAggregationManager.h"
 #include "fboss/agent/LldpManager.h"
 #include "fboss/agent/NeighborUpdater.h"
+#include "fboss/agent/PortStatusChangeTracker.h"
+#include "fboss/agent/RouteProgrammingLatency.h"
 #include "fboss/agent/RouteUpdateLogger.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
+#include "fboss/agent/SwitchStateChangePublisher.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/TxPacket.h"
 #include "fboss/agent/Utils.h"
@@ -41,11 +44,14 @@
 #include "fboss/agent/state/Interface.h"
 #include "fboss/agent/state/InterfaceMap.h"
 #include "fboss/agent/state/LabelForwardingEntry.h"
+#include "fboss/agent/state/MacEntry.h"
+#include "fboss/agent/state/MacTable.h"
 #include "fboss/agent/state/NdpEntry.h"
 #include "fboss/agent/state/NdpTable.h"
 #include "fboss/agent/state/Port.h"
 #include "fboss/agent/state/PortQueue.h"
 #include "fboss/agent/state/Route.h"
+#include "fboss/agent/state/StateDelta.h"
 #include "fboss/agent/state/StateUtils.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/state/Transceiver.h"
@@ -60,6 +66,8 @@
 #include <folly/MoveWrapper.h>
 #include <folly/Range.h>
 #include <folly/container/F14Map.h>
+#include <folly/experimental/coro/AsyncGenerator.h>
+#include <folly/experimental/coro/Invoke.h>
 #include <folly/functional/Partial.h>
 #include <folly/io/Cursor.h>
 #include <folly/io/IOBuf.h>
@@ -67,7 +75,9 @@
 #include <folly/logging/xlog.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 #include <thrift/lib/cpp2/async/DuplexChannel.h>
+#include <algorithm>
 #include <memory>
+#include <set>
 
 #include <limits>
 
@@ -103,6 +113,23 @@ DEFINE_bool(
     false,
     "Allow external mutations of running config");
 
+DEFINE_int32(
+    max_route_table_page_size,
+    10000,
+    "Max number of routes returned by one paginated route table call, and "
+    "converted at a time by the streaming ones");
+
+DEFINE_int32(
+    max_state_changes_per_message,
+    1000,
+    "Max number of changes sent in one subscribeToSwitchStateChanges() "
+    "message, larger snapshots and updates are split across messages");
+
+DEFINE_int32(
+    max_port_status_wait_ms,
+    20000,
+    "Max time a waitForPortStatusChanges() call may wait for changes");
+
 namespace facebook::fboss {
 
 namespace util {
@@ -536,6 +563,297 @@ PortLoopbackMode toThriftLoopbackMode(cfg::PortLoopbackMode mode) {
   }
   throw FbossError("Bogus loopback mode: ", mode);
 }
+
+folly::CIDRNetwork toCidrNetwork(const IpPrefix& prefix) {
+  auto ip = toIPAddress(*prefix.ip());
+  if (*prefix.prefixLength() < 0 || *prefix.prefixLength() > ip.bitCount()) {
+    throw FbossError("Invalid prefix length: ", *prefix.prefixLength());
+  }
+  return {ip, static_cast<uint8_t>(*prefix.prefixLength())};
+}
+
+template <typename RouteT>
+std::optional<UnicastRoute> toResolvedUnicastRoute(
+    const std::shared_ptr<RouteT>& route) {
+  if (!route->isResolved()) {
+    return std::nullopt;
+  }
+  UnicastRoute unicastRoute;
+  auto fwdInfo = route->getForwardInfo();
+  unicastRoute.dest()->ip() = toBinaryAddress(route->prefix().network);
+  unicastRoute.dest()->prefixLength() = route->prefix().mask;
+  unicastRoute.nextHopAddrs() = util::fromFwdNextHops(fwdInfo.getNextHopSet());
+  unicastRoute.nextHops() =
+      util::fromRouteNextHopSet(fwdInfo.normalizedNextHops());
+  if (fwdInfo.getCounterID().has_value()) {
+    unicastRoute.counterID() = *fwdInfo.getCounterID();
+  }
+  return unicastRoute;
+}
+
+template <typename RouteT>
+std::optional<UnicastRoute> toClientUnicastRoute(
+    const std::shared_ptr<RouteT>& route,
+    ClientID client) {
+  auto entry = route->getEntryForClient(client);
+  if (not entry) {
+    return std::nullopt;
+  }
+  UnicastRoute unicastRoute;
+  unicastRoute.dest()->ip() = toBinaryAddress(route->prefix().network);
+  unicastRoute.dest()->prefixLength() = route->prefix().mask;
+  unicastRoute.nextHops() = util::fromRouteNextHopSet(entry->getNextHopSet());
+  if (entry->getCounterID().has_value()) {
+    unicastRoute.counterID() = *entry->getCounterID();
+  }
+  for (const auto& nh : *unicastRoute.nextHops()) {
+    unicastRoute.nextHopAddrs()->emplace_back(*nh.address());
+  }
+  return unicastRoute;
+}
+
+/*
+ * Fill page with up to request.maxRoutes routes after request.cursor, as
+ * converted by convert(route). Routes for which convert() returns nullopt are
+ * skipped.
+ */
+template <typename PageT, typename ConvertFn>
+void fillRouteTablePage(
+    const std::shared_ptr<SwitchState>& state,
+    const RouteTableRequest& request,
+    PageT& page,
+    ConvertFn& convert) {
+  size_t maxRoutes =
+      std::clamp(*request.maxRoutes(), 1, FLAGS_max_route_table_page_size);
+  std::optional<RouteCursor> after;
+  if (auto cursor = request.cursor()) {
+    after = RouteCursor{
+        RouterID(*cursor->vrf()), toCidrNetwork(*cursor->prefix())};
+  }
+  std::optional<folly::CIDRNetwork> filter;
+  if (auto prefixFilter = request.prefixFilter()) {
+    filter = toCidrNetwork(*prefixFilter);
+  }
+
+  std::optional<RouteCursor> lastVisited;
+  forAllRoutesAfter(
+      state, after, filter, [&](RouterID rid, const auto& route) {
+        if (page.routes()->size() == maxRoutes) {
+          // Page is full, resume from the last route we visited
+          RouteTableCursor nextCursor;
+          nextCursor.vrf() = lastVisited->rid;
+          nextCursor.prefix() = toIpPrefix(lastVisited->prefix);
+          page.nextCursor() = std::move(nextCursor);
+          return false;
+        }
+        lastVisited = RouteCursor{rid, route->prefix().toCidrNetwork()};
+        if (auto converted = convert(route)) {
+          page.routes()->push_back(std::move(*converted));
+        }
+        return true;
+      });
+}
+
+/*
+ * Stream the routes of state, converting one page of routes at a time as the
+ * client consumes them.
+ */
+template <typename T, typename PageT, typename ConvertFn>
+apache::thrift::ServerStream<T> streamRouteTablePages(
+    std::shared_ptr<SwitchState> state,
+    ConvertFn convert) {
+  return folly::coro::co_invoke(
+      [state = std::move(state), convert = std::move(convert)]() mutable
+      -> folly::coro::AsyncGenerator<T&&> {
+        RouteTableRequest request;
+        request.maxRoutes() = FLAGS_max_route_table_page_size;
+        while (true) {
+          PageT page;
+          fillRouteTablePage(state, request, page, convert);
+          for (auto& route : *page.routes()) {
+            co_yield std::move(route);
+          }
+          if (!page.nextCursor()) {
+            co_return;
+          }
+          request.cursor() = std::move(*page.nextCursor());
+        }
+      });
+}
+
+// A change to one switch state entry, converted to thrift when called
+using SwitchStateChangeFn = folly::Function<SwitchStateChange()>;
+
+template <typename NodeT, typename ConvertFn>
+SwitchStateChangeFn makeSwitchStateChange(
+    SwitchStateChangeType type,
+    std::shared_ptr<NodeT> node,
+    const ConvertFn& convert) {
+  return [type, node = std::move(node), convert]() {
+    SwitchStateChange change;
+    change.type() = type;
+    change.entry() = convert(node, type);
+    return change;
+  };
+}
+
+template <typename MapDelta, typename ConvertFn>
+void collectNodeMapChanges(
+    const MapDelta& mapDelta,
+    const ConvertFn& convert,
+    std::vector<SwitchStateChangeFn>& changes) {
+  for (const auto& nodeDelta : mapDelta) {
+    const auto& oldNode = nodeDelta.getOld();
+    const auto& newNode = nodeDelta.getNew();
+    if (!oldNode) {
+      changes.push_back(makeSwitchStateChange(
+          SwitchStateChangeType::ADDED, newNode, convert));
+    } else if (!newNode) {
+      changes.push_back(makeSwitchStateChange(
+          SwitchStateChangeType::REMOVED, oldNode, convert));
+    } else {
+      changes.push_back(makeSwitchStateChange(
+          SwitchStateChangeType::CHANGED, newNode, convert));
+    }
+  }
+}
+
+template <typename NeighborEntryThriftT, typename NeighborEntryT>
+NeighborEntryThriftT populateNeighborEntryThrift(
+    const NeighborEntryT& entry,
+    const Vlan& vlan) {
+  NeighborEntryThriftT entryThrift;
+  entryThrift.ip() = toBinaryAddress(entry.getIP());
+  entryThrift.mac() = entry.getMac().toString();
+  entryThrift.port() = entry.getPort().asThriftPort();
+  entryThrift.vlanName() = vlan.getName();
+  entryThrift.vlanID() = vlan.getID();
+  entryThrift.state() = entry.isPending() ? "PENDING" : "REACHABLE";
+  entryThrift.classID() = entry.getClassID().has_value()
+      ? static_cast<int>(entry.getClassID().value())
+      : 0;
+  return entryThrift;
+}
+
+L2EntryThrift populateL2EntryThrift(const MacEntry& entry, VlanID vlanID) {
+  L2EntryThrift l2Entry;
+  l2Entry.mac() = entry.getMac().toString();
+  l2Entry.vlanID() = vlanID;
+  if (entry.getPort().isAggregatePort()) {
+    l2Entry.port() = 0;
+    l2Entry.trunk() = entry.getPort().aggPortID();
+  } else {
+    l2Entry.port() = entry.getPort().phyPortID();
+  }
+  // Only entries which were learnt make it to the switch state
+  l2Entry.l2EntryType() = L2EntryType::L2_ENTRY_TYPE_VALIDATED;
+  if (auto classID = entry.getClassID()) {
+    l2Entry.classID() = static_cast<int>(classID.value());
+  }
+  return l2Entry;
+}
+
+/*
+ * Changes of delta to the given subtrees. Entries are only converted to
+ * thrift as the returned changes are called, so that a large delta (e.g. the
+ * initial snapshot) can be sent a few changes at a time.
+ */
+std::vector<SwitchStateChangeFn> collectSwitchStateChanges(
+    const SwSwitch* sw,
+    const StateDelta& delta,
+    const std::set<SwitchStateSubtree>& subtrees) {
+  std::vector<SwitchStateChangeFn> changes;
+  auto subscribed = [&](SwitchStateSubtree subtree) {
+    return subtrees.find(subtree) != subtrees.end();
+  };
+
+  if (subscribed(SwitchStateSubtree::PORTS)) {
+    auto convertPort = [sw](
+                           const std::shared_ptr<Port>& port,
+                           SwitchStateChangeType type) {
+      PortInfoThrift portInfo;
+      if (type == SwitchStateChangeType::REMOVED) {
+        // The platform port may be gone with it
+        portInfo.portId() = port->getID();
+        portInfo.name() = port->getName();
+      } else {
+        getPortInfoHelper(*sw, portInfo, port);
+      }
+      SwitchStateEntry entry;
+      entry.port() = std::move(portInfo);
+      return entry;
+    };
+    collectNodeMapChanges(delta.getPortsDelta(), convertPort, changes);
+  }
+
+  if (subscribed(SwitchStateSubtree::ARP_TABLE) ||
+      subscribed(SwitchStateSubtree::NDP_TABLE) ||
+      subscribed(SwitchStateSubtree::L2_TABLE)) {
+    for (const auto& vlanDelta : delta.getVlansDelta()) {
+      auto vlan = vlanDelta.getNew() ? vlanDelta.getNew() : vlanDelta.getOld();
+      if (subscribed(SwitchStateSubtree::ARP_TABLE)) {
+        auto convertArp = [vlan](const auto& arpEntry, SwitchStateChangeType) {
+          SwitchStateEntry entry;
+          entry.arpEntry() =
+              populateNeighborEntryThrift<ArpEntryThrift>(*arpEntry, *vlan);
+          return entry;
+        };
+        collectNodeMapChanges(vlanDelta.getArpDelta(), convertArp, changes);
+      }
+      if (subscribed(SwitchStateSubtree::NDP_TABLE)) {
+        auto convertNdp = [vlan](const auto& ndpEntry, SwitchStateChangeType) {
+          SwitchStateEntry entry;
+          entry.ndpEntry() =
+              populateNeighborEntryThrift<NdpEntryThrift>(*ndpEntry, *vlan);
+          return entry;
+        };
+        collectNodeMapChanges(vlanDelta.getNdpDelta(), convertNdp, changes);
+      }
+      if (subscribed(SwitchStateSubtree::L2_TABLE)) {
+        auto convertMac = [vlanID = vlan->getID()](
+                              const auto& macEntry, SwitchStateChangeType) {
+          SwitchStateEntry entry;
+          entry.l2Entry() = populateL2EntryThrift(*macEntry, vlanID);
+          return entry;
+        };
+        collectNodeMapChanges(vlanDelta.getMacDelta(), convertMac, changes);
+      }
+    }
+  }
+
+  if (subscribed(SwitchStateSubtree::ACL_TABLE)) {
+    auto convertAcl = [](const auto& aclEntry, SwitchStateChangeType) {
+      SwitchStateEntry entry;
+      entry.aclEntry() = populateAclEntryThrift(*aclEntry);
+      return entry;
+    };
+    collectNodeMapChanges(delta.getAclsDelta(), convertAcl, changes);
+  }
+
+  if (subscribed(SwitchStateSubtree::ROUTE_TABLE)) {
+    auto convertRoute = [](const auto& route, SwitchStateChangeType) {
+      SwitchStateEntry entry;
+      entry.route() = route->toRouteDetails(true);
+      return entry;
+    };
+    forEachChangedRoute(
+        delta,
+        [&](RouterID /* rid */, const auto& /* oldRoute */, const auto& route) {
+          changes.push_back(makeSwitchStateChange(
+              SwitchStateChangeType::CHANGED, route, convertRoute));
+        },
+        [&](RouterID /* rid */, const auto& route) {
+          changes.push_back(makeSwitchStateChange(
+              SwitchStateChangeType::ADDED, route, convertRoute));
+        },
+        [&](RouterID /* rid */, const auto& route) {
+          changes.push_back(makeSwitchStateChange(
+              SwitchStateChangeType::REMOVED, route, convertRoute));
+        });
+  }
+  return changes;
+}
+
 } // namespace
 
 namespace facebook::fboss {
@@ -1099,6 +1417,32 @@ void ThriftHandler::patchCurrentStateJSON(
   sw_->updateStateBlocking("JSON patch", std::move(updateFn));
 }
 
+void ThriftHandler::getPendingStateUpdates(
+    std::vector<PendingStateUpdate>& pendingUpdates) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  for (const auto& [name, queued] : sw_->getPendingUpdates()) {
+    PendingStateUpdate pending;
+    *pending.name() = name;
+    *pending.queuedUs() = queued.count();
+    pendingUpdates.push_back(std::move(pending));
+  }
+}
+
+void ThriftHandler::getStateUpdateProfiles(
+    std::vector<StateUpdateProfile>& profiles) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  for (const auto& profile : sw_->getStateUpdateProfiles()) {
+    StateUpdateProfile profileThrift;
+    *profileThrift.name() = profile.name;
+    *profileThrift.count() = profile.count;
+    *profileThrift.totalQueueWaitUs() = profile.totalQueueWait.count();
+    *profileThrift.maxQueueWaitUs() = profile.maxQueueWait.count();
+    *profileThrift.totalApplyUs() = profile.totalApply.count();
+    *profileThrift.maxApplyUs() = profile.maxApply.count();
+    profiles.push_back(std::move(profileThrift));
+  }
+}
+
 void ThriftHandler::getPortStatusImpl(
     std::map<int32_t, PortStatus>& statusMap,
     const std::unique_ptr<std::vector<int32_t>>& ports) const {
@@ -1395,23 +1739,18 @@ void ThriftHandler::getRouteTable(std::vector<UnicastRoute>& routes) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
   auto state = sw_->getState();
-  forAllRoutes(state, [&routes](RouterID /*rid*/, const auto& route) {
-    UnicastRoute tempRoute;
-    if (!route->isResolved()) {
-      XLOG(INFO) << "Skipping unresolved route: " << route->toFollyDynamic();
-      return;
-    }
-    auto fwdInfo = route->getForwardInfo();
-    tempRoute.dest()->ip() = toBinaryAddress(route->prefix().network);
-    tempRoute.dest()->prefixLength() = route->prefix().mask;
-    tempRoute.nextHopAddrs() = util::fromFwdNextHops(fwdInfo.getNextHopSet());
-    tempRoute.nextHops() =
-        util::fromRouteNextHopSet(fwdInfo.normalizedNextHops());
-    if (fwdInfo.getCounterID().has_value()) {
-      tempRoute.counterID() = *fwdInfo.getCounterID();
-    }
-    routes.emplace_back(std::move(tempRoute));
-  });
+  int numUnresolved = 0;
+  forAllRoutes(
+      state, [&routes, &numUnresolved](RouterID /*rid*/, const auto& route) {
+        if (auto unicastRoute = toResolvedUnicastRoute(route)) {
+          routes.emplace_back(std::move(*unicastRoute));
+        } else {
+          XLOG(DBG3) << "Skipping unresolved route: " << route->str();
+          ++numUnresolved;
+        }
+      });
+  XLOG_IF(DBG2, numUnresolved > 0)
+      << "Skipped " << numUnresolved << " unresolved routes";
 }
 
 void ThriftHandler::getRouteTableByClient(
@@ -1421,21 +1760,9 @@ void ThriftHandler::getRouteTableByClient(
   ensureConfigured(__func__);
   auto state = sw_->getState();
   forAllRoutes(state, [&routes, client](RouterID /*rid*/, const auto& route) {
-    auto entry = route->getEntryForClient(ClientID(client));
-    if (not entry) {
-      return;
-    }
-    UnicastRoute tempRoute;
-    tempRoute.dest()->ip() = toBinaryAddress(route->prefix().network);
-    tempRoute.dest()->prefixLength() = route->prefix().mask;
-    tempRoute.nextHops() = util::fromRouteNextHopSet(entry->getNextHopSet());
-    if (entry->getCounterID().has_value()) {
-      tempRoute.counterID() = *entry->getCounterID();
-    }
-    for (const auto& nh : *tempRoute.nextHops()) {
-      tempRoute.nextHopAddrs()->emplace_back(*nh.address());
+    if (auto unicastRoute = toClientUnicastRoute(route, ClientID(client))) {
+      routes.emplace_back(std::move(*unicastRoute));
     }
-    routes.emplace_back(std::move(tempRoute));
   });
 }
 
@@ -1447,6 +1774,111 @@ void ThriftHandler::getRouteTableDetails(std::vector<RouteDetails>& routes) {
   });
 }
 
+void ThriftHandler::getRouteTablePage(
+    RouteTablePage& page,
+    std::unique_ptr<RouteTableRequest> request) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  auto convert = [](const auto& route) {
+    return toResolvedUnicastRoute(route);
+  };
+  fillRouteTablePage(sw_->getState(), *request, page, convert);
+}
+
+void ThriftHandler::getRouteTableByClientPage(
+    RouteTablePage& page,
+    int16_t client,
+    std::unique_ptr<RouteTableRequest> request) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  auto convert = [client](const auto& route) {
+    return toClientUnicastRoute(route, ClientID(client));
+  };
+  fillRouteTablePage(sw_->getState(), *request, page, convert);
+}
+
+void ThriftHandler::getRouteTableDetailsPage(
+    RouteDetailsPage& page,
+    std::unique_ptr<RouteTableRequest> request) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  auto convert = [](const auto& route) {
+    return std::make_optional(route->toRouteDetails(true));
+  };
+  fillRouteTablePage(sw_->getState(), *request, page, convert);
+}
+
+apache::thrift::ServerStream<UnicastRoute> ThriftHandler::streamRouteTable() {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  return streamRouteTablePages<UnicastRoute, RouteTablePage>(
+      sw_->getState(),
+      [](const auto& route) { return toResolvedUnicastRoute(route); });
+}
+
+apache::thrift::ServerStream<UnicastRoute>
+ThriftHandler::streamRouteTableByClient(int16_t client) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  return streamRouteTablePages<UnicastRoute, RouteTablePage>(
+      sw_->getState(), [client](const auto& route) {
+        return toClientUnicastRoute(route, ClientID(client));
+      });
+}
+
+apache::thrift::ServerStream<RouteDetails>
+ThriftHandler::streamRouteTableDetails() {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  return streamRouteTablePages<RouteDetails, RouteDetailsPage>(
+      sw_->getState(), [](const auto& route) {
+        return std::make_optional(route->toRouteDetails(true));
+      });
+}
+
+apache::thrift::ServerStream<SwitchStateChanges>
+ThriftHandler::subscribeToSwitchStateChanges(
+    std::unique_ptr<std::set<SwitchStateSubtree>> subtrees) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  if (subtrees->empty()) {
+    throw FbossError("No switch state subtree to subscribe to");
+  }
+  auto subscription = sw_->getStateChangePublisher()->subscribe();
+  return folly::coro::co_invoke(
+      [sw = sw_,
+       subtrees = std::move(*subtrees),
+       subscription = std::move(subscription)]() mutable
+      -> folly::coro::AsyncGenerator<SwitchStateChanges&&> {
+        size_t maxChanges = std::max(FLAGS_max_state_changes_per_message, 1);
+        // The first state we get is sent as a snapshot, i.e. a delta from an
+        // empty state. Every later one as a delta from the previous one we
+        // sent, which covers all the updates in between.
+        auto lastSent = std::make_shared<SwitchState>();
+        bool snapshot = true;
+        while (auto state = co_await subscription->next()) {
+          auto changes = collectSwitchStateChanges(
+              sw, StateDelta(lastSent, state), subtrees);
+          lastSent = std::move(state);
+          if (changes.empty() && !snapshot) {
+            continue;
+          }
+          size_t sent = 0;
+          do {
+            SwitchStateChanges message;
+            message.snapshot() = snapshot;
+            auto end = std::min(sent + maxChanges, changes.size());
+            for (; sent < end; ++sent) {
+              message.changes()->push_back(changes[sent]());
+            }
+            message.complete() = sent == changes.size();
+            co_yield std::move(message);
+          } while (sent < changes.size());
+          snapshot = false;
+        }
+      });
+}
+
 void ThriftHandler::getIpRoute(
     UnicastRoute& route,
     std::unique_ptr<Address> addr,
@@ -1614,8 +2046,15 @@ void ThriftHandler::startPktCapture(unique_ptr<CaptureInfo> info) {
   auto log = LOG_THRIFT_CALL(DBG1);
   ensureConfigured(__func__);
   auto* mgr = sw_->getCaptureMgr();
+  if (*info->snaplen() < 0) {
+    throw FbossError("Invalid capture snaplen ", *info->snaplen());
+  }
   auto capture = make_unique<PktCapture>(
-      *info->name(), *info->maxPackets(), *info->direction(), *info->filter());
+      *info->name(),
+      *info->maxPackets(),
+      *info->direction(),
+      *info->filter(),
+      *info->snaplen());
   mgr->startCapture(std::move(capture));
 }
 
@@ -1707,6 +2146,91 @@ void ThriftHandler::getRouteUpdateLoggingTrackedPrefixes(
   }
 }
 
+void ThriftHandler::getRouteEvents(
+    std::vector<RouteEventThrift>& events,
+    std::unique_ptr<std::vector<IpPrefix>> prefixes) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  std::set<std::pair<folly::IPAddress, uint8_t>> wanted;
+  for (const auto& prefix : *prefixes) {
+    wanted.emplace(
+        toIPAddress(*prefix.ip()),
+        static_cast<uint8_t>(*prefix.prefixLength()));
+  }
+  auto toUs = [](RouteEvent::Clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               time.time_since_epoch())
+        .count();
+  };
+  for (const auto& event : sw_->getRouteUpdateLogger()->getRouteEvents()) {
+    if (!wanted.empty() &&
+        wanted.find(std::make_pair(event.network, event.mask)) ==
+            wanted.end()) {
+      continue;
+    }
+    RouteEventThrift eventThrift;
+    *eventThrift.prefix()->ip() = toBinaryAddress(event.network);
+    *eventThrift.prefix()->prefixLength() = event.mask;
+    switch (event.type) {
+      case RouteEvent::Type::ADD:
+        *eventThrift.type() = RouteEventType::ADD;
+        break;
+      case RouteEvent::Type::CHANGE:
+        *eventThrift.type() = RouteEventType::CHANGE;
+        break;
+      case RouteEvent::Type::DELETE:
+        *eventThrift.type() = RouteEventType::DELETE;
+        break;
+    }
+    if (event.client) {
+      eventThrift.client() = *event.client;
+    }
+    *eventThrift.nexthopsHash() = event.nexthopsHash;
+    if (event.ribTime) {
+      eventThrift.ribTimeUs() = toUs(*event.ribTime);
+    }
+    if (event.switchStateTime) {
+      eventThrift.switchStateTimeUs() = toUs(*event.switchStateTime);
+    }
+    *eventThrift.hwTimeUs() = toUs(event.hwTime);
+    events.push_back(std::move(eventThrift));
+  }
+}
+
+void ThriftHandler::getRouteProgrammingLatencies(
+    std::vector<RouteProgrammingLatencyThrift>& latencies) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  for (const auto& latency :
+       sw_->getRouteProgrammingLatency()->getLatencies()) {
+    RouteProgrammingLatencyThrift latencyThrift;
+    switch (latency.stage) {
+      case RouteProgrammingStage::RIB_RESOLUTION:
+        *latencyThrift.stage() = RouteProgrammingStageType::RIB_RESOLUTION;
+        break;
+      case RouteProgrammingStage::FIB_UPDATE:
+        *latencyThrift.stage() = RouteProgrammingStageType::FIB_UPDATE;
+        break;
+      case RouteProgrammingStage::UPDATE_QUEUE:
+        *latencyThrift.stage() = RouteProgrammingStageType::UPDATE_QUEUE;
+        break;
+      case RouteProgrammingStage::HW_PROGRAMMING:
+        *latencyThrift.stage() = RouteProgrammingStageType::HW_PROGRAMMING;
+        break;
+      case RouteProgrammingStage::STATE_OBSERVERS:
+        *latencyThrift.stage() = RouteProgrammingStageType::STATE_OBSERVERS;
+        break;
+    }
+    *latencyThrift.count() = latency.count;
+    *latencyThrift.totalUs() = latency.total.count();
+    *latencyThrift.maxUs() = latency.max.count();
+    *latencyThrift.p50Us() = latency.p50.count();
+    *latencyThrift.p90Us() = latency.p90.count();
+    *latencyThrift.p99Us() = latency.p99.count();
+    latencies.push_back(std::move(latencyThrift));
+  }
+}
+
 void ThriftHandler::getMplsRouteUpdateLoggingTrackedLabels(
     std::vector<MplsRouteUpdateLoggingInfo>& infos) {
   auto log = LOG_THRIFT_CALL(DBG1);
@@ -1897,6 +2421,22 @@ void ThriftHandler::getConfigAppliedInfo(ConfigAppliedInfo& configAppliedInfo) {
   configAppliedInfo = sw_->getConfigAppliedInfo();
 }
 
+folly::SemiFuture<std::unique_ptr<PortStatusChanges>>
+ThriftHandler::semifuture_waitForPortStatusChanges(
+    int64_t sinceGeneration,
+    int32_t timeoutMs) {
+  auto log = LOG_THRIFT_CALL(DBG2);
+  ensureConfigured(__func__);
+  // Never hold on to a request longer than a client would wait for us
+  auto timeout = std::chrono::milliseconds(
+      std::clamp(timeoutMs, 0, FLAGS_max_port_status_wait_ms));
+  return sw_->getPortStatusChangeTracker()
+      ->waitForChanges(sinceGeneration, timeout)
+      .deferValue([](PortStatusChanges&& changes) {
+        return std::make_unique<PortStatusChanges>(std::move(changes));
+      });
+}
+
 void ThriftHandler::getLacpPartnerPair(
     LacpPartnerPair& lacpPartnerPair,
     int32_t portID) {
@@ -11,6 +11,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,7 @@
 #include <folly/Synchronized.h>
 #include <thrift/lib/cpp/server/TServerEventHandler.h>
 #include <thrift/lib/cpp2/async/DuplexChannel.h>
+#include <thrift/lib/cpp2/async/ServerStream.h>
 #include <thrift/lib/cpp2/server/ThriftServer.h>
 
 namespace facebook::fboss {
@@ -165,6 +167,24 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
       std::vector<UnicastRoute>& routeTable,
       int16_t clientId) override;
   void getRouteTableDetails(std::vector<RouteDetails>& routeTable) override;
+  void getRouteTablePage(
+      RouteTablePage& page,
+      std::unique_ptr<RouteTableRequest> request) override;
+  void getRouteTableByClientPage(
+      RouteTablePage& page,
+      int16_t clientId,
+      std::unique_ptr<RouteTableRequest> request) override;
+  void getRouteTableDetailsPage(
+      RouteDetailsPage& page,
+      std::unique_ptr<RouteTableRequest> request) override;
+  apache::thrift::ServerStream<UnicastRoute> streamRouteTable() override;
+  apache::thrift::ServerStream<UnicastRoute> streamRouteTableByClient(
+      int16_t clientId) override;
+  apache::thrift::ServerStream<RouteDetails> streamRouteTableDetails()
+      override;
+  apache::thrift::ServerStream<SwitchStateChanges>
+  subscribeToSwitchStateChanges(
+      std::unique_ptr<std::set<SwitchStateSubtree>> subtrees) override;
 
   void getPortStatus(
       std::map<int32_t, PortStatus>& status,
@@ -234,6 +254,11 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
       std::unique_ptr<std::string> identifier) override;
   void getRouteUpdateLoggingTrackedPrefixes(
       std::vector<RouteUpdateLoggingInfo>& infos) override;
+  void getRouteEvents(
+      std::vector<RouteEventThrift>& events,
+      std::unique_ptr<std::vector<IpPrefix>> prefixes) override;
+  void getRouteProgrammingLatencies(
+      std::vector<RouteProgrammingLatencyThrift>& latencies) override;
 
   void startLoggingMplsRouteUpdates(
       std::unique_ptr<MplsRouteUpdateLoggingInfo> info) override;
@@ -315,6 +340,17 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
    */
   void getConfigAppliedInfo(ConfigAppliedInfo& configAppliedInfo) override;
 
+  /*
+   * Long-poll for port status and config applied changes since
+   * sinceGeneration. Completes after up to timeoutMs (capped by
+   * --max_port_status_wait_ms) when nothing changed, without blocking a
+   * thrift thread meanwhile.
+   */
+  folly::SemiFuture<std::unique_ptr<PortStatusChanges>>
+  semifuture_waitForPortStatusChanges(
+      int64_t sinceGeneration,
+      int32_t timeoutMs) override;
+
   /**
    * Serialize live running switch state at the path pointer by JSON Pointer
    */
@@ -329,6 +365,11 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
       std::unique_ptr<std::string> jsonPointer,
       std::unique_ptr<std::string> jsonPatch) override;
 
+  void getPendingStateUpdates(
+      std::vector<PendingStateUpdate>& pendingUpdates) override;
+  void getStateUpdateProfiles(
+      std::vector<StateUpdateProfile>& profiles) override;
+
   SwitchRunState getSwitchRunState() override;
 
   void setSSLPolicy(apache::thrift::SSLPolicy sslPolicy) {
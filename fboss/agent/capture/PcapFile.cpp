@@ -14,6 +14,8 @@
 #include <folly/Exception.h>
 #include <folly/FileUtil.h>
 
+#include <limits.h>
+#include <algorithm>
 #include <chrono>
 
 using folly::IOBuf;
@@ -24,7 +26,14 @@ using std::chrono::seconds;
 
 namespace facebook::fboss {
 
-PcapFile::PktHeader::PktHeader(const PcapPkt& pkt) {
+namespace {
+// Max number of iovecs a single writev() accepts
+constexpr size_t kMaxIovecs = IOV_MAX;
+// Snaplen written in the global header when keeping whole packets
+constexpr uint32_t kMaxSnaplen = 0xffff;
+} // namespace
+
+PcapFile::PktHeader::PktHeader(const PcapPkt& pkt, uint32_t snaplen) {
   auto ts = pkt.timestamp().time_since_epoch();
   seconds tsSec = std::chrono::duration_cast<seconds>(ts);
   microseconds tsUsec = std::chrono::duration_cast<microseconds>(ts);
@@ -32,14 +41,18 @@ PcapFile::PktHeader::PktHeader(const PcapPkt& pkt) {
 
   timeSec = tsSec.count();
   timeUsec = (tsUsec - tsSec).count();
-  includedLen = len;
+  includedLen = snaplen ? std::min<uint64_t>(len, snaplen) : len;
   origLen = len;
 }
 
 PcapFile::PcapFile() {}
 
-PcapFile::PcapFile(folly::StringPiece path, bool overwriteExisting)
-    : file_(path.str().c_str(), openFlags(overwriteExisting), 0644) {}
+PcapFile::PcapFile(
+    folly::StringPiece path,
+    bool overwriteExisting,
+    uint32_t snaplen)
+    : file_(path.str().c_str(), openFlags(overwriteExisting), 0644),
+      snaplen_(snaplen) {}
 
 PcapFile::~PcapFile() {}
 
@@ -62,7 +75,7 @@ void PcapFile::writeGlobalHeader() {
   hdr.versionMinor = 4;
   hdr.tzOffset = 0;
   hdr.sigfigs = 0;
-  hdr.snaplen = 0xffff;
+  hdr.snaplen = snaplen_ ? snaplen_ : kMaxSnaplen;
   // Link type 1 is ethernet.  Other possible types we might want to use
   // include 113 for linux "cooked" capture format.
   hdr.linkType = 1;
@@ -72,24 +85,39 @@ void PcapFile::writeGlobalHeader() {
 }
 
 void PcapFile::writePackets(const std::vector<PcapPkt>& pkts) {
-  folly::fbvector<PktHeader> hdrs;
-  hdrs.reserve(pkts.size());
-  folly::fbvector<struct iovec> iov;
+  hdrs_.clear();
+  // The iovecs point into hdrs_, so it must not reallocate below
+  hdrs_.reserve(pkts.size());
+  iov_.clear();
   // Reserve enough space, assuming each packet is in a single IOBuf.
   // If some packets are split across IOBuf chains then we will end up
   // allocating more space as needed in the loop below.
-  iov.reserve(pkts.size() * 2);
+  iov_.reserve(pkts.size() * 2);
 
-  // Build iovecs for all of the packet headers and data
+  // Build iovecs for all of the packet headers and data, referencing the
+  // packet buffers rather than copying them
   for (const auto& pkt : pkts) {
-    hdrs.emplace_back(pkt);
-    PktHeader* curHdr = &hdrs.back();
-    iov.push_back({(void*)curHdr, sizeof(PktHeader)});
-    pkt.buf()->appendToIov(&iov);
+    hdrs_.emplace_back(pkt, snaplen_);
+    PktHeader* curHdr = &hdrs_.back();
+    iov_.push_back({(void*)curHdr, sizeof(PktHeader)});
+    size_t remaining = curHdr->includedLen;
+    for (const auto& range : *pkt.buf()) {
+      if (remaining == 0) {
+        break;
+      }
+      auto len = std::min(range.size(), remaining);
+      if (len > 0) {
+        iov_.push_back({(void*)range.data(), len});
+        remaining -= len;
+      }
+    }
   }
 
-  int ret = writevFull(file_.fd(), iov.data(), iov.size());
-  folly::checkUnixError(ret, "error writing pcap data");
+  for (size_t start = 0; start < iov_.size(); start += kMaxIovecs) {
+    auto count = std::min(kMaxIovecs, iov_.size() - start);
+    int ret = writevFull(file_.fd(), iov_.data() + start, count);
+    folly::checkUnixError(ret, "error writing pcap data");
+  }
 }
 
 int PcapFile::openFlags(bool overwriteExisting) {
@@ -9,8 +9,10 @@
  */
 #pragma once
 
+#include <folly/FBVector.h>
 #include <folly/File.h>
 #include <folly/Range.h>
+#include <sys/uio.h>
 #include <vector>
 
 namespace facebook::fboss {
@@ -23,11 +25,17 @@ class PcapPkt;
  * PcapFile uses blocking I/O.  If you are recording packets from a
  * non-blocking thread, you should use PcapWriter instead of using PcapFile
  * directly.
+ *
+ * Packets longer than snaplen bytes are truncated to their first snaplen
+ * bytes.  A snaplen of 0 keeps whole packets.
  */
 class PcapFile {
  public:
   PcapFile();
-  explicit PcapFile(folly::StringPiece path, bool overwriteExisting = false);
+  explicit PcapFile(
+      folly::StringPiece path,
+      bool overwriteExisting = false,
+      uint32_t snaplen = 0);
   ~PcapFile();
 
   void close();
@@ -41,7 +49,7 @@ class PcapFile {
 
  private:
   struct PktHeader {
-    explicit PktHeader(const PcapPkt& pkt);
+    PktHeader(const PcapPkt& pkt, uint32_t snaplen);
 
     uint32_t timeSec{0};
     uint32_t timeUsec{0};
@@ -56,6 +64,10 @@ class PcapFile {
   static int openFlags(bool overwriteExisting);
 
   folly::File file_;
+  uint32_t snaplen_{0};
+  // Re-used across writePackets() calls to avoid reallocating them
+  folly::fbvector<PktHeader> hdrs_;
+  folly::fbvector<struct iovec> iov_;
 };
 
 } // namespace facebook::fboss
@@ -25,95 +25,84 @@ namespace facebook::fboss {
 PcapQueue::PcapQueue(uint32_t pktCapacity, uint64_t bytesCapacity)
     : pktCapacity_(
           pktCapacity == 0 ? FLAGS_fboss_pcap_queue_depth : pktCapacity),
-      bytesCapacity_(bytesCapacity) {
-  queue_.reserve(pktCapacity_);
-}
+      bytesCapacity_(bytesCapacity),
+      // One slot of the ring is always left empty
+      ring_(pktCapacity_ + 1) {}
 
 PcapQueue::~PcapQueue() {}
 
 template <typename PktType>
 void PcapQueue::addPktInternal(const PktType* pkt) {
   // Check to see if this would exceed the queue capacity.
-  if (queue_.size() >= pktCapacity_) {
-    pktsDropped_ += 1;
+  auto pktBytes = pkt->buf()->computeChainDataLength();
+  auto bytesInQueue = bytesInQueue_.fetch_add(pktBytes) + pktBytes;
+  if (bytesCapacity_ > 0 && bytesInQueue >= bytesCapacity_) {
+    bytesInQueue_.fetch_sub(pktBytes);
+    pktsDropped_.fetch_add(1, std::memory_order_relaxed);
     return;
   }
-  auto newBytes = bytesInQueue_ + pkt->buf()->computeChainDataLength();
-  if (bytesCapacity_ > 0 && newBytes >= bytesCapacity_) {
-    pktsDropped_ += 1;
+  // The PcapPkt is only built (cloning the buffer) if there is room for it
+  if (!ring_.write(pkt)) {
+    bytesInQueue_.fetch_sub(pktBytes);
+    pktsDropped_.fetch_add(1, std::memory_order_relaxed);
     return;
   }
-
-  queue_.emplace_back(pkt);
+  // Cheap unless the reader is actually waiting
+  pktsAvailable_.notify();
 }
 
 void PcapQueue::addPkt(const RxPacket* pkt) {
-  {
-    std::lock_guard<std::mutex> guard(mutex_);
-    addPktInternal(pkt);
-  }
-  cv_.notify_one();
-}
-
-void PcapQueue::addPktLocked(const RxPacket* pkt) {
   addPktInternal(pkt);
-  // It is preferred not to be holding the lock when we signal cv_,
-  // but it is okay to call it with the lock held anyway.  (Having the lock
-  // held will just prevent the reader thread from being able to acquire it
-  // immediately when the reader wakes.)
-  cv_.notify_one();
 }
 
 void PcapQueue::addPkt(const TxPacket* pkt) {
-  {
-    std::lock_guard<std::mutex> guard(mutex_);
-    addPktInternal(pkt);
-  }
-  cv_.notify_one();
-}
-
-void PcapQueue::addPktLocked(const TxPacket* pkt) {
   addPktInternal(pkt);
-  // It is preferred not to be holding the lock when we signal cv_,
-  // but it is okay to call it with the lock held anyway.  (Having the lock
-  // held will just prevent the reader thread from being able to acquire it
-  // immediately when the reader wakes.)
-  cv_.notify_one();
 }
 
 void PcapQueue::finish() {
-  std::lock_guard<std::mutex> guard(mutex_);
-  finished_ = true;
-  cv_.notify_all();
+  finished_.store(true, std::memory_order_release);
+  pktsAvailable_.notifyAll();
 }
 
 bool PcapQueue::isFinished() const {
-  std::lock_guard<std::mutex> guard(mutex_);
-  return finished_;
+  return finished_.load(std::memory_order_acquire);
 }
 
 uint64_t PcapQueue::numDropped() const {
-  std::lock_guard<std::mutex> guard(mutex_);
-  return pktsDropped_;
+  return pktsDropped_.load(std::memory_order_relaxed);
 }
 
-bool PcapQueue::wait(std::vector<PcapPkt>* swapQueue) {
-  swapQueue->clear();
-  swapQueue->reserve(pktCapacity_);
-
-  std::unique_lock<std::mutex> guard(mutex_);
-  while (queue_.empty() && !finished_) {
-    cv_.wait(guard);
-  }
-  if (queue_.empty()) {
-    DCHECK(finished_);
-    queue_.shrink_to_fit();
-    return false;
+void PcapQueue::drain(std::vector<PcapPkt>* pkts) {
+  while (auto pkt = ring_.frontPtr()) {
+    bytesInQueue_.fetch_sub(pkt->buf()->computeChainDataLength());
+    pkts->push_back(std::move(*pkt));
+    ring_.popFront();
   }
+}
 
-  swapQueue->swap(queue_);
-  bytesInQueue_ = 0;
-  return true;
+bool PcapQueue::wait(std::vector<PcapPkt>* pkts) {
+  pkts->clear();
+  pkts->reserve(pktCapacity_);
+
+  while (true) {
+    // Packets added before finish() must still be returned, so check for
+    // finish() before draining the ring
+    bool finished = isFinished();
+    drain(pkts);
+    if (!pkts->empty()) {
+      return true;
+    }
+    if (finished) {
+      return false;
+    }
+
+    auto key = pktsAvailable_.prepareWait();
+    if (!ring_.isEmpty() || isFinished()) {
+      pktsAvailable_.cancelWait();
+      continue;
+    }
+    pktsAvailable_.wait(key);
+  }
 }
 
 } // namespace facebook::fboss
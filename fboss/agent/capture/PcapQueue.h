@@ -9,21 +9,29 @@
  */
 #pragma once
 
-#include <condition_variable>
-#include <mutex>
+#include "fboss/agent/capture/PcapPkt.h"
+
+#include <folly/ProducerConsumerQueue.h>
+#include <folly/synchronization/EventCount.h>
+
+#include <atomic>
 #include <vector>
 
 namespace facebook::fboss {
 
 class RxPacket;
 class TxPacket;
-class PcapPkt;
 
 /*
  * PcapQueue stores a queue of PcapPkt objects, for transferring packets
  * from an asynchronous capture thread to a blocking thread that will process
  * the packets.  (For instance, writing them to disk using blocking I/O.)
  *
+ * The queue is a fixed size single producer, single consumer ring.  Adding a
+ * packet never blocks or allocates, and only takes a reference to the packet
+ * buffer rather than copying it.  Callers adding packets from several threads
+ * must serialize their addPkt() calls (PktCaptureManager does).
+ *
  * There can only be a single reader.
  */
 class PcapQueue {
@@ -32,25 +40,11 @@ class PcapQueue {
   virtual ~PcapQueue();
 
   uint32_t getPktCapacity() const {
-    // pktCapacity_ is const, so no need for locking
     return pktCapacity_;
   }
 
-  /*
-   * Get the mutex protecting this PcapQueue.
-   *
-   * This is exposed to allow callers to also protect their own data
-   * with the same mutex if desired.  Callers should call addPktLocked()
-   * instead of addPkt() when they are already holding the PcapQueue mutex.
-   */
-  std::mutex& mutex() const {
-    return mutex_;
-  }
-
   void addPkt(const RxPacket* pkt);
-  void addPktLocked(const RxPacket* pkt);
   void addPkt(const TxPacket* pkt);
-  void addPktLocked(const TxPacket* pkt);
 
   /*
    * finish() signals that no more packets will be added to the queue.
@@ -71,13 +65,14 @@ class PcapQueue {
   uint64_t numDropped() const;
 
   /*
-   * Wait for new packets from the queue.
+   * Wait for new packets from the queue, and move all the queued ones to
+   * pkts.
    *
-   * Note: for best performance, the writer should re-use the same vector
-   * for multiple wait() calls.  On subsequent calls the queue will already
+   * Note: for best performance, the reader should re-use the same vector
+   * for multiple wait() calls.  On subsequent calls the vector will already
    * have the desired capacity, and will not need to reallocate memory.
    */
-  bool wait(std::vector<PcapPkt>* swapQueue);
+  bool wait(std::vector<PcapPkt>* pkts);
 
  private:
   // Forbidden copy constructor and assignment operator
@@ -86,16 +81,16 @@ class PcapQueue {
 
   template <typename PktType>
   void addPktInternal(const PktType* pkt);
+  void drain(std::vector<PcapPkt>* pkts);
 
-  mutable std::mutex mutex_;
-  std::condition_variable cv_;
-
-  bool finished_{false};
   const uint32_t pktCapacity_{0};
-  uint64_t bytesCapacity_{0};
-  uint64_t bytesInQueue_{0};
-  uint64_t pktsDropped_{0};
-  std::vector<PcapPkt> queue_;
+  const uint64_t bytesCapacity_{0};
+  folly::ProducerConsumerQueue<PcapPkt> ring_;
+  // Signalled by the producer when it adds packets or finishes
+  folly::EventCount pktsAvailable_;
+  std::atomic<bool> finished_{false};
+  std::atomic<uint64_t> bytesInQueue_{0};
+  std::atomic<uint64_t> pktsDropped_{0};
 };
 
 } // namespace facebook::fboss
@@ -23,8 +23,9 @@ PcapWriter::PcapWriter(uint32_t maxBufferedPkts) : queue_(maxBufferedPkts) {}
 PcapWriter::PcapWriter(
     StringPiece path,
     bool overwriteExisting,
-    uint32_t maxBufferedPkts)
-    : file_(path, overwriteExisting),
+    uint32_t maxBufferedPkts,
+    uint32_t snaplen)
+    : file_(path, overwriteExisting, snaplen),
       queue_(maxBufferedPkts),
       thread_(&PcapWriter::threadMain, this) {}
 
@@ -40,8 +41,11 @@ PcapWriter::~PcapWriter() {
   }
 }
 
-void PcapWriter::start(folly::StringPiece path, bool overwriteExisting) {
-  file_ = PcapFile(path, overwriteExisting);
+void PcapWriter::start(
+    folly::StringPiece path,
+    bool overwriteExisting,
+    uint32_t snaplen) {
+  file_ = PcapFile(path, overwriteExisting, snaplen);
   thread_ = std::thread(&PcapWriter::threadMain, this);
 }
 
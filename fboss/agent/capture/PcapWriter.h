@@ -20,7 +20,11 @@ namespace facebook::fboss {
  * PcapWriter listes to a PcapQueue and writes the packets it receives
  * to a pcap file.
  *
- * It performs blocking disk I/O, so it performs the writes in its own thread.
+ * It performs blocking disk I/O, so it performs the writes in its own thread,
+ * one vectored write for all the packets queued since the previous one.
+ *
+ * As with PcapQueue, callers adding packets from several threads must
+ * serialize their addPkt() calls.
  */
 class PcapWriter {
  public:
@@ -28,34 +32,22 @@ class PcapWriter {
   explicit PcapWriter(
       folly::StringPiece path,
       bool overwriteExisting = false,
-      uint32_t maxBufferedPkts = 0);
+      uint32_t maxBufferedPkts = 0,
+      uint32_t snaplen = 0);
   virtual ~PcapWriter();
 
-  void start(folly::StringPiece path, bool overwriteExisting = false);
-
-  /*
-   * Get the mutex protecting this PcapWriter.
-   *
-   * This is exposed to allow callers to also protect their own data
-   * with the same mutex if desired.  Callers should call addPktLocked()
-   * instead of addPkt() when they are already holding the PcapWriter mutex.
-   */
-  std::mutex& mutex() const {
-    return queue_.mutex();
-  }
+  // Packets are truncated to snaplen bytes, see PcapFile
+  void start(
+      folly::StringPiece path,
+      bool overwriteExisting = false,
+      uint32_t snaplen = 0);
 
   void addPkt(const RxPacket* pkt) {
     queue_.addPkt(pkt);
   }
-  void addPktLocked(const RxPacket* pkt) {
-    queue_.addPktLocked(pkt);
-  }
   void addPkt(const TxPacket* pkt) {
     queue_.addPkt(pkt);
   }
-  void addPktLocked(const TxPacket* pkt) {
-    queue_.addPktLocked(pkt);
-  }
   void finish();
 
   /*
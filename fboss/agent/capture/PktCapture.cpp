@@ -17,6 +17,54 @@ using folly::StringPiece;
 
 namespace facebook::fboss {
 
+PacketHeaderFilter::PacketHeaderFilter(
+    const PacketHeaderCaptureFilter& headerFilter)
+    : etherTypes_(
+          headerFilter.etherTypes()->begin(),
+          headerFilter.etherTypes()->end()),
+      vlans_(headerFilter.vlans()->begin(), headerFilter.vlans()->end()),
+      ipProtocols_(
+          headerFilter.ipProtocols()->begin(),
+          headerFilter.ipProtocols()->end()),
+      l4Ports_(
+          headerFilter.l4Ports()->begin(),
+          headerFilter.l4Ports()->end()) {}
+
+bool PacketHeaderFilter::passes(const PktHeaderInfo& headers, VlanID vlan)
+    const {
+  auto contains = [](const auto& set, auto value) {
+    return set.empty() || set.find(value) != set.end();
+  };
+  if (headers.l3Offset == 0) {
+    // Truncated packet
+    return false;
+  }
+  if (headers.vlanTci) {
+    vlan = VlanID(*headers.vlanTci & 0xfff);
+  }
+  if (!contains(vlans_, static_cast<uint16_t>(vlan)) ||
+      !contains(etherTypes_, headers.etherType)) {
+    return false;
+  }
+  if (ipProtocols_.empty() && l4Ports_.empty()) {
+    return true;
+  }
+
+  // Not IP, or a truncated IP header
+  if (!headers.ipProtocol || !contains(ipProtocols_, *headers.ipProtocol)) {
+    return false;
+  }
+  if (l4Ports_.empty()) {
+    return true;
+  }
+
+  if (!headers.isTcp() && !headers.isUdp()) {
+    return false;
+  }
+  return l4Ports_.find(headers.srcPort) != l4Ports_.end() ||
+      l4Ports_.find(headers.dstPort) != l4Ports_.end();
+}
+
 PktCapture::PktCapture(
     folly::StringPiece name,
     uint64_t maxPackets,
@@ -27,15 +75,17 @@ PktCapture::PktCapture(
     folly::StringPiece name,
     uint64_t maxPackets,
     CaptureDirection direction,
-    const CaptureFilter& captureFilter)
+    const CaptureFilter& captureFilter,
+    uint32_t snaplen)
     : name_(name.str()),
       maxPackets_(maxPackets),
       direction_(direction),
-      packetFilter_(captureFilter) {}
+      packetFilter_(captureFilter),
+      snaplen_(snaplen) {}
 
 void PktCapture::start(StringPiece path) {
   XLOG(INFO) << "starting packet capture " << toString();
-  writer_.start(path, true);
+  writer_.start(path, true, snaplen_);
 }
 
 void PktCapture::stop() {
@@ -44,20 +94,19 @@ void PktCapture::stop() {
 }
 
 bool PktCapture::packetReceived(const RxPacket* pkt) {
-  std::lock_guard<std::mutex> guard(writer_.mutex());
   if (direction_ != CaptureDirection::CAPTURE_ONLY_TX &&
-      true == packetFilter_.passes(pkt)) {
+      packetFilter_.passes(pkt)) {
     ++numPacketsReceived_;
-    writer_.addPktLocked(pkt);
+    writer_.addPkt(pkt);
   }
   return (numPacketsSent_ + numPacketsReceived_) < maxPackets_;
 }
 
 bool PktCapture::packetSent(const TxPacket* pkt) {
-  std::lock_guard<std::mutex> guard(writer_.mutex());
-  if (direction_ != CaptureDirection::CAPTURE_ONLY_RX) {
+  if (direction_ != CaptureDirection::CAPTURE_ONLY_RX &&
+      packetFilter_.passes(pkt)) {
     ++numPacketsSent_;
-    writer_.addPktLocked(pkt);
+    writer_.addPkt(pkt);
   }
   return (numPacketsSent_ + numPacketsReceived_) < maxPackets_;
 }
@@ -69,6 +118,9 @@ std::string PktCapture::toString(bool withStats) const {
              ? "Tx and Rx"
              : ((direction_ == CaptureDirection::CAPTURE_ONLY_RX) ? "RX only"
                                                                   : "TX only"));
+  if (snaplen_) {
+    ss << ", snaplen:" << snaplen_;
+  }
   if (withStats) {
     ss << ", Packet received:" << numPacketsReceived_
        << ", Packet sent:" << numPacketsSent_;
@@ -77,7 +129,6 @@ std::string PktCapture::toString(bool withStats) const {
 }
 
 int PktCapture::getCaptureCount() {
-  std::lock_guard<std::mutex> guard(writer_.mutex());
   return (numPacketsSent_ + numPacketsReceived_);
 }
 } // namespace facebook::fboss
@@ -14,9 +14,11 @@
 
 #include <boost/container/flat_set.hpp>
 #include <folly/Range.h>
+#include <atomic>
 #include <string>
 #include "fboss/agent/RxPacket.h"
 #include "fboss/agent/TxPacket.h"
+#include "fboss/agent/packet/PktHeaderInfo.h"
 
 namespace facebook::fboss {
 
@@ -37,17 +39,52 @@ class RxPacketFilter {
   boost::container::flat_set<CpuCosQueueId> cosQueues_;
 };
 
+/*
+ * BPF style filter on the ethernet, IP and TCP/UDP headers.  Received packets
+ * are matched against the headers classified for the rest of the agent, and
+ * nothing is classified when there are no criteria.
+ */
+class PacketHeaderFilter {
+ public:
+  explicit PacketHeaderFilter(const PacketHeaderCaptureFilter& headerFilter);
+
+  bool empty() const {
+    return etherTypes_.empty() && vlans_.empty() && ipProtocols_.empty() &&
+        l4Ports_.empty();
+  }
+
+  // vlan is the VLAN of the packet if it has no 802.1q header
+  bool passes(const folly::IOBuf* buf, VlanID vlan) const {
+    return empty() || passes(classifyPktHeaders(buf), vlan);
+  }
+  bool passes(const PktHeaderInfo& headers, VlanID vlan) const;
+
+ private:
+
+  boost::container::flat_set<uint16_t> etherTypes_;
+  boost::container::flat_set<uint16_t> vlans_;
+  boost::container::flat_set<uint8_t> ipProtocols_;
+  boost::container::flat_set<uint16_t> l4Ports_;
+};
+
 class PacketFilter {
  public:
   explicit PacketFilter(const CaptureFilter& captureFilter)
-      : rxPacketFilter_(captureFilter.get_rxCaptureFilter()) {}
+      : rxPacketFilter_(captureFilter.get_rxCaptureFilter()),
+        headerFilter_(captureFilter.get_headerFilter()) {}
 
-  bool passes(const RxPacket* pkt) {
-    return rxPacketFilter_.passes(pkt);
+  bool passes(const RxPacket* pkt) const {
+    return rxPacketFilter_.passes(pkt) &&
+        (headerFilter_.empty() ||
+         headerFilter_.passes(pkt->getHeaderInfo(), pkt->getSrcVlan()));
+  }
+  bool passes(const TxPacket* pkt) const {
+    return headerFilter_.passes(pkt->buf(), VlanID(0));
   }
 
  private:
   RxPacketFilter rxPacketFilter_;
+  PacketHeaderFilter headerFilter_;
 };
 
 /*
@@ -63,7 +100,8 @@ class PktCapture {
       folly::StringPiece name,
       uint64_t maxPackets,
       CaptureDirection direction,
-      const CaptureFilter& captureFilter);
+      const CaptureFilter& captureFilter,
+      uint32_t snaplen = 0);
 
   const std::string& name() const {
     return name_;
@@ -85,13 +123,14 @@ class PktCapture {
 
   const std::string name_;
 
-  // Note: the rest of the state in this class is protcted by
-  // the PcapWriter's mutex.
+  // packetReceived() and packetSent() are serialized by PktCaptureManager,
+  // the counters are only atomic for the readers.
   PcapWriter writer_;
   uint64_t maxPackets_{0};
-  uint64_t numPacketsReceived_{0};
-  uint64_t numPacketsSent_{0};
+  std::atomic<uint64_t> numPacketsReceived_{0};
+  std::atomic<uint64_t> numPacketsSent_{0};
   CaptureDirection direction_{CaptureDirection::CAPTURE_TX_RX};
   PacketFilter packetFilter_;
+  uint32_t snaplen_{0};
 };
 } // namespace facebook::fboss
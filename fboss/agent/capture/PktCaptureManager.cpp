@@ -118,6 +118,8 @@ void PktCaptureManager::forgetAllCaptures() {
 
 template <typename Fn>
 void PktCaptureManager::invokeCaptures(const Fn& fn) {
+  // Holding mutex_ also serializes the RX and TX threads adding packets to
+  // each capture, whose queue is single producer.
   std::lock_guard<std::mutex> g(mutex_);
 
   for (auto it = activeCaptures_.begin(); it != activeCaptures_.end();
@@ -269,3 +269,70 @@ TEST(CaptureTest, FullCapture) {
   //
   // EXPECT_BUF_EQ(updatedIpPktData, pcapPkts.at(4).data);
 }
+
+TEST(CaptureTest, HeaderFilter) {
+  // A TCP packet from port 1234 to port 80 on VLAN 1
+  auto tcpPktData = PktUtil::parseHexData(
+      // dst mac, src mac
+      "02 00 01 00 00 01  02 00 02 01 02 03"
+      // 802.1q, VLAN 1
+      "81 00 00 01"
+      // IPv4
+      "08 00"
+      // Version(4), IHL(5), DSCP(0), ECN(0), Total Length(24)
+      "45  00  00 18"
+      // Identification(0), Flags(0), Fragment offset(0)
+      "00 00  00 00"
+      // TTL(31), Protocol(6), Checksum (0, fake)
+      "1F  06  00 00"
+      // Source IP (1.2.3.4)
+      "01 02 03 04"
+      // Destination IP (10.0.0.10)
+      "0a 00 00 0a"
+      // Source port(1234), Destination port(80)
+      "04 d2  00 50");
+  auto passes = [&](const PacketHeaderCaptureFilter& filter) {
+    return PacketHeaderFilter(filter).passes(&tcpPktData, VlanID(0));
+  };
+
+  PacketHeaderCaptureFilter filter;
+  EXPECT_TRUE(PacketHeaderFilter(filter).empty());
+  EXPECT_TRUE(passes(filter));
+
+  filter.etherTypes() = {0x0800};
+  filter.vlans() = {1};
+  filter.ipProtocols() = {6};
+  filter.l4Ports() = {80};
+  EXPECT_TRUE(passes(filter));
+
+  // Any criteria not matching filters the packet out
+  auto mismatch = filter;
+  mismatch.etherTypes() = {0x86dd};
+  EXPECT_FALSE(passes(mismatch));
+  mismatch = filter;
+  mismatch.vlans() = {2};
+  EXPECT_FALSE(passes(mismatch));
+  mismatch = filter;
+  mismatch.ipProtocols() = {17};
+  EXPECT_FALSE(passes(mismatch));
+  mismatch = filter;
+  mismatch.l4Ports() = {443};
+  EXPECT_FALSE(passes(mismatch));
+
+  // Untagged packets match on the VLAN they were received on
+  auto untaggedPktData = PktUtil::parseHexData(
+      "02 00 01 00 00 01  02 00 02 01 02 03"
+      "08 06");
+  PacketHeaderCaptureFilter vlanFilter;
+  vlanFilter.vlans() = {1};
+  EXPECT_TRUE(
+      PacketHeaderFilter(vlanFilter).passes(&untaggedPktData, VlanID(1)));
+  EXPECT_FALSE(
+      PacketHeaderFilter(vlanFilter).passes(&untaggedPktData, VlanID(2)));
+
+  // Truncated packets never match a filter on the missing headers
+  PacketHeaderCaptureFilter portFilter;
+  portFilter.l4Ports() = {80};
+  EXPECT_FALSE(
+      PacketHeaderFilter(portFilter).passes(&untaggedPktData, VlanID(1)));
+}
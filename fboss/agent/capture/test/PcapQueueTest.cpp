@@ -71,3 +71,32 @@ TEST(PcapQueueTest, SimpleAdd) {
   ByteRange waitedPktData = waitedPktBufClone->coalesce();
   EXPECT_EQ(expectedPktData, waitedPktData);
 }
+
+TEST(PcapQueueTest, ConcurrentReader) {
+  PcapQueue queue(16);
+  std::vector<PcapPkt> waitedPkts;
+
+  std::thread waiter([&]() { pktWaitThread(&queue, &waitedPkts); });
+
+  auto pkt = MockRxPacket::fromHex(
+      // dst mac, src mac
+      "02 00 01 00 00 01  02 00 02 01 02 03"
+      // IPv4
+      "08 00");
+  pkt->padToLength(68);
+
+  // The reader drains the ring while we keep adding to it, every packet is
+  // either read or accounted as dropped
+  uint32_t numPkts = 10000;
+  for (uint32_t n = 0; n < numPkts; ++n) {
+    queue.addPkt(pkt.get());
+  }
+  queue.finish();
+  waiter.join();
+
+  EXPECT_EQ(numPkts, waitedPkts.size() + queue.numDropped());
+  for (const auto& waitedPkt : waitedPkts) {
+    // The captured packet shares the buffer of the original one
+    EXPECT_EQ(pkt->buf()->data(), waitedPkt.buf()->data());
+  }
+}
@@ -294,6 +294,8 @@ BcmEcmpEgress::BcmEcmpEgress(
   if (hw_->getPlatform()->getAsic()->isSupported(HwAsic::Feature::WIDE_ECMP)) {
     wideEcmpSupported_ = true;
   }
+  auto ecmpMembersGuard =
+      hw_->writableEgressManager()->lockEcmpMembersHwLocked();
   program();
 }
 
@@ -420,6 +422,8 @@ BcmEcmpEgress::~BcmEcmpEgress() {
   if (id_ == INVALID) {
     return;
   }
+  auto ecmpMembersGuard =
+      hw_->writableEgressManager()->lockEcmpMembersHwLocked();
   int ret;
   if (useHsdk_) {
     ret = bcm_l3_ecmp_destroy(hw_->getUnit(), id_);
@@ -975,6 +979,87 @@ bcm_mpls_label_t getLabel(const bcm_l3_egress_t& egress) {
   return reinterpret_cast<const bcm_l3_egress_t&>(egress).mpls_label;
 }
 
+std::optional<BcmEcmpEgress::LinkDownMembers>
+BcmEcmpEgress::getLinkDownMembers(const EgressIdSet& toRemove) const {
+  if (!useHsdk_ && isWideEcmpEnabled(wideEcmpSupported_)) {
+    // Wide ECMP groups are rebalanced rather than shrunk on link down
+    return std::nullopt;
+  }
+  int numPaths = 0;
+  LinkDownMembers members{id_, 0, ucmpEnabled_, useHsdk_, {}};
+  for (const auto& path : egressId2Weight_) {
+    numPaths += ucmpEnabled_ ? 1 : path.second;
+    if (toRemove.find(path.first) == toRemove.end() &&
+        hw_->getEgressManager()->isResolved(path.first)) {
+      members.egressId2Weight.insert(path);
+    }
+  }
+  if (!useHsdk_ && numPaths > kMaxNonWeightedEcmpPaths) {
+    return std::nullopt;
+  }
+  if (members.egressId2Weight.empty() ||
+      members.egressId2Weight.size() == egressId2Weight_.size()) {
+    // Either the last member goes, or nothing does
+    return std::nullopt;
+  }
+  // Same as when the group was programmed
+  members.maxPaths = ((numPaths + 3) >> 2) << 2;
+  return members;
+}
+
+bool BcmEcmpEgress::replaceMembersHwNotLocked(
+    int unit,
+    const LinkDownMembers& members) {
+  bcm_l3_egress_ecmp_t obj;
+  bcm_l3_egress_ecmp_t_init(&obj);
+  obj.ecmp_intf = members.ecmpId;
+  obj.max_paths = members.maxPaths;
+  int ret = 0;
+  if (members.useHsdk) {
+    if (members.ucmpEnabled) {
+      obj.ecmp_group_flags = BCM_L3_ECMP_MEMBER_WEIGHTED;
+    }
+    std::vector<bcm_l3_ecmp_member_t> memberArray;
+    for (const auto& path : members.egressId2Weight) {
+      uint64_t copies = members.ucmpEnabled ? 1 : path.second;
+      for (uint64_t i = 0; i < copies; i++) {
+        bcm_l3_ecmp_member_t member;
+        bcm_l3_ecmp_member_t_init(&member);
+        member.egress_if = path.first;
+        if (members.ucmpEnabled) {
+          member.weight = path.second;
+        }
+        memberArray.push_back(member);
+      }
+    }
+    ret = bcm_l3_ecmp_create(
+        unit,
+        BCM_L3_ECMP_O_REPLACE | BCM_L3_ECMP_O_CREATE_WITH_ID,
+        &obj,
+        memberArray.size(),
+        memberArray.data());
+  } else {
+    obj.flags |= BCM_L3_REPLACE | BCM_L3_WITH_ID;
+    std::vector<bcm_if_t> pathsArray;
+    for (const auto& path : members.egressId2Weight) {
+      pathsArray.insert(pathsArray.end(), path.second, path.first);
+    }
+    ret = bcm_l3_egress_ecmp_create(
+        unit, &obj, pathsArray.size(), pathsArray.data());
+  }
+  if (ret) {
+    // Called from the linkscan callback, let the caller fall back to
+    // removing members one by one rather than throwing
+    XLOG(ERR) << "Error replacing members of " << members.ecmpId << " with "
+              << egressId2WeightToString(members.egressId2Weight) << " "
+              << bcm_errmsg(ret);
+    return false;
+  }
+  XLOG(DBG1) << "Replaced members of " << members.ecmpId << " with "
+             << egressId2WeightToString(members.egressId2Weight);
+  return true;
+}
+
 bool BcmEcmpEgress::isWideEcmpEnabled(bool wideEcmpSupported) {
   return wideEcmpSupported && FLAGS_ecmp_width > kMaxNonWeightedEcmpPaths;
 }
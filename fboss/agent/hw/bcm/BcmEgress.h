@@ -25,6 +25,8 @@ extern "C" {
 #include <boost/container/flat_set.hpp>
 #include <boost/noncopyable.hpp>
 
+#include <optional>
+
 namespace facebook::fboss {
 
 class BcmSwitchIf;
@@ -154,6 +156,17 @@ class BcmEcmpEgress : public BcmEgressBase {
   using EgressIdSet = boost::container::flat_set<EgressId>;
   using EgressId2Weight = boost::container::flat_map<EgressId, uint64_t>;
   enum class Action { SHRINK, EXPAND, SKIP };
+  /*
+   * Members an ECMP group shrinks to once some of its egresses go down,
+   * with what is needed to program them in one call
+   */
+  struct LinkDownMembers {
+    EgressId ecmpId;
+    int maxPaths;
+    bool ucmpEnabled;
+    bool useHsdk;
+    EgressId2Weight egressId2Weight;
+  };
 
   BcmEcmpEgress(
       const BcmSwitchIf* hw,
@@ -221,6 +234,20 @@ class BcmEcmpEgress : public BcmEgressBase {
   void createWideEcmpEntry(int numPaths);
   static std::string egressId2WeightToString(
       const EgressId2Weight& egressId2Weight);
+  /*
+   * Resolved members left in this group once the given egresses go down.
+   * Unset if the group cannot be replaced in one call, i.e. for wide ECMP
+   * groups, or if no members would be left.
+   */
+  std::optional<LinkDownMembers> getLinkDownMembers(
+      const EgressIdSet& toRemove) const;
+  /*
+   * Replace all members of an ECMP group in one call. Called from the
+   * linkscan callback, without holding the hw lock.
+   */
+  static bool replaceMembersHwNotLocked(
+      int unit,
+      const LinkDownMembers& members);
 
  private:
   void program();
@@ -2,9 +2,22 @@
 
 #include "fboss/agent/hw/bcm/BcmEgressManager.h"
 #include "fboss/agent/hw/bcm/BcmHost.h"
+#include "fboss/agent/hw/bcm/BcmMultiPathNextHop.h"
 #include "fboss/agent/hw/bcm/BcmSwitch.h"
 #include "fboss/agent/hw/switch_asics/HwAsic.h"
 
+#include <folly/logging/xlog.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+DEFINE_uint32(
+    ecmp_backup_groups,
+    0,
+    "Max number of (ECMP group, port) pairs to precompute link down "
+    "members for, starting with the groups with the most routes. Link down "
+    "then shrinks these groups in one call each. 0 disables");
+
 namespace {
 constexpr auto kDefaultMemberWeight = 1;
 }
@@ -46,6 +59,7 @@ void BcmEgressManager::updatePortToEgressMapping(
   // Publish and replace with the updated mapping
   newMapping->publish();
   setPort2EgressIdsInternal(newMapping);
+  invalidateEcmpLinkDownBackups();
 }
 
 void BcmEgressManager::setPort2EgressIdsInternal(
@@ -75,6 +89,9 @@ void BcmEgressManager::linkStateChangedMaybeLocked(
         up ? BcmEcmpEgress::Action::EXPAND : BcmEcmpEgress::Action::SHRINK);
   } else {
     CHECK(!up);
+    if (applyEcmpLinkDownBackupsHwNotLocked(gport)) {
+      return;
+    }
     egressResolutionChangedHwNotLocked(
         hw_->getUnit(),
         portAndEgressIds->getEgressIds(),
@@ -84,6 +101,143 @@ void BcmEgressManager::linkStateChangedMaybeLocked(
   }
 }
 
+void BcmEgressManager::invalidateEcmpLinkDownBackups() {
+  std::unique_lock guard(portAndEgressIdsLock_);
+  ecmpLinkDownBackups_.reset();
+  ecmpLinkDownBackupsStale_ = true;
+  ++ecmpLinkDownBackupsGeneration_;
+}
+
+std::unique_lock<std::mutex> BcmEgressManager::lockEcmpMembersHwLocked() {
+  std::unique_lock<std::mutex> guard(ecmpMembersLock_);
+  invalidateEcmpLinkDownBackups();
+  return guard;
+}
+
+bool BcmEgressManager::applyEcmpLinkDownBackupsHwNotLocked(bcm_gport_t gport) {
+  // Keep ECMP members from changing under the hw lock until the backups are
+  // applied. Any change made before this point already dropped them.
+  std::unique_lock<std::mutex> membersGuard(ecmpMembersLock_);
+  std::shared_ptr<const EcmpLinkDownBackups> backups;
+  {
+    // Backups of other ports may have members over this port, so none can
+    // be used once this port is down
+    std::unique_lock guard(portAndEgressIdsLock_);
+    backups.swap(ecmpLinkDownBackups_);
+    ecmpLinkDownBackupsStale_ = true;
+    ++ecmpLinkDownBackupsGeneration_;
+  }
+  if (!backups) {
+    return false;
+  }
+  bool allReplaced = true;
+  auto itr = backups->port2Backups.find(gport);
+  if (itr != backups->port2Backups.end()) {
+    for (const auto& members : itr->second) {
+      allReplaced &=
+          BcmEcmpEgress::replaceMembersHwNotLocked(hw_->getUnit(), members);
+    }
+  }
+  return allReplaced &&
+      backups->fullyBackedPorts.find(gport) != backups->fullyBackedPorts.end();
+}
+
+void BcmEgressManager::updateEcmpLinkDownBackupsHwLocked() {
+  uint64_t generation;
+  {
+    std::unique_lock guard(portAndEgressIdsLock_);
+    if (FLAGS_ecmp_backup_groups == 0) {
+      ecmpLinkDownBackups_.reset();
+      return;
+    }
+    // Called on every state update, only walk the ECMP groups when
+    // something dropped the backups since they were last computed
+    if (!ecmpLinkDownBackupsStale_) {
+      return;
+    }
+    ecmpLinkDownBackupsStale_ = false;
+    generation = ecmpLinkDownBackupsGeneration_;
+  }
+
+  // Port of each egress, and egresses over ports which are down. The
+  // latter may already be removed from ECMP groups, so must not be in
+  // any backup.
+  auto portAndEgressIdMapping = getPortAndEgressIdsMap();
+  std::unordered_map<bcm_if_t, bcm_gport_t> egress2Port;
+  EgressIdSet downEgressIds;
+  for (const auto& portAndEgressIds : *portAndEgressIdMapping) {
+    auto gport = portAndEgressIds->getID();
+    bool down = BcmPort::isValidLocalPort(gport) &&
+        !hw_->isPortUp(PortID(BCM_GPORT_LOCAL_GET(gport)));
+    for (auto egressId : portAndEgressIds->getEgressIds()) {
+      egress2Port[egressId] = gport;
+      if (down) {
+        downEgressIds.insert(egressId);
+      }
+    }
+  }
+
+  // Hottest groups first
+  std::vector<std::pair<long, const BcmEcmpEgress*>> groups;
+  const auto& nextHops = hw_->getMultiPathNextHopTable()->getNextHops();
+  for (const auto& [key, weakPtr] : nextHops) {
+    auto nextHop = weakPtr.lock();
+    if (nextHop && nextHop->getEgress()) {
+      groups.emplace_back(nextHops.referenceCount(key), nextHop->getEgress());
+    }
+  }
+  std::stable_sort(groups.begin(), groups.end(), [](auto lhs, auto rhs) {
+    return lhs.first > rhs.first;
+  });
+
+  auto backups = std::make_shared<EcmpLinkDownBackups>();
+  boost::container::flat_set<bcm_gport_t> partiallyBackedPorts;
+  uint32_t numBackups = 0;
+  for (const auto& group : groups) {
+    auto ecmpEgress = group.second;
+    boost::container::flat_map<bcm_gport_t, EgressIdSet> port2EgressIds;
+    // Trunk egresses are removed when trunks go down, which is not tracked
+    // here, so groups over trunks are left to the traversal
+    bool overTrunk = false;
+    for (const auto& path : ecmpEgress->egressId2Weight()) {
+      auto itr = egress2Port.find(path.first);
+      if (itr == egress2Port.end()) {
+        continue;
+      }
+      overTrunk |= !BcmPort::isValidLocalPort(itr->second);
+      port2EgressIds[itr->second].insert(path.first);
+    }
+    for (const auto& [gport, egressIds] : port2EgressIds) {
+      std::optional<BcmEcmpEgress::LinkDownMembers> members;
+      if (!overTrunk && numBackups < FLAGS_ecmp_backup_groups) {
+        auto toRemove = downEgressIds;
+        toRemove.insert(egressIds.begin(), egressIds.end());
+        members = ecmpEgress->getLinkDownMembers(toRemove);
+      }
+      if (members) {
+        backups->port2Backups[gport].push_back(std::move(*members));
+        ++numBackups;
+      } else {
+        partiallyBackedPorts.insert(gport);
+      }
+    }
+  }
+  for (const auto& portAndEgressIds : *portAndEgressIdMapping) {
+    auto gport = portAndEgressIds->getID();
+    if (partiallyBackedPorts.find(gport) == partiallyBackedPorts.end()) {
+      backups->fullyBackedPorts.insert(gport);
+    }
+  }
+  XLOG(DBG2) << "Computed " << numBackups << " ECMP link down backups for "
+             << groups.size() << " ECMP groups";
+
+  std::unique_lock guard(portAndEgressIdsLock_);
+  // Drop the backups if a link went down or state changed meanwhile
+  if (generation == ecmpLinkDownBackupsGeneration_) {
+    ecmpLinkDownBackups_ = std::move(backups);
+  }
+}
+
 template <typename T>
 BcmEgressManager::EgressIdAndWeight BcmEgressManager::toEgressIdAndWeight(
     T egress) {
@@ -14,12 +14,17 @@
 
 #include <folly/SpinLock.h>
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 extern "C" {
 #include <bcm/l3.h>
 #include <bcm/types.h>
 }
 
 DECLARE_uint32(ecmp_width);
+DECLARE_uint32(ecmp_backup_groups);
 
 namespace facebook::fboss {
 
@@ -93,12 +98,48 @@ class BcmEgressManager {
   }
   void resolved(const bcm_if_t egressId) {
     resolvedEgresses_.insert(egressId);
+    invalidateEcmpLinkDownBackups();
   }
   void unresolved(const bcm_if_t egressId) {
     resolvedEgresses_.erase(egressId);
+    invalidateEcmpLinkDownBackups();
   }
 
+  /*
+   * ECMP link down backups
+   * For the ECMP groups with the most routes, precompute the members left
+   * once each port goes down. On link down, those groups are then shrunk by
+   * replacing all their members in one call, before (or, if every group
+   * over the port has a backup, instead of) traversing all ECMP groups.
+   * The number of backups is capped by --ecmp_backup_groups.
+   *
+   * Backups are dropped whenever egresses, their resolution, ECMP groups or
+   * link states change, and recomputed at the end of the next state update.
+   * Must be called while holding the hw lock.
+   */
+  void updateEcmpLinkDownBackupsHwLocked();
+  void invalidateEcmpLinkDownBackups();
+  /*
+   * ECMP members are changed while holding the hw lock, and by link down
+   * handling without it. Changes made while holding the hw lock must also
+   * hold the returned lock, which drops the link down backups, so that a
+   * link down never replaces the members of a group from backups computed
+   * before such a change.
+   */
+  std::unique_lock<std::mutex> lockEcmpMembersHwLocked();
+
  private:
+  struct EcmpLinkDownBackups {
+    using Backups = std::vector<BcmEcmpEgress::LinkDownMembers>;
+    boost::container::flat_map<bcm_gport_t, Backups> port2Backups;
+    // Ports all of whose ECMP groups have a backup
+    boost::container::flat_set<bcm_gport_t> fullyBackedPorts;
+  };
+  /*
+   * Apply the backups for a port going down and drop all backups. Returns
+   * true if that shrunk every ECMP group over the port.
+   */
+  bool applyEcmpLinkDownBackupsHwNotLocked(bcm_gport_t gport);
   /*
    * Called both while holding and not holding the hw lock.
    */
@@ -137,6 +178,13 @@ class BcmEgressManager {
    */
   std::shared_ptr<PortAndEgressIdsMap> portAndEgressIdsDontUseDirectly_;
   mutable folly::SpinLock portAndEgressIdsLock_;
+  // Also guarded by portAndEgressIdsLock_, null when invalidated
+  std::shared_ptr<const EcmpLinkDownBackups> ecmpLinkDownBackups_;
+  uint64_t ecmpLinkDownBackupsGeneration_{0};
+  // Set when the backups are dropped, cleared when recomputing them
+  bool ecmpLinkDownBackupsStale_{true};
+  // Held across applying the link down backups, see lockEcmpMembersHwLocked()
+  std::mutex ecmpMembersLock_;
   boost::container::flat_set<bcm_if_t> resolvedEgresses_;
 };
 
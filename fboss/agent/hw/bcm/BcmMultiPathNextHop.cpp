@@ -2,6 +2,7 @@
 
 #include "fboss/agent/hw/bcm/BcmMultiPathNextHop.h"
 
+#include "fboss/agent/hw/bcm/BcmEgressManager.h"
 #include "fboss/agent/hw/bcm/BcmHost.h"
 #include "fboss/agent/hw/bcm/BcmIntf.h"
 #include "fboss/agent/hw/bcm/BcmNextHop.h"
@@ -81,6 +82,8 @@ void BcmMultiPathNextHopTable::egressResolutionChangedHwLocked(
   if (action == BcmEcmpEgress::Action::SKIP) {
     return;
   }
+  auto ecmpMembersGuard =
+      getBcmSwitch()->writableEgressManager()->lockEcmpMembersHwLocked();
 
   for (const auto& nextHopsAndEcmpHostInfo : getNextHops()) {
     auto weakPtr = nextHopsAndEcmpHostInfo.second;
@@ -401,8 +401,9 @@ void BcmSwitch::resetTables() {
   // reset interfaces before host table, as interfaces have
   // host references now.
   intfTable_.reset();
-  egressManager_.reset();
+  // ECMP egresses lock ECMP members in the egress manager when destroyed
   multiPathNextHopTable_.reset();
+  egressManager_.reset();
   hostTable_.reset();
   toCPUEgress_.reset();
   portTable_.reset();
@@ -1262,6 +1263,9 @@ std::shared_ptr<SwitchState> BcmSwitch::stateChangedImpl(
   // ingressVlan and speed correctly before enabling.
   processEnabledPorts(delta);
 
+  // Recompute ECMP link down backups dropped by the changes above
+  egressManager_->updateEcmpLinkDownBackupsHwLocked();
+
   bcmStatUpdater_->refreshPostBcmStateChange(delta);
 
   return appliedState;
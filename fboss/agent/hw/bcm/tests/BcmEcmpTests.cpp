@@ -14,6 +14,7 @@
 #include "fboss/agent/FibHelpers.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/hw/bcm/BcmEcmpUtils.h"
+#include "fboss/agent/hw/bcm/BcmEgressManager.h"
 #include "fboss/agent/hw/bcm/BcmError.h"
 #include "fboss/agent/hw/bcm/BcmHost.h"
 #include "fboss/agent/hw/bcm/BcmMultiPathNextHop.h"
@@ -33,6 +34,7 @@
 #include <memory>
 #include <numeric>
 #include <set>
+#include <thread>
 
 extern "C" {
 #include <bcm/l3.h>
@@ -187,4 +189,56 @@ TEST_F(BcmEcmpTest, NativeUcmpFlag) {
   EXPECT_FALSE(utility::isNativeUcmpEnabled(getHwSwitch(), ecmp));
 }
 
+TEST_F(BcmEcmpTest, LinkDownBackupsDoNotUndoExpand) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_ecmp_backup_groups = 1000;
+  applyNewState(
+      ecmpHelper_->resolveNextHops(getProgrammedState(), kNumNextHops));
+  ecmpHelper_->programRoutes(getRouteUpdater(), kNumNextHops);
+  auto egressManager = getHwSwitch()->writableEgressManager();
+  auto egressIdOf = [&](int i) {
+    auto port = ecmpHelper_->getNextHops().at(i).portDesc.phyPortID();
+    auto portAndEgressIds =
+        egressManager->getPortAndEgressIdsMap()->getPortAndEgressIdsIf(
+            BcmPort::asGPort(port));
+    return *portAndEgressIds->getEgressIds().begin();
+  };
+  auto expanded = egressIdOf(0);
+  auto down = egressIdOf(1);
+
+  // Backups computed while next hop 0 is unresolved leave it out
+  applyNewState(ecmpHelper_->unresolveNextHops(
+      getProgrammedState(), {ecmpHelper_->getNextHops().at(0).portDesc}));
+  auto ecmpEgress = getEcmpEgress();
+  auto asic = getHwSwitch()->getPlatform()->getAsic();
+  {
+    // Next hop 0 getting resolved again under the hw lock, while the
+    // linkscan thread handles the port of next hop 1 going down
+    auto ecmpMembersGuard = egressManager->lockEcmpMembersHwLocked();
+    std::thread linkscan([&] {
+      egressManager->linkDownHwNotLocked(
+          ecmpHelper_->getNextHops().at(1).portDesc.phyPortID());
+    });
+    BcmEcmpEgress::addEgressIdHwLocked(
+        getUnit(),
+        ecmpEgress->getID(),
+        ecmpEgress->egressId2Weight(),
+        expanded,
+        getHwSwitch()->getRunState(),
+        false /* ucmpEnabled */,
+        asic->isSupported(HwAsic::Feature::WIDE_ECMP),
+        asic->isSupported(HwAsic::Feature::HSDK));
+    ecmpMembersGuard.unlock();
+    linkscan.join();
+  }
+
+  // The link down must not replace the group with members predating the
+  // expand
+  auto members =
+      getEcmpGroupInHw(getHwSwitch(), ecmpEgress->getID(), kNumNextHops);
+  EXPECT_EQ(kNumNextHops - 1, static_cast<int>(members.size()));
+  EXPECT_EQ(1u, members.count(expanded));
+  EXPECT_EQ(0u, members.count(down));
+}
+
 } // namespace facebook::fboss
@@ -27,10 +27,10 @@ class BcmLinkStateToggler : public HwLinkStateToggler {
       BcmSwitchEnsemble* ensemble,
       cfg::PortLoopbackMode desiredLoopbackMode)
       : HwLinkStateToggler(ensemble, desiredLoopbackMode) {}
+  void invokeLinkScanIfNeeded(PortID port, bool isUp) override;
 
  private:
   BcmSwitch* getHw();
-  void invokeLinkScanIfNeeded(PortID port, bool isUp) override;
   void setPortPreemphasis(const std::shared_ptr<Port>& port, int preemphasis)
       override;
 };
@@ -16,19 +16,62 @@
 #include "fboss/agent/hw/test/HwTestEcmpUtils.h"
 #include "fboss/agent/hw/test/HwTestPortUtils.h"
 #include "fboss/agent/state/Port.h"
+#include "fboss/agent/state/RouteTypes.h"
 #include "fboss/agent/test/EcmpSetupHelper.h"
 #include "fboss/lib/FunctionCallTimeReporter.h"
 
 #include <folly/Benchmark.h>
+#include <folly/Format.h>
 #include <folly/IPAddress.h>
+#include <gflags/gflags.h>
 
 namespace facebook::fboss {
 
 using utility::getEcmpSizeInHw;
 
-BENCHMARK(HwEcmpGroupShrink) {
+namespace {
+constexpr int kEcmpWidth = 4;
+// Ports with next hops, the ECMP group under test uses the first kEcmpWidth
+constexpr int kNumNextHopPorts = 8;
+
+/*
+ * Program additional ECMP groups over subsets of next hop ports which do not
+ * include the port brought down. Link down handling should not have to walk
+ * these, so shrink time should not grow with their number.
+ */
+void programUnaffectedGroups(
+    HwSwitchEnsemble* ensemble,
+    const utility::EcmpSetupAnyNPorts6& ecmpHelper,
+    int numGroups) {
+  auto portDescs = ecmpHelper.ecmpPortDescs(kNumNextHopPorts);
+  int programmed = 0;
+  // Every subset of two or more of the ports other than the first
+  for (uint32_t mask = 1; mask < (1 << (kNumNextHopPorts - 1)) &&
+       programmed < numGroups;
+       ++mask) {
+    if (__builtin_popcount(mask) < 2) {
+      continue;
+    }
+    boost::container::flat_set<PortDescriptor> groupPorts;
+    for (int i = 0; i < kNumNextHopPorts - 1; ++i) {
+      if (mask & (1 << i)) {
+        groupPorts.insert(portDescs[i + 1]);
+      }
+    }
+    auto prefix = RoutePrefixV6{
+        folly::IPAddressV6(folly::sformat("2401:db00:{:x}::", mask)), 64};
+    ecmpHelper.programRoutes(
+        std::make_unique<HwSwitchEnsembleRouteUpdateWrapper>(
+            ensemble->getRouteUpdater()),
+        groupPorts,
+        {prefix});
+    ++programmed;
+  }
+  CHECK_EQ(programmed, numGroups);
+}
+
+void runEcmpShrinkBenchmark(int numUnaffectedGroups) {
   folly::BenchmarkSuspender suspender;
-  constexpr int kEcmpWidth = 4;
   auto ensemble = createHwEnsemble(HwSwitchEnsemble::getAllFeatures());
   auto hwSwitch = ensemble->getHwSwitch();
   auto config =
@@ -36,12 +79,13 @@ BENCHMARK(HwEcmpGroupShrink) {
   ensemble->applyInitialConfig(config);
   auto ecmpHelper =
       utility::EcmpSetupAnyNPorts6(ensemble->getProgrammedState());
-  ensemble->applyNewState(
-      ecmpHelper.resolveNextHops(ensemble->getProgrammedState(), kEcmpWidth));
+  ensemble->applyNewState(ecmpHelper.resolveNextHops(
+      ensemble->getProgrammedState(), kNumNextHopPorts));
   ecmpHelper.programRoutes(
       std::make_unique<HwSwitchEnsembleRouteUpdateWrapper>(
           ensemble->getRouteUpdater()),
       kEcmpWidth);
+  programUnaffectedGroups(ensemble.get(), ecmpHelper, numUnaffectedGroups);
   auto prefix = folly::CIDRNetwork(folly::IPAddress("::"), 0);
   CHECK_EQ(
       kEcmpWidth,
@@ -53,10 +97,11 @@ BENCHMARK(HwEcmpGroupShrink) {
   // applyState interface. We want to start the clock ASAP post the link toggle,
   // so avoiding any extra apply state over head may give us slightly more
   // accurate reading for this micro benchmark.
-  utility::setPortLoopbackMode(
-      hwSwitch,
-      ecmpHelper.ecmpPortDescriptorAt(0).phyPortID(),
-      cfg::PortLoopbackMode::NONE);
+  auto downPort = ecmpHelper.ecmpPortDescriptorAt(0).phyPortID();
+  utility::setPortLoopbackMode(hwSwitch, downPort, cfg::PortLoopbackMode::NONE);
+  // Platforms without link scan, e.g. fake ones, do not notice the loopback
+  // change, signal the link down as link scan would
+  ensemble->getLinkToggler()->invokeLinkScanIfNeeded(downPort, false);
   {
     ScopedCallTimer timeIt;
     // We restart benchmarking ASAP *after* we have triggered port down
@@ -84,5 +129,25 @@ BENCHMARK(HwEcmpGroupShrink) {
     suspender.rehire();
   }
 }
+} // namespace
+
+BENCHMARK(HwEcmpGroupShrink) {
+  runEcmpShrinkBenchmark(0);
+}
+
+BENCHMARK(HwEcmpGroupShrinkWithUnaffectedGroups) {
+  runEcmpShrinkBenchmark(100);
+}
+
+/*
+ * Same as above, with link down members precomputed for every ECMP group
+ * (BCM only, other switches ignore the flag), so link down shrinks the group
+ * under test without traversing the unaffected ones.
+ */
+BENCHMARK(HwEcmpGroupShrinkWithUnaffectedGroupsAndBackups) {
+  gflags::FlagSaver flagSaver;
+  gflags::SetCommandLineOption("ecmp_backup_groups", "1000");
+  runEcmpShrinkBenchmark(100);
+}
 
 } // namespace facebook::fboss
@@ -22,6 +22,7 @@
 
 #include <folly/Benchmark.h>
 #include <folly/IPAddress.h>
+#include <gflags/gflags.h>
 
 #include <thread>
 
@@ -29,7 +30,8 @@ namespace facebook::fboss {
 
 using utility::getEcmpSizeInHw;
 
-BENCHMARK(HwEcmpGroupShrinkWithCompetingRouteUpdates) {
+namespace {
+void runEcmpShrinkWithCompetingRouteUpdatesBenchmark() {
   folly::BenchmarkSuspender suspender;
   constexpr int kEcmpWidth = 4;
   auto ensemble = createHwEnsemble(
@@ -104,5 +106,22 @@ BENCHMARK(HwEcmpGroupShrinkWithCompetingRouteUpdates) {
   }
   t.join();
 }
+} // namespace
+
+BENCHMARK(HwEcmpGroupShrinkWithCompetingRouteUpdates) {
+  runEcmpShrinkWithCompetingRouteUpdatesBenchmark();
+}
+
+/*
+ * Same as above, with link down members precomputed (BCM only, other
+ * switches ignore the flag). Each competing route update ends by
+ * recomputing the backups if anything dropped them, so this also covers
+ * the cost that adds to state updates.
+ */
+BENCHMARK(HwEcmpGroupShrinkWithCompetingRouteUpdatesAndBackups) {
+  gflags::FlagSaver flagSaver;
+  gflags::SetCommandLineOption("ecmp_backup_groups", "1000");
+  runEcmpShrinkWithCompetingRouteUpdatesBenchmark();
+}
 
 } // namespace facebook::fboss
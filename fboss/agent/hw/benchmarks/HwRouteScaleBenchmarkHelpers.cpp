@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/benchmarks/HwRouteScaleBenchmarkHelpers.h"
+
+DEFINE_bool(
+    route_stage_breakdown,
+    false,
+    "Print the time route benchmarks spent in each stage of route "
+    "programming");
+
+namespace facebook::fboss {
+
+void printRouteProgrammingStages(HwSwitchEnsemble* ensemble) {
+  auto latencies = ensemble->getRouteProgrammingLatency()->getLatencies();
+  if (FLAGS_json) {
+    folly::dynamic stages = folly::dynamic::object;
+    for (const auto& latency : latencies) {
+      folly::dynamic stage = folly::dynamic::object;
+      stage["count"] = latency.count;
+      stage["total_us"] = latency.total.count();
+      stage["max_us"] = latency.max.count();
+      stage["p50_us"] = latency.p50.count();
+      stage["p99_us"] = latency.p99.count();
+      stages[routeProgrammingStageName(latency.stage).str()] = stage;
+    }
+    folly::dynamic breakdown = folly::dynamic::object;
+    breakdown["route_programming_stages"] = stages;
+    std::cout << toPrettyJson(breakdown) << std::endl;
+  } else {
+    for (const auto& latency : latencies) {
+      XLOG(INFO) << routeProgrammingStageName(latency.stage)
+                 << " : count: " << latency.count
+                 << " total_us: " << latency.total.count()
+                 << " max_us: " << latency.max.count()
+                 << " p50_us: " << latency.p50.count()
+                 << " p99_us: " << latency.p99.count();
+    }
+  }
+}
+
+} // namespace facebook::fboss
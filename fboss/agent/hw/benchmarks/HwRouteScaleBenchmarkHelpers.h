@@ -7,6 +7,7 @@
  *  of patent rights can be found in the PATENTS file in the same directory.
  *
  */
+#pragma once
 
 #include "fboss/agent/HwSwitch.h"
 #include "fboss/agent/hw/test/ConfigFactory.h"
@@ -23,9 +24,16 @@
 #include "fboss/lib/FunctionCallTimeReporter.h"
 
 DECLARE_bool(json);
+DECLARE_bool(route_stage_breakdown);
 
 namespace facebook::fboss {
 
+/*
+ * Print the time the routes programmed through the ensemble's route updater
+ * spent in each stage, see --route_stage_breakdown
+ */
+void printRouteProgrammingStages(HwSwitchEnsemble* ensemble);
+
 /*
  * Helper function to benchmark speed of route insertion, deletion
  * in HW. This function inits the ASIC, generate switch states for
@@ -117,6 +125,7 @@ void routeAddDelBenchmarker(bool measureAdd) {
       // Activate benchmarker before applying switch states
       // for adding routes to h/w
       suspender.dismiss();
+      ensemble->getRouteProgrammingLatency()->clear();
       // Program 1 chunk to seed ~4k routes
       // program remaining chunks
       updater.programRoutes(RouterID(0), ClientID::BGPD, routeChunks);
@@ -124,6 +133,9 @@ void routeAddDelBenchmarker(bool measureAdd) {
       // deactivate benchmark measurement.
       suspender.rehire();
     }
+    if (FLAGS_route_stage_breakdown) {
+      printRouteProgrammingStages(ensemble.get());
+    }
     // Do a sync fib and have it compete with route lookups
     auto syncFib =
         [&updater,
@@ -149,12 +161,18 @@ void routeAddDelBenchmarker(bool measureAdd) {
     syncFib(allThriftRoutes);
   } else {
     updater.programRoutes(kRid, ClientID::BGPD, routeChunks);
-    ScopedCallTimer timeIt;
-    // We are about to blow away all routes, before that
-    // activate benchmark measurement.
-    suspender.dismiss();
-    updater.unprogramRoutes(kRid, ClientID::BGPD, routeChunks);
-    suspender.rehire();
+    ensemble->getRouteProgrammingLatency()->clear();
+    {
+      ScopedCallTimer timeIt;
+      // We are about to blow away all routes, before that
+      // activate benchmark measurement.
+      suspender.dismiss();
+      updater.unprogramRoutes(kRid, ClientID::BGPD, routeChunks);
+      suspender.rehire();
+    }
+    if (FLAGS_route_stage_breakdown) {
+      printRouteProgrammingStages(ensemble.get());
+    }
   }
   done = true;
   lookupThread.join();
@@ -11,9 +11,29 @@
 #include "fboss/agent/hw/sai/hw_test/SaiLinkStateToggler.h"
 
 #include "fboss/agent/hw/sai/switch/SaiPortManager.h"
+#include "fboss/agent/hw/switch_asics/HwAsic.h"
 #include "fboss/agent/hw/sai/switch/SaiSwitch.h"
 
 namespace facebook::fboss {
+void SaiLinkStateToggler::invokeLinkScanIfNeeded(PortID port, bool isUp) {
+  if (saiEnsemble_->getAsic()->getAsicType() !=
+      HwAsic::AsicType::ASIC_TYPE_FAKE) {
+    return;
+  }
+  /* fake sai does not generate port state notifications, so mimic them
+   * by invoking the link state callback of the sai switch */
+  auto saiSwitch = saiEnsemble_->getHwSwitch();
+  auto portHandle =
+      saiSwitch->managerTable()->portManager().getPortHandle(port);
+  if (!portHandle) {
+    throw FbossError("Cannot toggle link of non existent port: ", port);
+  }
+  sai_port_oper_status_notification_t operStatus{
+      portHandle->port->adapterKey(),
+      isUp ? SAI_PORT_OPER_STATUS_UP : SAI_PORT_OPER_STATUS_DOWN};
+  saiSwitch->linkStateChangedCallbackTopHalf(1, &operStatus);
+}
+
 void SaiLinkStateToggler::setPortPreemphasis(
     const std::shared_ptr<Port>& port,
     int preemphasis) {
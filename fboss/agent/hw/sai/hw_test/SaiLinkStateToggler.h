@@ -27,11 +27,9 @@ class SaiLinkStateToggler : public HwLinkStateToggler {
       cfg::PortLoopbackMode desiredLoopbackMode)
       : HwLinkStateToggler(ensemble, desiredLoopbackMode),
         saiEnsemble_(ensemble) {}
+  void invokeLinkScanIfNeeded(PortID port, bool isUp) override;
 
  private:
-  void invokeLinkScanIfNeeded(PortID /*port*/, bool /*isUp*/) override {
-    // TODO
-  }
   void setPortPreemphasis(const std::shared_ptr<Port>& port, int preemphasis)
       override;
   SaiSwitchEnsemble* saiEnsemble_;
@@ -25,7 +25,9 @@
 #include "fboss/agent/platforms/sai/SaiPlatform.h"
 
 #include <folly/MacAddress.h>
+#include <algorithm>
 #include <chrono>
+#include <limits>
 #include <memory>
 
 using namespace std::chrono;
@@ -216,18 +218,26 @@ sai_uint32_t SaiAclTableManager::swPriorityToSaiPriority(int priority) const {
    * But larger priority means higher priority is documented here:
    * https://github.com/opencomputeproject/SAI/blob/master/doc/SAI-Proposal-ACL-1.md
    */
-  sai_uint32_t saiPriority = aclEntryMaximumPriority_ - priority;
-  if (saiPriority < aclEntryMinimumPriority_) {
+  // Compare before subtracting, the unsigned difference would wrap around
+  if (priority < 0 ||
+      static_cast<sai_uint32_t>(priority) >
+          aclEntryMaximumPriority_ - aclEntryMinimumPriority_) {
     throw FbossError(
         "Acl Entry priority out of range. Supported: [",
         aclEntryMinimumPriority_,
         ", ",
         aclEntryMaximumPriority_,
         "], specified: ",
-        saiPriority);
+        static_cast<int64_t>(aclEntryMaximumPriority_) - priority);
   }
 
-  return saiPriority;
+  return aclEntryMaximumPriority_ - priority;
+}
+
+int SaiAclTableManager::getMaxAclEntryPriority() const {
+  return std::min<sai_uint32_t>(
+      aclEntryMaximumPriority_ - aclEntryMinimumPriority_,
+      std::numeric_limits<int>::max());
 }
 
 sai_acl_ip_frag_t SaiAclTableManager::cfgIpFragToSaiIpFrag(
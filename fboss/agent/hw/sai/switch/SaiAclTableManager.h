@@ -139,6 +139,8 @@ class SaiAclTableManager {
   void removeAclCounter(const cfg::TrafficCounter& trafficCount);
 
   sai_uint32_t swPriorityToSaiPriority(int priority) const;
+  // Highest SwitchState priority within the range supported by the switch
+  int getMaxAclEntryPriority() const;
 
   sai_acl_ip_frag_t cfgIpFragToSaiIpFrag(cfg::IpFragMatch cfgType) const;
   sai_acl_ip_type_t cfgIpTypeToSaiIpType(cfg::IpType cfgIpType) const;
@@ -118,6 +118,7 @@ void SaiNeighborManager::addNeighbor(
 
   SaiObjectEventPublisher::getInstance()->get<SaiFdbTraits>().subscribe(
       subscriber);
+  portToNeighbors_[saiPortDesc].emplace(subscriberKey);
   managedNeighbors_.emplace(subscriberKey, std::move(subscriber));
   XLOG(DBG2) << "Add Neighbor: create ManagedNeighbor" << swEntry->str();
 }
@@ -131,15 +132,25 @@ void SaiNeighborManager::removeNeighbor(
   }
   XLOG(INFO) << "removeNeighbor " << swEntry->getIP();
   auto subscriberKey = saiEntryFromSwEntry(swEntry);
-  if (managedNeighbors_.find(subscriberKey) == managedNeighbors_.end()) {
+  auto itr = managedNeighbors_.find(subscriberKey);
+  if (itr == managedNeighbors_.end()) {
     throw FbossError(
         "Attempted to remove non-existent neighbor: ", swEntry->getIP());
   }
-  managedNeighbors_.erase(subscriberKey);
+  auto portToNeighborsItr =
+      portToNeighbors_.find(itr->second->getSaiPortDesc());
+  if (portToNeighborsItr != portToNeighbors_.end()) {
+    portToNeighborsItr->second.erase(subscriberKey);
+    if (portToNeighborsItr->second.empty()) {
+      portToNeighbors_.erase(portToNeighborsItr);
+    }
+  }
+  managedNeighbors_.erase(itr);
   XLOG(DBG2) << "Remove Neighbor: " << swEntry->str();
 }
 
 void SaiNeighborManager::clear() {
+  portToNeighbors_.clear();
   managedNeighbors_.clear();
 }
 
@@ -183,6 +194,25 @@ bool SaiNeighborManager::isLinkUp(SaiPortDescriptor port) {
   return managerTable_->lagManager().isMinimumLinkMet(port.aggPortID());
 }
 
+void SaiNeighborManager::handleLinkDown(SaiPortDescriptor port) {
+  auto portToNeighborsItr = portToNeighbors_.find(port);
+  if (portToNeighborsItr == portToNeighbors_.end()) {
+    return;
+  }
+  XLOGF(
+      DBG2,
+      "link down on {}, notifying {} neighbors",
+      port.str(),
+      portToNeighborsItr->second.size());
+  for (const auto& key : portToNeighborsItr->second) {
+    auto itr = managedNeighbors_.find(key);
+    if (UNLIKELY(itr == managedNeighbors_.end())) {
+      XLOGF(FATAL, "no neighbor found for key in portToNeighbors_: {}", key);
+    }
+    itr->second->handleLinkDown();
+  }
+}
+
 std::string SaiNeighborManager::listManagedObjects() const {
   std::string output{};
   for (auto entry : managedNeighbors_) {
@@ -18,6 +18,7 @@
 #include "fboss/agent/types.h"
 
 #include "folly/container/F14Map.h"
+#include "folly/container/F14Set.h"
 
 #include <memory>
 #include <mutex>
@@ -129,6 +130,14 @@ class SaiNeighborManager {
 
   bool isLinkUp(SaiPortDescriptor port);
 
+  /*
+   * Notify next hops over the neighbors on this port or LAG that the link
+   * went down, so that next hop groups using them shrink. Work is
+   * proportional to the neighbors on the port, not the number of neighbors
+   * or next hop groups on the switch.
+   */
+  void handleLinkDown(SaiPortDescriptor port);
+
   std::string listManagedObjects() const;
 
  private:
@@ -142,6 +151,11 @@ class SaiNeighborManager {
       SaiNeighborTraits::NeighborEntry,
       std::shared_ptr<ManagedNeighbor>>
       managedNeighbors_;
+  // Reverse index of managedNeighbors_ by the port or LAG they are on
+  folly::F14FastMap<
+      SaiPortDescriptor,
+      folly::F14FastSet<SaiNeighborTraits::NeighborEntry>>
+      portToNeighbors_;
 };
 
 } // namespace facebook::fboss
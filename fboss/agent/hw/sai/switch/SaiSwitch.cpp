@@ -1095,8 +1095,10 @@ void SaiSwitch::linkStateChangedCallbackBottomHalf(
        * Only link down are handled in the fast path. We let the
        * link up processing happen via the regular state change
        * mechanism. Reason for that is, post a link down
-       * - We signal FDB entry, neighbor entry, next hop and next hop group
-       *   that a link went down.
+       * - We signal neighbor entries on the port, and through them next
+       *   hops and next hop groups, that a link went down. Neighbors are
+       *   found through a per port index, so this is proportional to the
+       *   affected neighbors rather than to all L2 entries on the port.
        * - Next hop group then shrinks the group based on which next hops are
        * affected.
        * - We now signal the callback (SwSwitch for wedge_agent, HwTest for hw
@@ -1122,13 +1124,14 @@ void SaiSwitch::linkStateChangedCallbackBottomHalf(
         // again
         managerTable_->lagManager().disableMember(swAggPort.value(), swPortId);
         if (!managerTable_->lagManager().isMinimumLinkMet(swAggPort.value())) {
-          // remove fdb entries on LAG, this would remove neighbors, next hops
-          // will point to drop and next hop group will shrink.
-          managerTable_->fdbManager().handleLinkDown(
+          // signal neighbors on LAG, this would remove next hops over them
+          // and next hop group will shrink.
+          managerTable_->neighborManager().handleLinkDown(
               SaiPortDescriptor(swAggPort.value()));
         }
       }
-      managerTable_->fdbManager().handleLinkDown(SaiPortDescriptor(swPortId));
+      managerTable_->neighborManager().handleLinkDown(
+          SaiPortDescriptor(swPortId));
       /*
        * Enable AFE adaptive mode (S249471) on TAJO platforms when a port
        * flaps
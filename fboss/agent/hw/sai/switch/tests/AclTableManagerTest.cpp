@@ -7,13 +7,21 @@
  *  of patent rights can be found in the PATENTS file in the same directory.
  *
  */
+#include "fboss/agent/AclPriorityAllocator.h"
+#include "fboss/agent/hw/sai/fake/FakeSai.h"
 #include "fboss/agent/hw/sai/switch/SaiAclTableGroupManager.h"
 #include "fboss/agent/hw/sai/switch/SaiAclTableManager.h"
 #include "fboss/agent/hw/sai/switch/SaiSwitch.h"
 #include "fboss/agent/hw/sai/switch/tests/ManagerTestBase.h"
 #include "fboss/agent/types.h"
 
+#include <folly/Conv.h>
+
+#include <limits>
+#include <map>
+#include <optional>
 #include <string>
+#include <vector>
 
 using namespace facebook::fboss;
 
@@ -46,6 +54,51 @@ class AclTableManagerTest : public ManagerTestBase {
   cfg::AclActionType kActionType() {
     return cfg::AclActionType::DENY;
   }
+
+  /*
+   * Program the ACL entries with the given names, in this order, letting the
+   * allocator keep the priorities of the programmed entries where it can.
+   * Entry names are their DSCP values.
+   */
+  void applyAcls(
+      const AclPriorityAllocator& allocator,
+      const std::vector<uint8_t>& names) {
+    auto newState = programmedState->clone();
+    auto origAcls = programmedState->getAcls();
+    std::vector<std::optional<int>> origPriorities;
+    for (auto name : names) {
+      std::optional<int> origPriority;
+      if (auto origAcl = origAcls->getEntryIf(folly::to<std::string>(name))) {
+        origPriority = origAcl->getPriority();
+      }
+      origPriorities.push_back(origPriority);
+    }
+    auto priorities = allocator.allocate(origPriorities);
+    auto acls = std::make_shared<AclMap>();
+    for (size_t i = 0; i < names.size(); ++i) {
+      auto aclEntry = std::make_shared<AclEntry>(
+          priorities[i], folly::to<std::string>(names[i]));
+      aclEntry->setDscp(names[i]);
+      aclEntry->setActionType(kActionType());
+      acls->addEntry(aclEntry);
+    }
+    newState->resetAcls(acls);
+    applyNewState(newState);
+  }
+
+  std::map<std::string, AclEntrySaiId> getAclEntryIds() {
+    auto aclTableHandle =
+        saiManagerTable->aclTableManager().getAclTableHandle(kAclTable1);
+    std::map<std::string, AclEntrySaiId> ids;
+    for (const auto& aclEntry : *programmedState->getAcls()) {
+      auto aclEntryHandle =
+          saiManagerTable->aclTableManager().getAclEntryHandle(
+              aclTableHandle, aclEntry->getPriority());
+      EXPECT_TRUE(aclEntryHandle);
+      ids.emplace(aclEntry->getID(), aclEntryHandle->aclEntry->adapterKey());
+    }
+    return ids;
+  }
 };
 
 TEST_F(AclTableManagerTest, addAclTable) {
@@ -225,6 +278,21 @@ TEST_F(AclTableManagerTest, checkNonExistentAclEntry) {
   EXPECT_FALSE(aclEntryHandle);
 }
 
+TEST_F(AclTableManagerTest, aclEntryPriorityOutOfRange) {
+  auto& aclTableManager = saiManagerTable->aclTableManager();
+  EXPECT_EQ(
+      aclTableManager.swPriorityToSaiPriority(0),
+      std::numeric_limits<uint32_t>::max());
+  // Would wrap around to the highest SAI priority if subtracted first
+  EXPECT_THROW(aclTableManager.swPriorityToSaiPriority(-1), FbossError);
+  // The supported range is wider than int, so every priority fits
+  EXPECT_EQ(
+      aclTableManager.getMaxAclEntryPriority(),
+      std::numeric_limits<int>::max());
+  EXPECT_NO_THROW(aclTableManager.swPriorityToSaiPriority(
+      aclTableManager.getMaxAclEntryPriority()));
+}
+
 TEST_F(AclTableManagerTest, aclMirroring) {
   std::string mirrorId = "mirror1";
   auto mirror = std::make_shared<Mirror>(mirrorId, PortID(1), std::nullopt);
@@ -243,3 +311,32 @@ TEST_F(AclTableManagerTest, aclMirroring) {
       aclEntryId, SaiAclEntryTraits::Attributes::ActionMirrorIngress());
   EXPECT_EQ((gotMirrorSaiIdList.getData())[0], mirrorHandle->adapterKey());
 }
+
+TEST_F(AclTableManagerTest, insertAclEntryInPriorityGap) {
+  AclPriorityAllocator allocator(1, 1000, 8);
+  applyAcls(allocator, {10, 20, 30, 40});
+  auto origIds = getAclEntryIds();
+  auto& fakeAclEntries = FakeSai::getInstance()->aclEntryManager.map();
+  EXPECT_EQ(4, fakeAclEntries.size());
+
+  // Only the inserted entry gets programmed, the others keep their SAI objects
+  applyAcls(allocator, {10, 15, 20, 30, 40});
+  auto ids = getAclEntryIds();
+  EXPECT_EQ(5, ids.size());
+  EXPECT_EQ(5, fakeAclEntries.size());
+  for (const auto& [name, id] : origIds) {
+    EXPECT_EQ(id, ids.at(name));
+  }
+  auto acls = programmedState->getAcls();
+  auto priority = acls->getEntry("15")->getPriority();
+  EXPECT_GT(priority, acls->getEntry("10")->getPriority());
+  EXPECT_LT(priority, acls->getEntry("20")->getPriority());
+
+  // Removing an entry leaves the others in place as well
+  applyAcls(allocator, {10, 15, 30, 40});
+  ids = getAclEntryIds();
+  EXPECT_EQ(4, fakeAclEntries.size());
+  for (const auto& name : {"10", "30", "40"}) {
+    EXPECT_EQ(origIds.at(name), ids.at(name));
+  }
+}
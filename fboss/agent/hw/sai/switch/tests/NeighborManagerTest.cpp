@@ -175,6 +175,23 @@ TEST_F(NeighborManagerTest, linkDown) {
   checkUnresolved(arpEntry);
 }
 
+TEST_F(NeighborManagerTest, neighborLinkDown) {
+  auto arpEntry = resolveArp(intf0.id, h0);
+  checkEntry(arpEntry, h0.mac);
+  saiManagerTable->neighborManager().handleLinkDown(
+      SaiPortDescriptor(PortID(h0.port.id)));
+  checkUnresolved(arpEntry);
+}
+
+TEST_F(NeighborManagerTest, neighborLinkDownAfterRemove) {
+  auto arpEntry = resolveArp(intf0.id, h0);
+  saiManagerTable->neighborManager().removeNeighbor(arpEntry);
+  // removed neighbors are no longer indexed by their port
+  saiManagerTable->neighborManager().handleLinkDown(
+      SaiPortDescriptor(PortID(h0.port.id)));
+  checkMissing(arpEntry);
+}
+
 TEST_F(NeighborManagerTest, linkDownReResolve) {
   saiManagerTable->bridgeManager().setL2LearningMode(
       cfg::L2LearningMode::SOFTWARE);
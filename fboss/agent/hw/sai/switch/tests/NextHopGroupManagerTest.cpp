@@ -166,6 +166,22 @@ TEST_F(NextHopGroupManagerTest, unresolveNeighbor) {
   checkNextHopGroup(saiNextHopGroup->adapterKey(), {});
 }
 
+TEST_F(NextHopGroupManagerTest, linkDownShrinksGroup) {
+  resolveArp(intf0.id, h0);
+  resolveArp(intf1.id, h1);
+  ResolvedNextHop nh1{h0.ip, InterfaceID(intf0.id), ECMP_WEIGHT};
+  ResolvedNextHop nh2{h1.ip, InterfaceID(intf1.id), ECMP_WEIGHT};
+  RouteNextHopEntry::NextHopSet swNextHops{nh1, nh2};
+  auto saiNextHopGroupHandle =
+      saiManagerTable->nextHopGroupManager().incRefOrAddNextHopGroup(
+          swNextHops);
+  auto saiNextHopGroup = saiNextHopGroupHandle->nextHopGroup;
+  checkNextHopGroup(saiNextHopGroup->adapterKey(), {h0.ip, h1.ip});
+  saiManagerTable->neighborManager().handleLinkDown(
+      SaiPortDescriptor(PortID(h1.port.id)));
+  checkNextHopGroup(saiNextHopGroup->adapterKey(), {h0.ip});
+}
+
 TEST_F(NextHopGroupManagerTest, derefThenResolve) {
   ResolvedNextHop nh1{h0.ip, InterfaceID(intf0.id), ECMP_WEIGHT};
   ResolvedNextHop nh2{h1.ip, InterfaceID(intf1.id), ECMP_WEIGHT};
@@ -0,0 +1,517 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/SaiBinaryTrace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/hw/sai/tracer/PortApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/SaiTracer.h"
+#include "fboss/agent/hw/sai/tracer/SwitchApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/TamApiTracer.h"
+
+#include <folly/logging/xlog.h>
+
+namespace facebook::fboss {
+
+namespace {
+
+std::string& recordBuffer() {
+  static thread_local std::string buffer;
+  return buffer;
+}
+
+// Out of line list an attribute value points to
+struct AttributeList {
+  uint32_t count;
+  // Address of the list pointer in the attribute value
+  void* listPtr;
+  size_t elemSize;
+
+  void* list() const {
+    void* list;
+    memcpy(&list, listPtr, sizeof(list));
+    return list;
+  }
+
+  void setList(void* list) {
+    memcpy(listPtr, &list, sizeof(list));
+  }
+};
+
+template <typename ListT>
+AttributeList makeAttributeList(ListT& list) {
+  return AttributeList{list.count, &list.list, sizeof(*list.list)};
+}
+
+// Lists are the attribute values SaiTracer prints through listFuncMap_ and
+// SET_SAI_STRING_ATTRIBUTES, anything else is fully contained in the
+// sai_attribute_t
+std::optional<AttributeList> getAttributeList(
+    std::size_t typeIndex,
+    sai_attribute_t& attr) {
+  if (typeIndex == TYPE_INDEX(std::vector<sai_object_id_t>)) {
+    return makeAttributeList(attr.value.objlist);
+  }
+  if (typeIndex == TYPE_INDEX(std::vector<sai_uint32_t>)) {
+    return makeAttributeList(attr.value.u32list);
+  }
+  if (typeIndex == TYPE_INDEX(std::vector<sai_int32_t>)) {
+    return makeAttributeList(attr.value.s32list);
+  }
+  if (typeIndex == TYPE_INDEX(std::vector<sai_qos_map_t>)) {
+    return makeAttributeList(attr.value.qosmap);
+  }
+  if (typeIndex == TYPE_INDEX(AclEntryActionSaiObjectIdList)) {
+    return makeAttributeList(attr.value.aclaction.parameter.objlist);
+  }
+  if (typeIndex == 0 &&
+      (attr.id == SAI_SWITCH_ATTR_SWITCH_HARDWARE_INFO ||
+       attr.id == SAI_SWITCH_ATTR_FIRMWARE_PATH_NAME)) {
+    return makeAttributeList(attr.value.s8list);
+  }
+  return std::nullopt;
+}
+
+// Number of list elements logged, the replayer source is limited to the same
+// (see SaiTracer::checkListCount())
+uint32_t loggedListCount(const AttributeList& list) {
+  return std::min<uint32_t>(
+      list.count, FLAGS_default_list_size * sizeof(int) / list.elemSize);
+}
+
+template <typename EntryT>
+void replayEntry(
+    SaiTracer& tracer,
+    const SaiTraceRecordHeader& header,
+    SaiTraceRecordReader& reader,
+    sai_object_type_t objectType,
+    void (SaiTracer::*create)(
+        const EntryT*,
+        uint32_t,
+        const sai_attribute_t*,
+        sai_status_t),
+    void (SaiTracer::*remove)(const EntryT*, sai_status_t),
+    void (SaiTracer::*setAttr)(
+        const EntryT*,
+        const sai_attribute_t*,
+        sai_status_t)) {
+  auto entry = reader.readStruct<EntryT>();
+  switch (header.type) {
+    case SaiTraceRecordType::ENTRY_CREATE: {
+      auto attrs = reader.readAttributes(tracer, objectType);
+      (tracer.*create)(&entry, attrs.size(), attrs.data(), header.rv);
+      break;
+    }
+    case SaiTraceRecordType::ENTRY_REMOVE:
+      (tracer.*remove)(&entry, header.rv);
+      break;
+    case SaiTraceRecordType::ENTRY_SET_ATTR: {
+      auto attrs = reader.readAttributes(tracer, objectType);
+      (tracer.*setAttr)(&entry, attrs.data(), header.rv);
+      break;
+    }
+    default:
+      throw FbossError(
+          "Unexpected entry record type ",
+          static_cast<uint32_t>(header.type));
+  }
+}
+
+} // namespace
+
+SaiTraceRecordWriter::SaiTraceRecordWriter(
+    SaiTraceRecordType type,
+    sai_status_t rv)
+    : buffer_(recordBuffer()) {
+  SaiTraceRecordHeader header{};
+  header.magic = kSaiTraceRecordMagic;
+  header.type = type;
+  header.rv = rv;
+  header.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+  buffer_.clear();
+  writeBytes(&header, sizeof(header));
+}
+
+void SaiTraceRecordWriter::writeU32(uint32_t value) {
+  writeBytes(&value, sizeof(value));
+}
+
+void SaiTraceRecordWriter::writeU64(uint64_t value) {
+  writeBytes(&value, sizeof(value));
+}
+
+void SaiTraceRecordWriter::writeBytes(const void* data, size_t size) {
+  if (size) {
+    buffer_.append(static_cast<const char*>(data), size);
+  }
+}
+
+void SaiTraceRecordWriter::writeString(const std::string& str) {
+  writeU32(str.size());
+  writeBytes(str.data(), str.size());
+}
+
+void SaiTraceRecordWriter::writeAttributes(
+    const SaiTracer& tracer,
+    sai_object_type_t objectType,
+    const sai_attribute_t* attrList,
+    uint32_t attrCount) {
+  writeU32(attrCount);
+  writeBytes(attrList, sizeof(sai_attribute_t) * attrCount);
+  for (uint32_t i = 0; i < attrCount; ++i) {
+    auto attr = attrList[i];
+    auto list =
+        getAttributeList(tracer.getAttributeType(objectType, attr.id), attr);
+    if (!list || !list->list()) {
+      continue;
+    }
+    auto count = loggedListCount(*list);
+    writeU32(count);
+    writeBytes(list->list(), list->elemSize * count);
+  }
+}
+
+folly::StringPiece SaiTraceRecordWriter::finish() {
+  uint32_t length = buffer_.size() - sizeof(SaiTraceRecordHeader);
+  memcpy(
+      buffer_.data() + offsetof(SaiTraceRecordHeader, length),
+      &length,
+      sizeof(length));
+  return buffer_;
+}
+
+uint32_t SaiTraceRecordReader::readU32() {
+  return readStruct<uint32_t>();
+}
+
+uint64_t SaiTraceRecordReader::readU64() {
+  return readStruct<uint64_t>();
+}
+
+folly::ByteRange SaiTraceRecordReader::readBytes(size_t size) {
+  if (payload_.size() < size) {
+    throw FbossError(
+        "SAI trace record too short, reading ",
+        size,
+        " bytes out of ",
+        payload_.size());
+  }
+  auto bytes = payload_.subpiece(0, size);
+  payload_.advance(size);
+  return bytes;
+}
+
+std::string SaiTraceRecordReader::readString() {
+  auto bytes = readBytes(readU32());
+  return std::string(bytes.begin(), bytes.end());
+}
+
+std::vector<sai_attribute_t> SaiTraceRecordReader::readAttributes(
+    const SaiTracer& tracer,
+    sai_object_type_t objectType) {
+  auto attrs = readArray<sai_attribute_t>(readU32());
+  for (auto& attr : attrs) {
+    auto list =
+        getAttributeList(tracer.getAttributeType(objectType, attr.id), attr);
+    if (!list || !list->list()) {
+      continue;
+    }
+    auto count = readU32();
+    // The text logging functions print up to this many elements of the list
+    if (count != loggedListCount(*list)) {
+      throw FbossError(
+          "Corrupt SAI trace record, list of ",
+          list->count,
+          " elements logged with ",
+          count,
+          " elements");
+    }
+    auto bytes = readBytes(list->elemSize * count);
+    // Never empty, so that an empty list is not mistaken for a null one
+    auto& storage =
+        lists_.emplace_back(std::max<size_t>(bytes.size(), 1), uint8_t(0));
+    memcpy(storage.data(), bytes.data(), bytes.size());
+    list->setList(storage.data());
+  }
+  return attrs;
+}
+
+std::vector<SaiBinaryTraceConverter::Boot> SaiBinaryTraceConverter::parse(
+    folly::ByteRange trace) {
+  std::vector<Boot> boots;
+  std::vector<std::string> comments;
+  auto start = trace.begin();
+
+  while (!trace.empty()) {
+    // Boot header lines written by AsyncLogger
+    if (trace.front() == '/' || trace.front() == '\n') {
+      auto end = std::find(trace.begin(), trace.end(), '\n');
+      if (end != trace.begin()) {
+        comments.emplace_back(trace.begin(), end);
+      }
+      trace.advance(std::min<size_t>(end - trace.begin() + 1, trace.size()));
+      continue;
+    }
+
+    SaiTraceRecordHeader header;
+    if (trace.size() < sizeof(header)) {
+      XLOG(WARN) << "Ignoring truncated record at offset "
+                 << trace.begin() - start;
+      break;
+    }
+    memcpy(&header, trace.data(), sizeof(header));
+    if (header.magic != kSaiTraceRecordMagic) {
+      XLOG(WARN) << "Unexpected data at offset " << trace.begin() - start
+                 << ", ignoring the rest of the trace";
+      break;
+    }
+    if (trace.size() - sizeof(header) < header.length) {
+      XLOG(WARN) << "Ignoring truncated record at offset "
+                 << trace.begin() - start;
+      break;
+    }
+
+    Record record{header, trace.subpiece(sizeof(header), header.length)};
+    trace.advance(sizeof(header) + header.length);
+
+    if (header.type == SaiTraceRecordType::BEGIN) {
+      boots.push_back(Boot{std::move(comments), {}});
+      comments.clear();
+    }
+    if (boots.empty()) {
+      XLOG(WARN) << "Ignoring record at offset " << trace.begin() - start
+                 << " logged before the start of a boot";
+      continue;
+    }
+    boots.back().records.push_back(record);
+  }
+
+  return boots;
+}
+
+void SaiBinaryTraceConverter::setFlags(const Boot& boot) {
+  SaiTraceRecordReader reader(boot.records.front().payload);
+  FLAGS_default_list_size = reader.readU32();
+  FLAGS_default_list_count = reader.readU32();
+  FLAGS_enable_get_attr_log = reader.readU32();
+  // Packets are only in the trace if they were logged
+  FLAGS_enable_packet_log = true;
+  FLAGS_enable_replayer = true;
+  FLAGS_enable_binary_log = false;
+}
+
+void SaiBinaryTraceConverter::convert(const Boot& boot) {
+  // The extension attributes are added to the attribute maps when the agent
+  // queries these apis, which is not logged
+  wrappedPortApi();
+  wrappedSwitchApi();
+  wrappedTamApi();
+
+  auto tracer = SaiTracer::getInstance();
+  for (const auto& comment : boot.comments) {
+    tracer->writeRawToFile(comment + "\n");
+  }
+  for (const auto& record : boot.records) {
+    tracer->setCallTime(std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(record.header.timestampNs))));
+    replay(*tracer, record);
+  }
+  tracer->setCallTime(std::nullopt);
+}
+
+void SaiBinaryTraceConverter::replay(SaiTracer& tracer, const Record& record) {
+  SaiTraceRecordReader reader(record.payload);
+  auto rv = record.header.rv;
+
+  switch (record.header.type) {
+    case SaiTraceRecordType::BEGIN:
+      // Already applied by setFlags()
+      break;
+    case SaiTraceRecordType::TEXT:
+      tracer.writeRawToFile(reader.readString());
+      break;
+    case SaiTraceRecordType::CREATE: {
+      auto fnName = reader.readString();
+      auto objectType = static_cast<sai_object_type_t>(reader.readU32());
+      sai_object_id_t objectId = reader.readU64();
+      sai_object_id_t switchId = reader.readU64();
+      auto attrs = reader.readAttributes(tracer, objectType);
+      if (objectType == SAI_OBJECT_TYPE_SWITCH) {
+        tracer.logSwitchCreateFn(&objectId, attrs.size(), attrs.data(), rv);
+      } else {
+        tracer.logCreateFn(
+            fnName,
+            &objectId,
+            switchId,
+            attrs.size(),
+            attrs.data(),
+            objectType,
+            rv);
+      }
+      break;
+    }
+    case SaiTraceRecordType::REMOVE: {
+      auto fnName = reader.readString();
+      auto objectType = static_cast<sai_object_type_t>(reader.readU32());
+      sai_object_id_t objectId = reader.readU64();
+      tracer.logRemoveFn(fnName, objectId, objectType, rv);
+      break;
+    }
+    case SaiTraceRecordType::SET_ATTR: {
+      auto fnName = reader.readString();
+      auto objectType = static_cast<sai_object_type_t>(reader.readU32());
+      sai_object_id_t objectId = reader.readU64();
+      auto attrs = reader.readAttributes(tracer, objectType);
+      tracer.logSetAttrFn(fnName, objectId, attrs.data(), objectType, rv);
+      break;
+    }
+    case SaiTraceRecordType::GET_ATTR: {
+      auto fnName = reader.readString();
+      auto objectType = static_cast<sai_object_type_t>(reader.readU32());
+      sai_object_id_t objectId = reader.readU64();
+      auto attrs = reader.readAttributes(tracer, objectType);
+      tracer.logGetAttrFn(
+          fnName, objectId, attrs.size(), attrs.data(), objectType, rv);
+      break;
+    }
+    case SaiTraceRecordType::BULK_SET_ATTR: {
+      auto fnName = reader.readString();
+      auto objectType = static_cast<sai_object_type_t>(reader.readU32());
+      auto objectCount = reader.readU32();
+      auto objectIds = reader.readArray<sai_object_id_t>(objectCount);
+      auto attrs = reader.readAttributes(tracer, objectType);
+      auto mode = static_cast<sai_bulk_op_error_mode_t>(reader.readU32());
+      auto statuses = reader.readArray<sai_status_t>(objectCount);
+      tracer.logBulkSetAttrFn(
+          fnName,
+          objectCount,
+          objectIds.data(),
+          attrs.data(),
+          mode,
+          statuses.data(),
+          objectType,
+          rv);
+      break;
+    }
+    case SaiTraceRecordType::ENTRY_CREATE:
+    case SaiTraceRecordType::ENTRY_REMOVE:
+    case SaiTraceRecordType::ENTRY_SET_ATTR: {
+      auto objectType = static_cast<sai_object_type_t>(reader.readU32());
+      switch (objectType) {
+        case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+          replayEntry<sai_route_entry_t>(
+              tracer,
+              record.header,
+              reader,
+              objectType,
+              &SaiTracer::logRouteEntryCreateFn,
+              &SaiTracer::logRouteEntryRemoveFn,
+              &SaiTracer::logRouteEntrySetAttrFn);
+          break;
+        case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+          replayEntry<sai_neighbor_entry_t>(
+              tracer,
+              record.header,
+              reader,
+              objectType,
+              &SaiTracer::logNeighborEntryCreateFn,
+              &SaiTracer::logNeighborEntryRemoveFn,
+              &SaiTracer::logNeighborEntrySetAttrFn);
+          break;
+        case SAI_OBJECT_TYPE_FDB_ENTRY:
+          replayEntry<sai_fdb_entry_t>(
+              tracer,
+              record.header,
+              reader,
+              objectType,
+              &SaiTracer::logFdbEntryCreateFn,
+              &SaiTracer::logFdbEntryRemoveFn,
+              &SaiTracer::logFdbEntrySetAttrFn);
+          break;
+        case SAI_OBJECT_TYPE_INSEG_ENTRY:
+          replayEntry<sai_inseg_entry_t>(
+              tracer,
+              record.header,
+              reader,
+              objectType,
+              &SaiTracer::logInsegEntryCreateFn,
+              &SaiTracer::logInsegEntryRemoveFn,
+              &SaiTracer::logInsegEntrySetAttrFn);
+          break;
+        default:
+          throw FbossError("Unexpected entry object type ", objectType);
+      }
+      break;
+    }
+    case SaiTraceRecordType::SEND_HOSTIF_PACKET: {
+      sai_object_id_t hostifId = reader.readU64();
+      auto bufferSize = reader.readU64();
+      auto buffer = reader.readBytes(bufferSize);
+      auto attrs =
+          reader.readAttributes(tracer, SAI_OBJECT_TYPE_HOSTIF_PACKET);
+      tracer.logSendHostifPacketFn(
+          hostifId, bufferSize, buffer.data(), attrs.size(), attrs.data(), rv);
+      break;
+    }
+    case SaiTraceRecordType::GET_STATS: {
+      auto fnName = reader.readString();
+      auto objectType = static_cast<sai_object_type_t>(reader.readU32());
+      sai_object_id_t objectId = reader.readU64();
+      auto numCounters = reader.readU32();
+      auto counterIds = reader.readArray<sai_stat_id_t>(numCounters);
+      auto counters = reader.readArray<uint64_t>(numCounters);
+      int mode = reader.readU32();
+      tracer.logGetStatsFn(
+          fnName,
+          objectId,
+          numCounters,
+          counterIds.data(),
+          counters.data(),
+          objectType,
+          rv,
+          mode);
+      break;
+    }
+    case SaiTraceRecordType::CLEAR_STATS: {
+      auto fnName = reader.readString();
+      auto objectType = static_cast<sai_object_type_t>(reader.readU32());
+      sai_object_id_t objectId = reader.readU64();
+      auto numCounters = reader.readU32();
+      auto counterIds = reader.readArray<sai_stat_id_t>(numCounters);
+      tracer.logClearStatsFn(
+          fnName, objectId, numCounters, counterIds.data(), objectType, rv);
+      break;
+    }
+    case SaiTraceRecordType::GET_OBJECT_KEY: {
+      auto objectType = static_cast<sai_object_type_t>(reader.readU32());
+      auto objectCount = reader.readU32();
+      std::vector<sai_object_key_t> objectKeys(objectCount);
+      for (auto& objectKey : objectKeys) {
+        objectKey.key.object_id = reader.readU64();
+      }
+      tracer.logGetObjectKeyFn(objectType, objectCount, objectKeys.data());
+      break;
+    }
+    default:
+      XLOG(WARN) << "Skipping unknown SAI trace record type "
+                 << static_cast<uint32_t>(record.header.type);
+      break;
+  }
+}
+
+} // namespace facebook::fboss
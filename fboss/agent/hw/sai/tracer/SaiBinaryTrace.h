@@ -0,0 +1,179 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <folly/Range.h>
+
+extern "C" {
+#include <sai.h>
+}
+
+namespace facebook::fboss {
+
+class SaiTracer;
+
+/*
+ * Compact binary encoding of the SAI calls logged by SaiTracer, used with
+ * --enable_binary_log.
+ *
+ * Formatting every call as C++ source is most of the cost of tracing, so the
+ * binary trace only records the call arguments: a trace is a sequence of
+ * records, each a SaiTraceRecordHeader followed by `length` bytes of payload.
+ * sai_trace_converter later feeds the decoded arguments back through the
+ * SaiTracer text logging functions to produce the same replayer source as a
+ * text trace would have.
+ *
+ * Integers and SAI structs are written in host byte order and layout, so a
+ * trace must be converted by a sai_trace_converter built for the same SAI
+ * version and architecture as the agent that produced it.
+ */
+enum class SaiTraceRecordType : uint32_t {
+  // Start of a trace, written once per boot. Carries the replayer flags the
+  // converter needs to reproduce the text trace's globals
+  BEGIN = 1,
+  // Already formatted source, for the calls made once per boot
+  TEXT = 2,
+  CREATE = 3,
+  REMOVE = 4,
+  SET_ATTR = 5,
+  GET_ATTR = 6,
+  BULK_SET_ATTR = 7,
+  // Route, neighbor, fdb and inseg entries
+  ENTRY_CREATE = 8,
+  ENTRY_REMOVE = 9,
+  ENTRY_SET_ATTR = 10,
+  SEND_HOSTIF_PACKET = 11,
+  GET_STATS = 12,
+  CLEAR_STATS = 13,
+  GET_OBJECT_KEY = 14,
+};
+
+// Not printable, so that records can be told apart from the text lines
+// AsyncLogger writes at the start of each boot
+constexpr uint32_t kSaiTraceRecordMagic = 0x5a1b17fb;
+
+struct SaiTraceRecordHeader {
+  uint32_t magic;
+  SaiTraceRecordType type;
+  // Payload bytes following the header
+  uint32_t length;
+  sai_status_t rv;
+  // Time of the call, in nanoseconds since epoch
+  int64_t timestampNs;
+};
+
+/*
+ * Builds one record. The buffer is thread local and reused across records,
+ * so that the hot path does not allocate once it has grown to the largest
+ * record size.
+ */
+class SaiTraceRecordWriter {
+ public:
+  SaiTraceRecordWriter(SaiTraceRecordType type, sai_status_t rv);
+
+  void writeU32(uint32_t value);
+  void writeU64(uint64_t value);
+  void writeBytes(const void* data, size_t size);
+  void writeString(const std::string& str);
+
+  // Attribute ids and values, followed by the content of the lists they
+  // point to
+  void writeAttributes(
+      const SaiTracer& tracer,
+      sai_object_type_t objectType,
+      const sai_attribute_t* attrList,
+      uint32_t attrCount);
+
+  // Header and payload of the record, valid until the next record is
+  // started on this thread
+  folly::StringPiece finish();
+
+ private:
+  std::string& buffer_;
+};
+
+// Decodes the payload of one record
+class SaiTraceRecordReader {
+ public:
+  explicit SaiTraceRecordReader(folly::ByteRange payload)
+      : payload_(payload) {}
+
+  uint32_t readU32();
+  uint64_t readU64();
+  folly::ByteRange readBytes(size_t size);
+  std::string readString();
+
+  template <typename T>
+  T readStruct() {
+    T value;
+    auto bytes = readBytes(sizeof(T));
+    memcpy(&value, bytes.data(), sizeof(T));
+    return value;
+  }
+
+  template <typename T>
+  std::vector<T> readArray(uint32_t count) {
+    // Check the count against the payload before allocating, a corrupt
+    // count must not get us to allocate gigabytes
+    auto bytes = readBytes(sizeof(T) * count);
+    std::vector<T> values(count);
+    memcpy(values.data(), bytes.data(), bytes.size());
+    return values;
+  }
+
+  // Attributes written by SaiTraceRecordWriter::writeAttributes(). List
+  // pointers refer to storage owned by this reader.
+  std::vector<sai_attribute_t> readAttributes(
+      const SaiTracer& tracer,
+      sai_object_type_t objectType);
+
+ private:
+  folly::ByteRange payload_;
+  std::vector<std::vector<uint8_t>> lists_;
+};
+
+/*
+ * Regenerates the replayer source of a binary trace through the text logging
+ * functions of the SaiTracer singleton. The tracer must be set up to log
+ * text, i.e. with --enable_replayer and without --enable_binary_log.
+ */
+class SaiBinaryTraceConverter {
+ public:
+  struct Record {
+    SaiTraceRecordHeader header;
+    folly::ByteRange payload;
+  };
+
+  struct Boot {
+    // Text lines AsyncLogger wrote ahead of the boot (boot type, version)
+    std::vector<std::string> comments;
+    std::vector<Record> records;
+  };
+
+  // Split a trace in the boots it is made of. A record cut short by an
+  // unclean exit ends the trace.
+  static std::vector<Boot> parse(folly::ByteRange trace);
+
+  // Set the replayer flags recorded by the boot's BEGIN record. Must be done
+  // before the SaiTracer singleton is created.
+  static void setFlags(const Boot& boot);
+
+  static void convert(const Boot& boot);
+
+ private:
+  static void replay(SaiTracer& tracer, const Record& record);
+};
+
+} // namespace facebook::fboss
@@ -72,6 +72,13 @@ DEFINE_bool(
     "Flag to indicate whether to log the get API calls. "
     "At runtime, it should be disabled to reduce logging overhead.");
 
+DEFINE_bool(
+    enable_binary_log,
+    false,
+    "Log SAI calls in a compact binary format instead of as replayer source. "
+    "Much cheaper at runtime, convert the log with sai_trace_converter to get "
+    "the replayer source.");
+
 DEFINE_string(
     sai_log,
     "/var/facebook/logs/fboss/sdk/sai_replayer.log",
@@ -371,41 +378,8 @@ sai_status_t __wrap_sai_get_object_key(
     return rv;
   }
 
-  vector<string> getObjectKeyLines = {
-      to<string>("expected_object_count=", *object_count),
-      to<string>(
-          "sai_get_object_count(switch_0, (_sai_object_type_t)",
-          object_type,
-          ", &object_count)"),
-      "object_list.resize(object_count)",
-      to<string>(
-          "sai_get_object_key(switch_0, (_sai_object_type_t)",
-          object_type,
-          ", &object_count, object_list.data())"),
-      to<string>(
-          "if (object_count < expected_object_count) { printf(\"[WARNING] current switch reloaded %u ",
-          facebook::fboss::saiObjectTypeToString(object_type),
-          " objects, expected %u\\n\", expected_object_count, object_count); }"),
-  };
-
-  vector<string> declarationLines;
-  declarationLines.reserve(*object_count);
-  for (int i = 0; i < *object_count; ++i) {
-    sai_object_key_t object = object_list[i];
-    string declaration = std::get<0>(SaiTracer::getInstance()->declareVariable(
-        &object.key.object_id, object_type));
-    declarationLines.push_back(to<string>(
-        declaration,
-        "=assignObject(object_list.data(), object_count, ",
-        i,
-        ", ",
-        object.key.object_id,
-        ")"));
-  }
-  vector<string> lines;
-  lines.insert(lines.end(), getObjectKeyLines.begin(), getObjectKeyLines.end());
-  lines.insert(lines.end(), declarationLines.begin(), declarationLines.end());
-  SaiTracer::getInstance()->writeToFile(lines);
+  SaiTracer::getInstance()->logGetObjectKeyFn(
+      object_type, *object_count, object_list);
   return rv;
 }
 
@@ -425,16 +399,28 @@ SaiTracer::SaiTracer() {
         FLAGS_sai_log, FLAGS_log_timeout, AsyncLogger::SAI_REPLAYER);
 
     asyncLogger_->startFlushThread();
-    asyncLogger_->appendLog(cpp_header_, strlen(cpp_header_));
+    if (FLAGS_enable_binary_log) {
+      // The converter writes the header and globals
+      SaiTraceRecordWriter record(
+          SaiTraceRecordType::BEGIN, SAI_STATUS_SUCCESS);
+      record.writeU32(FLAGS_default_list_size);
+      record.writeU32(FLAGS_default_list_count);
+      record.writeU32(FLAGS_enable_get_attr_log);
+      writeRecord(record);
+    } else {
+      asyncLogger_->appendLog(cpp_header_, strlen(cpp_header_));
+      setupGlobals();
+    }
 
-    setupGlobals();
     initVarCounts();
   }
 }
 
 SaiTracer::~SaiTracer() {
   if (FLAGS_enable_replayer) {
-    writeFooter();
+    if (!FLAGS_enable_binary_log) {
+      writeFooter();
+    }
     asyncLogger_->forceFlush();
     asyncLogger_->stopFlushThread();
   }
@@ -457,7 +443,27 @@ void SaiTracer::writeToFile(const vector<string>& strVec) {
   auto constexpr lineEnd = ";\n";
   auto lines = folly::join(lineEnd, strVec) + lineEnd + "\n";
 
-  asyncLogger_->appendLog(lines.c_str(), lines.size());
+  writeRawToFile(lines);
+}
+
+void SaiTracer::writeRawToFile(const std::string& str) {
+  if (!FLAGS_enable_replayer) {
+    return;
+  }
+
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::TEXT, SAI_STATUS_SUCCESS);
+    record.writeString(str);
+    writeRecord(record);
+    return;
+  }
+
+  asyncLogger_->appendLog(str.c_str(), str.size());
+}
+
+void SaiTracer::writeRecord(SaiTraceRecordWriter& record) {
+  auto data = record.finish();
+  asyncLogger_->appendLog(data.data(), data.size());
 }
 
 void SaiTracer::logApiInitialize(
@@ -529,6 +535,18 @@ void SaiTracer::logSwitchCreateFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::CREATE, rv);
+    record.writeString("create_switch");
+    record.writeU32(SAI_OBJECT_TYPE_SWITCH);
+    record.writeU64(*switch_id);
+    record.writeU64(SAI_NULL_OBJECT_ID);
+    record.writeAttributes(
+        *this, SAI_OBJECT_TYPE_SWITCH, attr_list, attr_count);
+    writeRecord(record);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_SWITCH);
@@ -571,6 +589,16 @@ void SaiTracer::logRouteEntryCreateFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::ENTRY_CREATE, rv);
+    record.writeU32(SAI_OBJECT_TYPE_ROUTE_ENTRY);
+    record.writeBytes(route_entry, sizeof(*route_entry));
+    record.writeAttributes(
+        *this, SAI_OBJECT_TYPE_ROUTE_ENTRY, attr_list, attr_count);
+    writeRecord(record);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_ROUTE_ENTRY);
@@ -607,6 +635,16 @@ void SaiTracer::logNeighborEntryCreateFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::ENTRY_CREATE, rv);
+    record.writeU32(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY);
+    record.writeBytes(neighbor_entry, sizeof(*neighbor_entry));
+    record.writeAttributes(
+        *this, SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, attr_list, attr_count);
+    writeRecord(record);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_NEIGHBOR_ENTRY);
@@ -643,6 +681,16 @@ void SaiTracer::logFdbEntryCreateFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::ENTRY_CREATE, rv);
+    record.writeU32(SAI_OBJECT_TYPE_FDB_ENTRY);
+    record.writeBytes(fdb_entry, sizeof(*fdb_entry));
+    record.writeAttributes(
+        *this, SAI_OBJECT_TYPE_FDB_ENTRY, attr_list, attr_count);
+    writeRecord(record);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_FDB_ENTRY);
@@ -679,6 +727,16 @@ void SaiTracer::logInsegEntryCreateFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::ENTRY_CREATE, rv);
+    record.writeU32(SAI_OBJECT_TYPE_INSEG_ENTRY);
+    record.writeBytes(inseg_entry, sizeof(*inseg_entry));
+    record.writeAttributes(
+        *this, SAI_OBJECT_TYPE_INSEG_ENTRY, attr_list, attr_count);
+    writeRecord(record);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_INSEG_ENTRY);
@@ -718,6 +776,17 @@ void SaiTracer::logCreateFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::CREATE, rv);
+    record.writeString(fn_name);
+    record.writeU32(object_type);
+    record.writeU64(*create_object_id);
+    record.writeU64(switch_id);
+    record.writeAttributes(*this, object_type, attr_list, attr_count);
+    writeRecord(record);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines = setAttrList(attr_list, attr_count, object_type);
 
@@ -747,6 +816,14 @@ void SaiTracer::logRouteEntryRemoveFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::ENTRY_REMOVE, rv);
+    record.writeU32(SAI_OBJECT_TYPE_ROUTE_ENTRY);
+    record.writeBytes(route_entry, sizeof(*route_entry));
+    writeRecord(record);
+    return;
+  }
+
   vector<string> lines{};
   setRouteEntry(route_entry, lines);
 
@@ -774,6 +851,14 @@ void SaiTracer::logNeighborEntryRemoveFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::ENTRY_REMOVE, rv);
+    record.writeU32(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY);
+    record.writeBytes(neighbor_entry, sizeof(*neighbor_entry));
+    writeRecord(record);
+    return;
+  }
+
   vector<string> lines{};
   setNeighborEntry(neighbor_entry, lines);
 
@@ -801,6 +886,14 @@ void SaiTracer::logFdbEntryRemoveFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::ENTRY_REMOVE, rv);
+    record.writeU32(SAI_OBJECT_TYPE_FDB_ENTRY);
+    record.writeBytes(fdb_entry, sizeof(*fdb_entry));
+    writeRecord(record);
+    return;
+  }
+
   vector<string> lines{};
   setFdbEntry(fdb_entry, lines);
 
@@ -828,6 +921,14 @@ void SaiTracer::logInsegEntryRemoveFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::ENTRY_REMOVE, rv);
+    record.writeU32(SAI_OBJECT_TYPE_INSEG_ENTRY);
+    record.writeBytes(inseg_entry, sizeof(*inseg_entry));
+    writeRecord(record);
+    return;
+  }
+
   vector<string> lines{};
   setInsegEntry(inseg_entry, lines);
 
@@ -857,6 +958,15 @@ void SaiTracer::logRemoveFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::REMOVE, rv);
+    record.writeString(fn_name);
+    record.writeU32(object_type);
+    record.writeU64(remove_object_id);
+    writeRecord(record);
+    return;
+  }
+
   vector<string> lines{};
 
   // Log current timestamp, object id and return value
@@ -889,6 +999,15 @@ void SaiTracer::logRouteEntrySetAttrFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::ENTRY_SET_ATTR, rv);
+    record.writeU32(SAI_OBJECT_TYPE_ROUTE_ENTRY);
+    record.writeBytes(route_entry, sizeof(*route_entry));
+    record.writeAttributes(*this, SAI_OBJECT_TYPE_ROUTE_ENTRY, attr, 1);
+    writeRecord(record);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_ROUTE_ENTRY);
 
@@ -920,6 +1039,15 @@ void SaiTracer::logNeighborEntrySetAttrFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::ENTRY_SET_ATTR, rv);
+    record.writeU32(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY);
+    record.writeBytes(neighbor_entry, sizeof(*neighbor_entry));
+    record.writeAttributes(*this, SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, attr, 1);
+    writeRecord(record);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_NEIGHBOR_ENTRY);
 
@@ -951,6 +1079,15 @@ void SaiTracer::logFdbEntrySetAttrFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::ENTRY_SET_ATTR, rv);
+    record.writeU32(SAI_OBJECT_TYPE_FDB_ENTRY);
+    record.writeBytes(fdb_entry, sizeof(*fdb_entry));
+    record.writeAttributes(*this, SAI_OBJECT_TYPE_FDB_ENTRY, attr, 1);
+    writeRecord(record);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_FDB_ENTRY);
 
@@ -982,6 +1119,15 @@ void SaiTracer::logInsegEntrySetAttrFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::ENTRY_SET_ATTR, rv);
+    record.writeU32(SAI_OBJECT_TYPE_INSEG_ENTRY);
+    record.writeBytes(inseg_entry, sizeof(*inseg_entry));
+    record.writeAttributes(*this, SAI_OBJECT_TYPE_INSEG_ENTRY, attr, 1);
+    writeRecord(record);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_INSEG_ENTRY);
 
@@ -1016,6 +1162,16 @@ void SaiTracer::logGetAttrFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::GET_ATTR, rv);
+    record.writeString(fn_name);
+    record.writeU32(object_type);
+    record.writeU64(get_object_id);
+    record.writeAttributes(*this, object_type, attr, attr_count);
+    writeRecord(record);
+    return;
+  }
+
   vector<string> lines = setAttrList(attr, attr_count, object_type);
   lines.push_back(
       to<string>("memset(get_attribute,0,ATTR_SIZE*", maxAttrCount_, ")"));
@@ -1051,6 +1207,16 @@ void SaiTracer::logSetAttrFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::SET_ATTR, rv);
+    record.writeString(fn_name);
+    record.writeU32(object_type);
+    record.writeU64(set_object_id);
+    record.writeAttributes(*this, object_type, attr, 1);
+    writeRecord(record);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, object_type);
 
@@ -1086,6 +1252,19 @@ void SaiTracer::logBulkSetAttrFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::BULK_SET_ATTR, rv);
+    record.writeString(fn_name);
+    record.writeU32(object_type);
+    record.writeU32(object_count);
+    record.writeBytes(object_id, sizeof(sai_object_id_t) * object_count);
+    record.writeAttributes(*this, object_type, attr_list, object_count);
+    record.writeU32(mode);
+    record.writeBytes(object_statuses, sizeof(sai_status_t) * object_count);
+    writeRecord(record);
+    return;
+  }
+
   // Setup attributes
   vector<string> lines = setAttrList(attr_list, object_count, object_type);
 
@@ -1134,6 +1313,17 @@ void SaiTracer::logSendHostifPacketFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::SEND_HOSTIF_PACKET, rv);
+    record.writeU64(hostif_id);
+    record.writeU64(buffer_size);
+    record.writeBytes(buffer, buffer_size);
+    record.writeAttributes(
+        *this, SAI_OBJECT_TYPE_HOSTIF_PACKET, attr_list, attr_count);
+    writeRecord(record);
+    return;
+  }
+
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_HOSTIF_PACKET);
 
@@ -1189,6 +1379,20 @@ void SaiTracer::logGetStatsFn(
   if (!FLAGS_enable_replayer || !FLAGS_enable_get_attr_log) {
     return;
   }
+
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::GET_STATS, rv);
+    record.writeString(fn_name);
+    record.writeU32(object_type);
+    record.writeU64(object_id);
+    record.writeU32(number_of_counters);
+    record.writeBytes(counter_ids, sizeof(sai_stat_id_t) * number_of_counters);
+    record.writeBytes(counters, sizeof(uint64_t) * number_of_counters);
+    record.writeU32(mode);
+    writeRecord(record);
+    return;
+  }
+
   vector<string> lines = {
       to<string>("memset(counter_list,0,4*", maxAttrCount_, ")"),
       to<string>("memset(counter_vals,0,8*", maxAttrCount_, ")")};
@@ -1231,6 +1435,17 @@ void SaiTracer::logClearStatsFn(
     return;
   }
 
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::CLEAR_STATS, rv);
+    record.writeString(fn_name);
+    record.writeU32(object_type);
+    record.writeU64(object_id);
+    record.writeU32(number_of_counters);
+    record.writeBytes(counter_ids, sizeof(sai_stat_id_t) * number_of_counters);
+    writeRecord(record);
+    return;
+  }
+
   vector<string> lines = {
       to<string>("memset(counter_list,0,4*", maxAttrCount_, ")")};
   for (int i = 0; i < number_of_counters; ++i) {
@@ -1258,6 +1473,63 @@ void SaiTracer::logClearStatsFn(
   writeToFile(lines);
 }
 
+void SaiTracer::logGetObjectKeyFn(
+    sai_object_type_t object_type,
+    uint32_t object_count,
+    const sai_object_key_t* object_list) {
+  if (!FLAGS_enable_replayer) {
+    return;
+  }
+
+  if (FLAGS_enable_binary_log) {
+    SaiTraceRecordWriter record(
+        SaiTraceRecordType::GET_OBJECT_KEY, SAI_STATUS_SUCCESS);
+    record.writeU32(object_type);
+    record.writeU32(object_count);
+    for (int i = 0; i < object_count; ++i) {
+      record.writeU64(object_list[i].key.object_id);
+    }
+    writeRecord(record);
+    return;
+  }
+
+  vector<string> getObjectKeyLines = {
+      to<string>("expected_object_count=", object_count),
+      to<string>(
+          "sai_get_object_count(switch_0, (_sai_object_type_t)",
+          object_type,
+          ", &object_count)"),
+      "object_list.resize(object_count)",
+      to<string>(
+          "sai_get_object_key(switch_0, (_sai_object_type_t)",
+          object_type,
+          ", &object_count, object_list.data())"),
+      to<string>(
+          "if (object_count < expected_object_count) { printf(\"[WARNING] current switch reloaded %u ",
+          facebook::fboss::saiObjectTypeToString(object_type),
+          " objects, expected %u\\n\", expected_object_count, object_count); }"),
+  };
+
+  vector<string> declarationLines;
+  declarationLines.reserve(object_count);
+  for (int i = 0; i < object_count; ++i) {
+    sai_object_key_t object = object_list[i];
+    string declaration = std::get<0>(declareVariable(
+        &object.key.object_id, object_type));
+    declarationLines.push_back(to<string>(
+        declaration,
+        "=assignObject(object_list.data(), object_count, ",
+        i,
+        ", ",
+        object.key.object_id,
+        ")"));
+  }
+  vector<string> lines;
+  lines.insert(lines.end(), getObjectKeyLines.begin(), getObjectKeyLines.end());
+  lines.insert(lines.end(), declarationLines.begin(), declarationLines.end());
+  writeToFile(lines);
+}
+
 std::tuple<string, string> SaiTracer::declareVariable(
     sai_object_id_t* object_id,
     sai_object_type_t object_type) {
@@ -1468,6 +1740,70 @@ vector<string> SaiTracer::setAttrList(
   return attrLines;
 }
 
+std::size_t SaiTracer::getAttributeType(
+    sai_object_type_t object_type,
+    sai_attr_id_t id) const {
+  // Same object types as setAttrList()
+  static const std::unordered_map<sai_object_type_t, AttributeTypeFunction>
+      attributeTypeFuncMap{
+          {SAI_OBJECT_TYPE_ACL_COUNTER, &getAclCounterAttributeType},
+          {SAI_OBJECT_TYPE_ACL_ENTRY, &getAclEntryAttributeType},
+          {SAI_OBJECT_TYPE_ACL_TABLE, &getAclTableAttributeType},
+          {SAI_OBJECT_TYPE_ACL_TABLE_GROUP, &getAclTableGroupAttributeType},
+          {SAI_OBJECT_TYPE_ACL_TABLE_GROUP_MEMBER,
+           &getAclTableGroupMemberAttributeType},
+          {SAI_OBJECT_TYPE_BRIDGE, &getBridgeAttributeType},
+          {SAI_OBJECT_TYPE_BRIDGE_PORT, &getBridgePortAttributeType},
+          {SAI_OBJECT_TYPE_BUFFER_POOL, &getBufferPoolAttributeType},
+          {SAI_OBJECT_TYPE_BUFFER_PROFILE, &getBufferProfileAttributeType},
+          {SAI_OBJECT_TYPE_COUNTER, &getCounterAttributeType},
+          {SAI_OBJECT_TYPE_DEBUG_COUNTER, &getDebugCounterAttributeType},
+          {SAI_OBJECT_TYPE_FDB_ENTRY, &getFdbEntryAttributeType},
+          {SAI_OBJECT_TYPE_HASH, &getHashAttributeType},
+          {SAI_OBJECT_TYPE_HOSTIF_PACKET, &getHostifPacketAttributeType},
+          {SAI_OBJECT_TYPE_HOSTIF_TRAP, &getHostifTrapAttributeType},
+          {SAI_OBJECT_TYPE_HOSTIF_TRAP_GROUP, &getHostifTrapGroupAttributeType},
+          {SAI_OBJECT_TYPE_INSEG_ENTRY, &getInsegEntryAttributeType},
+          {SAI_OBJECT_TYPE_LAG, &getLagAttributeType},
+          {SAI_OBJECT_TYPE_LAG_MEMBER, &getLagMemberAttributeType},
+          {SAI_OBJECT_TYPE_MACSEC, &getMacsecAttributeType},
+          {SAI_OBJECT_TYPE_MACSEC_PORT, &getMacsecPortAttributeType},
+          {SAI_OBJECT_TYPE_MACSEC_FLOW, &getMacsecFlowAttributeType},
+          {SAI_OBJECT_TYPE_MACSEC_SA, &getMacsecSAAttributeType},
+          {SAI_OBJECT_TYPE_MACSEC_SC, &getMacsecSCAttributeType},
+          {SAI_OBJECT_TYPE_MIRROR_SESSION, &getMirrorSessionAttributeType},
+          {SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, &getNeighborEntryAttributeType},
+          {SAI_OBJECT_TYPE_NEXT_HOP, &getNextHopAttributeType},
+          {SAI_OBJECT_TYPE_NEXT_HOP_GROUP, &getNextHopGroupAttributeType},
+          {SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER,
+           &getNextHopGroupMemberAttributeType},
+          {SAI_OBJECT_TYPE_PORT, &getPortAttributeType},
+          {SAI_OBJECT_TYPE_PORT_SERDES, &getPortSerdesAttributeType},
+          {SAI_OBJECT_TYPE_PORT_CONNECTOR, &getPortConnectorAttributeType},
+          {SAI_OBJECT_TYPE_QOS_MAP, &getQosMapAttributeType},
+          {SAI_OBJECT_TYPE_QUEUE, &getQueueAttributeType},
+          {SAI_OBJECT_TYPE_ROUTE_ENTRY, &getRouteEntryAttributeType},
+          {SAI_OBJECT_TYPE_ROUTER_INTERFACE, &getRouterInterfaceAttributeType},
+          {SAI_OBJECT_TYPE_SAMPLEPACKET, &getSamplePacketAttributeType},
+          {SAI_OBJECT_TYPE_SCHEDULER, &getSchedulerAttributeType},
+          {SAI_OBJECT_TYPE_SWITCH, &getSwitchAttributeType},
+          {SAI_OBJECT_TYPE_TAM, &getTamAttributeType},
+          {SAI_OBJECT_TYPE_TAM_EVENT, &getTamEventAttributeType},
+          {SAI_OBJECT_TYPE_TAM_EVENT_ACTION, &getTamEventActionAttributeType},
+          {SAI_OBJECT_TYPE_TAM_REPORT, &getTamReportAttributeType},
+          {SAI_OBJECT_TYPE_VIRTUAL_ROUTER, &getVirtualRouterAttributeType},
+          {SAI_OBJECT_TYPE_VLAN, &getVlanAttributeType},
+          {SAI_OBJECT_TYPE_VLAN_MEMBER, &getVlanMemberAttributeType},
+          {SAI_OBJECT_TYPE_WRED, &getWredAttributeType},
+      };
+
+  auto attributeTypeFunc = attributeTypeFuncMap.find(object_type);
+  if (attributeTypeFunc == attributeTypeFuncMap.end()) {
+    return 0;
+  }
+  return (*attributeTypeFunc->second)(id);
+}
+
 string SaiTracer::createFnCall(
     const string& fn_name,
     const string& var1,
@@ -1592,7 +1928,7 @@ string SaiTracer::rvCheck(sai_status_t rv) {
 }
 
 string SaiTracer::logTimeAndRv(sai_status_t rv, sai_object_id_t object_id) {
-  auto now = std::chrono::system_clock::now();
+  auto now = callTime_.value_or(std::chrono::system_clock::now());
   auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                     now.time_since_epoch()) %
       1000;
@@ -9,14 +9,17 @@
  */
 #pragma once
 
+#include <chrono>
 #include <map>
 #include <memory>
+#include <optional>
 #include <tuple>
 #include <typeindex>
 
 #include "fboss/agent/AsyncLogger.h"
 #include "fboss/agent/hw/sai/api/SaiVersion.h"
 #include "fboss/agent/hw/sai/api/Traits.h"
+#include "fboss/agent/hw/sai/tracer/SaiBinaryTrace.h"
 #include "fboss/agent/hw/sai/tracer/Utils.h"
 
 #include <folly/File.h>
@@ -31,12 +34,17 @@ extern "C" {
 
 DECLARE_bool(enable_replayer);
 DECLARE_bool(enable_packet_log);
+DECLARE_bool(enable_get_attr_log);
+DECLARE_bool(enable_binary_log);
+DECLARE_int32(default_list_size);
+DECLARE_int32(default_list_count);
 
 using PrimitiveFunction = std::string (*)(const sai_attribute_t*, int);
 using AttributeFunction =
     void (*)(const sai_attribute_t*, int, std::vector<std::string>&);
 using ListFunction =
     void (*)(const sai_attribute_t*, int, uint32_t, std::vector<std::string>&);
+using AttributeTypeFunction = std::size_t (*)(sai_attr_id_t);
 
 #define TYPE_INDEX(type) std::type_index(typeid(type)).hash_code()
 
@@ -190,12 +198,31 @@ class SaiTracer {
       sai_object_type_t object_type,
       sai_status_t rv);
 
+  void logGetObjectKeyFn(
+      sai_object_type_t object_type,
+      uint32_t object_count,
+      const sai_object_key_t* object_list);
+
   std::string getVariable(sai_object_id_t object_id);
 
+  // TYPE_INDEX of the value of an attribute, as listed in the object type's
+  // attribute map. 0 for attributes missing from the map.
+  std::size_t getAttributeType(sai_object_type_t object_type, sai_attr_id_t id)
+      const;
+
+  // Timestamp to log for the following calls instead of the current time.
+  // Used when regenerating the source of a binary trace.
+  void setCallTime(
+      std::optional<std::chrono::system_clock::time_point> callTime) {
+    callTime_ = callTime;
+  }
+
   uint32_t
   checkListCount(uint32_t list_count, uint32_t elem_size, uint32_t elem_count);
 
   void writeToFile(const std::vector<std::string>& strVec);
+  // Append already formatted source
+  void writeRawToFile(const std::string& str);
 
   sai_acl_api_t* aclApi_;
   sai_bridge_api_t* bridgeApi_;
@@ -312,10 +339,13 @@ class SaiTracer {
 
   void writeFooter();
 
+  void writeRecord(SaiTraceRecordWriter& record);
+
   uint32_t maxAttrCount_;
   uint32_t maxListCount_;
   uint32_t numCalls_;
   std::unique_ptr<AsyncLogger> asyncLogger_;
+  std::optional<std::chrono::system_clock::time_point> callTime_;
 
   // Variables mappings in generated C code
   // varCounts map from object type to the current counter
@@ -494,10 +524,11 @@ class SaiTracer {
       "void run_trace() {\n";
 };
 
-#define SET_ATTRIBUTE_FUNC_DECLARATION(obj_type) \
-  void set##obj_type##Attributes(                \
-      const sai_attribute_t* attr_list,          \
-      uint32_t attr_count,                       \
+#define SET_ATTRIBUTE_FUNC_DECLARATION(obj_type)              \
+  std::size_t get##obj_type##AttributeType(sai_attr_id_t id); \
+  void set##obj_type##Attributes(                             \
+      const sai_attribute_t* attr_list,                       \
+      uint32_t attr_count,                                    \
       std::vector<std::string>& attrLines);
 
 #define WRAP_CREATE_FUNC(obj_type, sai_obj_type, api_type)                 \
@@ -670,6 +701,11 @@ class SaiTracer {
   }
 
 #define SET_SAI_REGULAR_ATTRIBUTES(obj_type)                                 \
+  std::size_t get##obj_type##AttributeType(sai_attr_id_t id) {               \
+    auto iter = _##obj_type##Map.find(id);                                   \
+    return iter == _##obj_type##Map.end() ? 0 : iter->second.second;         \
+  }                                                                          \
+                                                                             \
   void set##obj_type##Attributes(                                            \
       const sai_attribute_t* attr_list,                                      \
       uint32_t attr_count,                                                   \
@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/SaiBinaryTrace.h"
+#include "fboss/agent/hw/sai/tracer/SaiTracer.h"
+
+#include <folly/FileUtil.h>
+#include <folly/Singleton.h>
+#include <folly/init/Init.h>
+#include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+
+#include <string>
+
+DECLARE_string(sai_log);
+
+DEFINE_string(
+    binary_sai_log,
+    "",
+    "Binary SAI trace logged with --enable_binary_log. The replayer source "
+    "is written to --sai_log.");
+
+DEFINE_int32(
+    boot_index,
+    -1,
+    "Boot of the trace to convert, counting from 0. Negative values count "
+    "from the last boot.");
+
+using namespace facebook::fboss;
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+
+  std::string trace;
+  if (!folly::readFile(FLAGS_binary_sai_log.c_str(), trace)) {
+    XLOG(ERR) << "Failed to read " << FLAGS_binary_sai_log;
+    return 1;
+  }
+
+  auto boots = SaiBinaryTraceConverter::parse(folly::ByteRange(
+      folly::StringPiece(trace)));
+  int numBoots = boots.size();
+  auto bootIndex =
+      FLAGS_boot_index < 0 ? numBoots + FLAGS_boot_index : FLAGS_boot_index;
+  if (bootIndex < 0 || bootIndex >= numBoots) {
+    XLOG(ERR) << "No boot " << FLAGS_boot_index << " in "
+              << FLAGS_binary_sai_log << ", which has " << numBoots
+              << " boots";
+    return 1;
+  }
+
+  const auto& boot = boots[bootIndex];
+  for (const auto& comment : boot.comments) {
+    XLOG(INFO) << comment;
+  }
+  XLOG(INFO) << "Converting " << boot.records.size() << " records to "
+             << FLAGS_sai_log;
+
+  // The tracer writes the header and globals when it is created, so the flags
+  // of the trace have to be set first
+  SaiBinaryTraceConverter::setFlags(boot);
+  SaiBinaryTraceConverter::convert(boot);
+
+  // Write the footer and flush
+  folly::SingletonVault::singleton()->destroyInstances();
+  return 0;
+}
@@ -0,0 +1,258 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/SaiBinaryTrace.h"
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/hw/sai/tracer/SaiTracer.h"
+
+#include <folly/FileUtil.h>
+#include <folly/Singleton.h>
+#include <folly/String.h>
+#include <folly/testing/TestUtil.h>
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <regex>
+
+DECLARE_string(sai_log);
+
+using namespace facebook::fboss;
+
+namespace {
+
+// Replayer source without what differs between two runs: the boot headers
+// AsyncLogger writes, and the time of the calls
+std::string normalize(const std::string& source) {
+  static const std::regex kCallTime(
+      "[0-9]{4}-[0-9]{2}-[0-9]{2} [0-9]{2}:[0-9]{2}:[0-9]{2}\\.[0-9]{3}");
+  std::vector<folly::StringPiece> lines;
+  folly::split('\n', source, lines);
+  std::string normalized;
+  for (auto line : lines) {
+    if (line.startsWith("// Start of a ") || line.startsWith("// Commit id") ||
+        line.startsWith("// SDK version")) {
+      continue;
+    }
+    normalized += std::regex_replace(line.str(), kCallTime, "<time>");
+    normalized += '\n';
+  }
+  return normalized;
+}
+
+// A few calls covering object and entry records, attribute lists and failures
+void logCalls() {
+  auto tracer = SaiTracer::getInstance();
+
+  sai_object_id_t switchId = 1;
+  tracer->logSwitchCreateFn(&switchId, 0, nullptr, SAI_STATUS_SUCCESS);
+
+  std::vector<sai_int32_t> fields{
+      SAI_NATIVE_HASH_FIELD_SRC_IP, SAI_NATIVE_HASH_FIELD_DST_IP};
+  sai_attribute_t attr;
+  attr.id = SAI_HASH_ATTR_NATIVE_HASH_FIELD_LIST;
+  attr.value.s32list.count = fields.size();
+  attr.value.s32list.list = fields.data();
+  sai_object_id_t hashId = 2;
+  tracer->logCreateFn(
+      "create_hash",
+      &hashId,
+      switchId,
+      1,
+      &attr,
+      SAI_OBJECT_TYPE_HASH,
+      SAI_STATUS_SUCCESS);
+
+  fields.push_back(SAI_NATIVE_HASH_FIELD_L4_SRC_PORT);
+  attr.value.s32list.count = fields.size();
+  attr.value.s32list.list = fields.data();
+  tracer->logSetAttrFn(
+      "set_hash_attribute",
+      hashId,
+      &attr,
+      SAI_OBJECT_TYPE_HASH,
+      SAI_STATUS_SUCCESS);
+
+  sai_route_entry_t route{};
+  route.switch_id = switchId;
+  route.vr_id = 3;
+  route.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+  route.destination.addr.ip4 = 0x0000000a;
+  route.destination.mask.ip4 = 0x000000ff;
+  sai_attribute_t routeAttr;
+  routeAttr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+  routeAttr.value.oid = 4;
+  tracer->logRouteEntryCreateFn(&route, 1, &routeAttr, SAI_STATUS_SUCCESS);
+
+  tracer->logRemoveFn(
+      "remove_hash", hashId, SAI_OBJECT_TYPE_HASH, SAI_STATUS_FAILURE);
+}
+
+} // namespace
+
+class SaiBinaryTraceTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    FLAGS_enable_replayer = true;
+    FLAGS_enable_binary_log = false;
+  }
+
+  void TearDown() override {
+    resetTracer();
+  }
+
+  // Flush the log of the SaiTracer singleton, and let the next
+  // SaiTracer::getInstance() create a new one with the current flags
+  void resetTracer() {
+    folly::SingletonVault::singleton()->destroyInstances();
+    folly::SingletonVault::singleton()->reenableInstances();
+  }
+
+  // The log of the calls made by logFn
+  template <typename LogFn>
+  std::string trace(const std::string& fileName, LogFn logFn) {
+    FLAGS_sai_log = tmpDir_.path().string() + "/" + fileName;
+    logFn();
+    resetTracer();
+    std::string log;
+    EXPECT_TRUE(folly::readFile(FLAGS_sai_log.c_str(), log));
+    return log;
+  }
+
+  std::string binaryTrace() {
+    FLAGS_enable_binary_log = true;
+    auto binary = trace("binary.log", logCalls);
+    FLAGS_enable_binary_log = false;
+    return binary;
+  }
+
+  static std::vector<SaiBinaryTraceConverter::Boot> parse(
+      const std::string& trace) {
+    return SaiBinaryTraceConverter::parse(
+        folly::ByteRange(folly::StringPiece(trace)));
+  }
+
+ private:
+  gflags::FlagSaver flagSaver_;
+  folly::test::TemporaryDirectory tmpDir_;
+};
+
+TEST_F(SaiBinaryTraceTest, convertedTraceMatchesTextTrace) {
+  auto text = trace("text.log", logCalls);
+  auto binary = binaryTrace();
+
+  auto boots = parse(binary);
+  ASSERT_EQ(boots.size(), 1u);
+  SaiBinaryTraceConverter::setFlags(boots[0]);
+  auto converted = trace("converted.log", [&boots] {
+    SaiBinaryTraceConverter::convert(boots[0]);
+  });
+
+  EXPECT_NE(text.find("create_hash"), std::string::npos);
+  EXPECT_EQ(normalize(converted), normalize(text));
+}
+
+TEST_F(SaiBinaryTraceTest, truncatedRecordsAreIgnored) {
+  auto binary = binaryTrace();
+  auto numRecords = parse(binary)[0].records.size();
+
+  // Whatever the trace was cut at, e.g. by a crash, only the complete
+  // records are returned
+  for (auto size = binary.size() - 1; size > 0; size--) {
+    auto truncated = binary.substr(0, size);
+    auto boots = parse(truncated);
+    if (boots.empty()) {
+      continue;
+    }
+    ASSERT_EQ(boots.size(), 1u);
+    EXPECT_LT(boots[0].records.size(), numRecords);
+    for (const auto& record : boots[0].records) {
+      EXPECT_LE(
+          record.payload.end(),
+          reinterpret_cast<const uint8_t*>(truncated.data()) + size);
+    }
+  }
+}
+
+TEST_F(SaiBinaryTraceTest, corruptRecordsEndTheTrace) {
+  auto binary = binaryTrace();
+  auto records = parse(binary)[0].records;
+  auto lastRecordOffset = records.back().payload.begin() -
+      reinterpret_cast<const uint8_t*>(binary.data()) -
+      sizeof(SaiTraceRecordHeader);
+
+  // Length beyond the end of the trace
+  auto corrupt = binary;
+  uint32_t length = 0xffffffff;
+  memcpy(
+      corrupt.data() + lastRecordOffset +
+          offsetof(SaiTraceRecordHeader, length),
+      &length,
+      sizeof(length));
+  EXPECT_EQ(parse(corrupt)[0].records.size(), records.size() - 1);
+
+  // Not a record
+  corrupt = binary;
+  corrupt[lastRecordOffset + offsetof(SaiTraceRecordHeader, magic)] ^= 0xff;
+  EXPECT_EQ(parse(corrupt)[0].records.size(), records.size() - 1);
+}
+
+TEST_F(SaiBinaryTraceTest, corruptPayloadIsRejected) {
+  // Only used for the attribute types, no need to log
+  FLAGS_enable_replayer = false;
+  auto tracer = SaiTracer::getInstance();
+
+  std::vector<sai_int32_t> fields{
+      SAI_NATIVE_HASH_FIELD_SRC_IP, SAI_NATIVE_HASH_FIELD_DST_IP};
+  sai_attribute_t attr;
+  attr.id = SAI_HASH_ATTR_NATIVE_HASH_FIELD_LIST;
+  attr.value.s32list.count = fields.size();
+  attr.value.s32list.list = fields.data();
+  SaiTraceRecordWriter writer(SaiTraceRecordType::CREATE, SAI_STATUS_SUCCESS);
+  writer.writeAttributes(*tracer, SAI_OBJECT_TYPE_HASH, &attr, 1);
+  auto record = writer.finish();
+  std::string payload = record.subpiece(sizeof(SaiTraceRecordHeader)).str();
+
+  SaiTraceRecordReader reader{folly::ByteRange(folly::StringPiece(payload))};
+  auto attrs = reader.readAttributes(*tracer, SAI_OBJECT_TYPE_HASH);
+  ASSERT_EQ(attrs.size(), 1u);
+  ASSERT_EQ(attrs[0].value.s32list.count, fields.size());
+  EXPECT_EQ(attrs[0].value.s32list.list[1], fields[1]);
+
+  auto readAttributes = [&tracer](const std::string& payload) {
+    SaiTraceRecordReader reader{folly::ByteRange(folly::StringPiece(payload))};
+    reader.readAttributes(*tracer, SAI_OBJECT_TYPE_HASH);
+  };
+
+  // Every cut short payload is rejected
+  for (size_t size = 0; size < payload.size(); size++) {
+    EXPECT_THROW(readAttributes(payload.substr(0, size)), FbossError);
+  }
+
+  // The list logged with fewer elements than the attribute says it has
+  auto corrupt = payload;
+  uint32_t listCount = 1;
+  memcpy(
+      corrupt.data() + sizeof(uint32_t) + sizeof(sai_attribute_t),
+      &listCount,
+      sizeof(listCount));
+  EXPECT_THROW(readAttributes(corrupt), FbossError);
+
+  // Counts beyond the payload are rejected before allocating anything
+  uint32_t hugeCount = 0xffffffff;
+  std::string hugeArray(reinterpret_cast<char*>(&hugeCount), sizeof(hugeCount));
+  SaiTraceRecordReader arrayReader{
+      folly::ByteRange(folly::StringPiece(hugeArray))};
+  EXPECT_THROW(
+      arrayReader.readArray<uint64_t>(arrayReader.readU32()), FbossError);
+  SaiTraceRecordReader stringReader{
+      folly::ByteRange(folly::StringPiece(hugeArray))};
+  EXPECT_THROW(stringReader.readString(), FbossError);
+}
@@ -46,6 +46,11 @@ class HwLinkStateToggler {
       const std::vector<PortID>& ports) {
     portStateChangeImpl(switchState, ports, false);
   }
+  /*
+   * On platforms without link scan, such as fake ones, signal a link state
+   * change to the HwSwitch as link scan would have. No-op otherwise.
+   */
+  virtual void invokeLinkScanIfNeeded(PortID port, bool isUp) = 0;
 
  protected:
   HwSwitchEnsemble* getHwSwitchEnsemble() {
@@ -62,7 +67,6 @@ class HwLinkStateToggler {
       std::shared_ptr<SwitchState> switchState,
       const std::vector<PortID>& ports,
       bool up);
-  virtual void invokeLinkScanIfNeeded(PortID port, bool isUp) = 0;
   virtual void setPortPreemphasis(
       const std::shared_ptr<Port>& port,
       int preemphasis) = 0;
@@ -12,6 +12,7 @@
 
 #include "fboss/agent/HwSwitch.h"
 #include "fboss/agent/L2Entry.h"
+#include "fboss/agent/RouteProgrammingLatency.h"
 #include "fboss/agent/hw/gen-cpp2/hardware_stats_types.h"
 #include "fboss/agent/hw/test/HwSwitchEnsembleRouteUpdateWrapper.h"
 #include "fboss/agent/if/gen-cpp2/ctrl_types.h"
@@ -203,6 +204,13 @@ class HwSwitchEnsemble : public HwSwitch::Callback {
     return HwSwitchEnsembleRouteUpdateWrapper(
         this, routingInformationBase_.get());
   }
+  /*
+   * Time route updates through getRouteUpdater() spent in each stage of
+   * programming. There is no SwSwitch update queue or state observers here.
+   */
+  RouteProgrammingLatency* getRouteProgrammingLatency() {
+    return &routeProgrammingLatency_;
+  }
   size_t getMinPktsForLineRate(const PortID& portId);
   int readPfcDeadlockDetectionCounter(const PortID& port);
   int readPfcDeadlockRecoveryCounter(const PortID& port);
@@ -255,6 +263,7 @@ class HwSwitchEnsemble : public HwSwitch::Callback {
   folly::Synchronized<std::set<HwSwitchEventObserverIf*>> hwEventObservers_;
   std::unique_ptr<std::thread> thriftThread_;
   std::unique_ptr<folly::FunctionScheduler> fs_;
+  RouteProgrammingLatency routeProgrammingLatency_;
 
   std::map<PortID, int> watchdogDeadlockCounter_;
   std::map<PortID, int> watchdogRecoveryCounter_;
@@ -19,6 +19,7 @@
 #include "fboss/agent/hw/test/HwSwitchEnsemble.h"
 
 #include <folly/logging/xlog.h>
+#include <chrono>
 #include <memory>
 
 namespace facebook::fboss {
@@ -33,10 +34,20 @@ std::shared_ptr<SwitchState> hwSwitchEnsembleFibUpdate(
       vrf, v4NetworkToRoute, v6NetworkToRoute, labelToRoute);
 
   auto hwEnsemble = static_cast<facebook::fboss::HwSwitchEnsemble*>(cookie);
+  auto start = std::chrono::steady_clock::now();
+  auto newState = fibUpdater(hwEnsemble->getProgrammedState());
+  auto hwStart = std::chrono::steady_clock::now();
   hwEnsemble->getHwSwitch()->transactionsSupported()
-      ? hwEnsemble->applyNewStateTransaction(
-            fibUpdater(hwEnsemble->getProgrammedState()))
-      : hwEnsemble->applyNewState(fibUpdater(hwEnsemble->getProgrammedState()));
+      ? hwEnsemble->applyNewStateTransaction(newState)
+      : hwEnsemble->applyNewState(newState);
+  auto end = std::chrono::steady_clock::now();
+  auto latency = hwEnsemble->getRouteProgrammingLatency();
+  latency->addSample(
+      RouteProgrammingStage::FIB_UPDATE,
+      std::chrono::duration_cast<std::chrono::microseconds>(hwStart - start));
+  latency->addSample(
+      RouteProgrammingStage::HW_PROGRAMMING,
+      std::chrono::duration_cast<std::chrono::microseconds>(end - hwStart));
   return hwEnsemble->getProgrammedState();
 }
 
@@ -49,6 +60,12 @@ HwSwitchEnsembleRouteUpdateWrapper::HwSwitchEnsembleRouteUpdateWrapper(
           rib ? hwEnsemble : nullptr),
       hwEnsemble_(hwEnsemble) {}
 
+void HwSwitchEnsembleRouteUpdateWrapper::updateStats(
+    const RoutingInformationBase::UpdateStatistics& stats) {
+  hwEnsemble_->getRouteProgrammingLatency()->addSample(
+      RouteProgrammingStage::RIB_RESOLUTION, stats.ribResolutionDuration);
+}
+
 AdminDistance HwSwitchEnsembleRouteUpdateWrapper::clientIdToAdminDistance(
     ClientID clientId) const {
   static const std::map<ClientID, AdminDistance> kClient2Admin = {
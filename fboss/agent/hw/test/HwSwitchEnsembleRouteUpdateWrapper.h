@@ -58,7 +58,7 @@ class HwSwitchEnsembleRouteUpdateWrapper : public RouteUpdateWrapper {
       const utility::RouteDistributionGenerator::ThriftRouteChunks& routeChunks,
       bool add);
   void updateStats(
-      const RoutingInformationBase::UpdateStatistics& /*stats*/) override {}
+      const RoutingInformationBase::UpdateStatistics& stats) override;
   AdminDistance clientIdToAdminDistance(ClientID clientId) const override;
 
   HwSwitchEnsemble* hwEnsemble_;
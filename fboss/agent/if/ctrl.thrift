@@ -120,6 +120,35 @@ struct RouteDetails {
   9: optional RouteCounterID counterID;
 }
 
+// Position in a route table walk: VRFs in ascending order, and within a VRF
+// the v6 routes followed by the v4 routes
+struct RouteTableCursor {
+  1: i32 vrf;
+  2: IpPrefix prefix;
+}
+
+struct RouteTableRequest {
+  // Only return the routes covered by this prefix (all routes if unset)
+  1: optional IpPrefix prefixFilter;
+  // Only return the routes after this cursor, i.e. the nextCursor of the
+  // previous page. Start from the first route if unset.
+  2: optional RouteTableCursor cursor;
+  // Max number of routes to return, capped by the agent
+  3: i32 maxRoutes = 1000;
+}
+
+struct RouteTablePage {
+  1: list<UnicastRoute> routes;
+  // Set if there may be more routes, to be passed back as cursor
+  2: optional RouteTableCursor nextCursor;
+}
+
+struct RouteDetailsPage {
+  1: list<RouteDetails> routes;
+  // Set if there may be more routes, to be passed back as cursor
+  2: optional RouteTableCursor nextCursor;
+}
+
 struct MplsRouteDetails {
   1: mpls.MplsLabel topLabel;
   2: string action;
@@ -422,8 +451,22 @@ struct RxCaptureFilter {
 # can put additional Rx filters here if need be
 }
 
+/*
+ * Filter on the packet headers, applied to both RX and TX packets. A packet
+ * passes if each non empty list contains its value of the header field.
+ */
+struct PacketHeaderCaptureFilter {
+  1: list<i32> etherTypes;
+  // 802.1q VLAN, or the ingress VLAN for untagged RX packets
+  2: list<i32> vlans;
+  3: list<i32> ipProtocols;
+  // TCP or UDP source or destination port
+  4: list<i32> l4Ports;
+}
+
 struct CaptureFilter {
   1: RxCaptureFilter rxCaptureFilter;
+  2: PacketHeaderCaptureFilter headerFilter;
 }
 
 struct CaptureInfo {
@@ -443,6 +486,8 @@ struct CaptureInfo {
    * set of criteria that packet must meet to be captured
    */
   4: CaptureFilter filter;
+  // Only keep the first snaplen bytes of each packet, 0 to keep all of them
+  5: i32 snaplen = 0;
 }
 
 struct RouteUpdateLoggingInfo {
@@ -526,6 +571,77 @@ enum ClientID {
   OPENR = 786,
 }
 
+enum RouteEventType {
+  ADD = 1,
+  CHANGE = 2,
+  DELETE = 3,
+}
+
+/*
+ * A route programmed to the FIB. Times are in microseconds since the epoch,
+ * and latencies of the programming stages are the differences between them.
+ */
+struct RouteEventThrift {
+  1: IpPrefix prefix;
+  2: RouteEventType type;
+  // Client with the best entry, unset for routes without client entries
+  3: optional ClientID client;
+  // Hash of the forwarding action and nexthops, 0 for DELETE
+  4: i64 nexthopsHash;
+  // When the RIB handed the route to the FIB, unset if it did not come from
+  // the RIB
+  5: optional i64 ribTimeUs;
+  // When the SwitchState with the route was computed
+  6: optional i64 switchStateTimeUs;
+  // When the route was programmed to the hardware
+  7: i64 hwTimeUs;
+}
+
+enum RouteProgrammingStageType {
+  RIB_RESOLUTION = 1,
+  FIB_UPDATE = 2,
+  UPDATE_QUEUE = 3,
+  HW_PROGRAMMING = 4,
+  STATE_OBSERVERS = 5,
+}
+
+/*
+ * Latency of one stage of route programming, over the agent's lifetime.
+ * Percentiles are upper bounds, to within a factor of 2.
+ */
+struct RouteProgrammingLatencyThrift {
+  1: RouteProgrammingStageType stage;
+  2: i64 count;
+  3: i64 totalUs;
+  4: i64 maxUs;
+  5: i64 p50Us;
+  6: i64 p90Us;
+  7: i64 p99Us;
+}
+
+/*
+ * A state update waiting in the SwSwitch update queue
+ */
+struct PendingStateUpdate {
+  1: string name;
+  // Time since the update was queued
+  2: i64 queuedUs;
+}
+
+/*
+ * Queue wait and apply times of the state updates with one name. Apply time
+ * is the time taken by the update's function, not the hardware programming
+ * it shares with the updates coalesced with it.
+ */
+struct StateUpdateProfile {
+  1: string name;
+  2: i64 count;
+  3: i64 totalQueueWaitUs;
+  4: i64 maxQueueWaitUs;
+  5: i64 totalApplyUs;
+  6: i64 maxApplyUs;
+}
+
 struct AclEntryThrift {
   1: i32 priority;
   2: string name;
@@ -600,6 +716,60 @@ struct ConfigAppliedInfo {
   2: optional i64 lastColdbootAppliedInMs;
 }
 
+struct PortStatusChanges {
+  // Generation of this reply, to be passed back as sinceGeneration
+  1: i64 generation;
+  // Set if portStatus holds every port instead of only the changed ones,
+  // e.g. because sinceGeneration was from a previous agent instance
+  2: bool fullSync = false;
+  // Ports whose status changed since sinceGeneration
+  3: map<i32, PortStatus> portStatus;
+  // Ports removed since sinceGeneration
+  4: list<i32> removedPorts;
+  5: ConfigAppliedInfo configAppliedInfo;
+}
+
+enum SwitchStateSubtree {
+  PORTS = 1,
+  ARP_TABLE = 2,
+  NDP_TABLE = 3,
+  L2_TABLE = 4,
+  ACL_TABLE = 5,
+  ROUTE_TABLE = 6,
+}
+
+enum SwitchStateChangeType {
+  ADDED = 1,
+  CHANGED = 2,
+  REMOVED = 3,
+}
+
+// Entry of one of the SwitchStateSubtree, in the getters' format
+union SwitchStateEntry {
+  1: PortInfoThrift port;
+  2: ArpEntryThrift arpEntry;
+  3: NdpEntryThrift ndpEntry;
+  4: L2EntryThrift l2Entry;
+  5: AclEntryThrift aclEntry;
+  6: RouteDetails route;
+}
+
+struct SwitchStateChange {
+  1: SwitchStateChangeType type;
+  // New value of the entry, or its last value if REMOVED. Only the id and
+  // name are set for removed ports.
+  2: SwitchStateEntry entry;
+}
+
+struct SwitchStateChanges {
+  // Set for the initial snapshot, which has every entry of the subscribed
+  // subtrees as ADDED
+  1: bool snapshot = false;
+  // Unset if the rest of this snapshot or update follows in the next message
+  2: bool complete = true;
+  3: list<SwitchStateChange> changes;
+}
+
 service FbossCtrl extends phy.FbossCommonPhyCtrl {
   /*
    * Retrieve up-to-date counters from the hardware, and publish all
@@ -779,6 +949,49 @@ service FbossCtrl extends phy.FbossCommonPhyCtrl {
   list<RouteDetails> getRouteTableDetailsByClients(
     1: list<i16> clientId,
   ) throws (1: fboss.FbossBaseError error);
+
+  /*
+   * Paginated variants of the route table calls above. Each call converts at
+   * most request.maxRoutes routes, resuming after request.cursor.
+   */
+  RouteTablePage getRouteTablePage(1: RouteTableRequest request) throws (
+    1: fboss.FbossBaseError error,
+  );
+  RouteTablePage getRouteTableByClientPage(
+    1: i16 clientId,
+    2: RouteTableRequest request,
+  ) throws (1: fboss.FbossBaseError error);
+  RouteDetailsPage getRouteTableDetailsPage(
+    1: RouteTableRequest request,
+  ) throws (1: fboss.FbossBaseError error);
+
+  /*
+   * Streaming variants of the route table calls above. Routes are converted
+   * as the client consumes them, from the switch state at the time of the
+   * call.
+   */
+  stream<UnicastRoute> streamRouteTable() throws (
+    1: fboss.FbossBaseError error,
+  );
+  stream<UnicastRoute> streamRouteTableByClient(1: i16 clientId) throws (
+    1: fboss.FbossBaseError error,
+  );
+  stream<RouteDetails> streamRouteTableDetails() throws (
+    1: fboss.FbossBaseError error,
+  );
+
+  /*
+   * Stream the changes to the given subtrees of the switch state, starting
+   * with a snapshot of them. Updates which happen while the client is not
+   * consuming the stream are coalesced into a single update, so a slow
+   * client only sees the net change of each entry.
+   *
+   * ARP/NDP and L2 entries are the ones in the switch state rather than the
+   * neighbor caches and hardware tables, so ARP/NDP entries have no ttl.
+   */
+  stream<SwitchStateChanges> subscribeToSwitchStateChanges(
+    1: set<SwitchStateSubtree> subtrees,
+  ) throws (1: fboss.FbossBaseError error);
   InterfaceDetail getInterfaceDetail(1: i32 interfaceId) throws (
     1: fboss.FbossBaseError error,
   );
@@ -979,6 +1192,23 @@ service FbossCtrl extends phy.FbossCommonPhyCtrl {
 
   list<RouteUpdateLoggingInfo> getRouteUpdateLoggingTrackedPrefixes();
 
+  /*
+   * Most recent route programming events, oldest first, for the given
+   * prefixes or for all prefixes if none are given. See
+   * --route_event_trace_size.
+   */
+  list<RouteEventThrift> getRouteEvents(1: list<IpPrefix> prefixes) throws (
+    1: fboss.FbossBaseError error,
+  );
+
+  /*
+   * Time route updates spent in each stage of programming, from RIB
+   * resolution to the hardware
+   */
+  list<RouteProgrammingLatencyThrift> getRouteProgrammingLatencies() throws (
+    1: fboss.FbossBaseError error,
+  );
+
   /*
    * Log all updates to mpls routes for given label
    */
@@ -1018,6 +1248,16 @@ service FbossCtrl extends phy.FbossCommonPhyCtrl {
     1: fboss.FbossBaseError error,
   );
 
+  /*
+   * Long-poll for port status and config applied changes. Returns as soon as
+   * anything changed after sinceGeneration, or after timeoutMs with an empty
+   * reply. Pass 0 as sinceGeneration to get a full snapshot.
+   */
+  PortStatusChanges waitForPortStatusChanges(
+    1: i64 sinceGeneration,
+    2: i32 timeoutMs,
+  ) throws (1: fboss.FbossBaseError error);
+
   /*
    * Serialize switch state at path pointed by JSON pointer
    */
@@ -1029,6 +1269,16 @@ service FbossCtrl extends phy.FbossCommonPhyCtrl {
    */
   void patchCurrentStateJSON(1: string jsonPointer, 2: string jsonPatch);
 
+  /*
+   * State updates waiting to be applied, oldest first
+   */
+  list<PendingStateUpdate> getPendingStateUpdates();
+
+  /*
+   * Per update name profile of the state updates applied so far
+   */
+  list<StateUpdateProfile> getStateUpdateProfiles();
+
   /*
   * Switch run state
   */
@@ -1,6 +1,12 @@
 // Copyright 2004-present Facebook. All Rights Reserved.
 #include "fboss/agent/lldp/LinkNeighborDB.h"
 
+#include <folly/hash/Hash.h>
+#include <folly/hash/SpookyHashV2.h>
+
+#include <algorithm>
+#include <cstring>
+
 using std::lock_guard;
 using std::mutex;
 using std::vector;
@@ -49,24 +55,84 @@ bool LinkNeighborDB::NeighborKey::operator==(const NeighborKey& other) const {
       portId_ == other.portId_);
 }
 
+size_t LinkNeighborDB::NeighborKey::hash() const {
+  return folly::hash::hash_combine(
+      static_cast<uint8_t>(chassisIdType_),
+      static_cast<uint8_t>(portIdType_),
+      chassisId_,
+      portId_);
+}
+
+namespace {
+uint64_t hashPdu(folly::ByteRange pdu) {
+  return folly::hash::SpookyHashV2::Hash64(pdu.data(), pdu.size(), 0);
+}
+} // namespace
+
 LinkNeighborDB::LinkNeighborDB() {}
 
-void LinkNeighborDB::update(const LinkNeighbor& neighbor) {
+void LinkNeighborDB::update(
+    const LinkNeighbor& neighbor,
+    folly::ByteRange pdu) {
   lock_guard<mutex> guard(mutex_);
 
   // Go ahead and prune expired neighbors each time we get updated.
   pruneLocked(steady_clock::now());
 
-  auto it = byLocalPort_.find(neighbor.getLocalPort());
-  if (it == byLocalPort_.end()) {
-    // This is the first time we have seen data for this port.
-    auto ret = byLocalPort_.emplace(neighbor.getLocalPort(), NeighborMap());
-    it = ret.first;
+  auto& portNeighbors = byLocalPort_[neighbor.getLocalPort()];
+  NeighborKey key(neighbor);
+  auto it = portNeighbors.neighbors.find(key);
+  if (it == portNeighbors.neighbors.end()) {
+    it = portNeighbors.neighbors
+             .emplace(key, NeighborEntry{neighbor, byExpiration_.end()})
+             .first;
+  } else {
+    it->second.neighbor = neighbor;
   }
+  setExpirationLocked(neighbor.getLocalPort(), it, neighbor);
 
-  NeighborKey key(neighbor);
-  // It would be nicer to use insert_or_assign() once we move to C++17
-  it->second[key] = neighbor;
+  auto& lastPdu = portNeighbors.lastPdu;
+  if (pdu.empty()) {
+    lastPdu = ReceivedPdu();
+    return;
+  }
+  lastPdu.hash = hashPdu(pdu);
+  lastPdu.vlan = neighbor.getLocalVlan();
+  lastPdu.srcMac = neighbor.getMac();
+  lastPdu.bytes.assign(reinterpret_cast<const char*>(pdu.data()), pdu.size());
+  lastPdu.key = std::move(key);
+}
+
+std::optional<LinkNeighbor> LinkNeighborDB::refreshIfUnchanged(
+    PortID port,
+    VlanID vlan,
+    folly::MacAddress srcMac,
+    folly::ByteRange pdu) {
+  if (pdu.empty()) {
+    return std::nullopt;
+  }
+  auto hash = hashPdu(pdu);
+
+  lock_guard<mutex> guard(mutex_);
+  auto portIt = byLocalPort_.find(port);
+  if (portIt == byLocalPort_.end()) {
+    return std::nullopt;
+  }
+  const auto& lastPdu = portIt->second.lastPdu;
+  if (!lastPdu.key || lastPdu.hash != hash || lastPdu.vlan != vlan ||
+      lastPdu.srcMac != srcMac || lastPdu.bytes.size() != pdu.size() ||
+      std::memcmp(lastPdu.bytes.data(), pdu.data(), pdu.size()) != 0) {
+    return std::nullopt;
+  }
+  auto it = portIt->second.neighbors.find(*lastPdu.key);
+  if (it == portIt->second.neighbors.end()) {
+    // Expired since
+    return std::nullopt;
+  }
+  auto& neighbor = it->second.neighbor;
+  neighbor.setTTL(neighbor.getTTL());
+  setExpirationLocked(port, it, neighbor);
+  return neighbor;
 }
 
 vector<LinkNeighbor> LinkNeighborDB::getNeighbors() {
@@ -74,10 +140,17 @@ vector<LinkNeighbor> LinkNeighborDB::getNeighbors() {
   lock_guard<mutex> guard(mutex_);
 
   for (const auto& portEntry : byLocalPort_) {
-    for (const auto& entry : portEntry.second) {
-      results.push_back(entry.second);
+    for (const auto& entry : portEntry.second.neighbors) {
+      results.push_back(entry.second.neighbor);
     }
   }
+  // Ports are hashed, keep returning neighbors by port
+  std::stable_sort(
+      results.begin(),
+      results.end(),
+      [](const LinkNeighbor& lhs, const LinkNeighbor& rhs) {
+        return lhs.getLocalPort() < rhs.getLocalPort();
+      });
 
   return results;
 }
@@ -88,8 +161,8 @@ vector<LinkNeighbor> LinkNeighborDB::getNeighbors(PortID port) {
 
   auto it = byLocalPort_.find(port);
   if (it != byLocalPort_.end()) {
-    for (const auto& entry : it->second) {
-      results.push_back(entry.second);
+    for (const auto& entry : it->second.neighbors) {
+      results.push_back(entry.second.neighbor);
     }
   }
 
@@ -109,35 +182,41 @@ int LinkNeighborDB::pruneExpiredNeighbors(steady_clock::time_point now) {
 void LinkNeighborDB::portDown(PortID port) {
   lock_guard<mutex> guard(mutex_);
   // Port went down, prune lldp entries for that port
-  byLocalPort_.erase(port);
+  auto it = byLocalPort_.find(port);
+  if (it == byLocalPort_.end()) {
+    return;
+  }
+  for (const auto& entry : it->second.neighbors) {
+    byExpiration_.erase(entry.second.expiration);
+  }
+  byLocalPort_.erase(it);
 }
 
 int LinkNeighborDB::pruneLocked(steady_clock::time_point now) {
-  // We just do a linear scan for now.
-  //
-  // We could maintain a priority queue of entries by expiration time,
-  // to make this scanning faster.  However, we don't expect the number of
-  // neighbors to be very large, so the extra complexity isn't worth
-  // implementing right now.
-
-  int count = 0;
-  for (auto& portEntry : byLocalPort_) {
-    // Advance the iterator manually to avoid make sure we don't
-    // have invalid iterators to erased elements.
-    auto& map = portEntry.second;
-    auto it = map.begin();
-    while (it != map.end()) {
-      auto current = it;
-      ++it;
-      if (current->second.isExpired(now)) {
-        map.erase(current);
-      } else {
-        count++;
-      }
+  // Only visit the expired entries, the index is ordered by expiration time
+  auto it = byExpiration_.begin();
+  while (it != byExpiration_.end() && now > it->first) {
+    auto [port, key] = it->second;
+    auto& portNeighbors = byLocalPort_.at(port);
+    portNeighbors.neighbors.erase(portNeighbors.neighbors.find(*key));
+    if (portNeighbors.neighbors.empty()) {
+      byLocalPort_.erase(port);
     }
+    it = byExpiration_.erase(it);
   }
 
-  return count;
+  return byExpiration_.size();
+}
+
+void LinkNeighborDB::setExpirationLocked(
+    PortID port,
+    NeighborMap::iterator it,
+    const LinkNeighbor& neighbor) {
+  if (it->second.expiration != byExpiration_.end()) {
+    byExpiration_.erase(it->second.expiration);
+  }
+  it->second.expiration = byExpiration_.emplace(
+      neighbor.getExpirationTime(), std::make_pair(port, &it->first));
 }
 
 } // namespace facebook::fboss
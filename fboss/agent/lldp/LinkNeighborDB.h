@@ -4,9 +4,15 @@
 #include "fboss/agent/lldp/LinkNeighbor.h"
 #include "fboss/agent/types.h"
 
+#include <folly/MacAddress.h>
+#include <folly/Range.h>
+
 #include <chrono>
 #include <map>
 #include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace facebook::fboss {
@@ -24,8 +30,25 @@ class LinkNeighborDB {
 
   /*
    * Update the DB with new neighbor information.
+   *
+   * If given, pdu is the PDU the neighbor was parsed from, which is
+   * remembered for refreshIfUnchanged().
    */
-  void update(const LinkNeighbor& neighbor);
+  void update(const LinkNeighbor& neighbor, folly::ByteRange pdu = {});
+
+  /*
+   * If pdu is identical to the last PDU given to update() for this port,
+   * i.e. has the same content hash, bytes, source MAC and VLAN, restart the
+   * TTL of the neighbor parsed from it and return that neighbor. Neighbors
+   * send the same PDU every interval, so most PDUs need not be parsed again.
+   *
+   * Returns std::nullopt if the PDU has to be parsed and passed to update().
+   */
+  std::optional<LinkNeighbor> refreshIfUnchanged(
+      PortID port,
+      VlanID vlan,
+      folly::MacAddress srcMac,
+      folly::ByteRange pdu);
 
   /*
    * Get all known neighbors.
@@ -56,6 +79,7 @@ class LinkNeighborDB {
     explicit NeighborKey(const LinkNeighbor& neighbor);
     bool operator<(const NeighborKey& other) const;
     bool operator==(const NeighborKey& other) const;
+    size_t hash() const;
 
    private:
     LldpChassisIdType chassisIdType_;
@@ -63,7 +87,38 @@ class LinkNeighborDB {
     std::string chassisId_;
     std::string portId_;
   };
-  typedef std::map<NeighborKey, LinkNeighbor> NeighborMap;
+  struct NeighborKeyHash {
+    size_t operator()(const NeighborKey& key) const {
+      return key.hash();
+    }
+  };
+
+  /*
+   * All neighbors ordered by expiration time, so that pruning only visits
+   * the expired ones. Keys point into the (node based) NeighborMap.
+   */
+  using ExpirationIndex = std::multimap<
+      std::chrono::steady_clock::time_point,
+      std::pair<PortID, const NeighborKey*>>;
+  struct NeighborEntry {
+    LinkNeighbor neighbor;
+    ExpirationIndex::iterator expiration;
+  };
+  using NeighborMap =
+      std::unordered_map<NeighborKey, NeighborEntry, NeighborKeyHash>;
+
+  struct ReceivedPdu {
+    uint64_t hash{0};
+    VlanID vlan{0};
+    folly::MacAddress srcMac;
+    std::string bytes;
+    // Of the neighbor parsed from the PDU
+    std::optional<NeighborKey> key;
+  };
+  struct PortNeighbors {
+    NeighborMap neighbors;
+    ReceivedPdu lastPdu;
+  };
 
   // Forbidden copy constructor and assignment operator
   LinkNeighborDB(LinkNeighborDB const&) = delete;
@@ -71,9 +126,14 @@ class LinkNeighborDB {
 
   // Returns number of entries left after pruning
   int pruneLocked(std::chrono::steady_clock::time_point now);
+  void setExpirationLocked(
+      PortID port,
+      NeighborMap::iterator it,
+      const LinkNeighbor& neighbor);
 
   std::mutex mutex_;
-  std::map<PortID, NeighborMap> byLocalPort_;
+  std::unordered_map<PortID, PortNeighbors> byLocalPort_;
+  ExpirationIndex byExpiration_;
 };
 
 } // namespace facebook::fboss
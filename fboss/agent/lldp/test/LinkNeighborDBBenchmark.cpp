@@ -0,0 +1,135 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+#include "fboss/agent/lldp/Lldp.h"
+#include "fboss/agent/lldp/LinkNeighbor.h"
+#include "fboss/agent/lldp/LinkNeighborDB.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+#include <folly/init/Init.h>
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBuf.h>
+#include <glog/logging.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace facebook::fboss;
+using folly::ByteRange;
+using folly::IOBuf;
+using folly::MacAddress;
+using folly::io::Cursor;
+
+namespace {
+
+constexpr auto kNumPorts = 512;
+constexpr uint16_t kEthertypeLldp = 0x88cc;
+const MacAddress kNeighborMac("02:00:00:00:00:01");
+
+void appendTlv(
+    std::vector<uint8_t>* pdu,
+    LldpTlvType type,
+    const std::string& value,
+    std::optional<uint8_t> subtype = std::nullopt) {
+  uint16_t length = value.size() + (subtype ? 1 : 0);
+  uint16_t header = (static_cast<uint16_t>(type) << 9) | length;
+  pdu->push_back(header >> 8);
+  pdu->push_back(header & 0xff);
+  if (subtype) {
+    pdu->push_back(*subtype);
+  }
+  pdu->insert(pdu->end(), value.begin(), value.end());
+}
+
+// What a neighbor switch sends every interval on port, without the
+// ethernet header
+std::vector<uint8_t> makeLldpPdu(int port, int generation) {
+  std::vector<uint8_t> pdu;
+  appendTlv(
+      &pdu,
+      LldpTlvType::CHASSIS,
+      "rsw1aa.01.abc1",
+      static_cast<uint8_t>(LldpChassisIdType::LOCALLY_ASSIGNED));
+  appendTlv(
+      &pdu,
+      LldpTlvType::PORT,
+      folly::to<std::string>("eth1/", port / 4 + 1, "/", port % 4 + 1),
+      static_cast<uint8_t>(LldpPortIdType::INTERFACE_NAME));
+  appendTlv(&pdu, LldpTlvType::TTL, std::string("\x00\x78", 2));
+  appendTlv(
+      &pdu,
+      LldpTlvType::SYSTEM_NAME,
+      folly::to<std::string>("rsw1aa.01.abc1.facebook.com.", generation));
+  appendTlv(
+      &pdu,
+      LldpTlvType::PORT_DESC,
+      folly::to<std::string>("fsw001.p", port, ".01.abc1:eth", port));
+  appendTlv(&pdu, LldpTlvType::PDU_END, "");
+  return pdu;
+}
+
+// Same steps as LldpManager::handlePacket()
+void handlePdu(
+    LinkNeighborDB* db,
+    PortID port,
+    const std::vector<uint8_t>& pdu) {
+  IOBuf buf(IOBuf::WRAP_BUFFER, pdu.data(), pdu.size());
+  Cursor cursor(&buf);
+  ByteRange bytes = cursor.peekBytes();
+  auto unchanged =
+      db->refreshIfUnchanged(port, VlanID(1), kNeighborMac, bytes);
+  if (unchanged) {
+    folly::doNotOptimizeAway(unchanged);
+    return;
+  }
+  LinkNeighbor neighbor;
+  CHECK(neighbor.parseLldpPdu(
+      port, VlanID(1), kNeighborMac, kEthertypeLldp, &cursor));
+  db->update(neighbor, bytes);
+}
+
+/*
+ * Receive one round of PDUs on all ports, after the DB has learnt the
+ * neighbors. If changing, every neighbor changed its PDU since the last round,
+ * otherwise they are all sent again as is, which is the steady state.
+ */
+void receiveLldpPdus(uint32_t iters, bool changing) {
+  folly::BenchmarkSuspender suspender;
+  std::vector<std::vector<uint8_t>> pdus[2];
+  for (auto generation = 0; generation < 2; generation++) {
+    for (auto port = 0; port < kNumPorts; port++) {
+      pdus[generation].push_back(makeLldpPdu(port, generation));
+    }
+  }
+  LinkNeighborDB db;
+  for (auto port = 0; port < kNumPorts; port++) {
+    handlePdu(&db, PortID(port + 1), pdus[0][port]);
+  }
+
+  suspender.dismiss();
+  for (uint32_t i = 0; i < iters; i++) {
+    const auto& round = pdus[changing ? (i + 1) % 2 : 0];
+    for (auto port = 0; port < kNumPorts; port++) {
+      handlePdu(&db, PortID(port + 1), round[port]);
+    }
+  }
+  suspender.rehire();
+
+  CHECK_EQ(kNumPorts, db.pruneExpiredNeighbors());
+}
+
+} // namespace
+
+BENCHMARK(LldpReceiveUnchangedPdus512Ports, iters) {
+  receiveLldpPdus(iters, false);
+}
+
+BENCHMARK(LldpReceiveChangedPdus512Ports, iters) {
+  receiveLldpPdus(iters, true);
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
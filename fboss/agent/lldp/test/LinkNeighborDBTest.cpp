@@ -2,7 +2,9 @@
 #include "fboss/agent/lldp/LinkNeighborDB.h"
 #include "fboss/agent/lldp/LinkNeighbor.h"
 
+#include <folly/Conv.h>
 #include <gtest/gtest.h>
+#include <thread>
 
 using namespace facebook::fboss;
 using folly::MacAddress;
@@ -105,3 +107,95 @@ TEST(LinkNeighborDB, test) {
   ASSERT_EQ(1, neighbors.size());
   EXPECT_EQ("neighbor3 name", neighbors[0].getSystemName());
 }
+
+TEST(LinkNeighborDB, refreshIfUnchanged) {
+  LinkNeighborDB db;
+
+  LinkNeighbor n1;
+  MacAddress n1mac("00:11:22:33:44:55");
+  n1.setProtocol(LinkProtocol::LLDP);
+  n1.setLocalPort(PortID(1));
+  n1.setLocalVlan(VlanID(1));
+  n1.setMac(n1mac);
+  n1.setChassisId("neighbor1", LldpChassisIdType::LOCALLY_ASSIGNED);
+  n1.setPortId("1/1", LldpPortIdType::LOCALLY_ASSIGNED);
+  n1.setSystemName("neighbor1 name");
+  n1.setTTL(seconds(5));
+
+  // The DB doesn't parse PDUs, any bytes will do
+  std::string pdu1 = "neighbor1 pdu";
+  std::string pdu2 = "neighbor1 pdu updated";
+  auto range1 = folly::StringPiece(pdu1);
+  auto range2 = folly::StringPiece(pdu2);
+
+  // Nothing known about the port yet
+  EXPECT_FALSE(db.refreshIfUnchanged(
+      PortID(1), VlanID(1), n1mac, folly::ByteRange(range1)));
+
+  db.update(n1, folly::ByteRange(range1));
+  auto neighbor = db.refreshIfUnchanged(
+      PortID(1), VlanID(1), n1mac, folly::ByteRange(range1));
+  ASSERT_TRUE(neighbor);
+  EXPECT_EQ("neighbor1 name", neighbor->getSystemName());
+  EXPECT_EQ(seconds(5), neighbor->getTTL());
+
+  // Different content, source MAC, VLAN or port all need parsing
+  EXPECT_FALSE(db.refreshIfUnchanged(
+      PortID(1), VlanID(1), n1mac, folly::ByteRange(range2)));
+  EXPECT_FALSE(db.refreshIfUnchanged(
+      PortID(1),
+      VlanID(1),
+      MacAddress("00:11:22:33:44:66"),
+      folly::ByteRange(range1)));
+  EXPECT_FALSE(db.refreshIfUnchanged(
+      PortID(1), VlanID(2), n1mac, folly::ByteRange(range1)));
+  EXPECT_FALSE(db.refreshIfUnchanged(
+      PortID(2), VlanID(1), n1mac, folly::ByteRange(range1)));
+
+  // Updating without the PDU forgets it
+  db.update(n1);
+  EXPECT_FALSE(db.refreshIfUnchanged(
+      PortID(1), VlanID(1), n1mac, folly::ByteRange(range1)));
+
+  // A refresh restarts the TTL, so the neighbor outlives its first expiration
+  db.update(n1, folly::ByteRange(range1));
+  auto firstExpiration = db.getNeighbors()[0].getExpirationTime();
+  /* sleep override */
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  neighbor = db.refreshIfUnchanged(
+      PortID(1), VlanID(1), n1mac, folly::ByteRange(range1));
+  ASSERT_TRUE(neighbor);
+  EXPECT_GT(neighbor->getExpirationTime(), firstExpiration);
+  EXPECT_EQ(1, db.pruneExpiredNeighbors(firstExpiration));
+  EXPECT_EQ(
+      0, db.pruneExpiredNeighbors(neighbor->getExpirationTime() + seconds(1)));
+
+  // Expired neighbors are no longer refreshed
+  EXPECT_FALSE(db.refreshIfUnchanged(
+      PortID(1), VlanID(1), n1mac, folly::ByteRange(range1)));
+}
+
+TEST(LinkNeighborDB, portDown) {
+  LinkNeighborDB db;
+
+  for (auto port = 1; port <= 2; port++) {
+    LinkNeighbor neighbor;
+    neighbor.setProtocol(LinkProtocol::LLDP);
+    neighbor.setLocalPort(PortID(port));
+    neighbor.setLocalVlan(VlanID(1));
+    neighbor.setMac(MacAddress("00:11:22:33:44:55"));
+    neighbor.setChassisId("neighbor1", LldpChassisIdType::LOCALLY_ASSIGNED);
+    neighbor.setPortId(
+        folly::to<std::string>("1/", port), LldpPortIdType::LOCALLY_ASSIGNED);
+    neighbor.setTTL(seconds(5));
+    db.update(neighbor);
+  }
+  ASSERT_EQ(2, db.getNeighbors().size());
+
+  db.portDown(PortID(1));
+  auto neighbors = db.getNeighbors();
+  ASSERT_EQ(1, neighbors.size());
+  EXPECT_EQ(PortID(2), neighbors[0].getLocalPort());
+  EXPECT_EQ(1, db.pruneExpiredNeighbors());
+  EXPECT_EQ(0, db.pruneExpiredNeighbors(steady_clock::now() + seconds(6)));
+}
@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/packet/PktHeaderInfo.h"
+
+#include <folly/Bits.h>
+#include <folly/io/Cursor.h>
+
+#include <array>
+
+#include "fboss/agent/packet/Ethertype.h"
+#include "fboss/agent/packet/IPProto.h"
+
+namespace {
+
+using facebook::fboss::ETHERTYPE;
+using facebook::fboss::IP_PROTO;
+using facebook::fboss::PktHeaderInfo;
+
+constexpr size_t kEthHdrLen = 14;
+constexpr size_t kVlanTagLen = 4;
+constexpr size_t kIPv4MinHdrLen = 20;
+constexpr size_t kIPv4MaxHdrLen = 60;
+constexpr size_t kIPv6HdrLen = 40;
+// Ports and ICMP type/code are all in the first 4 bytes of the L4 header
+constexpr size_t kL4PrefixLen = 4;
+// Longest run of header bytes the classifier looks at
+constexpr size_t kMaxHeadersLen =
+    kEthHdrLen + kVlanTagLen + kIPv4MaxHdrLen + kL4PrefixLen;
+
+uint16_t load16(const uint8_t* p) {
+  return folly::Endian::big(folly::loadUnaligned<uint16_t>(p));
+}
+
+void classifyL4(const uint8_t* p, size_t len, size_t off, PktHeaderInfo* info) {
+  if (len < off + kL4PrefixLen) {
+    return;
+  }
+  switch (static_cast<IP_PROTO>(*info->ipProtocol)) {
+    case IP_PROTO::IP_PROTO_TCP:
+    case IP_PROTO::IP_PROTO_UDP:
+      info->srcPort = load16(p + off);
+      info->dstPort = load16(p + off + 2);
+      break;
+    case IP_PROTO::IP_PROTO_ICMP:
+    case IP_PROTO::IP_PROTO_IPV6_ICMP:
+      info->icmpType = p[off];
+      info->icmpCode = p[off + 1];
+      break;
+    default:
+      return;
+  }
+  info->l4Offset = off;
+}
+
+void classifyIPv4(const uint8_t* p, size_t len, PktHeaderInfo* info) {
+  auto off = info->l3Offset;
+  if (len < off + kIPv4MinHdrLen) {
+    return;
+  }
+  uint8_t versionIhl = p[off];
+  size_t ihl = (versionIhl & 0x0f) * 4;
+  if ((versionIhl >> 4) != 4 || ihl < kIPv4MinHdrLen || len < off + ihl) {
+    return;
+  }
+  info->hopLimit = p[off + 8];
+  info->ipProtocol = p[off + 9];
+  // Only the first fragment carries the L4 header
+  if ((load16(p + off + 6) & 0x1fff) == 0) {
+    classifyL4(p, len, off + ihl, info);
+  }
+}
+
+void classifyIPv6(const uint8_t* p, size_t len, PktHeaderInfo* info) {
+  auto off = info->l3Offset;
+  if (len < off + kIPv6HdrLen || (p[off] >> 4) != 6) {
+    return;
+  }
+  info->ipProtocol = p[off + 6];
+  info->hopLimit = p[off + 7];
+  classifyL4(p, len, off + kIPv6HdrLen, info);
+}
+
+/*
+ * Classify the headers in the len contiguous bytes at p, which may be fewer
+ * than the whole packet.
+ */
+PktHeaderInfo classify(const uint8_t* p, size_t len) {
+  PktHeaderInfo info;
+  if (len < kEthHdrLen) {
+    return info;
+  }
+  info.dstMac = folly::MacAddress::fromBinary(folly::ByteRange(p, 6));
+  info.srcMac = folly::MacAddress::fromBinary(folly::ByteRange(p + 6, 6));
+  uint16_t etherType = load16(p + 12);
+  size_t off = kEthHdrLen;
+  if (etherType == static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_VLAN)) {
+    if (len < kEthHdrLen + kVlanTagLen) {
+      return info;
+    }
+    info.vlanTci = load16(p + off);
+    etherType = load16(p + off + 2);
+    off += kVlanTagLen;
+  }
+  info.etherType = etherType;
+  info.l3Offset = off;
+
+  switch (static_cast<ETHERTYPE>(etherType)) {
+    case ETHERTYPE::ETHERTYPE_IPV4:
+      classifyIPv4(p, len, &info);
+      break;
+    case ETHERTYPE::ETHERTYPE_IPV6:
+      classifyIPv6(p, len, &info);
+      break;
+    default:
+      break;
+  }
+  return info;
+}
+
+} // namespace
+
+namespace facebook::fboss {
+
+bool PktHeaderInfo::isTcp() const {
+  return l4Offset &&
+      *ipProtocol == static_cast<uint8_t>(IP_PROTO::IP_PROTO_TCP);
+}
+
+bool PktHeaderInfo::isUdp() const {
+  return l4Offset &&
+      *ipProtocol == static_cast<uint8_t>(IP_PROTO::IP_PROTO_UDP);
+}
+
+bool PktHeaderInfo::isIcmp() const {
+  return l4Offset &&
+      (*ipProtocol == static_cast<uint8_t>(IP_PROTO::IP_PROTO_ICMP) ||
+       *ipProtocol == static_cast<uint8_t>(IP_PROTO::IP_PROTO_IPV6_ICMP));
+}
+
+PktHeaderInfo classifyPktHeaders(const folly::IOBuf* buf) {
+  // Fast path: the headers, or the whole packet, are in the first buffer
+  if (!buf->isChained() || buf->length() >= kMaxHeadersLen) {
+    return classify(buf->data(), buf->length());
+  }
+  std::array<uint8_t, kMaxHeadersLen> headers;
+  folly::io::Cursor cursor(buf);
+  auto len = cursor.pullAtMost(headers.data(), headers.size());
+  return classify(headers.data(), len);
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/MacAddress.h>
+#include <folly/io/IOBuf.h>
+
+#include <cstdint>
+#include <optional>
+
+namespace facebook::fboss {
+
+/*
+ * Offsets and key fields of the ethernet, IP and TCP/UDP/ICMP headers of a
+ * packet, extracted in a single pass by classifyPktHeaders().
+ *
+ * This is only what is needed to dispatch a packet. Handlers still parse the
+ * full header of the protocol they implement.
+ */
+struct PktHeaderInfo {
+  folly::MacAddress dstMac;
+  folly::MacAddress srcMac;
+  // 802.1Q tag control information, if the packet has a VLAN tag
+  std::optional<uint16_t> vlanTci;
+  // Ethertype of the header following the ethernet header and VLAN tag
+  uint16_t etherType{0};
+  // Offset of the header following the ethernet header and VLAN tag. 0 if
+  // the ethernet header is truncated, in which case nothing else is set.
+  uint16_t l3Offset{0};
+
+  // IPv4 protocol or IPv6 next header. Only set for IP packets with a
+  // complete header. IPv6 extension headers are not followed.
+  std::optional<uint8_t> ipProtocol;
+  // IPv4 TTL or IPv6 hop limit
+  uint8_t hopLimit{0};
+  // Offset of the TCP, UDP or ICMP header. 0 if the packet has none, or it
+  // is a non-first fragment.
+  uint16_t l4Offset{0};
+
+  // TCP and UDP ports, if l4Offset is set
+  uint16_t srcPort{0};
+  uint16_t dstPort{0};
+  // ICMP or ICMPv6 type and code, if l4Offset is set
+  uint8_t icmpType{0};
+  uint8_t icmpCode{0};
+
+  bool isTcp() const;
+  bool isUdp() const;
+  bool isIcmp() const;
+};
+
+/*
+ * Classify the headers of a packet starting with an ethernet header.
+ *
+ * Headers are read with plain loads when they are contiguous in the first
+ * buffer of the chain, which is nearly always the case for received
+ * packets. They are only copied out first when split across buffers.
+ */
+PktHeaderInfo classifyPktHeaders(const folly::IOBuf* buf);
+
+} // namespace facebook::fboss
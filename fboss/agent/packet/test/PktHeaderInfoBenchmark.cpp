@@ -0,0 +1,153 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/packet/PktHeaderInfo.h"
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBuf.h>
+
+#include <vector>
+
+#include "fboss/agent/packet/Ethertype.h"
+#include "fboss/agent/packet/IPProto.h"
+#include "fboss/agent/packet/PktUtil.h"
+
+using namespace facebook::fboss;
+using folly::IOBuf;
+using folly::io::Cursor;
+
+namespace {
+
+// The kinds of packets trapped to the CPU, as in the packet header tests
+const std::vector<IOBuf>& samples() {
+  static const std::vector<IOBuf> kSamples = [] {
+    std::vector<IOBuf> samples;
+    // ARP request, VLAN tagged
+    samples.push_back(PktUtil::parseHexData(
+        "ff ff ff ff ff ff  00 02 00 01 02 03  81 00 00 01  08 06"
+        "00 01  08 00  06  04  00 01"
+        "00 02 00 01 02 03  0a 00 00 0f  00 00 00 00 00 00  0a 00 00 01"));
+    // DHCPv4 discover
+    samples.push_back(PktUtil::parseHexData(
+        "ff ff ff ff ff ff  00 02 00 01 02 03  08 00"
+        "45 00 00 1c  00 00 00 00  40 11 00 00  00 00 00 00  ff ff ff ff"
+        "00 44  00 43  00 08  00 00"));
+    // TCP
+    samples.push_back(PktUtil::parseHexData(
+        "02 00 01 00 00 01  02 00 02 01 02 03  08 00"
+        "45 00 00 28  00 00 40 00  1f 06 00 00  01 02 03 04  0a 00 00 0a"
+        "04 d2  00 b3  00 00 00 00  00 00 00 00  50 02 ff ff  00 00 00 00"));
+    // ICMPv6 neighbor solicitation, VLAN tagged
+    samples.push_back(PktUtil::parseHexData(
+        "33 33 ff 00 00 01  00 02 00 01 02 03  81 00 00 05  86 dd"
+        "6e 00 00 00  00 08  3a  ff"
+        "fe 80 00 00 00 00 00 00  00 02 00 ff fe 01 02 03"
+        "ff 02 00 00 00 00 00 00  00 00 00 01 ff 00 00 01"
+        "87 00 00 00  00 00 00 00"));
+    return samples;
+  }();
+  return kSamples;
+}
+
+// The samples, with the ethernet header in a buffer of its own
+const std::vector<std::unique_ptr<IOBuf>>& chainedSamples() {
+  static const std::vector<std::unique_ptr<IOBuf>> kChained = [] {
+    std::vector<std::unique_ptr<IOBuf>> chained;
+    for (const auto& sample : samples()) {
+      auto head = IOBuf::copyBuffer(sample.data(), 14);
+      head->prependChain(
+          IOBuf::copyBuffer(sample.data() + 14, sample.length() - 14));
+      chained.push_back(std::move(head));
+    }
+    return chained;
+  }();
+  return kChained;
+}
+
+/*
+ * What the receive path used to do: read the ethernet header with a cursor,
+ * then read the IP and UDP headers again to check for DHCP.
+ */
+uint16_t cursorParse(const IOBuf* buf) {
+  Cursor c(buf);
+  auto dstMac = PktUtil::readMac(&c);
+  auto srcMac = PktUtil::readMac(&c);
+  folly::doNotOptimizeAway(dstMac);
+  folly::doNotOptimizeAway(srcMac);
+  auto ethertype = c.readBE<uint16_t>();
+  if (ethertype == static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_VLAN)) {
+    c += 2;
+    ethertype = c.readBE<uint16_t>();
+  }
+  uint8_t protocol;
+  if (ethertype == static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_IPV4)) {
+    auto ihl = (c.read<uint8_t>() & 0xf) * 4;
+    c += 8;
+    protocol = c.read<uint8_t>();
+    c += ihl - 10;
+  } else if (ethertype == static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_IPV6)) {
+    c += 6;
+    protocol = c.read<uint8_t>();
+    c += 33;
+  } else {
+    return ethertype;
+  }
+  if (protocol != static_cast<uint8_t>(IP_PROTO::IP_PROTO_UDP)) {
+    return protocol;
+  }
+  c += 2;
+  return c.readBE<uint16_t>();
+}
+
+uint16_t classify(const IOBuf* buf) {
+  auto headers = classifyPktHeaders(buf);
+  folly::doNotOptimizeAway(headers.dstMac);
+  folly::doNotOptimizeAway(headers.srcMac);
+  return headers.dstPort;
+}
+
+} // namespace
+
+BENCHMARK(CursorParse, iters) {
+  const auto& bufs = samples();
+  for (size_t i = 0; i < iters; i++) {
+    folly::doNotOptimizeAway(cursorParse(&bufs[i % bufs.size()]));
+  }
+}
+
+BENCHMARK_RELATIVE(ClassifyContiguous, iters) {
+  const auto& bufs = samples();
+  for (size_t i = 0; i < iters; i++) {
+    folly::doNotOptimizeAway(classify(&bufs[i % bufs.size()]));
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(CursorParseChained, iters) {
+  const auto& bufs = chainedSamples();
+  for (size_t i = 0; i < iters; i++) {
+    folly::doNotOptimizeAway(cursorParse(bufs[i % bufs.size()].get()));
+  }
+}
+
+BENCHMARK_RELATIVE(ClassifyChained, iters) {
+  const auto& bufs = chainedSamples();
+  for (size_t i = 0; i < iters; i++) {
+    folly::doNotOptimizeAway(classify(bufs[i % bufs.size()].get()));
+  }
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
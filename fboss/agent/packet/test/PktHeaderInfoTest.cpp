@@ -0,0 +1,228 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/packet/PktHeaderInfo.h"
+
+#include <gtest/gtest.h>
+
+#include <folly/MacAddress.h>
+#include <folly/Range.h>
+#include <folly/io/IOBuf.h>
+
+#include <algorithm>
+
+#include "fboss/agent/hw/mock/MockRxPacket.h"
+#include "fboss/agent/packet/Ethertype.h"
+#include "fboss/agent/packet/IPProto.h"
+
+using namespace facebook::fboss;
+using folly::IOBuf;
+using folly::MacAddress;
+
+namespace {
+
+// Split buf into a chain of buffers of at most segmentLen bytes
+std::unique_ptr<IOBuf> chain(const IOBuf* buf, size_t segmentLen) {
+  auto copy = buf->cloneCoalesced();
+  folly::ByteRange data(copy->data(), copy->length());
+  std::unique_ptr<IOBuf> head;
+  for (size_t off = 0; off < data.size(); off += segmentLen) {
+    auto segment = IOBuf::copyBuffer(
+        data.data() + off, std::min(segmentLen, data.size() - off));
+    if (head) {
+      head->prependChain(std::move(segment));
+    } else {
+      head = std::move(segment);
+    }
+  }
+  return head;
+}
+
+void expectSameHeaders(const PktHeaderInfo& a, const PktHeaderInfo& b) {
+  EXPECT_EQ(a.dstMac, b.dstMac);
+  EXPECT_EQ(a.srcMac, b.srcMac);
+  EXPECT_EQ(a.vlanTci, b.vlanTci);
+  EXPECT_EQ(a.etherType, b.etherType);
+  EXPECT_EQ(a.l3Offset, b.l3Offset);
+  EXPECT_EQ(a.ipProtocol, b.ipProtocol);
+  EXPECT_EQ(a.hopLimit, b.hopLimit);
+  EXPECT_EQ(a.l4Offset, b.l4Offset);
+  EXPECT_EQ(a.srcPort, b.srcPort);
+  EXPECT_EQ(a.dstPort, b.dstPort);
+  EXPECT_EQ(a.icmpType, b.icmpType);
+  EXPECT_EQ(a.icmpCode, b.icmpCode);
+}
+
+} // namespace
+
+TEST(PktHeaderInfoTest, arp) {
+  auto pkt = MockRxPacket::fromHex(
+      // dst mac, src mac
+      "ff ff ff ff ff ff  00 02 00 01 02 03"
+      // 802.1q, VLAN 1
+      "81 00  00 01"
+      // ARP
+      "08 06"
+      // Hardware type, protocol type, lengths, operation
+      "00 01  08 00  06  04  00 01"
+      // Sender MAC and IP
+      "00 02 00 01 02 03  0a 00 00 0f"
+      // Target MAC and IP
+      "00 00 00 00 00 00  0a 00 00 01");
+  const auto& headers = pkt->getHeaderInfo();
+  EXPECT_EQ(MacAddress("ff:ff:ff:ff:ff:ff"), headers.dstMac);
+  EXPECT_EQ(MacAddress("00:02:00:01:02:03"), headers.srcMac);
+  EXPECT_EQ(1, headers.vlanTci);
+  EXPECT_EQ(
+      static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_ARP), headers.etherType);
+  EXPECT_EQ(18, headers.l3Offset);
+  EXPECT_FALSE(headers.ipProtocol);
+  EXPECT_EQ(0, headers.l4Offset);
+}
+
+TEST(PktHeaderInfoTest, ipv4Udp) {
+  auto pkt = MockRxPacket::fromHex(
+      // dst mac, src mac
+      "ff ff ff ff ff ff  00 02 00 01 02 03"
+      // IPv4
+      "08 00"
+      // Version(4), IHL(6), DSCP(0), ECN(0), Total Length(32)
+      "46  00  00 20"
+      // Identification(0), Flags(0), Fragment offset(0)
+      "00 00  00 00"
+      // TTL(64), Protocol(17), Checksum (0, fake)
+      "40  11  00 00"
+      // Source IP (0.0.0.0), Destination IP (255.255.255.255)
+      "00 00 00 00  ff ff ff ff"
+      // Options
+      "01 01 01 00"
+      // Source port(68), Destination port(67), Length(8), Checksum(0)
+      "00 44  00 43  00 08  00 00");
+  const auto& headers = pkt->getHeaderInfo();
+  EXPECT_FALSE(headers.vlanTci);
+  EXPECT_EQ(
+      static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_IPV4), headers.etherType);
+  EXPECT_EQ(14, headers.l3Offset);
+  EXPECT_EQ(static_cast<uint8_t>(IP_PROTO::IP_PROTO_UDP), headers.ipProtocol);
+  EXPECT_EQ(64, headers.hopLimit);
+  EXPECT_EQ(38, headers.l4Offset);
+  EXPECT_TRUE(headers.isUdp());
+  EXPECT_FALSE(headers.isTcp());
+  EXPECT_EQ(68, headers.srcPort);
+  EXPECT_EQ(67, headers.dstPort);
+}
+
+TEST(PktHeaderInfoTest, ipv4Fragment) {
+  auto pkt = MockRxPacket::fromHex(
+      // dst mac, src mac
+      "02 00 01 00 00 01  02 00 02 01 02 03"
+      // IPv4
+      "08 00"
+      // Version(4), IHL(5), DSCP(0), ECN(0), Total Length(24)
+      "45  00  00 18"
+      // Identification(1), Flags(0), Fragment offset(1)
+      "00 01  00 01"
+      // TTL(31), Protocol(6), Checksum (0, fake)
+      "1F  06  00 00"
+      // Source IP (1.2.3.4), Destination IP (10.0.0.10)
+      "01 02 03 04  0a 00 00 0a"
+      // Payload, not a TCP header
+      "04 d2  00 50");
+  const auto& headers = pkt->getHeaderInfo();
+  EXPECT_EQ(static_cast<uint8_t>(IP_PROTO::IP_PROTO_TCP), headers.ipProtocol);
+  EXPECT_EQ(0, headers.l4Offset);
+  EXPECT_FALSE(headers.isTcp());
+}
+
+TEST(PktHeaderInfoTest, ipv6Icmp) {
+  auto pkt = MockRxPacket::fromHex(
+      // dst mac, src mac
+      "33 33 ff 00 00 01  00 02 00 01 02 03"
+      // 802.1q, VLAN 5
+      "81 00  00 05"
+      // IPv6
+      "86 dd"
+      // Version 6, traffic class, flow label
+      "6e 00 00 00"
+      // Payload length(8), Next header(58), Hop limit(255)
+      "00 08  3a  ff"
+      // Source address
+      "fe 80 00 00 00 00 00 00  00 02 00 ff fe 01 02 03"
+      // Destination address
+      "ff 02 00 00 00 00 00 00  00 00 00 01 ff 00 00 01"
+      // Type(135, neighbor solicitation), Code(0), Checksum(0, fake)
+      "87  00  00 00"
+      // Reserved
+      "00 00 00 00");
+  const auto& headers = pkt->getHeaderInfo();
+  EXPECT_EQ(5, headers.vlanTci);
+  EXPECT_EQ(
+      static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_IPV6), headers.etherType);
+  EXPECT_EQ(18, headers.l3Offset);
+  EXPECT_EQ(
+      static_cast<uint8_t>(IP_PROTO::IP_PROTO_IPV6_ICMP), headers.ipProtocol);
+  EXPECT_EQ(255, headers.hopLimit);
+  EXPECT_EQ(58, headers.l4Offset);
+  EXPECT_TRUE(headers.isIcmp());
+  EXPECT_EQ(135, headers.icmpType);
+  EXPECT_EQ(0, headers.icmpCode);
+}
+
+TEST(PktHeaderInfoTest, truncated) {
+  // Not a whole ethernet header
+  auto pkt = MockRxPacket::fromHex("ff ff ff ff ff ff  00 02 00 01 02 03");
+  EXPECT_EQ(0, pkt->getHeaderInfo().l3Offset);
+
+  // Not a whole IPv4 header
+  pkt = MockRxPacket::fromHex(
+      "ff ff ff ff ff ff  00 02 00 01 02 03"
+      "08 00"
+      "45  00  00 18");
+  EXPECT_EQ(14, pkt->getHeaderInfo().l3Offset);
+  EXPECT_FALSE(pkt->getHeaderInfo().ipProtocol);
+
+  // Bad IHL
+  pkt = MockRxPacket::fromHex(
+      "ff ff ff ff ff ff  00 02 00 01 02 03"
+      "08 00"
+      "44  00  00 14  00 00  00 00  40  11  00 00"
+      "00 00 00 00  ff ff ff ff");
+  EXPECT_FALSE(pkt->getHeaderInfo().ipProtocol);
+
+  // No whole L4 ports
+  pkt = MockRxPacket::fromHex(
+      "ff ff ff ff ff ff  00 02 00 01 02 03"
+      "08 00"
+      "45  00  00 16  00 00  00 00  40  11  00 00"
+      "00 00 00 00  ff ff ff ff"
+      "00 44");
+  EXPECT_EQ(
+      static_cast<uint8_t>(IP_PROTO::IP_PROTO_UDP),
+      pkt->getHeaderInfo().ipProtocol);
+  EXPECT_EQ(0, pkt->getHeaderInfo().l4Offset);
+}
+
+TEST(PktHeaderInfoTest, chainedBuffers) {
+  auto pkt = MockRxPacket::fromHex(
+      "33 33 ff 00 00 01  00 02 00 01 02 03"
+      "81 00  00 05"
+      "86 dd"
+      "6e 00 00 00  00 08  11  ff"
+      "fe 80 00 00 00 00 00 00  00 02 00 ff fe 01 02 03"
+      "ff 02 00 00 00 00 00 00  00 00 00 01 00 01 00 02"
+      // Source port(546), Destination port(547)
+      "02 22  02 23  00 08  00 00");
+  const auto& contiguous = pkt->getHeaderInfo();
+  EXPECT_EQ(547, contiguous.dstPort);
+  // Headers split at every offset classify the same
+  for (size_t segmentLen = 1; segmentLen < 20; segmentLen++) {
+    auto chained = chain(pkt->buf(), segmentLen);
+    expectSameHeaders(contiguous, classifyPktHeaders(chained.get()));
+  }
+}
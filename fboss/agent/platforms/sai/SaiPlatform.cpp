@@ -12,6 +12,8 @@
 
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/hw/HwSwitchWarmBootHelper.h"
+#include "fboss/agent/hw/sai/switch/SaiAclTableManager.h"
+#include "fboss/agent/hw/sai/switch/SaiManagerTable.h"
 #include "fboss/agent/hw/sai/switch/SaiSwitch.h"
 #include "fboss/agent/hw/switch_asics/HwAsic.h"
 #include "fboss/agent/platforms/sai/SaiBcmDarwinPlatformPort.h"
@@ -118,6 +120,12 @@ HwSwitch* SaiPlatform::getHwSwitch() const {
   return saiSwitch_.get();
 }
 
+int SaiPlatform::getMaxAclEntryPriority() const {
+  // The supported range is only known once the switch is created
+  CHECK(saiSwitch_);
+  return saiSwitch_->managerTable()->aclTableManager().getMaxAclEntryPriority();
+}
+
 void SaiPlatform::onHwInitialized(SwSwitch* sw) {
   initLEDs();
   sw->registerStateObserver(this, "SaiPlatform");
@@ -48,6 +48,7 @@ class SaiPlatform : public Platform, public StateObserver {
   ~SaiPlatform() override;
 
   HwSwitch* getHwSwitch() const override;
+  int getMaxAclEntryPriority() const override;
   void onHwInitialized(SwSwitch* sw) override;
   void onInitialConfigApplied(SwSwitch* sw) override;
   std::unique_ptr<ThriftHandler> createHandler(SwSwitch* sw) override;
@@ -474,8 +474,23 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::updateImpl(
   UpdateStatistics stats;
   std::chrono::microseconds duration;
   std::shared_ptr<SwitchState> appliedState;
-  Timer updateTimer(&duration);
   std::exception_ptr updateException;
+  // Time spent in the FIB callback, to tell it apart from the RIB's own work
+  std::chrono::microseconds fibUpdateDuration{0};
+  auto timedFibUpdateCallback = [&fibUpdateDuration, &fibUpdateCallback](
+                                    RouterID vrf,
+                                    const IPv4NetworkToRouteMap& v4Routes,
+                                    const IPv6NetworkToRouteMap& v6Routes,
+                                    const LabelToRouteMap& labelRoutes,
+                                    void* fibCookie) {
+    auto start = std::chrono::steady_clock::now();
+    SCOPE_EXIT {
+      fibUpdateDuration +=
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - start);
+    };
+    return fibUpdateCallback(vrf, v4Routes, v6Routes, labelRoutes, fibCookie);
+  };
   auto updateFn = [&]() {
     std::vector<typename TraitsType::RibRoute> toAddRoutes;
     toAddRoutes.reserve(toAdd.size());
@@ -505,17 +520,22 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::updateImpl(
           toDelPrefixes,
           resetClientsRoutes,
           updateType,
-          fibUpdateCallback,
+          timedFibUpdateCallback,
           cookie);
     } catch (const std::exception& e) {
       updateException = std::current_exception();
     }
   };
-  ribUpdateEventBase_.runInEventBaseThreadAndWait(updateFn);
+  {
+    Timer updateTimer(&duration);
+    ribUpdateEventBase_.runInEventBaseThreadAndWait(updateFn);
+  }
   if (updateException) {
     std::rethrow_exception(updateException);
   }
   stats.duration = duration;
+  stats.fibUpdateDuration = fibUpdateDuration;
+  stats.ribResolutionDuration = duration - fibUpdateDuration;
   return stats;
 }
 
@@ -177,7 +177,12 @@ class RoutingInformationBase {
     std::size_t v6RoutesDeleted{0};
     std::size_t mplsRoutesAdded{0};
     std::size_t mplsRoutesDeleted{0};
+    // Total time of the update, including the FIB update callback
     std::chrono::microseconds duration{0};
+    // Time spent resolving routes and updating the RIB
+    std::chrono::microseconds ribResolutionDuration{0};
+    // Time spent in the FIB update callback
+    std::chrono::microseconds fibUpdateDuration{0};
   };
 
   /*
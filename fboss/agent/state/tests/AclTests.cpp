@@ -10,6 +10,7 @@
 
 #include "fboss/agent/ApplyThriftConfig.h"
 #include "fboss/agent/FbossError.h"
+#include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/hw/mock/MockPlatform.h"
 #include "fboss/agent/state/AclEntry.h"
@@ -19,6 +20,8 @@
 #include "fboss/agent/test/TestUtils.h"
 #include "folly/IPAddress.h"
 
+#include <fb303/ServiceData.h>
+#include <folly/Conv.h>
 #include <folly/IPAddress.h>
 #include <folly/MacAddress.h>
 #include <gtest/gtest.h>
@@ -31,10 +34,16 @@ using std::make_shared;
 using std::shared_ptr;
 
 DECLARE_bool(enable_acl_table_group);
+DECLARE_int32(acl_priority_gap);
 
 namespace {
 // We offset the start point in ApplyThriftConfig
 constexpr auto kAclStartPriority = 100000;
+
+int64_t getAclHwOperationsEstimate() {
+  return facebook::fb303::fbData->getCounter(folly::to<std::string>(
+      SwitchStats::kCounterPrefix, "config_apply.acl_hw_ops_estimate"));
+}
 } // namespace
 
 TEST(Acl, applyConfig) {
@@ -440,6 +449,93 @@ TEST(Acl, AclGeneration) {
            .dscpValue());
 }
 
+TEST(Acl, AclPriorityGap) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_enable_acl_table_group = false;
+  FLAGS_acl_priority_gap = 10;
+  auto platform = createMockPlatform();
+  auto stateV0 = make_shared<SwitchState>();
+  stateV0->registerPort(PortID(1), "port1");
+
+  cfg::SwitchConfig config;
+  config.ports()->resize(1);
+  preparedMockPortConfig(config.ports()[0], 1);
+  config.acls()->resize(3);
+  for (auto i = 0; i < 3; i++) {
+    *config.acls()[i].name() = folly::to<std::string>("acl", i * 2);
+    *config.acls()[i].actionType() = cfg::AclActionType::DENY;
+    config.acls()[i].l4DstPort() = i * 2;
+  }
+
+  auto stateV1 = publishAndApplyConfig(stateV0, &config, platform.get());
+  ASSERT_NE(nullptr, stateV1);
+  EXPECT_EQ(kAclStartPriority, stateV1->getAcl("acl0")->getPriority());
+  EXPECT_EQ(kAclStartPriority + 10, stateV1->getAcl("acl2")->getPriority());
+  EXPECT_EQ(kAclStartPriority + 20, stateV1->getAcl("acl4")->getPriority());
+
+  // The inserted entry takes a priority in the gap, the others are unchanged
+  cfg::AclEntry acl1;
+  *acl1.name() = "acl1";
+  *acl1.actionType() = cfg::AclActionType::DENY;
+  acl1.l4DstPort() = 1;
+  config.acls()->insert(config.acls()->begin() + 1, acl1);
+  auto stateV2 = publishAndApplyConfig(stateV1, &config, platform.get());
+  ASSERT_NE(nullptr, stateV2);
+  EXPECT_EQ(kAclStartPriority + 5, stateV2->getAcl("acl1")->getPriority());
+  for (const auto& name : {"acl0", "acl2", "acl4"}) {
+    EXPECT_EQ(stateV1->getAcl(name), stateV2->getAcl(name));
+  }
+}
+
+TEST(Acl, AclPriorityGapFrontInsert) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_enable_acl_table_group = false;
+  auto platform = createMockPlatform();
+  cfg::SwitchConfig config;
+  config.ports()->resize(1);
+  preparedMockPortConfig(config.ports()[0], 1);
+  config.acls()->resize(3);
+  for (auto i = 0; i < 3; i++) {
+    *config.acls()[i].name() = folly::to<std::string>("acl", i + 1);
+    *config.acls()[i].actionType() = cfg::AclActionType::DENY;
+    config.acls()[i].l4DstPort() = i + 1;
+  }
+  cfg::AclEntry acl0;
+  *acl0.name() = "acl0";
+  *acl0.actionType() = cfg::AclActionType::DENY;
+  acl0.l4DstPort() = 0;
+  auto frontInsertConfig = config;
+  frontInsertConfig.acls()->insert(frontInsertConfig.acls()->begin(), acl0);
+
+  auto frontInsert = [&](int gap) {
+    FLAGS_acl_priority_gap = gap;
+    auto stateV0 = make_shared<SwitchState>();
+    stateV0->registerPort(PortID(1), "port1");
+    auto stateV1 = publishAndApplyConfig(stateV0, &config, platform.get());
+    EXPECT_NE(nullptr, stateV1);
+    auto stateV2 =
+        publishAndApplyConfig(stateV1, &frontInsertConfig, platform.get());
+    EXPECT_NE(nullptr, stateV2);
+    return stateV2;
+  };
+
+  // Without gaps every entry moves: the 3 priorities each get another
+  // entry, 2 operations each, and one priority is added
+  auto state = frontInsert(1);
+  for (auto i = 0; i < 4; i++) {
+    auto name = folly::to<std::string>("acl", i);
+    EXPECT_EQ(kAclStartPriority + i, state->getAcl(name)->getPriority());
+  }
+  EXPECT_EQ(7, getAclHwOperationsEstimate());
+
+  // With gaps only the first entry moves to make room
+  state = frontInsert(10);
+  EXPECT_EQ(kAclStartPriority, state->getAcl("acl0")->getPriority());
+  EXPECT_EQ(kAclStartPriority + 9, state->getAcl("acl1")->getPriority());
+  EXPECT_EQ(kAclStartPriority + 10, state->getAcl("acl2")->getPriority());
+  EXPECT_EQ(3, getAclHwOperationsEstimate());
+}
+
 TEST(Acl, SerializeAclEntry) {
   auto entry = std::make_unique<AclEntry>(0, "dscp1");
   entry->setDscp(1);
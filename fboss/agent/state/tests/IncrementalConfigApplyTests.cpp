@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/gen-cpp2/switch_config_types.h"
+#include "fboss/agent/hw/mock/MockPlatform.h"
+#include "fboss/agent/rib/RoutingInformationBase.h"
+#include "fboss/agent/state/AclEntry.h"
+#include "fboss/agent/state/AclMap.h"
+#include "fboss/agent/state/Mirror.h"
+#include "fboss/agent/state/MirrorMap.h"
+#include "fboss/agent/state/SflowCollectorMap.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/MirrorConfigs.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+using std::make_shared;
+using std::shared_ptr;
+
+DECLARE_bool(enable_acl_table_group);
+DECLARE_bool(incremental_config_apply);
+
+namespace {
+
+cfg::SwitchConfig aclConfig() {
+  cfg::SwitchConfig config;
+  config.ports()->resize(2);
+  preparedMockPortConfig(config.ports()[0], 1);
+  preparedMockPortConfig(config.ports()[1], 2);
+
+  config.acls()->resize(1);
+  *config.acls()[0].name() = "acl1";
+  *config.acls()[0].actionType() = cfg::AclActionType::DENY;
+  config.acls()[0].dstIp() = "192.168.0.0/24";
+  config.acls()[0].dstPort() = 8;
+  return config;
+}
+
+// A state whose ACLs no longer match the config it was built from, so that
+// re-applying the ACL section is visible
+shared_ptr<SwitchState> withoutAcls(const shared_ptr<SwitchState>& state) {
+  auto newState = state->clone();
+  newState->resetAcls(make_shared<AclMap>());
+  newState->publish();
+  return newState;
+}
+
+class IncrementalConfigApplyTest : public ::testing::Test {
+ public:
+  shared_ptr<SwitchState> applyConfig(
+      const shared_ptr<SwitchState>& state,
+      const cfg::SwitchConfig& config,
+      const cfg::SwitchConfig* prevConfig) {
+    RoutingInformationBase* rib = nullptr;
+    return applyThriftConfig(state, &config, platform_.get(), rib, prevConfig);
+  }
+
+  void SetUp() override {
+    FLAGS_enable_acl_table_group = false;
+    FLAGS_incremental_config_apply = true;
+    platform_ = createMockPlatform();
+    auto stateV0 = make_shared<SwitchState>();
+    stateV0->registerPort(PortID(1), "port1");
+    stateV0->registerPort(PortID(2), "port2");
+    config_ = aclConfig();
+    state_ = publishAndApplyConfig(stateV0, &config_, platform_.get());
+    ASSERT_NE(nullptr, state_);
+    state_->publish();
+  }
+
+  void TearDown() override {
+    FLAGS_incremental_config_apply = true;
+  }
+
+ protected:
+  std::unique_ptr<MockPlatform> platform_;
+  cfg::SwitchConfig config_;
+  shared_ptr<SwitchState> state_;
+};
+
+} // namespace
+
+TEST_F(IncrementalConfigApplyTest, changedAclApplied) {
+  auto newConfig = config_;
+  newConfig.acls()[0].dstPort() = 9;
+  auto newState = applyConfig(state_, newConfig, &config_);
+  ASSERT_NE(nullptr, newState);
+  auto acl = newState->getAcl("acl1");
+  ASSERT_NE(nullptr, acl);
+  EXPECT_EQ(9, acl->getDstPort());
+  // Nothing outside of the ACLs changed
+  EXPECT_EQ(state_->getPorts(), newState->getPorts());
+  EXPECT_EQ(state_->getQosPolicies(), newState->getQosPolicies());
+}
+
+TEST_F(IncrementalConfigApplyTest, unchangedAclsSkipped) {
+  auto stateV1 = withoutAcls(state_);
+  auto newConfig = config_;
+  newConfig.sFlowCollectors()->resize(1);
+  *newConfig.sFlowCollectors()[0].ip() = "2401:db00::1";
+  *newConfig.sFlowCollectors()[0].port() = 6343;
+
+  // ACLs did not change from the previous config, so are not re-applied
+  auto stateV2 = applyConfig(stateV1, newConfig, &config_);
+  ASSERT_NE(nullptr, stateV2);
+  EXPECT_EQ(stateV1->getAcls(), stateV2->getAcls());
+  EXPECT_EQ(nullptr, stateV2->getAcl("acl1"));
+  EXPECT_EQ(1, stateV2->getSflowCollectors()->size());
+
+  // Without the previous config every section is applied
+  auto stateV3 = applyConfig(stateV1, newConfig, nullptr);
+  ASSERT_NE(nullptr, stateV3);
+  EXPECT_NE(nullptr, stateV3->getAcl("acl1"));
+}
+
+TEST_F(IncrementalConfigApplyTest, portChangeReappliesAcls) {
+  auto stateV1 = withoutAcls(state_);
+  auto newConfig = config_;
+  newConfig.ports()[1].description() = "new description";
+
+  // Mirrors refer to ports, and ACLs to mirrors
+  auto stateV2 = applyConfig(stateV1, newConfig, &config_);
+  ASSERT_NE(nullptr, stateV2);
+  EXPECT_NE(nullptr, stateV2->getAcl("acl1"));
+}
+
+TEST_F(IncrementalConfigApplyTest, mirrorChangeReappliesAcls) {
+  auto stateV1 = withoutAcls(state_);
+  auto newConfig = config_;
+  newConfig.mirrors()->push_back(utility::getSPANMirror("mirror1", PortID(1)));
+
+  // ACLs may refer to mirrors, so are applied when mirrors change
+  auto stateV2 = applyConfig(stateV1, newConfig, &config_);
+  ASSERT_NE(nullptr, stateV2);
+  EXPECT_NE(nullptr, stateV2->getMirrors()->getMirrorIf("mirror1"));
+  EXPECT_NE(nullptr, stateV2->getAcl("acl1"));
+}
+
+TEST_F(IncrementalConfigApplyTest, disabledByFlag) {
+  FLAGS_incremental_config_apply = false;
+  auto stateV1 = withoutAcls(state_);
+  auto stateV2 = applyConfig(stateV1, config_, &config_);
+  ASSERT_NE(nullptr, stateV2);
+  EXPECT_NE(nullptr, stateV2->getAcl("acl1"));
+}
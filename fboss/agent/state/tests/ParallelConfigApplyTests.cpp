@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/gen-cpp2/switch_config_types.h"
+#include "fboss/agent/hw/mock/MockPlatform.h"
+#include "fboss/agent/state/Mirror.h"
+#include "fboss/agent/state/MirrorMap.h"
+#include "fboss/agent/state/QosPolicyMap.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/MirrorConfigs.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <folly/Conv.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+using std::shared_ptr;
+
+DECLARE_bool(enable_acl_table_group);
+DECLARE_int32(config_apply_threads);
+
+namespace {
+
+constexpr int kNumAcls = 200;
+
+// testConfigA with ACLs, a mirror used by one of them and a QoS policy, so
+// that every level of config sections has something to build
+cfg::SwitchConfig fullConfig() {
+  auto config = testConfigA();
+  config.mirrors()->push_back(utility::getSPANMirror("mirror0", PortID(1)));
+  config.acls()->resize(kNumAcls);
+  for (int i = 0; i < kNumAcls; ++i) {
+    auto& acl = config.acls()[i];
+    *acl.name() = folly::to<std::string>("acl", i);
+    *acl.actionType() = cfg::AclActionType::DENY;
+    acl.l4DstPort() = 1024 + i;
+  }
+
+  cfg::MatchAction action;
+  action.ingressMirror() = "mirror0";
+  cfg::MatchToAction mirrorAction;
+  *mirrorAction.matcher() = "acl0";
+  *mirrorAction.action() = action;
+  config.dataPlaneTrafficPolicy() = cfg::TrafficPolicyConfig();
+  config.dataPlaneTrafficPolicy()->matchToAction()->push_back(mirrorAction);
+
+  config.qosPolicies()->resize(1);
+  *config.qosPolicies()[0].name() = "qp0";
+  cfg::QosRule rule;
+  *rule.queueId() = 2;
+  *rule.dscp() = {10, 12};
+  config.qosPolicies()[0].rules()->push_back(rule);
+  return config;
+}
+
+class ParallelConfigApplyTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    FLAGS_enable_acl_table_group = false;
+    platform_ = createMockPlatform();
+    threads_ = FLAGS_config_apply_threads;
+  }
+
+  void TearDown() override {
+    FLAGS_config_apply_threads = threads_;
+  }
+
+  shared_ptr<SwitchState> apply(const cfg::SwitchConfig& config, int threads) {
+    FLAGS_config_apply_threads = threads;
+    auto state = publishAndApplyConfig(testStateA(), &config, platform_.get());
+    EXPECT_NE(nullptr, state);
+    return state;
+  }
+
+ protected:
+  std::unique_ptr<MockPlatform> platform_;
+  int threads_;
+};
+
+} // namespace
+
+TEST_F(ParallelConfigApplyTest, sameStateAsSequential) {
+  auto config = fullConfig();
+  auto sequential = apply(config, 0);
+  auto parallel = apply(config, 4);
+  ASSERT_NE(nullptr, sequential);
+  ASSERT_NE(nullptr, parallel);
+  EXPECT_EQ(sequential->toFollyDynamic(), parallel->toFollyDynamic());
+  EXPECT_NE(nullptr, parallel->getAcl("acl0"));
+  EXPECT_NE(nullptr, parallel->getMirrors()->getMirrorIf("mirror0"));
+  EXPECT_NE(nullptr, parallel->getQosPolicies()->getQosPolicyIf("qp0"));
+}
+
+TEST_F(ParallelConfigApplyTest, sectionErrorPropagates) {
+  // The ACL refers to a mirror which does not exist
+  auto config = fullConfig();
+  config.mirrors()->clear();
+  FLAGS_config_apply_threads = 4;
+  EXPECT_THROW(
+      publishAndApplyConfig(testStateA(), &config, platform_.get()),
+      FbossError);
+}
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "fboss/agent/AclClassifier.h"
+#include "fboss/agent/state/AclEntry.h"
+#include "fboss/agent/state/AclMap.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr int kNumAcls = 2000;
+// Distinct packets classified, reused for larger iteration counts
+constexpr int kNumPackets = 4096;
+
+// Like ConfigApplyBenchmark, a destination prefix and L4 port per entry
+std::shared_ptr<AclMap> makeAcls() {
+  auto acls = std::make_shared<AclMap>();
+  for (int i = 0; i < kNumAcls; ++i) {
+    auto acl = std::make_shared<AclEntry>(i, fmt::format("acl{}", i));
+    acl->setActionType(cfg::AclActionType::DENY);
+    acl->setDstIp(folly::IPAddress::createNetwork(
+        fmt::format("2401:db00:{:x}::/64", i)));
+    acl->setL4DstPort(1024 + i % 1000);
+    acls->addEntry(acl);
+  }
+  return acls;
+}
+
+/*
+ * Packets hitting entries all over the table. missPercent percent of them
+ * hit no entry at all, which means matching against every entry.
+ */
+std::vector<AclPacket> makePackets(int missPercent) {
+  std::vector<AclPacket> packets;
+  for (int i = 0; i < kNumPackets; ++i) {
+    // Spread the hit entries with a stride coprime to kNumAcls
+    auto acl = (i * 7919) % kNumAcls;
+    bool miss = i % 100 < missPercent;
+    AclPacket packet;
+    packet.srcIp = folly::IPAddress("2401:db00:ffff::1");
+    packet.dstIp = folly::IPAddress(fmt::format("2401:db00:{:x}::1", acl));
+    packet.proto = 6;
+    packet.l4SrcPort = 40000;
+    packet.l4DstPort = miss ? 80 : 1024 + acl % 1000;
+    packet.ttl = 64;
+    packet.etherType = 0x86DD;
+    packets.push_back(packet);
+  }
+  return packets;
+}
+
+void classifyPackets(uint32_t iters, int missPercent, bool bulk) {
+  folly::BenchmarkSuspender suspender;
+  auto acls = makeAcls();
+  AclClassifier classifier(*acls);
+  auto packets = makePackets(missPercent);
+
+  // One iteration per packet, so the benchmark reports packets per second
+  suspender.dismiss();
+  for (uint32_t done = 0; done < iters; done += kNumPackets) {
+    auto count = std::min<uint32_t>(kNumPackets, iters - done);
+    if (bulk) {
+      if (count < kNumPackets) {
+        suspender.rehire();
+        packets.resize(count);
+        suspender.dismiss();
+      }
+      folly::doNotOptimizeAway(classifier.classify(packets));
+    } else {
+      for (uint32_t i = 0; i < count; ++i) {
+        folly::doNotOptimizeAway(classifier.classify(packets[i]));
+      }
+    }
+  }
+}
+
+} // namespace
+
+BENCHMARK(AclClassifier2kEntries, iters) {
+  classifyPackets(iters, 0, false);
+}
+
+BENCHMARK(AclClassifier2kEntriesBulk, iters) {
+  classifyPackets(iters, 0, true);
+}
+
+BENCHMARK(AclClassifier2kEntriesBulkMisses, iters) {
+  classifyPackets(iters, 100, true);
+}
+
+BENCHMARK(AclClassifier2kEntriesShadowedEntries) {
+  folly::BenchmarkSuspender suspender;
+  auto acls = makeAcls();
+  AclClassifier classifier(*acls);
+  suspender.dismiss();
+  folly::doNotOptimizeAway(classifier.findShadowedEntries());
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,243 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/AclClassifier.h"
+#include "fboss/agent/state/AclEntry.h"
+#include "fboss/agent/state/AclMap.h"
+
+#include <folly/Conv.h>
+#include <folly/IPAddress.h>
+#include <folly/MacAddress.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+using folly::IPAddress;
+using folly::MacAddress;
+using std::make_shared;
+
+namespace {
+
+AclPacket makeTcpPacket(
+    const std::string& srcIp,
+    const std::string& dstIp,
+    uint16_t l4DstPort) {
+  AclPacket packet;
+  packet.srcIp = IPAddress(srcIp);
+  packet.dstIp = IPAddress(dstIp);
+  packet.proto = 6;
+  packet.l4SrcPort = 40000;
+  packet.l4DstPort = l4DstPort;
+  packet.ttl = 64;
+  packet.etherType = packet.dstIp.isV4() ? 0x0800 : 0x86DD;
+  return packet;
+}
+
+std::string matchedAcl(
+    const AclClassifier& classifier,
+    const AclPacket& packet) {
+  auto index = classifier.classify(packet);
+  return index == AclClassifier::kNoMatch
+      ? "none"
+      : classifier.getEntries()[index]->getID();
+}
+
+} // namespace
+
+TEST(AclClassifier, priority) {
+  auto acls = make_shared<AclMap>();
+  // Added out of priority order
+  auto ssh = make_shared<AclEntry>(3, "ssh");
+  ssh->setProto(6);
+  ssh->setL4DstPort(22);
+  acls->addEntry(ssh);
+  auto subnet = make_shared<AclEntry>(2, "subnet");
+  subnet->setDstIp(IPAddress::createNetwork("2401:db00:1::/48"));
+  acls->addEntry(subnet);
+  auto host = make_shared<AclEntry>(1, "host");
+  host->setDstIp(IPAddress::createNetwork("2401:db00:1::1/128"));
+  host->setL4DstPort(22);
+  acls->addEntry(host);
+
+  AclClassifier classifier(*acls);
+  ASSERT_EQ(3, classifier.getEntries().size());
+  EXPECT_EQ("host", classifier.getEntries()[0]->getID());
+
+  EXPECT_EQ(
+      "host",
+      matchedAcl(classifier, makeTcpPacket("2401::1", "2401:db00:1::1", 22)));
+  EXPECT_EQ(
+      "subnet",
+      matchedAcl(classifier, makeTcpPacket("2401::1", "2401:db00:1::1", 80)));
+  EXPECT_EQ(
+      "subnet",
+      matchedAcl(classifier, makeTcpPacket("2401::1", "2401:db00:1::2", 22)));
+  EXPECT_EQ(
+      "ssh",
+      matchedAcl(classifier, makeTcpPacket("2401::1", "2401:db00:2::1", 22)));
+  EXPECT_EQ(
+      "none",
+      matchedAcl(classifier, makeTcpPacket("2401::1", "2401:db00:2::1", 80)));
+
+  auto udp = makeTcpPacket("2401::1", "2401:db00:2::1", 22);
+  udp.proto = 17;
+  EXPECT_EQ("none", matchedAcl(classifier, udp));
+}
+
+TEST(AclClassifier, ipTypes) {
+  auto acls = make_shared<AclMap>();
+  auto v4Net = make_shared<AclEntry>(1, "v4Net");
+  v4Net->setSrcIp(IPAddress::createNetwork("10.0.0.0/8"));
+  acls->addEntry(v4Net);
+  auto v6 = make_shared<AclEntry>(2, "v6");
+  v6->setIpType(cfg::IpType::IP6);
+  acls->addEntry(v6);
+  auto ip = make_shared<AclEntry>(3, "ip");
+  ip->setIpType(cfg::IpType::IP);
+  acls->addEntry(ip);
+  auto lldp = make_shared<AclEntry>(4, "lldp");
+  lldp->setEtherType(cfg::EtherType::LLDP);
+  acls->addEntry(lldp);
+
+  AclClassifier classifier(*acls);
+  EXPECT_EQ(
+      "v4Net",
+      matchedAcl(classifier, makeTcpPacket("10.1.2.3", "11.0.0.1", 1)));
+  EXPECT_EQ(
+      "ip", matchedAcl(classifier, makeTcpPacket("11.1.2.3", "10.0.0.1", 1)));
+  // The IPv4 mapped IPv6 address of 10.1.2.3 is no IPv4 address
+  EXPECT_EQ(
+      "v6", matchedAcl(classifier, makeTcpPacket("::ffff:10.1.2.3", "::1", 1)));
+
+  AclPacket lldpPacket;
+  lldpPacket.dstMac = MacAddress("01:80:c2:00:00:0e");
+  lldpPacket.etherType = 0x88cc;
+  EXPECT_EQ("lldp", matchedAcl(classifier, lldpPacket));
+}
+
+TEST(AclClassifier, fragmentsAndTtl) {
+  auto acls = make_shared<AclMap>();
+  auto notFirst = make_shared<AclEntry>(1, "notFirst");
+  notFirst->setIpFrag(cfg::IpFragMatch::MATCH_NOT_FIRST_FRAGMENT);
+  acls->addEntry(notFirst);
+  auto lowTtl = make_shared<AclEntry>(2, "lowTtl");
+  // TTL 0 and 1
+  lowTtl->setTtl(AclTtl(0, 0xfe));
+  acls->addEntry(lowTtl);
+  auto fragment = make_shared<AclEntry>(3, "fragment");
+  fragment->setIpFrag(cfg::IpFragMatch::MATCH_ANY_FRAGMENT);
+  acls->addEntry(fragment);
+  auto notFragmented = make_shared<AclEntry>(4, "notFragmented");
+  notFragmented->setIpFrag(cfg::IpFragMatch::MATCH_NOT_FRAGMENTED);
+  acls->addEntry(notFragmented);
+
+  AclClassifier classifier(*acls);
+  auto packet = makeTcpPacket("2401::1", "2401::2", 22);
+  EXPECT_EQ("notFragmented", matchedAcl(classifier, packet));
+  packet.ttl = 1;
+  EXPECT_EQ("lowTtl", matchedAcl(classifier, packet));
+  packet.ttl = 2;
+  packet.fragment = AclPacket::Fragment::FIRST_FRAGMENT;
+  EXPECT_EQ("fragment", matchedAcl(classifier, packet));
+  packet.fragment = AclPacket::Fragment::NOT_FIRST_FRAGMENT;
+  EXPECT_EQ("notFirst", matchedAcl(classifier, packet));
+
+  // Only IP packets are (not) fragmented
+  AclPacket nonIp;
+  nonIp.ttl = 2;
+  EXPECT_EQ("none", matchedAcl(classifier, nonIp));
+}
+
+TEST(AclClassifier, classifyMany) {
+  auto acls = make_shared<AclMap>();
+  // More entries than fit in one block
+  for (auto i = 0; i < 200; i++) {
+    auto acl = make_shared<AclEntry>(i, folly::to<std::string>("acl", i));
+    acl->setDstIp(IPAddress::createNetwork(
+        folly::to<std::string>("2401:db00:", i, "::/48")));
+    acl->setL4DstPort(i % 10);
+    acls->addEntry(acl);
+  }
+  AclClassifier classifier(*acls);
+
+  std::vector<AclPacket> packets;
+  for (auto i = 0; i < 500; i++) {
+    packets.push_back(makeTcpPacket(
+        "2401::1", folly::to<std::string>("2401:db00:", i, "::1"), i % 20));
+  }
+  auto matches = classifier.classify(packets);
+  ASSERT_EQ(packets.size(), matches.size());
+  for (int i = 0; i < packets.size(); i++) {
+    EXPECT_EQ(classifier.classify(packets[i]), matches[i]);
+    EXPECT_EQ(i < 200 && i % 20 < 10 ? i : AclClassifier::kNoMatch, matches[i]);
+  }
+}
+
+TEST(AclClassifier, shadowedEntries) {
+  auto acls = make_shared<AclMap>();
+  auto subnet = make_shared<AclEntry>(1, "subnet");
+  subnet->setDstIp(IPAddress::createNetwork("10.0.0.0/8"));
+  acls->addEntry(subnet);
+  // Shadowed by subnet
+  auto host = make_shared<AclEntry>(2, "host");
+  host->setDstIp(IPAddress::createNetwork("10.0.0.1/32"));
+  host->setL4DstPort(22);
+  acls->addEntry(host);
+  // Not shadowed, also matches IPv6
+  auto ssh = make_shared<AclEntry>(3, "ssh");
+  ssh->setL4DstPort(22);
+  acls->addEntry(ssh);
+  // Shadowed by ssh
+  auto sshV6 = make_shared<AclEntry>(4, "sshV6");
+  sshV6->setL4DstPort(22);
+  sshV6->setIpType(cfg::IpType::IP6);
+  acls->addEntry(sshV6);
+  // Not shadowed by subnet, as the subnet is IPv4 only
+  auto v6 = make_shared<AclEntry>(5, "v6");
+  v6->setIpType(cfg::IpType::IP6);
+  acls->addEntry(v6);
+
+  AclClassifier classifier(*acls);
+  auto shadowed = classifier.findShadowedEntries();
+  ASSERT_EQ(2, shadowed.size());
+  EXPECT_EQ("host", shadowed[0].first->getID());
+  EXPECT_EQ("subnet", shadowed[0].second->getID());
+  EXPECT_EQ("sshV6", shadowed[1].first->getID());
+  EXPECT_EQ("ssh", shadowed[1].second->getID());
+}
+
+TEST(AclClassifier, dryRun) {
+  auto oldAcls = make_shared<AclMap>();
+  auto deny = make_shared<AclEntry>(1, "deny");
+  deny->setDstIp(IPAddress::createNetwork("10.0.0.0/24"));
+  deny->setActionType(cfg::AclActionType::DENY);
+  oldAcls->addEntry(deny);
+
+  // The new config widens the denied subnet
+  auto newAcls = make_shared<AclMap>();
+  auto newDeny = make_shared<AclEntry>(1, "deny");
+  newDeny->setDstIp(IPAddress::createNetwork("10.0.0.0/23"));
+  newDeny->setActionType(cfg::AclActionType::DENY);
+  newAcls->addEntry(newDeny);
+
+  std::vector<AclPacket> packets;
+  for (auto i = 0; i < 4; i++) {
+    packets.push_back(makeTcpPacket(
+        "11.0.0.1", folly::to<std::string>("10.0.", i, ".1"), 80));
+  }
+  auto oldMatches = AclClassifier(*oldAcls).classify(packets);
+  auto newMatches = AclClassifier(*newAcls).classify(packets);
+  std::vector<int> changed;
+  for (int i = 0; i < packets.size(); i++) {
+    if (oldMatches[i] != newMatches[i]) {
+      changed.push_back(i);
+    }
+  }
+  EXPECT_EQ(std::vector<int>{1}, changed);
+}
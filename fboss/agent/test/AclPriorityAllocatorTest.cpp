@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/AclPriorityAllocator.h"
+#include "fboss/agent/FbossError.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+using std::nullopt;
+
+using Priorities = std::vector<int>;
+
+TEST(AclPriorityAllocator, newEntries) {
+  AclPriorityAllocator allocator(100, 1000, 10);
+  EXPECT_EQ(Priorities({}), allocator.allocate({}));
+  EXPECT_EQ(
+      Priorities({100, 110, 120}),
+      allocator.allocate({nullopt, nullopt, nullopt}));
+
+  // Gap 1 numbers the entries consecutively
+  EXPECT_EQ(
+      Priorities({100, 101, 102}),
+      AclPriorityAllocator(100, 1000, 1).allocate({nullopt, nullopt, nullopt}));
+}
+
+TEST(AclPriorityAllocator, insertInGap) {
+  AclPriorityAllocator allocator(100, 1000, 10);
+  // Only the inserted entries get priorities, centered in the gaps
+  EXPECT_EQ(
+      Priorities({100, 105, 110, 120}),
+      allocator.allocate({100, nullopt, 110, 120}));
+  EXPECT_EQ(
+      Priorities({100, 103, 106, 110, 120}),
+      allocator.allocate({100, nullopt, nullopt, 110, 120}));
+  // Appended entries leave the gap after the last entry
+  EXPECT_EQ(
+      Priorities({100, 110, 120, 130}),
+      allocator.allocate({100, 110, 120, nullopt}));
+  // Entries removed in between leave their priorities unused
+  EXPECT_EQ(Priorities({100, 120}), allocator.allocate({100, 120}));
+}
+
+TEST(AclPriorityAllocator, insertWithoutGap) {
+  AclPriorityAllocator allocator(100, 1000, 1);
+  // The entries after the inserted one move as far as needed, no further
+  EXPECT_EQ(
+      Priorities({100, 101, 102, 103}),
+      allocator.allocate({100, nullopt, 101, 102}));
+  EXPECT_EQ(
+      Priorities({100, 101, 102, 110}),
+      allocator.allocate({100, nullopt, 101, 110}));
+  EXPECT_EQ(
+      Priorities({100, 101, 102}), allocator.allocate({nullopt, 100, 101}));
+}
+
+TEST(AclPriorityAllocator, reorder) {
+  AclPriorityAllocator allocator(100, 1000, 10);
+  // Moving one entry to the end keeps the others in place
+  EXPECT_EQ(
+      Priorities({110, 120, 130, 140}),
+      allocator.allocate({110, 120, 130, 100}));
+  // Moving the last entry to the front moves the old first entry as well, as
+  // there is no room before it
+  EXPECT_EQ(
+      Priorities({100, 109, 110, 120}),
+      allocator.allocate({120, 100, 110, nullopt}));
+  // Swapping two entries moves one of them
+  EXPECT_EQ(
+      Priorities({100, 105, 110, 130}),
+      allocator.allocate({100, 120, 110, 130}));
+}
+
+TEST(AclPriorityAllocator, outOfRange) {
+  AclPriorityAllocator allocator(100, 1000, 10);
+  // Priorities outside of the range, e.g. of entries moving between ranges,
+  // are replaced
+  EXPECT_EQ(Priorities({100, 110, 120}), allocator.allocate({5, 100, 2000}));
+}
+
+TEST(AclPriorityAllocator, full) {
+  AclPriorityAllocator allocator(100, 102, 10);
+  EXPECT_EQ(
+      Priorities({100, 101, 102}),
+      allocator.allocate({nullopt, nullopt, nullopt}));
+  EXPECT_EQ(
+      Priorities({100, 101, 102}), allocator.allocate({102, nullopt, 100}));
+  EXPECT_THROW(
+      allocator.allocate({nullopt, nullopt, nullopt, nullopt}), FbossError);
+  EXPECT_THROW(AclPriorityAllocator(100, 99, 1), FbossError);
+  EXPECT_THROW(AclPriorityAllocator(100, 1000, 0), FbossError);
+}
@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/AsyncLogger.h"
+
+#include <folly/Benchmark.h>
+#include <folly/String.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+DECLARE_bool(async_logger_drop_on_overflow);
+
+DEFINE_string(
+    async_logger_benchmark_file,
+    "/tmp/async_logger_benchmark",
+    "File the benchmarked async logger writes to");
+
+using namespace facebook::fboss;
+
+namespace {
+
+// Number of routes HwFswScaleRouteAddBenchmark programs
+// (FSWRouteScaleGenerator distribution)
+constexpr auto kFswScaleRoutes = 16000;
+
+// What the SAI replayer traces for one sai_create_route_entry() call of that
+// benchmark, see SaiTracer::logRouteEntryCreateFn()
+std::string makeRouteAddRecord(int route) {
+  std::vector<std::string> lines = {
+      "s_a[0].id=SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID",
+      folly::to<std::string>("s_a[0].value.oid=nextHopGroup_", route % 64),
+      "r_e.switch_id=switch_0",
+      "r_e.vr_id=virtualRouter_0",
+      "r_e.destination.addr_family=SAI_IP_ADDR_FAMILY_IPV4",
+      folly::to<std::string>("r_e.destination.addr.ip4=", 167772160 + route),
+      "r_e.destination.mask.ip4=4294967040",
+      "// 2022-01-01 00:00:00.000000 rv: 0",
+      "rv=route_api->create_route_entry(&r_e,1,s_a)",
+      "rvCheck(rv,0,0)"};
+  return folly::join(";\n", lines) + ";\n\n";
+}
+
+void traceFswScaleRouteAdd(int numThreads, bool dropOnOverflow) {
+  folly::BenchmarkSuspender suspender;
+  gflags::FlagSaver flagSaver;
+  FLAGS_async_logger_drop_on_overflow = dropOnOverflow;
+
+  std::vector<std::string> records;
+  records.reserve(kFswScaleRoutes);
+  for (auto route = 0; route < kFswScaleRoutes; route++) {
+    records.push_back(makeRouteAddRecord(route));
+  }
+  AsyncLogger logger(
+      FLAGS_async_logger_benchmark_file, 100, AsyncLogger::SAI_REPLAYER);
+  logger.startFlushThread();
+
+  // Like the route programming threads, producers only pay for appending
+  // the records, the flush to disk happens in the background
+  suspender.dismiss();
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < numThreads; i++) {
+    threads.emplace_back([&, i]() {
+      for (auto route = i; route < kFswScaleRoutes; route += numThreads) {
+        logger.appendLog(records[route].c_str(), records[route].size());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  suspender.rehire();
+
+  logger.forceFlush();
+  logger.stopFlushThread();
+  std::remove(FLAGS_async_logger_benchmark_file.c_str());
+}
+
+} // namespace
+
+BENCHMARK(AsyncLoggerFswScaleRouteAdd) {
+  traceFswScaleRouteAdd(1, false);
+}
+
+BENCHMARK(AsyncLoggerFswScaleRouteAdd4Threads) {
+  traceFswScaleRouteAdd(4, false);
+}
+
+BENCHMARK(AsyncLoggerFswScaleRouteAddDropOnOverflow) {
+  traceFswScaleRouteAdd(1, true);
+}
+
+BENCHMARK(AsyncLoggerFswScaleRouteAdd4ThreadsDropOnOverflow) {
+  traceFswScaleRouteAdd(4, true);
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -11,9 +11,14 @@
 #include "fboss/agent/AsyncLogger.h"
 
 #include <folly/CPortability.h>
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 #include <stdio.h>
 
+DECLARE_bool(async_logger_drop_on_overflow);
+
 #define TEST_LOG "/tmp/sai_logger_test"
 
 // Test string size that's larger than half of the buffer,
@@ -133,3 +138,68 @@ TEST_F(AsyncLoggerTest, concurrentWaitTest) {
   // Therefore, the flush count should be equal or greater than two.
   EXPECT_GE(asyncLogger->getFlushCount(), 2);
 }
+
+TEST_F(AsyncLoggerTest, dropOnOverflowTest) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_async_logger_drop_on_overflow = true;
+
+  std::string str(kTestStringSize, '.');
+  asyncLogger->appendLog(str.c_str(), str.size());
+  EXPECT_EQ(asyncLogger->getOverflowCount(), 0);
+
+  // Does not fit, dropped right away instead of waiting for the flush
+  asyncLogger->appendLog(str.c_str(), str.size());
+  EXPECT_EQ(asyncLogger->getOverflowCount(), 1);
+  EXPECT_EQ(asyncLogger->getDroppedCount(), 1);
+
+  // The overflow still triggers a flush, at the latest on the next timeout
+  std::unique_lock<std::mutex> lock(latch);
+  cv.wait_for(lock, std::chrono::milliseconds(logTimeout + 20));
+  EXPECT_GE(asyncLogger->getFlushCount(), 1);
+
+  asyncLogger->appendLog(str.c_str(), str.size());
+  EXPECT_EQ(asyncLogger->getDroppedCount(), 1);
+}
+
+TEST_F(AsyncLoggerTest, concurrentAppendTest) {
+  // Enough records to go through the buffers several times, with producers
+  // blocking on overflow
+  constexpr auto kNumThreads = 8;
+  constexpr auto kNumRecords = 10000;
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumThreads; i++) {
+    threads.emplace_back([this, i]() {
+      for (auto j = 0; j < kNumRecords; j++) {
+        auto record = folly::to<std::string>("thread ", i, " record ", j, "\n");
+        asyncLogger->appendLog(record.c_str(), record.size());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  asyncLogger->forceFlush();
+  EXPECT_GT(asyncLogger->getOverflowCount(), 0);
+  EXPECT_EQ(asyncLogger->getDroppedCount(), 0);
+
+  // Every record is written whole, and in order for a given thread
+  std::string log;
+  ASSERT_TRUE(folly::readFile(TEST_LOG, log));
+  std::vector<folly::StringPiece> lines;
+  folly::split('\n', log, lines);
+  std::vector<int> nextRecord(kNumThreads, 0);
+  for (auto line : lines) {
+    if (!line.startsWith("thread ")) {
+      continue;
+    }
+    int thread, record;
+    ASSERT_EQ(
+        sscanf(line.str().c_str(), "thread %d record %d", &thread, &record),
+        2);
+    ASSERT_LT(thread, kNumThreads);
+    EXPECT_EQ(record, nextRecord[thread]++);
+  }
+  for (auto i = 0; i < kNumThreads; i++) {
+    EXPECT_EQ(nextRecord[i], kNumRecords);
+  }
+}
@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/gen-cpp2/switch_config_types.h"
+#include "fboss/agent/hw/mock/MockPlatform.h"
+#include "fboss/agent/rib/RoutingInformationBase.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/TestUtils.h"
+
+using namespace facebook::fboss;
+
+DECLARE_bool(enable_acl_table_group);
+
+namespace {
+
+constexpr int kNumAcls = 4000;
+constexpr int kNumPorts = 20;
+
+// testConfigA, for ports 1-20, with many ACLs
+cfg::SwitchConfig largeConfig() {
+  auto config = testConfigA();
+  config.acls()->resize(kNumAcls);
+  for (int i = 0; i < kNumAcls; ++i) {
+    auto& acl = config.acls()[i];
+    *acl.name() = fmt::format("acl{}", i);
+    *acl.actionType() = cfg::AclActionType::DENY;
+    acl.dstIp() = fmt::format("2401:db00:{:x}::/64", i);
+    acl.l4DstPort() = 1024 + i % 1000;
+  }
+  config.sFlowCollectors()->resize(1);
+  *config.sFlowCollectors()[0].ip() = "2401:db00::1";
+  *config.sFlowCollectors()[0].port() = 6343;
+  return config;
+}
+
+std::shared_ptr<SwitchState> initialState() {
+  auto state = std::make_shared<SwitchState>();
+  for (int idx = 1; idx <= kNumPorts; ++idx) {
+    state->registerPort(PortID(idx), fmt::format("port{}", idx));
+  }
+  return state;
+}
+
+/*
+ * Apply the large config, then measure applying it again with the sFlow
+ * collector port changed, with or without the previously applied config.
+ */
+void applyOneLineChange(size_t iters, bool incremental) {
+  FLAGS_enable_acl_table_group = false;
+  std::unique_ptr<MockPlatform> platform;
+  std::shared_ptr<SwitchState> state;
+  cfg::SwitchConfig config;
+  cfg::SwitchConfig newConfig;
+  RoutingInformationBase* rib = nullptr;
+  BENCHMARK_SUSPEND {
+    platform = createMockPlatform();
+    config = largeConfig();
+    newConfig = config;
+    *newConfig.sFlowCollectors()[0].port() = 6344;
+    state = publishAndApplyConfig(initialState(), &config, platform.get());
+    CHECK(state);
+    state->publish();
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    auto newState = applyThriftConfig(
+        state,
+        &newConfig,
+        platform.get(),
+        rib,
+        incremental ? &config : nullptr);
+    folly::doNotOptimizeAway(newState);
+    BENCHMARK_SUSPEND {
+      newState.reset();
+    }
+  }
+}
+
+} // namespace
+
+BENCHMARK(FullConfigApply, iters) {
+  applyOneLineChange(iters, false);
+}
+
+BENCHMARK_RELATIVE(IncrementalConfigApply, iters) {
+  applyOneLineChange(iters, true);
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -124,6 +124,21 @@ class FibHelperTest : public ::testing::Test {
     }
   }
 
+  // More specific prefixes within kPrefix1()
+  std::vector<folly::CIDRNetwork> kPrefix1Subnets() const {
+    if constexpr (std::is_same_v<AddrT, folly::IPAddressV4>) {
+      return {
+          {folly::IPAddressV4{"10.1.4.0"}, 26},
+          {folly::IPAddressV4{"10.1.4.64"}, 28},
+          {folly::IPAddressV4{"10.1.4.128"}, 32}};
+    } else {
+      return {
+          {folly::IPAddressV6{"2803:6080:d038:3066::"}, 80},
+          {folly::IPAddressV6{"2803:6080:d038:3066:1::"}, 96},
+          {folly::IPAddressV6{"2803:6080:d038:3066::8"}, 128}};
+    }
+  }
+
   void resolveNeighbor(AddrT ipAddress, MacAddress macAddress) {
     /*
      * Cause a neighbor entry to resolve by receiving appropriate ARP/NDP, and
@@ -209,4 +224,68 @@ TYPED_TEST(FibHelperTest, forAllRoutes) {
   forAllRoutes(this->sw_->getState(), countRoutes);
   EXPECT_EQ(count, prevCount + 1);
 }
+
+TYPED_TEST(FibHelperTest, forAllRoutesAfter) {
+  this->programRoute(this->kPrefix2());
+  for (const auto& prefix : this->kPrefix1Subnets()) {
+    this->programRoute(prefix);
+  }
+  auto state = this->sw_->getState();
+  auto toCursor = [](RouterID rid, const auto& route) {
+    return RouteCursor{rid, route->prefix().toCidrNetwork()};
+  };
+  auto sameRoute = [](const RouteCursor& lhs, const RouteCursor& rhs) {
+    return lhs.rid == rhs.rid && lhs.prefix == rhs.prefix;
+  };
+
+  std::vector<RouteCursor> allRoutes;
+  forAllRoutes(state, [&](RouterID rid, const auto& route) {
+    allRoutes.push_back(toCursor(rid, route));
+  });
+
+  // Walking in chunks, each one resuming after the last visited route,
+  // visits the same routes in the same order as forAllRoutes()
+  auto walk = [&](const std::optional<folly::CIDRNetwork>& filter,
+                  int chunkSize) {
+    std::vector<RouteCursor> visited;
+    std::optional<RouteCursor> after;
+    while (true) {
+      int numVisited = 0;
+      forAllRoutesAfter(
+          state, after, filter, [&](RouterID rid, const auto& route) {
+            visited.push_back(toCursor(rid, route));
+            return ++numVisited < chunkSize;
+          });
+      if (numVisited < chunkSize) {
+        return visited;
+      }
+      after = visited.back();
+    }
+  };
+  for (auto chunkSize : {1, 2, 1000}) {
+    auto visited = walk(std::nullopt, chunkSize);
+    ASSERT_EQ(visited.size(), allRoutes.size());
+    for (size_t i = 0; i < visited.size(); i++) {
+      EXPECT_TRUE(sameRoute(visited[i], allRoutes[i]));
+    }
+  }
+
+  // Only the routes covered by the filter are visited
+  std::vector<RouteCursor> coveredRoutes;
+  for (const auto& route : allRoutes) {
+    if (route.prefix.first.inSubnet(
+            this->kPrefix1().first, this->kPrefix1().second) &&
+        route.prefix.second >= this->kPrefix1().second) {
+      coveredRoutes.push_back(route);
+    }
+  }
+  EXPECT_EQ(coveredRoutes.size(), this->kPrefix1Subnets().size() + 1);
+  for (auto chunkSize : {1, 2, 1000}) {
+    auto visited = walk(this->kPrefix1(), chunkSize);
+    ASSERT_EQ(visited.size(), coveredRoutes.size());
+    for (size_t i = 0; i < visited.size(); i++) {
+      EXPECT_TRUE(sameRoute(visited[i], coveredRoutes[i]));
+    }
+  }
+}
 } // namespace facebook::fboss
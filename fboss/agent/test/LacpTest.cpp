@@ -7,9 +7,12 @@
  *  of patent rights can be found in the PATENTS file in the same directory.
  *
  */
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -30,11 +33,17 @@
 #include "fboss/agent/LacpController.h"
 #include "fboss/agent/LacpTypes.h"
 #include "fboss/agent/LinkAggregationManager.h"
+#include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/SwitchStats.h"
+#include "fboss/agent/TxPacket.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
+#include "fboss/agent/hw/mock/MockHwSwitch.h"
+#include "fboss/agent/state/AggregatePortMap.h"
+#include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/CounterCache.h"
 #include "fboss/agent/test/HwTestHandle.h"
 #include "fboss/agent/test/TestUtils.h"
+#include "fboss/agent/test/TrunkUtils.h"
 #include "fboss/agent/types.h"
 
 using namespace facebook::fboss;
@@ -226,6 +235,95 @@ class MockLacpServicer : public LacpServicerIf {
       std::vector<std::shared_ptr<LacpController>>(
           folly::Range<std::vector<PortID>::const_iterator>));
 };
+
+/*
+ * Connects pairs of LacpControllers back to back: the LACPDUs transmitted by
+ * one of them are received by the other.
+ */
+class LacpLoopbackServicer : public LacpServicerIf {
+ public:
+  explicit LacpLoopbackServicer(folly::EventBase* lacpEvb)
+      : lacpEvb_(lacpEvb) {}
+
+  bool transmit(LACPDU lacpdu, PortID portID) override {
+    peers_.at(portID)->received(lacpdu);
+    return true;
+  }
+  void enableForwardingAndSetPartnerState(
+      PortID portID,
+      AggregatePortID /* unused */,
+      const ParticipantInfo& /* unused */) override {
+    (*portToIsForwarding_.wlock())[portID] = true;
+  }
+  void disableForwardingAndSetPartnerState(
+      PortID portID,
+      AggregatePortID /* unused */,
+      const ParticipantInfo& /* unused */) override {
+    (*portToIsForwarding_.wlock())[portID] = false;
+  }
+  void recordLacpTimeout() override {
+    ++numTimeouts_;
+  }
+  void recordLacpMismatchPduTeardown() override {}
+  std::vector<std::shared_ptr<LacpController>> getControllersFor(
+      folly::Range<std::vector<PortID>::const_iterator> ports) override {
+    std::vector<std::shared_ptr<LacpController>> controllers;
+    for (const auto& port : ports) {
+      controllers.push_back(controllers_.at(port));
+    }
+    return controllers;
+  }
+
+  // Must be called before the controllers are started
+  void connect(
+      const std::shared_ptr<LacpController>& lhs,
+      const std::shared_ptr<LacpController>& rhs) {
+    controllers_[lhs->portID()] = lhs;
+    controllers_[rhs->portID()] = rhs;
+    peers_[lhs->portID()] = rhs;
+    peers_[rhs->portID()] = lhs;
+  }
+
+  int numForwarding() const {
+    auto portToIsForwarding = portToIsForwarding_.rlock();
+    return std::count_if(
+        portToIsForwarding->begin(),
+        portToIsForwarding->end(),
+        [](const auto& portAndIsForwarding) {
+          return portAndIsForwarding.second;
+        });
+  }
+  int numTimeouts() const {
+    return numTimeouts_;
+  }
+
+  ~LacpLoopbackServicer() override {
+    lacpEvb_->runInEventBaseThreadAndWait([this]() {
+      peers_.clear();
+      controllers_.clear();
+    });
+  }
+
+ private:
+  using PortIDToController =
+      boost::container::flat_map<PortID, std::shared_ptr<LacpController>>;
+  PortIDToController controllers_;
+  PortIDToController peers_;
+
+  folly::Synchronized<boost::container::flat_map<PortID, bool>>
+      portToIsForwarding_;
+  std::atomic<int> numTimeouts_{0};
+
+  folly::EventBase* lacpEvb_{nullptr};
+};
+
+// Returns once the loop callbacks already registered on evb have run
+void runLoopCallbacks(folly::EventBase* evb) {
+  folly::Baton<> done;
+  evb->runInEventBaseThread(
+      [evb, &done]() { evb->runInLoop([&done]() { done.post(); }); });
+  done.wait();
+}
 } // namespace
 
 /*
@@ -1288,3 +1386,196 @@ TEST_F(LacpTest, lacpDownCounters) {
   // both members should timeout
   counters.checkDelta(SwitchStats::kCounterPrefix + "lacp.rx_timeout.sum", 2);
 }
+
+/*
+ * 512 members in fast timeout mode, in LAGs of 32 members, all running over
+ * the same LACP EventBase, converge with their partners and then stay
+ * converged, i.e. no receive timer expires late.
+ */
+TEST_F(LacpTest, lacpScale) {
+  constexpr int kNumMembers = 512;
+  constexpr int kMembersPerLag = 32;
+  // Clear of the ports used by the other tests, as selections are global
+  constexpr int kLocalPortBase = 1000;
+  constexpr int kPartnerPortBase = 2000;
+  auto rate = cfg::LacpPortRate::FAST;
+  auto lacpEvbase = lacpEvb();
+  LacpLoopbackServicer servicer(lacpEvbase);
+
+  auto createController = [&](int port, int key, folly::MacAddress systemID) {
+    return std::make_shared<LacpController>(
+        PortID(port),
+        lacpEvbase,
+        32768 /* port priority */,
+        rate,
+        cfg::LacpPortActivity::ACTIVE,
+        cfg::switch_config_constants::DEFAULT_LACP_HOLD_TIMER_MULTIPLIER(),
+        AggregatePortID(key),
+        65535 /* system priority */,
+        systemID,
+        1 /* minimum-link count */,
+        &servicer);
+  };
+
+  std::vector<std::shared_ptr<LacpController>> controllers;
+  for (int i = 0; i < kNumMembers; ++i) {
+    auto local = createController(
+        kLocalPortBase + i,
+        kLocalPortBase + i / kMembersPerLag,
+        MacAddress("02:90:fb:5e:1e:85"));
+    auto partner = createController(
+        kPartnerPortBase + i,
+        kPartnerPortBase + i / kMembersPerLag,
+        MacAddress("02:90:fb:5e:24:28"));
+    servicer.connect(local, partner);
+    controllers.push_back(local);
+    controllers.push_back(partner);
+  }
+  for (const auto& controller : controllers) {
+    controller->startMachines();
+    controller->portUp();
+  }
+
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (servicer.numForwarding() < 2 * kNumMembers &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  ASSERT_EQ(servicer.numForwarding(), 2 * kNumMembers);
+
+  // Outlast a few fast receive timeouts
+  std::this_thread::sleep_for(PeriodicTransmissionMachine::SHORT_PERIOD * 5);
+  EXPECT_EQ(servicer.numForwarding(), 2 * kNumMembers);
+  EXPECT_EQ(servicer.numTimeouts(), 0);
+
+  for (const auto& controller : controllers) {
+    controller->stopMachines();
+  }
+}
+
+/*
+ * A LACPDU counts against the transmissions allowed per second only once it
+ * is sent, including when the servicer sends it after transmit() returned.
+ */
+TEST_F(LacpTest, onlySentLacpdusCountAgainstTransmissionLimit) {
+  auto lacpEvbase = lacpEvb();
+  MockLacpServicer servicer;
+  // The machines are not started, so the transmissions left are not
+  // replenished during the test
+  auto controller = std::make_shared<LacpController>(
+      PortID(0xA),
+      lacpEvbase,
+      32768 /* port priority */,
+      cfg::LacpPortRate::FAST,
+      cfg::LacpPortActivity::ACTIVE,
+      cfg::switch_config_constants::DEFAULT_LACP_HOLD_TIMER_MULTIPLIER(),
+      AggregatePortID(1),
+      65535 /* system priority */,
+      MacAddress("02:90:fb:5e:1e:85"),
+      1 /* minimum-link count */,
+      &servicer);
+  auto ntt = [&](int times) {
+    lacpEvbase->runInEventBaseThreadAndWait([&]() {
+      for (int i = 0; i < times; ++i) {
+        controller->ntt();
+      }
+    });
+  };
+
+  // Not sent yet
+  EXPECT_CALL(servicer, transmit(testing::_, PortID(0xA)))
+      .Times(5)
+      .WillRepeatedly(testing::Return(false));
+  ntt(5);
+  testing::Mock::VerifyAndClearExpectations(&servicer);
+
+  // Two of them sent later, leaving one transmission
+  lacpEvbase->runInEventBaseThreadAndWait([&]() {
+    controller->transmitted(LACPDU());
+    controller->transmitted(LACPDU());
+  });
+  EXPECT_CALL(servicer, transmit(testing::_, PortID(0xA)))
+      .WillOnce(testing::Return(true));
+  ntt(3);
+  testing::Mock::VerifyAndClearExpectations(&servicer);
+}
+
+/*
+ * LACPDUs transmitted through the LinkAggregationManager during one loop
+ * iteration are sent together at its end, once per member.
+ */
+TEST_F(LacpTest, lagManagerBatchesTransmissions) {
+  auto config = testConfigA();
+  auto handle = createTestHandle(&config, SwitchFlags::ENABLE_LACP);
+  auto sw = handle->getSw();
+  auto lagManager = sw->getLagManager();
+  auto lacpEvbase = sw->getLacpEvb();
+
+  // Only accessed from the LACP thread until the batch was sent
+  std::vector<PortID> sentPorts;
+  EXPECT_HW_CALL(
+      sw, sendPacketOutOfPortAsync_(testing::_, testing::_, testing::_))
+      .WillRepeatedly(testing::Invoke(
+          [&sentPorts](TxPacket*, PortID port, std::optional<uint8_t>) {
+            sentPorts.push_back(port);
+            return true;
+          }));
+
+  const std::vector<PortID> ports{PortID(1), PortID(2), PortID(3)};
+  size_t sentWhileTransmitting = 0;
+  lacpEvbase->runInEventBaseThreadAndWait([&]() {
+    for (auto port : ports) {
+      // Only sent at the end of the iteration
+      EXPECT_FALSE(lagManager->transmit(LACPDU(), port));
+    }
+    // Supersedes the previous LACPDU of the member
+    lagManager->transmit(LACPDU(), ports[0]);
+    sentWhileTransmitting = sentPorts.size();
+  });
+  runLoopCallbacks(lacpEvbase);
+
+  EXPECT_EQ(sentWhileTransmitting, 0u);
+  EXPECT_EQ(sentPorts, ports);
+}
+
+/*
+ * Forwarding and partner state changes made while their state update is
+ * queued are applied by that update, the last change of a member winning.
+ */
+TEST_F(LacpTest, lagManagerCoalescesForwardingStates) {
+  const AggregatePortID kAggPort(1);
+  auto config = testConfigA();
+  utility::addAggPort(1, {1, 2}, &config);
+  auto handle = createTestHandle(&config, SwitchFlags::ENABLE_LACP);
+  auto sw = handle->getSw();
+  auto lagManager = sw->getLagManager();
+  auto lacpEvbase = sw->getLacpEvb();
+  // Let the members, whose ports are down, settle
+  runLoopCallbacks(lacpEvbase);
+  waitForStateUpdates(sw);
+
+  // Block the update thread, so that all changes wait for the same update
+  folly::Baton<> blockUpdates;
+  sw->getUpdateEvb()->runInEventBaseThread(
+      [&blockUpdates]() { blockUpdates.wait(); });
+  lacpEvbase->runInEventBaseThreadAndWait([&]() {
+    lagManager->enableForwardingAndSetPartnerState(
+        PortID(1), kAggPort, ParticipantInfo());
+    lagManager->disableForwardingAndSetPartnerState(
+        PortID(1), kAggPort, ParticipantInfo());
+    lagManager->enableForwardingAndSetPartnerState(
+        PortID(2), kAggPort, ParticipantInfo());
+  });
+  EXPECT_HW_CALL(sw, stateChanged(testing::_)).Times(1);
+  blockUpdates.post();
+  waitForStateUpdates(sw);
+
+  auto aggPort =
+      sw->getState()->getAggregatePorts()->getAggregatePort(kAggPort);
+  EXPECT_EQ(
+      aggPort->getForwardingState(PortID(1)),
+      AggregatePort::Forwarding::DISABLED);
+  EXPECT_EQ(
+      aggPort->getForwardingState(PortID(2)),
+      AggregatePort::Forwarding::ENABLED);
+}
@@ -11,16 +11,69 @@
 #include <gtest/gtest.h>
 
 #include "fboss/agent/L2Entry.h"
+#include "fboss/agent/MacTableUtils.h"
+#include "fboss/agent/StateObserver.h"
+#include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/state/Port.h"
+#include "fboss/agent/state/StateDelta.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/state/Vlan.h"
+#include "fboss/agent/test/CounterCache.h"
 #include "fboss/agent/test/HwTestHandle.h"
 #include "fboss/agent/test/TestUtils.h"
 
 #include <folly/MacAddress.h>
+#include <folly/synchronization/Baton.h>
+
+#include <string>
+#include <vector>
 
 namespace facebook::fboss {
 
+namespace {
+
+// Records the state deltas of one MAC: "added", "removed" or "changed"
+class MacDeltaRecorder : public StateObserver {
+ public:
+  MacDeltaRecorder(SwSwitch* sw, folly::MacAddress mac) : sw_(sw), mac_(mac) {
+    sw_->registerStateObserver(this, "MacDeltaRecorder");
+  }
+  ~MacDeltaRecorder() override {
+    sw_->unregisterStateObserver(this);
+  }
+
+  void stateUpdated(const StateDelta& delta) override {
+    for (const auto& vlanDelta : delta.getVlansDelta()) {
+      for (const auto& macDelta : vlanDelta.getMacDelta()) {
+        const auto& oldEntry = macDelta.getOld();
+        const auto& newEntry = macDelta.getNew();
+        if ((oldEntry ? oldEntry : newEntry)->getMac() != mac_) {
+          continue;
+        }
+        if (!oldEntry) {
+          changes_.emplace_back("added");
+        } else if (!newEntry) {
+          changes_.emplace_back("removed");
+        } else {
+          changes_.emplace_back("changed");
+        }
+      }
+    }
+  }
+
+  const std::vector<std::string>& getChanges() const {
+    return changes_;
+  }
+
+ private:
+  SwSwitch* sw_;
+  folly::MacAddress mac_;
+  // Only touched by the update thread, and read once it is idle
+  std::vector<std::string> changes_;
+};
+
+} // namespace
+
 class MacTableManagerTest : public ::testing::Test {
  public:
   using Func = folly::Function<void()>;
@@ -77,6 +130,39 @@ class MacTableManagerTest : public ::testing::Test {
     });
   }
 
+  /*
+   * Deliver the learning events while the update thread is blocked, so that
+   * they are all applied by the same state update.
+   */
+  void triggerMacCbsInOneBatch(
+      const std::vector<std::pair<L2Entry, L2EntryUpdateType>>& updates) {
+    folly::Baton<> blockUpdates;
+    sw_->getUpdateEvb()->runInEventBaseThread(
+        [&blockUpdates]() { blockUpdates.wait(); });
+    for (const auto& [l2Entry, l2EntryUpdateType] : updates) {
+      sw_->l2LearningUpdateReceived(l2Entry, l2EntryUpdateType);
+    }
+    blockUpdates.post();
+    waitForStateUpdates(sw_);
+  }
+
+  L2Entry l2Entry(folly::MacAddress mac, VlanID vlan, PortID port) const {
+    return L2Entry(
+        mac,
+        vlan,
+        PortDescriptor(port),
+        L2Entry::L2EntryType::L2_ENTRY_TYPE_PENDING);
+  }
+
+  std::shared_ptr<MacEntry> getMacEntry(folly::MacAddress mac, VlanID vlan) {
+    auto vlanNode = sw_->getState()->getVlans()->getVlan(vlan);
+    return vlanNode->getMacTable()->getNodeIf(mac);
+  }
+
+  SwSwitch* getSw() const {
+    return sw_;
+  }
+
   void verifyMacIsDeleted() {
     verifyStateUpdate([=]() {
       auto vlan = sw_->getState()->getVlans()->getVlan(kVlan());
@@ -142,4 +228,114 @@ TEST_F(MacTableManagerTest, SameMacAgedCbTwice) {
   verifyMacIsDeleted();
 }
 
+TEST_F(MacTableManagerTest, ManyMacsLearnedInOneBatch) {
+  // MACs on both VLANs of testStateA
+  constexpr int kNumMacs = 2000;
+  std::vector<std::pair<L2Entry, L2EntryUpdateType>> updates;
+  for (int i = 0; i < kNumMacs; ++i) {
+    auto mac = folly::MacAddress::fromHBO(0x020000000000 + i);
+    auto vlan = i % 2 ? VlanID(55) : VlanID(1);
+    auto port = i % 2 ? PortID(11) : PortID(1);
+    updates.emplace_back(
+        l2Entry(mac, vlan, port), L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD);
+  }
+
+  CounterCache counters(getSw());
+  triggerMacCbsInOneBatch(updates);
+  counters.update();
+
+  for (const auto& [entry, type] : updates) {
+    auto node = getMacEntry(entry.getMac(), entry.getVlanID());
+    ASSERT_NE(nullptr, node);
+    EXPECT_EQ(entry.getPort(), node->getPort());
+  }
+  counters.checkDelta(
+      SwitchStats::kCounterPrefix + "l2_learning.events.sum", kNumMacs);
+  counters.checkDelta(
+      SwitchStats::kCounterPrefix + "l2_learning.suppressed.sum", 0);
+}
+
+TEST_F(MacTableManagerTest, MacFlapsSuppressed) {
+  constexpr int kNumMacs = 100;
+  std::vector<std::pair<L2Entry, L2EntryUpdateType>> updates;
+  for (int i = 0; i < kNumMacs; ++i) {
+    auto mac = folly::MacAddress::fromHBO(0x020000000000 + i);
+    // Learned, aged, then learned again on another port
+    updates.emplace_back(
+        l2Entry(mac, kVlan(), PortID(1)),
+        L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD);
+    updates.emplace_back(
+        l2Entry(mac, kVlan(), PortID(1)),
+        L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_DELETE);
+    updates.emplace_back(
+        l2Entry(mac, kVlan(), PortID(2)),
+        L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD);
+  }
+  // Learned then aged
+  updates.emplace_back(
+      l2Entry(kMacAddress(), kVlan(), kPortID()),
+      L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD);
+  updates.emplace_back(
+      l2Entry(kMacAddress(), kVlan(), kPortID()),
+      L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_DELETE);
+
+  CounterCache counters(getSw());
+  triggerMacCbsInOneBatch(updates);
+  counters.update();
+
+  for (int i = 0; i < kNumMacs; ++i) {
+    auto node =
+        getMacEntry(folly::MacAddress::fromHBO(0x020000000000 + i), kVlan());
+    ASSERT_NE(nullptr, node);
+    EXPECT_EQ(PortDescriptor(PortID(2)), node->getPort());
+  }
+  verifyMacIsDeleted();
+  counters.checkDelta(
+      SwitchStats::kCounterPrefix + "l2_learning.events.sum", updates.size());
+  counters.checkDelta(
+      SwitchStats::kCounterPrefix + "l2_learning.suppressed.sum",
+      2 * kNumMacs + 1);
+}
+
+TEST_F(MacTableManagerTest, MacAgedAndRelearnedOnSamePort) {
+  // A learned MAC, which got a classID assigned
+  auto classID = cfg::AclLookupClass::CLASS_QUEUE_PER_HOST_QUEUE_0;
+  triggerMacLearnedCb();
+  updateState(
+      "Associate classID", [=](const std::shared_ptr<SwitchState>& state) {
+        return MacTableUtils::updateOrAddEntryWithClassID(
+            state, kVlan(), getMacEntry(kMacAddress(), kVlan()), classID);
+      });
+  ASSERT_EQ(classID, getMacEntry(kMacAddress(), kVlan())->getClassID());
+
+  // The hardware ages it out, and learns it again on the same port
+  MacDeltaRecorder recorder(getSw(), kMacAddress());
+  CounterCache counters(getSw());
+  triggerMacCbsInOneBatch({
+      {L2Entry(
+           kMacAddress(),
+           kVlan(),
+           PortDescriptor(kPortID()),
+           L2Entry::L2EntryType::L2_ENTRY_TYPE_VALIDATED,
+           classID),
+       L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_DELETE},
+      {l2Entry(kMacAddress(), kVlan(), kPortID()),
+       L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD},
+  });
+  waitForStateUpdates(getSw());
+  counters.update();
+
+  // Removed and added again, as the two events would have done on their own
+  EXPECT_EQ(
+      std::vector<std::string>({"removed", "added"}), recorder.getChanges());
+  auto node = getMacEntry(kMacAddress(), kVlan());
+  ASSERT_NE(nullptr, node);
+  EXPECT_EQ(PortDescriptor(kPortID()), node->getPort());
+  EXPECT_FALSE(node->getClassID().has_value());
+  counters.checkDelta(
+      SwitchStats::kCounterPrefix + "l2_learning.events.sum", 2);
+  counters.checkDelta(
+      SwitchStats::kCounterPrefix + "l2_learning.suppressed.sum", 0);
+}
+
 } // namespace facebook::fboss
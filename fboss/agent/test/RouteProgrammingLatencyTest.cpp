@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RouteProgrammingLatency.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+using std::chrono::microseconds;
+
+TEST(RouteProgrammingLatencyTest, empty) {
+  RouteProgrammingLatency latency;
+  auto latencies = latency.getLatencies();
+  ASSERT_EQ(kNumRouteProgrammingStages, latencies.size());
+  for (size_t i = 0; i < latencies.size(); ++i) {
+    EXPECT_EQ(static_cast<RouteProgrammingStage>(i), latencies[i].stage);
+    EXPECT_EQ(0, latencies[i].count);
+    EXPECT_EQ(microseconds(0), latencies[i].p99);
+  }
+}
+
+TEST(RouteProgrammingLatencyTest, percentiles) {
+  RouteProgrammingLatency latency;
+  // 98 fast updates and 2 slow ones
+  for (int i = 0; i < 98; ++i) {
+    latency.addSample(RouteProgrammingStage::HW_PROGRAMMING, microseconds(10));
+  }
+  latency.addSample(RouteProgrammingStage::HW_PROGRAMMING, microseconds(5000));
+  latency.addSample(RouteProgrammingStage::HW_PROGRAMMING, microseconds(6000));
+  latency.addSample(RouteProgrammingStage::FIB_UPDATE, microseconds(3));
+
+  auto hw = latency.getLatencies()[static_cast<size_t>(
+      RouteProgrammingStage::HW_PROGRAMMING)];
+  EXPECT_EQ(100, hw.count);
+  EXPECT_EQ(microseconds(98 * 10 + 5000 + 6000), hw.total);
+  EXPECT_EQ(microseconds(6000), hw.max);
+  // 10us is in the [8, 16) bucket
+  EXPECT_EQ(microseconds(15), hw.p50);
+  EXPECT_EQ(microseconds(15), hw.p90);
+  // 5000us is in the [4096, 8192) bucket, capped at the max
+  EXPECT_EQ(microseconds(6000), hw.p99);
+
+  auto fib = latency.getLatencies()[static_cast<size_t>(
+      RouteProgrammingStage::FIB_UPDATE)];
+  EXPECT_EQ(1, fib.count);
+  EXPECT_EQ(microseconds(3), fib.p50);
+
+  latency.clear();
+  for (const auto& stage : latency.getLatencies()) {
+    EXPECT_EQ(0, stage.count);
+  }
+}
@@ -499,3 +499,67 @@ TEST_F(RouteUpdateLoggerTest, TrackAllLabelsManySubscribers) {
   EXPECT_EQ(1, mockMplsRouteLogger->changedFor.size());
 }
 } // namespace
+
+// Every route change is traced, whether it is logged or not
+TEST_F(RouteUpdateLoggerTest, RouteEvents) {
+  routeUpdateLogger->stateUpdated(*deltaAdd);
+  expectNoLogging();
+  auto untrackedEvents = routeUpdateLogger->getRouteEvents();
+
+  logAllRouteUpdates();
+  routeUpdateLogger->stateUpdated(*deltaAdd);
+  auto events = routeUpdateLogger->getRouteEvents();
+  auto numLogged = mockRouteLoggerV4->added.size() +
+      mockRouteLoggerV4->changed.size() + mockRouteLoggerV6->added.size() +
+      mockRouteLoggerV6->changed.size();
+  EXPECT_EQ(numLogged, untrackedEvents.size());
+  EXPECT_EQ(2 * numLogged, events.size());
+  for (const auto& event : events) {
+    // Not applied through the RIB
+    EXPECT_FALSE(event.ribTime);
+    EXPECT_FALSE(event.switchStateTime);
+  }
+}
+
+TEST_F(RouteUpdateLoggerTest, RouteEventStages) {
+  auto before = RouteEvent::Clock::now();
+  SwSwitchRouteUpdateWrapper updater = sw->getRouteUpdater();
+  updater.addRoute(
+      RouterID(0),
+      folly::IPAddressV4("10.10.0.0"),
+      16,
+      ClientID::OPENR,
+      RouteNextHopEntry(RouteForwardAction::DROP, AdminDistance::EBGP));
+  updater.program();
+
+  auto events = sw->getRouteUpdateLogger()->getRouteEvents();
+  ASSERT_FALSE(events.empty());
+  const auto& event = events.back();
+  EXPECT_EQ(folly::IPAddress("10.10.0.0"), event.network);
+  EXPECT_EQ(16, event.mask);
+  EXPECT_EQ(RouteEvent::Type::ADD, event.type);
+  EXPECT_EQ(ClientID::OPENR, event.client);
+  ASSERT_TRUE(event.ribTime);
+  ASSERT_TRUE(event.switchStateTime);
+  EXPECT_LE(before, *event.ribTime);
+  EXPECT_LE(*event.ribTime, *event.switchStateTime);
+  EXPECT_LE(*event.switchStateTime, event.hwTime);
+}
+
+TEST(RouteEventTracerTest, OverwriteOldest) {
+  RouteEventTracer tracer(3);
+  for (uint8_t mask = 0; mask < 5; mask++) {
+    RouteEvent event;
+    event.mask = mask;
+    tracer.record({event});
+  }
+  auto events = tracer.getEvents();
+  ASSERT_EQ(3, events.size());
+  EXPECT_EQ(2, events[0].mask);
+  EXPECT_EQ(3, events[1].mask);
+  EXPECT_EQ(4, events[2].mask);
+
+  RouteEventTracer disabled(0);
+  disabled.record({RouteEvent()});
+  EXPECT_TRUE(disabled.getEvents().empty());
+}
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/StateUpdateProfiler.h"
+
+#include <gtest/gtest.h>
+
+#include <folly/Conv.h>
+
+using namespace facebook::fboss;
+using std::chrono::microseconds;
+
+TEST(StateUpdateProfilerTest, perName) {
+  StateUpdateProfiler profiler;
+  profiler.updateApplied("Updating ACLs", microseconds(10), microseconds(3));
+  profiler.updateApplied("Updating ACLs", microseconds(30), microseconds(1));
+  profiler.updateApplied("JSON patch", microseconds(5), microseconds(100));
+
+  auto profiles = profiler.getProfiles();
+  ASSERT_EQ(2, profiles.size());
+  for (const auto& profile : profiles) {
+    if (profile.name == "Updating ACLs") {
+      EXPECT_EQ(2, profile.count);
+      EXPECT_EQ(microseconds(40), profile.totalQueueWait);
+      EXPECT_EQ(microseconds(30), profile.maxQueueWait);
+      EXPECT_EQ(microseconds(4), profile.totalApply);
+      EXPECT_EQ(microseconds(3), profile.maxApply);
+    } else {
+      EXPECT_EQ("JSON patch", profile.name);
+      EXPECT_EQ(1, profile.count);
+      EXPECT_EQ(microseconds(100), profile.maxApply);
+    }
+  }
+}
+
+TEST(StateUpdateProfilerTest, boundedNames) {
+  StateUpdateProfiler profiler;
+  for (size_t i = 0; i < StateUpdateProfiler::kMaxNames + 10; ++i) {
+    profiler.updateApplied(
+        folly::to<std::string>("resolve nbr ", i),
+        microseconds(1),
+        microseconds(1));
+  }
+  // Known names are still counted under their own name
+  profiler.updateApplied("resolve nbr 0", microseconds(1), microseconds(1));
+
+  auto profiles = profiler.getProfiles();
+  EXPECT_EQ(StateUpdateProfiler::kMaxNames + 1, profiles.size());
+  for (const auto& profile : profiles) {
+    if (profile.name == StateUpdateProfiler::kOtherName) {
+      EXPECT_EQ(10, profile.count);
+    } else if (profile.name == "resolve nbr 0") {
+      EXPECT_EQ(2, profile.count);
+    } else {
+      EXPECT_EQ(1, profile.count);
+    }
+  }
+}
@@ -16,6 +16,7 @@
 #include "fboss/agent/NeighborUpdater.h"
 #include "fboss/agent/PortStats.h"
 #include "fboss/agent/SwitchStats.h"
+#include "fboss/agent/hw/mock/MockRxPacket.h"
 #include "fboss/agent/state/ArpTable.h"
 #include "fboss/agent/state/Interface.h"
 #include "fboss/agent/state/Port.h"
@@ -28,6 +29,7 @@
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
 #include <folly/MacAddress.h>
+#include <folly/synchronization/Baton.h>
 
 #include <algorithm>
 
@@ -41,6 +43,8 @@ using ::testing::ByRef;
 using ::testing::Eq;
 using ::testing::Return;
 
+DECLARE_int32(minimum_ethernet_packet_length);
+
 class SwSwitchTest : public ::testing::Test {
  public:
   void SetUp() override {
@@ -99,6 +103,23 @@ TEST_F(SwSwitchTest, UpdateStatsExceptionCounter) {
       SwitchStats::kCounterPrefix + "update_stats_exceptions.sum.60", 1);
 }
 
+TEST_F(SwSwitchTest, TruncatedPacketCountedAsError) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_minimum_ethernet_packet_length = 0;
+  CounterCache counters(sw);
+
+  // Dst MAC and half of the src MAC
+  auto pkt = MockRxPacket::fromHex("02 00 01 00 00 01  02 00 02");
+  pkt->setSrcPort(PortID(1));
+  pkt->setSrcVlan(VlanID(1));
+  sw->packetReceived(std::move(pkt));
+
+  counters.update();
+  counters.checkDelta(SwitchStats::kCounterPrefix + "trapped.pkts.sum", 1);
+  counters.checkDelta(SwitchStats::kCounterPrefix + "trapped.error.sum", 1);
+  counters.checkDelta(SwitchStats::kCounterPrefix + "trapped.bogus.sum", 0);
+}
+
 TEST_F(SwSwitchTest, TestStateNonCoalescing) {
   const PortID kPort1{1};
   const VlanID kVlan1{1};
@@ -161,6 +182,58 @@ TEST_F(SwSwitchTest, TestStateNonCoalescing) {
   verifyReachableCnt(0);
 }
 
+TEST_F(SwSwitchTest, LinkUpsBatched) {
+  constexpr int kNumPorts = 10;
+  for (int i = 1; i <= kNumPorts; ++i) {
+    ASSERT_FALSE(sw->getState()->getPort(PortID(i))->isUp());
+  }
+  CounterCache counters(sw);
+  // Deliver the link events while the update thread is blocked, so that
+  // the link ups all wait for the same state update
+  folly::Baton<> blockUpdates;
+  sw->getUpdateEvb()->runInEventBaseThread(
+      [&blockUpdates]() { blockUpdates.wait(); });
+  for (int i = 1; i <= kNumPorts; ++i) {
+    sw->linkStateChanged(PortID(i), true);
+  }
+  // Supersedes the pending link up
+  sw->linkStateChanged(PortID(kNumPorts), false);
+  blockUpdates.post();
+  waitForStateUpdates(sw);
+  counters.update();
+
+  for (int i = 1; i < kNumPorts; ++i) {
+    EXPECT_TRUE(sw->getState()->getPort(PortID(i))->isUp());
+  }
+  EXPECT_FALSE(sw->getState()->getPort(PortID(kNumPorts))->isUp());
+  counters.checkDelta(
+      SwitchStats::kCounterPrefix + "link_up.events.sum", kNumPorts);
+  counters.checkDelta(
+      SwitchStats::kCounterPrefix + "link_up.suppressed.sum", 1);
+}
+
+TEST_F(SwSwitchTest, LinkUpAfterLinkDownNotBatchedBeforeIt) {
+  const PortID kPort(1);
+  ASSERT_FALSE(sw->getState()->getPort(kPort)->isUp());
+  CounterCache counters(sw);
+  // With the update thread blocked, the first link up is queued ahead of
+  // the link down. The second one must be applied after the link down.
+  folly::Baton<> blockUpdates;
+  sw->getUpdateEvb()->runInEventBaseThread(
+      [&blockUpdates]() { blockUpdates.wait(); });
+  sw->linkStateChanged(kPort, true);
+  sw->linkStateChanged(kPort, false);
+  sw->linkStateChanged(kPort, true);
+  blockUpdates.post();
+  waitForStateUpdates(sw);
+  counters.update();
+
+  EXPECT_TRUE(sw->getState()->getPort(kPort)->isUp());
+  counters.checkDelta(SwitchStats::kCounterPrefix + "link_up.events.sum", 2);
+  counters.checkDelta(
+      SwitchStats::kCounterPrefix + "link_up.suppressed.sum", 1);
+}
+
 TEST_F(SwSwitchTest, VerifyIsValidStateUpdate) {
   ON_CALL(*getMockHw(sw), isValidStateUpdate(_))
       .WillByDefault(testing::Return(true));
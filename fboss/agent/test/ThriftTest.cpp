@@ -13,7 +13,9 @@
 #include "fboss/agent/ApplyThriftConfig.h"
 #include "fboss/agent/FbossHwUpdateError.h"
 #include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/SwitchStateChangePublisher.h"
 #include "fboss/agent/ThriftHandler.h"
+#include "fboss/agent/Utils.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/hw/mock/MockPlatform.h"
 #include "fboss/agent/state/Port.h"
@@ -26,6 +28,7 @@
 #include "fboss/agent/test/TestUtils.h"
 
 #include <folly/IPAddress.h>
+#include <folly/experimental/coro/BlockingWait.h>
 #include <gtest/gtest.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
@@ -34,6 +37,7 @@ using namespace facebook::stats;
 using apache::thrift::TEnumTraits;
 using cfg::PortSpeed;
 using facebook::network::toBinaryAddress;
+using facebook::network::toIPAddress;
 using facebook::network::thrift::BinaryAddress;
 using folly::IPAddress;
 using folly::IPAddressV4;
@@ -1148,6 +1152,146 @@ TEST_F(ThriftTest, getRouteTableByClient) {
   // 6 intf routes + 2 default routes + 1 link local route
   EXPECT_EQ(7, routeTable.size());
 }
+
+TEST_F(ThriftTest, getRouteTablePage) {
+  ThriftHandler handler(sw_);
+  std::vector<UnicastRoute> routeTable;
+  handler.getRouteTable(routeTable);
+  std::vector<RouteDetails> routeDetails;
+  handler.getRouteTableDetails(routeDetails);
+
+  // Paging through with a page size which does not divide the route count
+  std::vector<UnicastRoute> pagedRoutes;
+  std::vector<RouteDetails> pagedDetails;
+  std::optional<RouteTableCursor> cursor, detailsCursor;
+  do {
+    auto request = std::make_unique<RouteTableRequest>();
+    request->maxRoutes() = 3;
+    request->cursor().from_optional(cursor);
+    RouteTablePage page;
+    handler.getRouteTablePage(page, std::move(request));
+    EXPECT_LE(page.routes()->size(), 3);
+    pagedRoutes.insert(
+        pagedRoutes.end(), page.routes()->begin(), page.routes()->end());
+    cursor = page.nextCursor().to_optional();
+  } while (cursor);
+  do {
+    auto request = std::make_unique<RouteTableRequest>();
+    request->maxRoutes() = 3;
+    request->cursor().from_optional(detailsCursor);
+    RouteDetailsPage page;
+    handler.getRouteTableDetailsPage(page, std::move(request));
+    EXPECT_LE(page.routes()->size(), 3);
+    pagedDetails.insert(
+        pagedDetails.end(), page.routes()->begin(), page.routes()->end());
+    detailsCursor = page.nextCursor().to_optional();
+  } while (detailsCursor);
+  EXPECT_EQ(routeTable, pagedRoutes);
+  EXPECT_EQ(routeDetails, pagedDetails);
+
+  // Prefix filter only returns the covered routes
+  auto request = std::make_unique<RouteTableRequest>();
+  request->prefixFilter() = toIpPrefix(folly::IPAddress::createNetwork("::/0"));
+  RouteTablePage v6Page;
+  handler.getRouteTablePage(v6Page, std::move(request));
+  EXPECT_FALSE(v6Page.nextCursor());
+  auto v6Routes = std::count_if(
+      routeTable.begin(), routeTable.end(), [](const auto& route) {
+        return toIPAddress(*route.dest()->ip()).isV6();
+      });
+  EXPECT_EQ(v6Routes, v6Page.routes()->size());
+  for (const auto& route : *v6Page.routes()) {
+    EXPECT_TRUE(toIPAddress(*route.dest()->ip()).isV6());
+  }
+
+  // Client page matches getRouteTableByClient
+  auto clientId = static_cast<int16_t>(ClientID::INTERFACE_ROUTE);
+  std::vector<UnicastRoute> clientRoutes;
+  handler.getRouteTableByClient(clientRoutes, clientId);
+  RouteTablePage clientPage;
+  handler.getRouteTableByClientPage(
+      clientPage, clientId, std::make_unique<RouteTableRequest>());
+  EXPECT_EQ(clientRoutes, *clientPage.routes());
+}
+TEST_F(ThriftTest, subscribeToSwitchStateChanges) {
+  ThriftHandler handler(sw_);
+  auto subtrees = std::make_unique<std::set<SwitchStateSubtree>>();
+  subtrees->insert(SwitchStateSubtree::ROUTE_TABLE);
+  auto stream = handler.subscribeToSwitchStateChanges(std::move(subtrees))
+                    .toClientStreamUnsafeDoNotUse()
+                    .toAsyncGenerator();
+  // Changes of the next complete snapshot or update
+  auto nextChanges = [&](bool snapshot) {
+    std::vector<SwitchStateChange> changes;
+    while (true) {
+      auto message = folly::coro::blockingWait(stream.next());
+      EXPECT_TRUE(message.has_value());
+      EXPECT_EQ(snapshot, *message->snapshot());
+      for (auto& change : *message->changes()) {
+        changes.push_back(std::move(change));
+      }
+      if (*message->complete()) {
+        return changes;
+      }
+    }
+  };
+
+  // Starts with every route, as ADDED
+  std::vector<RouteDetails> routeDetails;
+  handler.getRouteTableDetails(routeDetails);
+  std::vector<RouteDetails> snapshotRoutes;
+  for (const auto& change : nextChanges(true)) {
+    EXPECT_EQ(SwitchStateChangeType::ADDED, *change.type());
+    snapshotRoutes.push_back(*change.entry()->route());
+  }
+  EXPECT_THAT(snapshotRoutes, UnorderedElementsAreArray(routeDetails));
+
+  // Then only the routes which changed
+  auto prefix = toIpPrefix(folly::IPAddress::createNetwork("7.1.0.0/16"));
+  handler.addUnicastRoute(
+      static_cast<int16_t>(ClientID::BGPD),
+      makeUnicastRoute("7.1.0.0/16", "10.0.0.11"));
+  auto added = nextChanges(false);
+  ASSERT_EQ(1, added.size());
+  EXPECT_EQ(SwitchStateChangeType::ADDED, *added[0].type());
+  EXPECT_EQ(prefix, *added[0].entry()->route()->dest());
+
+  handler.deleteUnicastRoute(
+      static_cast<int16_t>(ClientID::BGPD),
+      std::make_unique<IpPrefix>(prefix));
+  auto removed = nextChanges(false);
+  ASSERT_EQ(1, removed.size());
+  EXPECT_EQ(SwitchStateChangeType::REMOVED, *removed[0].type());
+  EXPECT_EQ(prefix, *removed[0].entry()->route()->dest());
+
+  // Updates to other subtrees are not sent
+  handler.setPortState(1, false);
+  waitForStateUpdates(sw_);
+  sw_->getStateChangePublisher()->stop();
+  EXPECT_FALSE(folly::coro::blockingWait(stream.next()).has_value());
+}
+
+TEST_F(ThriftTest, switchStateChangesCoalesce) {
+  auto subscription = sw_->getStateChangePublisher()->subscribe();
+  // A new subscription gets the current state right away
+  EXPECT_EQ(sw_->getState(), folly::coro::blockingWait(subscription->next()));
+
+  // A subscriber which falls behind only gets the latest state
+  ThriftHandler handler(sw_);
+  handler.addUnicastRoute(
+      static_cast<int16_t>(ClientID::BGPD),
+      makeUnicastRoute("7.1.0.0/16", "10.0.0.11"));
+  handler.addUnicastRoute(
+      static_cast<int16_t>(ClientID::BGPD),
+      makeUnicastRoute("7.2.0.0/16", "10.0.0.11"));
+  auto state = waitForStateUpdates(sw_);
+  EXPECT_EQ(state, folly::coro::blockingWait(subscription->next()));
+
+  sw_->getStateChangePublisher()->stop();
+  EXPECT_EQ(nullptr, folly::coro::blockingWait(subscription->next()));
+  EXPECT_EQ(0, sw_->getStateChangePublisher()->numSubscriptions());
+}
+
 std::unique_ptr<MplsRoute> makeMplsRoute(
     int32_t mplsLabel,
     std::string nxtHop,
@@ -1752,6 +1896,55 @@ TEST_F(ThriftTest, getConfigAppliedInfo) {
   }
 }
 
+TEST_F(ThriftTest, waitForPortStatusChanges) {
+  const PortID port1{1};
+  ThriftHandler handler(sw_);
+  auto waitForChanges = [&handler](int64_t sinceGeneration, int32_t timeoutMs) {
+    return handler.semifuture_waitForPortStatusChanges(
+        sinceGeneration, timeoutMs);
+  };
+
+  // Unknown generation gets a full snapshot right away
+  auto full = *waitForChanges(0, 60000).get();
+  EXPECT_TRUE(*full.fullSync());
+  std::map<int32_t, PortStatus> allPortStatus;
+  handler.getPortStatus(
+      allPortStatus, std::make_unique<std::vector<int32_t>>());
+  EXPECT_EQ(*full.portStatus(), allPortStatus);
+  ConfigAppliedInfo configAppliedInfo;
+  handler.getConfigAppliedInfo(configAppliedInfo);
+  EXPECT_EQ(*full.configAppliedInfo(), configAppliedInfo);
+
+  // Nothing changed, so we get an empty reply at timeout
+  auto idle = *waitForChanges(*full.generation(), 10).get();
+  EXPECT_FALSE(*idle.fullSync());
+  EXPECT_EQ(*idle.generation(), *full.generation());
+  EXPECT_TRUE(idle.portStatus()->empty());
+  EXPECT_TRUE(idle.removedPorts()->empty());
+
+  // Only the changed port is returned
+  handler.setPortState(port1, !*allPortStatus[port1].enabled());
+  waitForStateUpdates(sw_);
+  auto changed = *waitForChanges(*full.generation(), 60000).get();
+  EXPECT_FALSE(*changed.fullSync());
+  EXPECT_GT(*changed.generation(), *full.generation());
+  ASSERT_EQ(changed.portStatus()->size(), 1u);
+  EXPECT_EQ(changed.portStatus()->begin()->first, port1);
+  EXPECT_EQ(
+      *changed.portStatus()->begin()->second.enabled(),
+      !*allPortStatus[port1].enabled());
+
+  // A pending waiter is completed by a config apply
+  auto waiter = waitForChanges(*changed.generation(), 60000);
+  sw_->applyConfig(
+      "New config with new speed profile", testConfigAWithLookupClasses());
+  auto afterConfig = *std::move(waiter).get();
+  EXPECT_GT(*afterConfig.generation(), *changed.generation());
+  EXPECT_GT(
+      *afterConfig.configAppliedInfo()->lastAppliedInMs(),
+      *configAppliedInfo.lastAppliedInMs());
+}
+
 TEST_F(ThriftTest, applySpeedAndProfileMismatchConfig) {
   ThriftHandler handler(sw_);
   auto mismatchConfig = testConfigA();
@@ -44,6 +44,11 @@ void CmdGlobalOptions::init(CLI::App& app) {
       ->check(CLI::PositiveNumber);
   app.add_option(
       "--color", color_, "color (no, yes => yes for tty and no for pipe)");
+  app.add_option(
+         "--parallelism",
+         parallelism_,
+         "Maximum number of hosts queried at the same time")
+      ->check(CLI::PositiveNumber);
   app.add_option(
       "--filter",
       filters_,
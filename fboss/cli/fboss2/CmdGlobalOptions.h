@@ -122,6 +122,10 @@ class CmdGlobalOptions {
     return color_;
   }
 
+  int getParallelism() const {
+    return parallelism_;
+  }
+
   // Setters for testing purposes
   void setAgentThriftPort(int port) {
     agentThriftPort_ = port;
@@ -153,6 +157,7 @@ class CmdGlobalOptions {
   int sensorServiceThriftPort_{5970};
   int dataCorralServiceThriftPort_{5971};
   std::string color_{"yes"};
+  int parallelism_{100};
   std::vector<std::string> filters_{};
 };
 
@@ -37,55 +37,53 @@
 #include "fboss/cli/fboss2/commands/show/transceiver/CmdShowTransceiver.h"
 #include "fboss/cli/fboss2/utils/CmdClientUtils.h"
 #include "fboss/cli/fboss2/utils/CmdUtils.h"
+#include "fboss/cli/fboss2/utils/HostFanOut.h"
 #include "folly/futures/Future.h"
 #include "thrift/lib/cpp2/protocol/Serializer.h"
 
 #include <folly/Singleton.h>
 #include <folly/logging/xlog.h>
-#include <future>
 #include <iostream>
 
 template <typename CmdTypeT>
 void printTabular(
     CmdTypeT& cmd,
-    std::vector<std::shared_future<
-        std::tuple<std::string, typename CmdTypeT::RetType, std::string>>>&
-        results,
+    const std::tuple<std::string, typename CmdTypeT::RetType, std::string>&
+        result,
+    bool multipleHosts,
     std::ostream& out,
     std::ostream& err) {
-  for (auto& result : results) {
-    auto [host, data, errStr] = result.get();
-    if (results.size() != 1) {
-      out << host << "::" << std::endl << std::string(80, '=') << std::endl;
-    }
-
-    if (errStr.empty()) {
-      cmd.printOutput(data);
-    } else {
-      err << errStr << std::endl << std::endl;
-    }
+  const auto& [host, data, errStr] = result;
+  if (multipleHosts) {
+    out << host << "::" << std::endl << std::string(80, '=') << std::endl;
+  }
+
+  if (errStr.empty()) {
+    cmd.printOutput(data);
+  } else {
+    err << errStr << std::endl << std::endl;
   }
 }
 
 template <typename CmdTypeT>
-void printJson(
-    const CmdTypeT& /* cmd */,
-    std::vector<std::shared_future<
-        std::tuple<std::string, typename CmdTypeT::RetType, std::string>>>&
-        results,
-    std::ostream& out,
+void addJsonResult(
+    std::map<std::string, typename CmdTypeT::RetType>& hostResults,
+    std::tuple<std::string, typename CmdTypeT::RetType, std::string>&& result,
     std::ostream& err) {
-  std::map<std::string, typename CmdTypeT::RetType> hostResults;
-  for (auto& result : results) {
-    auto [host, data, errStr] = result.get();
-    if (errStr.empty()) {
-      hostResults[host] = data;
-    } else {
-      err << host << "::" << std::endl << std::string(80, '=') << std::endl;
-      err << errStr << std::endl << std::endl;
-    }
+  auto& [host, data, errStr] = result;
+  if (errStr.empty()) {
+    hostResults[host] = std::move(data);
+  } else {
+    err << host << "::" << std::endl << std::string(80, '=') << std::endl;
+    err << errStr << std::endl << std::endl;
   }
+}
 
+template <typename CmdTypeT>
+void printJson(
+    const CmdTypeT& /* cmd */,
+    const std::map<std::string, typename CmdTypeT::RetType>& hostResults,
+    std::ostream& out) {
   out << apache::thrift::SimpleJSONSerializer::serialize<std::string>(
              hostResults)
       << std::endl;
@@ -169,29 +167,31 @@ void CmdHandler<CmdTypeT, CmdTypeTraits>::run() {
     hosts = {"localhost"};
   }
 
-  std::vector<std::shared_future<std::tuple<std::string, RetType, std::string>>>
-      futureList;
-  for (const auto& host : hosts) {
-    futureList.push_back(std::async(
-                             std::launch::async,
-                             &CmdHandler::asyncHandler,
-                             this,
-                             host /*, inArgs*/)
-                             .share());
+  // Tabular output is printed as the hosts complete, JSON output needs all of
+  // them to build a single object
+  auto isJson = CmdGlobalOptions::getInstance()->getFmt().isJson();
+  std::map<std::string, RetType> jsonResults;
+  bool anyFailed = false;
+  utils::fanOutToHosts<std::tuple<std::string, RetType, std::string>>(
+      hosts,
+      CmdGlobalOptions::getInstance()->getParallelism(),
+      [this](const std::string& host) { return asyncHandler(host); },
+      [&](std::tuple<std::string, RetType, std::string>&& result) {
+        // exit with failure if any of the calls failed
+        anyFailed |= !std::get<2>(result).empty();
+        if (isJson) {
+          addJsonResult<CmdTypeT>(jsonResults, std::move(result), std::cerr);
+        } else {
+          printTabular(impl(), result, hosts.size() != 1, std::cout, std::cerr);
+        }
+      });
+
+  if (isJson) {
+    printJson(impl(), jsonResults, std::cout);
   }
 
-  if (CmdGlobalOptions::getInstance()->getFmt().isJson()) {
-    printJson(impl(), futureList, std::cout, std::cerr);
-  } else {
-    printTabular(impl(), futureList, std::cout, std::cerr);
-  }
-
-  for (auto& fut : futureList) {
-    auto [host, data, errStr] = fut.get();
-    // exit with failure if any of the calls failed
-    if (!errStr.empty()) {
-      exit(1);
-    }
+  if (anyFailed) {
+    exit(1);
   }
 }
 
@@ -0,0 +1,123 @@
+// (c) Facebook, Inc. and its affiliates. Confidential and proprietary.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <folly/logging/xlog.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fboss/cli/fboss2/test/CmdHandlerTestBase.h"
+#include "fboss/cli/fboss2/utils/CmdClientUtils.h"
+#include "fboss/cli/fboss2/utils/HostFanOut.h"
+
+using namespace ::testing;
+
+namespace facebook::fboss {
+
+namespace {
+
+std::vector<std::string> makeHosts(int numHosts) {
+  std::vector<std::string> hosts;
+  for (int i = 0; i < numHosts; i++) {
+    hosts.push_back(folly::to<std::string>("rsw", i, ".test"));
+  }
+  return hosts;
+}
+
+} // namespace
+
+class HostFanOutTestFixture : public CmdHandlerTestBase {};
+
+TEST_F(HostFanOutTestFixture, resultsInHostOrder) {
+  auto hosts = makeHosts(1000);
+  std::vector<std::string> results;
+  utils::fanOutToHosts<std::string>(
+      hosts,
+      16,
+      [](const std::string& host) {
+        // Hosts complete out of order
+        std::this_thread::sleep_for(std::chrono::microseconds(
+            std::hash<std::string>()(host) % 3 * 100));
+        return host;
+      },
+      [&](std::string&& result) { results.push_back(std::move(result)); });
+  EXPECT_EQ(results, hosts);
+}
+
+TEST_F(HostFanOutTestFixture, boundedConcurrency) {
+  constexpr auto kParallelism = 8;
+  auto hosts = makeHosts(1000);
+  std::atomic<int> inFlight{0};
+  std::atomic<int> maxInFlight{0};
+  // Hosts started and not yet handed out
+  std::atomic<int> pending{0};
+  std::atomic<int> maxPending{0};
+  auto updateMax = [](std::atomic<int>& max, int value) {
+    auto current = max.load();
+    while (value > current && !max.compare_exchange_weak(current, value)) {
+    }
+  };
+
+  utils::fanOutToHosts<int>(
+      hosts,
+      kParallelism,
+      [&](const std::string& host) {
+        updateMax(maxPending, ++pending);
+        updateMax(maxInFlight, ++inFlight);
+        // One slow host holds back the results of all the others
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(host == "rsw10.test" ? 50 : 1));
+        --inFlight;
+        return 0;
+      },
+      [&](int&&) { --pending; });
+
+  EXPECT_LE(maxInFlight.load(), kParallelism);
+  // The window moves before the result is handed out
+  EXPECT_LE(maxPending.load(), 2 * kParallelism + 1);
+}
+
+TEST_F(HostFanOutTestFixture, queryManyHosts) {
+  constexpr auto kNumHosts = 1024;
+  setupMockedAgentServer();
+  EXPECT_CALL(getMockAgent(), getArpTable(_))
+      .Times(kNumHosts)
+      .WillRepeatedly(Invoke([&](auto& entries) {
+        // Stand-in for the latency of a remote switch
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        entries.resize(2);
+      }));
+
+  // Every host is the local stand-in agent
+  auto hosts = makeHosts(kNumHosts);
+  size_t numEntries = 0;
+  auto start = std::chrono::steady_clock::now();
+  utils::fanOutToHosts<std::vector<ArpEntryThrift>>(
+      hosts,
+      100,
+      [&](const std::string& /* host */) {
+        std::vector<ArpEntryThrift> entries;
+        auto client = utils::createClient<FbossCtrlAsyncClient>(localhost());
+        client->sync_getArpTable(entries);
+        return entries;
+      },
+      [&](std::vector<ArpEntryThrift>&& entries) {
+        numEntries += entries.size();
+      });
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  XLOG(INFO) << "Queried " << kNumHosts << " hosts in "
+             << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed)
+                    .count()
+             << "ms";
+  EXPECT_EQ(numEntries, 2 * kNumHosts);
+  // Well under the 5s the hosts would take one after the other
+  EXPECT_LT(elapsed, std::chrono::seconds(5));
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace facebook::fboss::utils {
+
+/*
+ * Run query for every host on at most `parallelism` threads, and hand the
+ * results to onResult in host order, each one as soon as it and the results
+ * of all the hosts before it are in.
+ *
+ * A host is only started once the host `2 * parallelism` places before it
+ * has been handed out, so a slow host holds back at most that many results
+ * and memory does not grow with the number of hosts.
+ *
+ * query is called concurrently and must not throw. onResult is called on the
+ * calling thread, one result at a time.
+ */
+template <typename ResultT>
+void fanOutToHosts(
+    const std::vector<std::string>& hosts,
+    int parallelism,
+    const std::function<ResultT(const std::string&)>& query,
+    const std::function<void(ResultT&&)>& onResult) {
+  auto numHosts = hosts.size();
+  auto numThreads = std::min<size_t>(std::max(parallelism, 1), numHosts);
+  auto window = 2 * numThreads;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<std::optional<ResultT>> results(numHosts);
+  size_t nextToStart = 0;
+  size_t nextToHandOut = 0;
+
+  auto worker = [&]() {
+    while (true) {
+      size_t index;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&]() {
+          return nextToStart == numHosts ||
+              nextToStart < nextToHandOut + window;
+        });
+        if (nextToStart == numHosts) {
+          return;
+        }
+        index = nextToStart++;
+      }
+
+      auto result = query(hosts[index]);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        results[index] = std::move(result);
+      }
+      cv.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; i++) {
+    threads.emplace_back(worker);
+  }
+
+  for (size_t i = 0; i < numHosts; i++) {
+    ResultT result;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [&]() { return results[i].has_value(); });
+      result = std::move(*results[i]);
+      results[i].reset();
+      nextToHandOut = i + 1;
+    }
+    // Room for one more host in the window
+    cv.notify_all();
+    onResult(std::move(result));
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+} // namespace facebook::fboss::utils
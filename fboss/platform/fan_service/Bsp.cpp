@@ -276,6 +276,7 @@ void Bsp::getOpticsDataThrift(
     opticData->qsfpServiceTimeStamp = currentQsfpSvcTimestamp;
     opticData->dataProcessTimeStamp = 0;
     opticData->calculatedPwm = 0;
+    pSensorData->markEntryUpdated(opticsGroup->opticName);
   } else {
     // After parsing, we realized that this data is same
     // as previous data, according to the timestamp of the update.
@@ -319,6 +320,7 @@ void Bsp::getOpticsDataSysfs(
     opticData->lastOpticsUpdateTimeInSec = getCurrentTime();
     opticData->dataProcessTimeStamp = 0;
     opticData->calculatedPwm = 0;
+    pSensorData->markEntryUpdated(opticsGroup->opticName);
   }
 }
 
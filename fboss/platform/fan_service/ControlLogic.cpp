@@ -17,10 +17,43 @@ ControlLogic::ControlLogic(
   numFanFailed_ = 0;
   numSensorFailed_ = 0;
   lastControlUpdateSec_ = pBsp_->getCurrentTime();
+  buildIndex();
 }
 
 ControlLogic::~ControlLogic() {}
 
+void ControlLogic::buildIndex() {
+  for (auto sensor = pConfig_->sensors.begin();
+       sensor != pConfig_->sensors.end();
+       ++sensor) {
+    sensorIndex_[sensor->sensorName] = &(*sensor);
+  }
+  for (auto zone = pConfig_->zones.begin(); zone != pConfig_->zones.end();
+       ++zone) {
+    ZoneIndex zoneIndex;
+    zoneIndex.zone = &(*zone);
+    for (auto sensorName = zone->sensorNames.begin();
+         sensorName != zone->sensorNames.end();
+         sensorName++) {
+      zoneIndex.sensors.push_back(findSensorConfig(*sensorName));
+      sensorToZones_[*sensorName].push_back(zoneIndex_.size());
+    }
+    for (auto fan = pConfig_->fans.begin(); fan != pConfig_->fans.end();
+         ++fan) {
+      if (std::find(
+              zone->fanNames.begin(), zone->fanNames.end(), fan->fanName) !=
+          zone->fanNames.end()) {
+        zoneIndex.fans.push_back(&(*fan));
+      }
+    }
+    zoneIndex_.push_back(std::move(zoneIndex));
+  }
+}
+
+void ControlLogic::setEventDriven(bool eventDriven) {
+  eventDriven_ = eventDriven;
+}
+
 void ControlLogic::getFanUpdate() {
   SensorEntryType entryType;
 
@@ -109,6 +142,13 @@ void ControlLogic::getFanUpdate() {
   return;
 }
 
+bool ControlLogic::isStatefulSensor(const Sensor& sensorItem) {
+  return sensorItem.calculationType ==
+      fan_config_structs::SensorPwmCalcType::kSensorPwmCalcIncrementPid ||
+      sensorItem.calculationType ==
+      fan_config_structs::SensorPwmCalcType::kSensorPwmCalcPid;
+}
+
 void ControlLogic::updateTargetPwm(Sensor* sensorItem) {
   bool accelerate, deadFanExists;
   float previousSensorValue, sensorValue, targetPwm;
@@ -243,146 +283,195 @@ void ControlLogic::updateTargetPwm(Sensor* sensorItem) {
 }
 
 void ControlLogic::getSensorUpdate() {
-  std::string sensorItemName;
-  float rawValue = 0.0, adjustedValue, targetPwm;
-  uint64_t calculatedTime = 0;
+  // Readings previewed by updateControlForSensors are now calculated for real
+  previewPwm_.clear();
   for (auto configSensorItem = pConfig_->sensors.begin();
        configSensorItem != pConfig_->sensors.end();
        ++configSensorItem) {
-    XLOG(INFO) << "Control :: Sensor Name : " << configSensorItem->sensorName;
-    bool sensorAccessFail = false;
-    sensorItemName = configSensorItem->sensorName;
-    if (pSensor_->checkIfEntryExists(sensorItemName)) {
-      XLOG(INFO) << "Control :: Sensor Exists. Getting the entry type";
-      // 1.a Get the reading
-      SensorEntryType entryType = pSensor_->getSensorEntryType(sensorItemName);
-      switch (entryType) {
-        case SensorEntryType::kSensorEntryInt:
-          rawValue = pSensor_->getSensorDataInt(sensorItemName);
-          rawValue = rawValue / configSensorItem->scale;
-          break;
-        case SensorEntryType::kSensorEntryFloat:
-          rawValue = pSensor_->getSensorDataFloat(sensorItemName);
-          rawValue = rawValue / configSensorItem->scale;
-          break;
-        default:
-          facebook::fboss::FbossError(
-              "Invalid Sensor Entry Type in entry name : ", sensorItemName);
-          break;
-      }
-    } else {
-      XLOG(ERR) << "Control :: Sensor Read Fail : " << sensorItemName;
-      sensorAccessFail = true;
-    }
-    XLOG(INFO) << "Control :: Done raw sensor reading";
+    processSensorUpdate(&(*configSensorItem));
+  }
+}
 
-    if (sensorAccessFail) {
-      // If the sensor data cache is stale for a while, we consider it as the
-      // failure of such sensor
-      uint64_t timeDiffInSec = pBsp_->getCurrentTime() -
-          configSensorItem->processedData.lastUpdatedTime;
-      if (timeDiffInSec >= configSensorItem->sensorFailThresholdInSec) {
-        configSensorItem->processedData.sensorFailed == true;
-        numSensorFailed_++;
-      }
-    } else {
-      calculatedTime = pSensor_->getLastUpdated(sensorItemName);
-      configSensorItem->processedData.lastUpdatedTime = calculatedTime;
-      configSensorItem->processedData.sensorFailed = false;
+bool ControlLogic::readSensor(Sensor* configSensorItem) {
+  std::string sensorItemName = configSensorItem->sensorName;
+  float rawValue = 0.0, adjustedValue;
+  bool sensorAccessFail = false;
+  if (pSensor_->checkIfEntryExists(sensorItemName)) {
+    XLOG(INFO) << "Control :: Sensor Exists. Getting the entry type";
+    // 1.a Get the reading
+    SensorEntryType entryType = pSensor_->getSensorEntryType(sensorItemName);
+    switch (entryType) {
+      case SensorEntryType::kSensorEntryInt:
+        rawValue = pSensor_->getSensorDataInt(sensorItemName);
+        rawValue = rawValue / configSensorItem->scale;
+        break;
+      case SensorEntryType::kSensorEntryFloat:
+        rawValue = pSensor_->getSensorDataFloat(sensorItemName);
+        rawValue = rawValue / configSensorItem->scale;
+        break;
+      default:
+        facebook::fboss::FbossError(
+            "Invalid Sensor Entry Type in entry name : ", sensorItemName);
+        break;
     }
+    configSensorItem->processedData.lastUpdatedTime =
+        pSensor_->getLastUpdated(sensorItemName);
+  } else {
+    XLOG(ERR) << "Control :: Sensor Read Fail : " << sensorItemName;
+    sensorAccessFail = true;
+  }
+  XLOG(INFO) << "Control :: Done raw sensor reading";
 
-    // 1.b If adjustment table exists, adjust the raw value
-    if (configSensorItem->offsetTable.size() == 0) {
-      adjustedValue = rawValue;
-    } else {
-      float offset = 0;
-      for (auto tableEntry = configSensorItem->offsetTable.begin();
-           tableEntry != configSensorItem->offsetTable.end();
-           ++tableEntry) {
-        if (rawValue >= tableEntry->first) {
-          offset = tableEntry->second;
-        }
-        adjustedValue = rawValue + offset;
+  // 1.b If adjustment table exists, adjust the raw value
+  if (configSensorItem->offsetTable.size() == 0) {
+    adjustedValue = rawValue;
+  } else {
+    float offset = 0;
+    for (auto tableEntry = configSensorItem->offsetTable.begin();
+         tableEntry != configSensorItem->offsetTable.end();
+         ++tableEntry) {
+      if (rawValue >= tableEntry->first) {
+        offset = tableEntry->second;
       }
+      adjustedValue = rawValue + offset;
     }
-    configSensorItem->processedData.adjustedReadCache = adjustedValue;
-    XLOG(INFO) << "Control :: Adjusted Value : " << adjustedValue;
-    // 1.c Check and trigger alarm
-    bool prevMajorAlarm = configSensorItem->processedData.majorAlarmTriggered;
-    configSensorItem->processedData.majorAlarmTriggered =
-        (adjustedValue >= configSensorItem->alarm.high_major);
-    // If major alarm was triggered, write it as a ERR log
-    if (!prevMajorAlarm &&
-        configSensorItem->processedData.majorAlarmTriggered) {
-      XLOG(ERR) << "Major Alarm Triggered on " << configSensorItem->sensorName
-                << " at value " << adjustedValue;
-    } else if (
-        prevMajorAlarm &&
-        !configSensorItem->processedData.majorAlarmTriggered) {
-      XLOG(WARN) << "Major Alarm Cleared on " << configSensorItem->sensorName
-                 << " at value " << adjustedValue;
+  }
+  configSensorItem->processedData.adjustedReadCache = adjustedValue;
+  XLOG(INFO) << "Control :: Adjusted Value : " << adjustedValue;
+  return !sensorAccessFail;
+}
+
+ControlLogic::PwmInputs ControlLogic::getPwmInputs(
+    const Sensor& sensorItem) const {
+  return PwmInputs{
+      sensorItem.processedData.adjustedReadCache,
+      sensorItem.fourCurves.previousSensorRead,
+      sensorItem.processedData.targetPwmCache,
+      numFanFailed_ > 0};
+}
+
+float ControlLogic::previewTargetPwm(Sensor* sensorItem) {
+  // Calculate from the state the last control pass left, and put it back,
+  // so that the next control pass calculates the same pwm again.
+  auto previousSensorRead = sensorItem->fourCurves.previousSensorRead;
+  auto targetPwm = sensorItem->processedData.targetPwmCache;
+  updateTargetPwm(sensorItem);
+  auto previewPwm = sensorItem->processedData.targetPwmCache;
+  sensorItem->fourCurves.previousSensorRead = previousSensorRead;
+  sensorItem->processedData.targetPwmCache = targetPwm;
+  return previewPwm;
+}
+
+void ControlLogic::processSensorUpdate(Sensor* configSensorItem) {
+  uint64_t calculatedTime = 0;
+  XLOG(INFO) << "Control :: Sensor Name : " << configSensorItem->sensorName;
+  bool sensorAccessFail = !readSensor(configSensorItem);
+  float adjustedValue = configSensorItem->processedData.adjustedReadCache;
+
+  if (sensorAccessFail) {
+    // If the sensor data cache is stale for a while, we consider it as the
+    // failure of such sensor
+    uint64_t timeDiffInSec = pBsp_->getCurrentTime() -
+        configSensorItem->processedData.lastUpdatedTime;
+    if (timeDiffInSec >= configSensorItem->sensorFailThresholdInSec) {
+      configSensorItem->processedData.sensorFailed == true;
+      numSensorFailed_++;
     }
-    bool prevMinorAlarm = configSensorItem->processedData.minorAlarmTriggered;
-    if (adjustedValue >= configSensorItem->alarm.high_minor) {
-      if (configSensorItem->processedData.soakStarted) {
-        uint64_t timeDiffInSec = pBsp_->getCurrentTime() -
-            configSensorItem->processedData.soakStartedAt;
-        if (timeDiffInSec >= configSensorItem->alarm.high_minor_soak) {
-          configSensorItem->processedData.minorAlarmTriggered = true;
-          configSensorItem->processedData.soakStarted = false;
-        }
-      } else {
-        configSensorItem->processedData.soakStarted = true;
-        configSensorItem->processedData.soakStartedAt = calculatedTime;
+  } else {
+    calculatedTime = configSensorItem->processedData.lastUpdatedTime;
+    configSensorItem->processedData.sensorFailed = false;
+  }
+
+  // 1.c Check and trigger alarm
+  bool prevMajorAlarm = configSensorItem->processedData.majorAlarmTriggered;
+  configSensorItem->processedData.majorAlarmTriggered =
+      (adjustedValue >= configSensorItem->alarm.high_major);
+  // If major alarm was triggered, write it as a ERR log
+  if (!prevMajorAlarm &&
+      configSensorItem->processedData.majorAlarmTriggered) {
+    XLOG(ERR) << "Major Alarm Triggered on " << configSensorItem->sensorName
+              << " at value " << adjustedValue;
+  } else if (
+      prevMajorAlarm &&
+      !configSensorItem->processedData.majorAlarmTriggered) {
+    XLOG(WARN) << "Major Alarm Cleared on " << configSensorItem->sensorName
+               << " at value " << adjustedValue;
+  }
+  bool prevMinorAlarm = configSensorItem->processedData.minorAlarmTriggered;
+  if (adjustedValue >= configSensorItem->alarm.high_minor) {
+    if (configSensorItem->processedData.soakStarted) {
+      uint64_t timeDiffInSec = pBsp_->getCurrentTime() -
+          configSensorItem->processedData.soakStartedAt;
+      if (timeDiffInSec >= configSensorItem->alarm.high_minor_soak) {
+        configSensorItem->processedData.minorAlarmTriggered = true;
+        configSensorItem->processedData.soakStarted = false;
       }
     } else {
-      configSensorItem->processedData.minorAlarmTriggered = false;
-      configSensorItem->processedData.soakStarted = false;
+      configSensorItem->processedData.soakStarted = true;
+      configSensorItem->processedData.soakStartedAt = calculatedTime;
     }
-    // If minor alarm was triggered, write it as a WARN log
-    if (!prevMinorAlarm &&
-        configSensorItem->processedData.minorAlarmTriggered) {
-      XLOG(WARN) << "Minor Alarm Triggered on " << configSensorItem->sensorName
-                 << " at value " << adjustedValue;
-    }
-    if (prevMinorAlarm &&
-        !configSensorItem->processedData.minorAlarmTriggered) {
-      XLOG(WARN) << "Minor Alarm Cleared on " << configSensorItem->sensorName
-                 << " at value " << adjustedValue;
-    }
-    // 1.d Check the range (if required), and do emergency
-    // shutdown, if the value is out of range for more than
-    // the "tolerance" times
-    if (configSensorItem->rangeCheck.enabled) {
-      if ((adjustedValue > configSensorItem->rangeCheck.rangeHigh) ||
-          (adjustedValue < configSensorItem->rangeCheck.rangeLow)) {
-        configSensorItem->rangeCheck.invalidCount += 1;
-        if (configSensorItem->rangeCheck.invalidCount >=
+  } else {
+    configSensorItem->processedData.minorAlarmTriggered = false;
+    configSensorItem->processedData.soakStarted = false;
+  }
+  // If minor alarm was triggered, write it as a WARN log
+  if (!prevMinorAlarm &&
+      configSensorItem->processedData.minorAlarmTriggered) {
+    XLOG(WARN) << "Minor Alarm Triggered on " << configSensorItem->sensorName
+               << " at value " << adjustedValue;
+  }
+  if (prevMinorAlarm &&
+      !configSensorItem->processedData.minorAlarmTriggered) {
+    XLOG(WARN) << "Minor Alarm Cleared on " << configSensorItem->sensorName
+               << " at value " << adjustedValue;
+  }
+  // 1.d Check the range (if required), and do emergency
+  // shutdown, if the value is out of range for more than
+  // the "tolerance" times
+  if (configSensorItem->rangeCheck.enabled) {
+    if ((adjustedValue > configSensorItem->rangeCheck.rangeHigh) ||
+        (adjustedValue < configSensorItem->rangeCheck.rangeLow)) {
+      configSensorItem->rangeCheck.invalidCount += 1;
+      if (configSensorItem->rangeCheck.invalidCount >=
+          configSensorItem->rangeCheck.tolerance) {
+        // ERR log only once.
+        if (configSensorItem->rangeCheck.invalidCount ==
             configSensorItem->rangeCheck.tolerance) {
-          // ERR log only once.
-          if (configSensorItem->rangeCheck.invalidCount ==
-              configSensorItem->rangeCheck.tolerance) {
-            XLOG(ERR) << "Sensor " << configSensorItem->sensorName
-                      << " out of range for too long!";
-          }
-          // If we are not yet in emergency state, do the emergency shutdown.
-          if ((configSensorItem->rangeCheck.action ==
-               kRangeCheckActionShutdown) &&
-              (pBsp_->getEmergencyState() == false)) {
-            pBsp_->emergencyShutdown(pConfig_, true);
-          }
+          XLOG(ERR) << "Sensor " << configSensorItem->sensorName
+                    << " out of range for too long!";
+        }
+        // If we are not yet in emergency state, do the emergency shutdown.
+        if ((configSensorItem->rangeCheck.action ==
+             kRangeCheckActionShutdown) &&
+            (pBsp_->getEmergencyState() == false)) {
+          pBsp_->emergencyShutdown(pConfig_, true);
         }
-      } else {
-        configSensorItem->rangeCheck.invalidCount = 0;
       }
+    } else {
+      configSensorItem->rangeCheck.invalidCount = 0;
+    }
+  }
+  // 1.e Calculate the target pwm in percent
+  //     (the table or incremental pid should produce
+  //      percent as its output)
+  //     In event driven mode, skip the calculation of stateless sensors if
+  //     its inputs are the same as the last time, as the pwm would be too.
+  //     (Incremental) PID sensors integrate on every control period.
+  if (eventDriven_ && !isStatefulSensor(*configSensorItem)) {
+    auto pwmInputs = getPwmInputs(*configSensorItem);
+    auto lastPwmInputs = lastPwmInputs_.find(configSensorItem);
+    if (lastPwmInputs != lastPwmInputs_.end() &&
+        lastPwmInputs->second == pwmInputs) {
+      XLOG(INFO) << configSensorItem->sensorName
+                 << " has the unchanged target PWM of "
+                 << configSensorItem->processedData.targetPwmCache;
+      return;
     }
-    // 1.e Calculate the target pwm in percent
-    //     (the table or incremental pid should produce
-    //      percent as its output)
-    updateTargetPwm(&(*configSensorItem));
-    XLOG(INFO) << configSensorItem->sensorName << " has the target PWM of "
-               << configSensorItem->processedData.targetPwmCache;
+    lastPwmInputs_[configSensorItem] = pwmInputs;
   }
+  updateTargetPwm(configSensorItem);
+  XLOG(INFO) << configSensorItem->sensorName << " has the target PWM of "
+             << configSensorItem->processedData.targetPwmCache;
   return;
 }
 
@@ -392,64 +481,65 @@ void ControlLogic::getOpticsUpdate() {
   // No need to worry about timestamp, but update it anyway
   for (auto optic = pConfig_->optics.begin(); optic != pConfig_->optics.end();
        ++optic) {
-    XLOG(INFO) << "Control :: Optics Group Name : " << optic->opticName;
-    std::string opticName = optic->opticName;
+    processOpticUpdate(&(*optic));
+  }
+}
 
-    if (!pSensor_->checkIfOpticEntryExists(opticName)) {
-      // No data found. Skip this config entry
-      continue;
+void ControlLogic::processOpticUpdate(Optic* optic) {
+  XLOG(INFO) << "Control :: Optics Group Name : " << optic->opticName;
+  std::string opticName = optic->opticName;
+
+  if (!pSensor_->checkIfOpticEntryExists(opticName)) {
+    // No data found. Skip this config entry
+    return;
+  } else {
+    auto opticData = pSensor_->getOpticEntry(opticName);
+    int pwmSoFar = 0;
+    int dataSize = 0;
+    if (opticData != nullptr) {
+      opticData->data.size();
+    }
+    if (dataSize == 0) {
+      // This data set is empty, already processed. Ignore.
+      return;
     } else {
-      auto opticData = pSensor_->getOpticEntry(opticName);
-      int pwmSoFar = 0;
-      int dataSize = 0;
-      if (opticData != nullptr) {
-        opticData->data.size();
-      }
-      if (dataSize == 0) {
-        // This data set is empty, already processed. Ignore.
-        continue;
-      } else {
-        for (auto dataPair = opticData->data.begin();
-             dataPair != opticData->data.end();
-             ++dataPair) {
-          auto dataType = dataPair->first;
-          auto value = dataPair->second;
-          int pwmForThis = 0;
-          auto tablePointer =
-              pConfig_->getConfigOpticTable(opticName, dataType);
-          // We have <type, value> pair. If we have table entry for this
-          // optics type, get the matching pwm value using the optics value
-          if (tablePointer != nullptr) {
-            // Start with the minumum, then continue the comparison
-            pwmForThis = (*tablePointer)[0].second;
-            for (auto tableEntry = tablePointer->begin();
-                 tableEntry != tablePointer->end();
-                 ++tableEntry) {
-              if (value > tableEntry->first) {
-                pwmForThis = tableEntry->second;
-              }
+      for (auto dataPair = opticData->data.begin();
+           dataPair != opticData->data.end();
+           ++dataPair) {
+        auto dataType = dataPair->first;
+        auto value = dataPair->second;
+        int pwmForThis = 0;
+        auto tablePointer =
+            pConfig_->getConfigOpticTable(opticName, dataType);
+        // We have <type, value> pair. If we have table entry for this
+        // optics type, get the matching pwm value using the optics value
+        if (tablePointer != nullptr) {
+          // Start with the minumum, then continue the comparison
+          pwmForThis = (*tablePointer)[0].second;
+          for (auto tableEntry = tablePointer->begin();
+               tableEntry != tablePointer->end();
+               ++tableEntry) {
+            if (value > tableEntry->first) {
+              pwmForThis = tableEntry->second;
             }
           }
-          if (pwmForThis > pwmSoFar) {
-            pwmSoFar = pwmForThis;
-          }
         }
-        opticData->calculatedPwm = pwmSoFar;
-        // As we consumed the data, clear the vector
-        opticData->data.clear();
-        opticData->dataProcessTimeStamp = opticData->lastOpticsUpdateTimeInSec;
+        if (pwmForThis > pwmSoFar) {
+          pwmSoFar = pwmForThis;
+        }
       }
+      opticData->calculatedPwm = pwmSoFar;
+      // As we consumed the data, clear the vector
+      opticData->data.clear();
+      opticData->dataProcessTimeStamp = opticData->lastOpticsUpdateTimeInSec;
     }
   }
 }
 
-Sensor* ControlLogic::findSensorConfig(std::string sensorName) {
-  for (auto sensorConfig = pConfig_->sensors.begin();
-       sensorConfig != pConfig_->sensors.end();
-       ++sensorConfig) {
-    if (sensorConfig->sensorName == sensorName) {
-      return &(*sensorConfig);
-    }
+Sensor* ControlLogic::findSensorConfig(const std::string& sensorName) {
+  auto sensorConfig = sensorIndex_.find(sensorName);
+  if (sensorConfig != sensorIndex_.end()) {
+    return sensorConfig->second;
   }
   facebook::fboss::FbossError("Enable to find sensorConfig : ", sensorName);
   return nullptr;
@@ -507,17 +597,13 @@ bool ControlLogic::checkIfFanPresent(Fan* fan) {
   }
   return false;
 }
-void ControlLogic::programFan(Zone* zone, float pwmSoFar) {
-  for (auto fan = pConfig_->fans.begin(); fan != pConfig_->fans.end(); ++fan) {
+void ControlLogic::programFan(const ZoneIndex& zoneIndex, float pwmSoFar) {
+  Zone* zone = zoneIndex.zone;
+  for (auto fan : zoneIndex.fans) {
     auto srcType = *fan->pwm.accessType();
     float pwmToProgram = 0;
     float currentPwm = fan->fanStatus.currentPwm;
     bool writeSuccess;
-    // If this fan does not belong to the current zone, do not do anything
-    if (std::find(zone->fanNames.begin(), zone->fanNames.end(), fan->fanName) ==
-        zone->fanNames.end()) {
-      continue;
-    }
     if ((zone->slope == 0) || (currentPwm == 0)) {
       pwmToProgram = pwmSoFar;
     } else {
@@ -548,14 +634,14 @@ void ControlLogic::programFan(Zone* zone, float pwmSoFar) {
       case fan_config_structs::SourceType::kSrcSysfs:
         writeSuccess = pBsp_->setFanPwmSysfs(*fan->pwm.path(), pwmInt);
         if (!writeSuccess) {
-          setFanFailState(std::addressof(*fan), true);
+          setFanFailState(fan, true);
         }
         break;
       case fan_config_structs::SourceType::kSrcUtil:
         writeSuccess =
             pBsp_->setFanPwmShell(*fan->pwm.path(), fan->fanName, pwmInt);
         if (!writeSuccess) {
-          setFanFailState(std::addressof(*fan), true);
+          setFanFailState(fan, true);
         }
         break;
       case fan_config_structs::SourceType::kSrcThrift:
@@ -621,99 +707,140 @@ void ControlLogic::setFanFailState(Fan* fan, bool fanFailed) {
 }
 
 void ControlLogic::adjustZoneFans(bool boostMode) {
-  for (auto zone = pConfig_->zones.begin(); zone != pConfig_->zones.end();
-       ++zone) {
-    float pwmSoFar = 0;
-    XLOG(INFO) << "Zone : " << zone->zoneName;
-    // First, calculate the pwm value for this zone
-    auto zoneType = zone->type;
-    int totalPwmConsidered = 0;
-    for (auto sensorName = zone->sensorNames.begin();
-         sensorName != zone->sensorNames.end();
-         sensorName++) {
-      auto pSensorConfig_ = findSensorConfig(*sensorName);
-      if ((pSensorConfig_ != nullptr) ||
-          (pSensor_->checkIfOpticEntryExists(*sensorName))) {
-        totalPwmConsidered++;
-        float pwmForThisSensor;
-        if (pSensorConfig_ != nullptr) {
-          // If this is a sensor name
-          pwmForThisSensor = pSensorConfig_->processedData.targetPwmCache;
-        } else {
-          // If this is an optics name
-          pwmForThisSensor = pSensor_->getOpticsPwm(*sensorName);
-        }
-        switch (zoneType) {
-          case fan_config_structs::ZoneType::kZoneMax:
-            if (pwmSoFar < pwmForThisSensor) {
-              pwmSoFar = pwmForThisSensor;
-            }
-            break;
-          case fan_config_structs::ZoneType::kZoneMin:
-            if (pwmSoFar > pwmForThisSensor) {
-              pwmSoFar = pwmForThisSensor;
-            }
-            break;
-          case fan_config_structs::ZoneType::kZoneAvg:
-            pwmSoFar += pwmForThisSensor;
-            break;
-          case fan_config_structs::ZoneType::kZoneInval:
-          default:
-            facebook::fboss::FbossError(
-                "Undefined Zone Type for zone : ", zone->zoneName);
-            break;
-        }
-        XLOG(INFO) << "  Sensor/Optic " << *sensorName << " : "
-                   << pwmForThisSensor << " Overall so far : " << pwmSoFar;
+  for (const auto& zoneIndex : zoneIndex_) {
+    adjustZone(zoneIndex, boostMode);
+  }
+}
+
+void ControlLogic::adjustZone(const ZoneIndex& zoneIndex, bool boostMode) {
+  Zone* zone = zoneIndex.zone;
+  float pwmSoFar = 0;
+  XLOG(INFO) << "Zone : " << zone->zoneName;
+  // First, calculate the pwm value for this zone
+  auto zoneType = zone->type;
+  int totalPwmConsidered = 0;
+  for (size_t i = 0; i < zone->sensorNames.size(); i++) {
+    const std::string* sensorName = &zone->sensorNames[i];
+    auto pSensorConfig_ = zoneIndex.sensors[i];
+    if ((pSensorConfig_ != nullptr) ||
+        (pSensor_->checkIfOpticEntryExists(*sensorName))) {
+      totalPwmConsidered++;
+      float pwmForThisSensor;
+      if (pSensorConfig_ != nullptr) {
+        // If this is a sensor name
+        auto previewPwm = previewPwm_.find(pSensorConfig_);
+        pwmForThisSensor = previewPwm != previewPwm_.end()
+            ? previewPwm->second
+            : pSensorConfig_->processedData.targetPwmCache;
+      } else {
+        // If this is an optics name
+        pwmForThisSensor = pSensor_->getOpticsPwm(*sensorName);
       }
+      switch (zoneType) {
+        case fan_config_structs::ZoneType::kZoneMax:
+          if (pwmSoFar < pwmForThisSensor) {
+            pwmSoFar = pwmForThisSensor;
+          }
+          break;
+        case fan_config_structs::ZoneType::kZoneMin:
+          if (pwmSoFar > pwmForThisSensor) {
+            pwmSoFar = pwmForThisSensor;
+          }
+          break;
+        case fan_config_structs::ZoneType::kZoneAvg:
+          pwmSoFar += pwmForThisSensor;
+          break;
+        case fan_config_structs::ZoneType::kZoneInval:
+        default:
+          facebook::fboss::FbossError(
+              "Undefined Zone Type for zone : ", zone->zoneName);
+          break;
+      }
+      XLOG(INFO) << "  Sensor/Optic " << *sensorName << " : "
+                 << pwmForThisSensor << " Overall so far : " << pwmSoFar;
     }
-    if (zoneType == fan_config_structs::ZoneType::kZoneAvg) {
-      pwmSoFar /= (float)totalPwmConsidered;
+  }
+  if (zoneType == fan_config_structs::ZoneType::kZoneAvg) {
+    pwmSoFar /= (float)totalPwmConsidered;
+  }
+  XLOG(INFO) << "  Final PWM : " << pwmSoFar;
+  if (boostMode) {
+    if (pwmSoFar < pConfig_->getPwmBoostValue()) {
+      pwmSoFar = pConfig_->getPwmBoostValue();
     }
-    XLOG(INFO) << "  Final PWM : " << pwmSoFar;
-    if (boostMode) {
-      if (pwmSoFar < pConfig_->getPwmBoostValue()) {
-        pwmSoFar = pConfig_->getPwmBoostValue();
-      }
+  }
+  // Update the previous pwm value in each associated sensors,
+  // so that they may be used in the next calculation.
+  for (auto pSensorConfig_ : zoneIndex.sensors) {
+    if (pSensorConfig_ != nullptr) {
+      pSensorConfig_->incrementPid.previousTargetPwm = pwmSoFar;
     }
-    // Update the previous pwm value in each associated sensors,
-    // so that they may be used in the next calculation.
-    for (auto sensorName = zone->sensorNames.begin();
-         sensorName != zone->sensorNames.end();
-         sensorName++) {
-      auto pSensorConfig_ = findSensorConfig(*sensorName);
+  }
+  // Secondly, set Zone pwm value to all the fans in the zone
+  programFan(zoneIndex, pwmSoFar);
+}
+
+void ControlLogic::setTransitionValue() {
+  for (const auto& zoneIndex : zoneIndex_) {
+    // Only the zones with fans need the transitional value
+    if (zoneIndex.fans.empty()) {
+      continue;
+    }
+    for (auto pSensorConfig_ : zoneIndex.sensors) {
       if (pSensorConfig_ != nullptr) {
-        pSensorConfig_->incrementPid.previousTargetPwm = pwmSoFar;
+        pSensorConfig_->incrementPid.previousTargetPwm =
+            pConfig_->getPwmTransitionValue();
       }
     }
-    // Secondly, set Zone pwm value to all the fans in the zone
-    programFan(&(*zone), pwmSoFar);
+    programFan(zoneIndex, pConfig_->getPwmTransitionValue());
   }
 }
 
-void ControlLogic::setTransitionValue() {
-  for (auto zone = pConfig_->zones.begin(); zone != pConfig_->zones.end();
-       ++zone) {
-    for (auto fan = pConfig_->fans.begin(); fan != pConfig_->fans.end();
-         ++fan) {
-      // If this a fan belongs to the zone, then write the transitional value
-      if (std::find(
-              zone->fanNames.begin(), zone->fanNames.end(), fan->fanName) !=
-          zone->fanNames.end()) {
-        for (auto sensorName = zone->sensorNames.begin();
-             sensorName != zone->sensorNames.end();
-             sensorName++) {
-          auto pSensorConfig_ = findSensorConfig(*sensorName);
-          if (pSensorConfig_ != nullptr) {
-            pSensorConfig_->incrementPid.previousTargetPwm =
-                pConfig_->getPwmTransitionValue();
-          }
-        }
-        programFan(&(*zone), pConfig_->getPwmTransitionValue());
+void ControlLogic::updateControlForSensors(
+    std::shared_ptr<SensorData> pS,
+    const std::unordered_set<std::string>& updatedEntries) {
+  pSensor_ = pS;
+  std::vector<bool> zoneAffected(zoneIndex_.size(), false);
+
+  for (const auto& name : updatedEntries) {
+    if (auto sensorConfig = sensorIndex_.find(name);
+        sensorConfig != sensorIndex_.end()) {
+      if (isStatefulSensor(*sensorConfig->second)) {
+        // Their steps are sized for the control period, and dT is measured
+        // from the last control pass. Leave them to updateControl.
+        continue;
       }
+      // Only the pwm. Alarms, range checks and sensor failures count
+      // control periods, so they are left to updateControl.
+      readSensor(sensorConfig->second);
+      previewPwm_[sensorConfig->second] =
+          previewTargetPwm(sensorConfig->second);
+    }
+    auto zones = sensorToZones_.find(name);
+    if (zones == sensorToZones_.end()) {
+      // Fan rpm, presence, or anything else no zone cares about
+      continue;
+    }
+    for (auto zone : zones->second) {
+      zoneAffected[zone] = true;
+    }
+  }
+  for (auto optic = pConfig_->optics.begin(); optic != pConfig_->optics.end();
+       ++optic) {
+    if (updatedEntries.find(optic->opticName) != updatedEntries.end()) {
+      processOpticUpdate(&(*optic));
+    }
+  }
+
+  for (size_t i = 0; i < zoneIndex_.size(); i++) {
+    if (zoneAffected[i]) {
+      XLOG(INFO) << "Control :: Event driven update of zone "
+                 << zoneIndex_[i].zone->zoneName;
+      adjustZone(zoneIndex_[i], lastBoostMode_);
     }
   }
 }
+
 void ControlLogic::updateControl(std::shared_ptr<SensorData> pS) {
   pSensor_ = pS;
 
@@ -738,6 +865,9 @@ void ControlLogic::updateControl(std::shared_ptr<SensorData> pS) {
 
   // Determine proposed pwm value by each sensor read
   XLOG(INFO) << "Control :: Reading Sensor Status and determine per sensor PWM";
+  // Every sensor is processed, the updates were only needed by the event
+  // driven updates since the last pass.
+  pSensor_->takeUpdatedEntries();
   getSensorUpdate();
 
   // Determine proposed pwm value by each optics read
@@ -765,6 +895,7 @@ void ControlLogic::updateControl(std::shared_ptr<SensorData> pS) {
         (numSensorFailed_ >= pConfig_->pwmBoostOnDeadSensor)) ||
        boost_due_to_no_qsfp);
   XLOG(INFO) << "Control :: Boost mode " << (boostMode ? "On" : "Off");
+  lastBoostMode_ = boostMode;
   XLOG(INFO) << "Control :: Updating Zones with new Fan value";
 
   // Finally, set pwm values per zone.
@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <unordered_set>
+
 #include "Bsp.h"
 #include "SensorData.h"
 
@@ -19,6 +22,20 @@ class ControlLogic {
   // updateControl : Main entry for the control logic to process sensor
   //                 readings and set PWM value accordingly
   void updateControl(std::shared_ptr<SensorData> pS);
+  // updateControlForSensors : Event driven entry point. Reprograms only the
+  //                 zones referring to the given (newly changed) sensor/optics
+  //                 readings, with the pwm the next updateControl will
+  //                 calculate for them. Fan checks, boost mode, alarms, range
+  //                 checks and sensor failures are still evaluated by
+  //                 updateControl, once per control period.
+  void updateControlForSensors(
+      std::shared_ptr<SensorData> pS,
+      const std::unordered_set<std::string>& updatedEntries);
+  // In event driven mode, updateControl skips the pwm calculation of the
+  // stateless sensors whose inputs did not change since their last one.
+  // PID and incremental PID sensors integrate over time, so they are only
+  // calculated by updateControl, on every control period.
+  void setEventDriven(bool eventDriven);
   void setTransitionValue();
 
  private:
@@ -32,16 +49,58 @@ class ControlLogic {
   int numSensorFailed_;
   // Last control update time. Used for dT calculation
   uint64_t lastControlUpdateSec_;
+  // Boost mode decided by the last full control pass
+  bool lastBoostMode_{false};
+  bool eventDriven_{false};
+
+  // Lookup tables built once from the config, so that the control loop
+  // does not search sensors and fans by name on every pass.
+  struct ZoneIndex {
+    Zone* zone;
+    // Sensor config of each entry in zone->sensorNames (nullptr for optics)
+    std::vector<Sensor*> sensors;
+    std::vector<Fan*> fans;
+  };
+  std::vector<ZoneIndex> zoneIndex_;
+  std::unordered_map<std::string, Sensor*> sensorIndex_;
+  // Sensor / optics name -> index of the zones (in zoneIndex_) using it
+  std::unordered_map<std::string, std::vector<size_t>> sensorToZones_;
+
+  // Everything the pwm calculation of a stateless sensor depends on
+  struct PwmInputs {
+    float sensorRead;
+    float previousSensorRead;
+    float targetPwm;
+    bool deadFanExists;
+    bool operator==(const PwmInputs& other) const {
+      return sensorRead == other.sensorRead &&
+          previousSensorRead == other.previousSensorRead &&
+          targetPwm == other.targetPwm && deadFanExists == other.deadFanExists;
+    }
+  };
+  // Inputs of the last pwm calculation of each stateless sensor
+  std::unordered_map<const Sensor*, PwmInputs> lastPwmInputs_;
+  // Pwm of the sensors updated since the last control pass, calculated by
+  // updateControlForSensors ahead of it
+  std::unordered_map<const Sensor*, float> previewPwm_;
 
   // Private Methods
+  void buildIndex();
   void getSensorUpdate();
+  bool readSensor(Sensor* sensorItem);
+  void processSensorUpdate(Sensor* sensorItem);
+  PwmInputs getPwmInputs(const Sensor& sensorItem) const;
+  float previewTargetPwm(Sensor* sensorItem);
   void getFanUpdate();
   void getOpticsUpdate();
-  void programFan(Zone* zone, float pwmSoFar);
+  void processOpticUpdate(Optic* optic);
+  void programFan(const ZoneIndex& zoneIndex, float pwmSoFar);
   void adjustZoneFans(bool boostMode);
+  void adjustZone(const ZoneIndex& zoneIndex, bool boostMode);
   void updateTargetPwm(Sensor* sensorItem);
+  static bool isStatefulSensor(const Sensor& sensorItem);
   void setFanFailState(Fan* fan, bool fanFailed);
   bool checkIfFanPresent(Fan* fan);
-  Sensor* findSensorConfig(std::string sensorName);
+  Sensor* findSensorConfig(const std::string& sensorName);
 };
 } // namespace facebook::fboss::platform
@@ -8,6 +8,12 @@
 // Additional FB helper funtion
 #include "common/time/Time.h"
 
+DEFINE_bool(
+    event_driven_control,
+    false,
+    "Recompute the affected zones as soon as a sensor fetch brings new "
+    "readings, instead of waiting for the next control period");
+
 namespace facebook::fboss::platform {
 FanService::FanService() {
   lastControlExecutionTimeSec_ = 0;
@@ -78,6 +84,18 @@ void FanService::kickstart() {
 
   // Start control logic, and attach bsp and sensors
   pControlLogic_ = std::make_shared<ControlLogic>(pConfig_, pBsp_);
+  pControlLogic_->setEventDriven(FLAGS_event_driven_control);
+}
+
+void FanService::processSensorUpdates(bool controlDue) {
+  // If the full control pass runs now anyway, it picks up the updates
+  if (!FLAGS_event_driven_control || controlDue) {
+    return;
+  }
+  auto updatedEntries = pSensorData_->takeUpdatedEntries();
+  if (!updatedEntries.empty()) {
+    pControlLogic_->updateControlForSensors(pSensorData_, updatedEntries);
+  }
 }
 
 int FanService::controlFan(/*folly::EventBase* evb*/) {
@@ -127,9 +145,14 @@ int FanService::controlFan(/*folly::EventBase* evb*/) {
       lastSensorFetchTimeSec_ = currentTimeSec;
     }
   }
+  bool controlDue = (currentTimeSec - lastControlExecutionTimeSec_) >=
+      pConfig_->getControlFrequency();
+  // In event driven mode, react to the new readings right away
+  if (hasSensorDataUpdate) {
+    processSensorUpdates(controlDue);
+  }
   // Change Fan PWM as needed according to control execution frequency
-  if ((currentTimeSec - lastControlExecutionTimeSec_) >=
-      pConfig_->getControlFrequency()) {
+  if (controlDue) {
     lastControlExecutionTimeSec_ = currentTimeSec;
     pControlLogic_->updateControl(pSensorData_);
   }
@@ -185,6 +208,9 @@ int FanService::runMock(std::string mockInputFile, std::string mockOutputFile) {
       XLOG(INFO) << "Time to read sensor data";
       pBsp_->getSensorData(pConfig_, pSensorData_);
       XLOG(INFO) << "Done reading sensor data";
+      processSensorUpdates(
+          (currentTimeSec - lastControlExecutionTimeSec_) >=
+          pConfig_->getControlFrequency());
     }
     // Update fan as needed
     if ((currentTimeSec - lastControlExecutionTimeSec_) >=
@@ -9,6 +9,8 @@
 #include "SensorData.h"
 #include "ServiceConfig.h"
 
+DECLARE_bool(event_driven_control);
+
 namespace folly {
 class EventBase;
 }
@@ -70,5 +72,8 @@ class FanService {
   std::shared_ptr<Bsp> BspFactory();
   // Main Loop for standalone execution
   int mainLoop();
+  // In event driven mode, pass the freshly changed readings to the control
+  // logic, unless the full control pass is due at the same time.
+  void processSensorUpdates(bool controlDue);
 };
 } // namespace facebook::fboss::platform
@@ -248,6 +248,7 @@ void Mokujin::getOpticsData(
       opticData->lastOpticsUpdateTimeInSec = getCurrentTime();
       opticData->dataProcessTimeStamp = 0;
       opticData->calculatedPwm = 0;
+      pSensorData->markEntryUpdated(opticGroup->opticName);
     }
   }
   return;
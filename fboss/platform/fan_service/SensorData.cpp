@@ -15,6 +15,16 @@ uint64_t SensorData::getLastQsfpSvcTime() {
   return lastSuccessfulQsfpServiceContact_;
 }
 
+void SensorData::markEntryUpdated(const std::string& name) {
+  updatedEntries_.insert(name);
+}
+
+std::unordered_set<std::string> SensorData::takeUpdatedEntries() {
+  std::unordered_set<std::string> updated;
+  updated.swap(updatedEntries_);
+  return updated;
+}
+
 SensorEntry* SensorData::getOrCreateSensorEntry(const std::string& name) {
   bool entryExist = checkIfEntryExists(name);
   SensorEntry* pEntry;
@@ -39,7 +49,13 @@ void SensorData::updateEntryInt(
     const std::string& name,
     int data,
     uint64_t timeStamp) {
+  bool entryExist = checkIfEntryExists(name);
   auto pEntry = getOrCreateSensorEntry(name);
+  if (!entryExist ||
+      pEntry->sensorEntryType != SensorEntryType::kSensorEntryInt ||
+      std::get<int>(pEntry->value) != data) {
+    updatedEntries_.insert(name);
+  }
   pEntry->timeStampSec = timeStamp;
   // pEntry->odsTime=facebook::WallClockUtil::NowInSecFast();
   pEntry->sensorEntryType = SensorEntryType::kSensorEntryInt;
@@ -49,7 +65,13 @@ void SensorData::updateEntryFloat(
     const std::string& name,
     float data,
     uint64_t timeStamp) {
+  bool entryExist = checkIfEntryExists(name);
   auto pEntry = getOrCreateSensorEntry(name);
+  if (!entryExist ||
+      pEntry->sensorEntryType != SensorEntryType::kSensorEntryFloat ||
+      std::get<float>(pEntry->value) != data) {
+    updatedEntries_.insert(name);
+  }
   pEntry->timeStampSec = timeStamp;
   pEntry->sensorEntryType = SensorEntryType::kSensorEntryFloat;
   pEntry->value = data;
@@ -7,6 +7,7 @@
 #pragma once
 // Standard C++ routines
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 // We reuse the same facebook::fboss::FbossError
 // , for consistency
@@ -78,12 +79,19 @@ class SensorData {
   }
   void setLastQsfpSvcTime(uint64_t t);
   uint64_t getLastQsfpSvcTime();
+  // Names of the sensor / optic entries whose value changed since the
+  // last call. Used by the event driven control loop to only recompute
+  // the sensors (and zones) that actually got new readings.
+  // Optic entries are filled in place, so the writer marks them explicitly.
+  void markEntryUpdated(const std::string& name);
+  std::unordered_set<std::string> takeUpdatedEntries();
 
  private:
   std::unordered_map<std::string, SensorEntry> sensorEntry_;
   std::unordered_map<std::string, OpticEntry> opticEntry_;
   const SensorEntry* getSensorEntry(const std::string& name) const;
   SensorEntry* getOrCreateSensorEntry(const std::string& name);
+  std::unordered_set<std::string> updatedEntries_;
   uint64_t lastSuccessfulQsfpServiceContact_;
 };
 
@@ -0,0 +1,265 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/platform/fan_service/ControlLogic.h"
+#include "fboss/platform/fan_service/Mokujin.h"
+#include "fboss/platform/fan_service/ServiceConfig.h"
+#include "fboss/platform/fan_service/if/gen-cpp2/fan_config_structs_types.h"
+
+#include <gtest/gtest.h>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace facebook::fboss::platform;
+
+namespace {
+
+constexpr uint64_t kFetchIntervalSec = 5;
+constexpr uint64_t kControlIntervalSec = 30;
+constexpr uint64_t kReplayEndSec = 170;
+
+struct TraceEvent {
+  uint64_t timeSec;
+  std::string sensorName;
+  float value;
+};
+
+// A recorded sensor trace. sensor_a holds 35 over two control periods, so
+// that the second one moves it from the "up" to the "down" table.
+const std::vector<TraceEvent> kTrace = {
+    {0, "sensor_a", 25},
+    {0, "sensor_b", 25},
+    {12, "sensor_a", 35},
+    {72, "sensor_a", 45},
+    {95, "sensor_a", 28},
+    {130, "sensor_b", 32},
+};
+
+// Fan pwm observed at each fetch tick : <time, pwm>
+using PwmTrace = std::vector<std::pair<uint64_t, int>>;
+
+} // namespace
+
+class ControlLogicReplayTest : public ::testing::Test {
+ protected:
+  static std::shared_ptr<ServiceConfig> makeServiceConfig() {
+    auto config = std::make_shared<ServiceConfig>();
+    for (const std::string suffix : {"a", "b"}) {
+      Sensor sensor;
+      sensor.sensorName = "sensor_" + suffix;
+      sensor.calculationType =
+          fan_config_structs::SensorPwmCalcType::kSensorPwmCalcFourLinearTable;
+      sensor.fourCurves.normalUp = {{20, 30}, {30, 50}, {40, 70}};
+      sensor.fourCurves.normalDown = {{20, 30}, {30, 40}, {40, 60}};
+      sensor.fourCurves.failUp = sensor.fourCurves.normalUp;
+      sensor.fourCurves.failDown = sensor.fourCurves.normalDown;
+      sensor.alarm.high_major = 100;
+      sensor.alarm.high_minor = 100;
+      config->sensors.push_back(sensor);
+
+      Fan fan;
+      fan.fanName = "fan_" + suffix;
+      fan.pwm.accessType() = fan_config_structs::SourceType::kSrcSysfs;
+      fan.pwm.path() = "fan_" + suffix + "_pwm";
+      fan.rpmAccess.accessType() = fan_config_structs::SourceType::kSrcSysfs;
+      fan.rpmAccess.path() = "fan_" + suffix + "_rpm";
+      config->fans.push_back(fan);
+
+      Zone zone;
+      zone.type = fan_config_structs::ZoneType::kZoneMax;
+      zone.zoneName = "zone_" + suffix;
+      zone.sensorNames = {sensor.sensorName};
+      zone.fanNames = {fan.fanName};
+      config->zones.push_back(zone);
+    }
+    return config;
+  }
+
+  // Same, with sensor_a controlled by an incremental PID
+  static std::shared_ptr<ServiceConfig> makePidServiceConfig() {
+    auto config = makeServiceConfig();
+    auto& sensor = config->sensors[0];
+    sensor.calculationType =
+        fan_config_structs::SensorPwmCalcType::kSensorPwmCalcIncrementPid;
+    sensor.incrementPid.setPoint = 40;
+    sensor.incrementPid.kp = 0;
+    sensor.incrementPid.ki = 1;
+    sensor.incrementPid.kd = 0;
+    sensor.incrementPid.updateMinMaxVal();
+    return config;
+  }
+
+  // Replays the trace, fetching sensors every kFetchIntervalSec and running
+  // the full control pass every kControlIntervalSec, the same way FanService
+  // does. onTick is called after each fetch tick.
+  static std::map<std::string, PwmTrace> replay(
+      bool eventDriven,
+      std::shared_ptr<ServiceConfig> config = makeServiceConfig(),
+      const std::vector<TraceEvent>& trace = kTrace,
+      const std::function<void(uint64_t, const Bsp&)>& onTick = nullptr) {
+    auto mokujin = std::make_shared<Mokujin>();
+    auto sensorData = std::make_shared<SensorData>();
+    sensorData->setLastQsfpSvcTime(0);
+    ControlLogic controlLogic(config, mokujin);
+    controlLogic.setEventDriven(eventDriven);
+    for (const auto& fan : config->fans) {
+      mokujin->updateSimulationData(*fan.rpmAccess.path(), 5000);
+    }
+
+    std::map<std::string, PwmTrace> pwms;
+    auto event = trace.begin();
+    for (uint64_t now = 0; now <= kReplayEndSec; now += kFetchIntervalSec) {
+      mokujin->setTimeStamp(now);
+      for (; event != trace.end() && event->timeSec <= now; ++event) {
+        mokujin->updateSimulationData(event->sensorName, event->value);
+      }
+      mokujin->getSensorData(config, sensorData);
+      bool controlDue = (now % kControlIntervalSec) == 0;
+      if (eventDriven && !controlDue) {
+        auto updatedEntries = sensorData->takeUpdatedEntries();
+        if (!updatedEntries.empty()) {
+          controlLogic.updateControlForSensors(sensorData, updatedEntries);
+        }
+      }
+      if (controlDue) {
+        controlLogic.updateControl(sensorData);
+      }
+      for (const auto& fan : config->fans) {
+        pwms[fan.fanName].emplace_back(
+            now, static_cast<int>(mokujin->readSysfs(*fan.pwm.path())));
+      }
+      if (onTick) {
+        onTick(now, *mokujin);
+      }
+    }
+    return pwms;
+  }
+
+  // Collapse the per tick trace into <time of change, new pwm>
+  static PwmTrace changes(const PwmTrace& trace) {
+    PwmTrace result;
+    for (const auto& [time, pwm] : trace) {
+      if (result.empty() || result.back().second != pwm) {
+        result.emplace_back(time, pwm);
+      }
+    }
+    return result;
+  }
+};
+
+TEST_F(ControlLogicReplayTest, EventDrivenMatchesPolling) {
+  auto polling = replay(false);
+  auto eventDriven = replay(true);
+
+  for (const auto& fanName : {"fan_a", "fan_b"}) {
+    auto pollingChanges = changes(polling[fanName]);
+    auto eventChanges = changes(eventDriven[fanName]);
+    ASSERT_EQ(pollingChanges.size(), eventChanges.size()) << fanName;
+    for (size_t i = 0; i < pollingChanges.size(); i++) {
+      // Same sequence of fan speeds ...
+      EXPECT_EQ(pollingChanges[i].second, eventChanges[i].second) << fanName;
+      // ... but never applied later than the polling loop would
+      EXPECT_LE(eventChanges[i].first, pollingChanges[i].first) << fanName;
+    }
+  }
+}
+
+TEST_F(ControlLogicReplayTest, EventDrivenReactsWithinFetchInterval) {
+  auto eventDriven = replay(true);
+  auto fanA = changes(eventDriven["fan_a"]);
+  // 25 -> 35 at t=12 is seen by the fetch at t=15, long before the next
+  // control period at t=30.
+  ASSERT_GE(fanA.size(), 2u);
+  EXPECT_EQ(fanA[1].first, 15u);
+  // 255 * 50%
+  EXPECT_EQ(fanA[1].second, 127);
+  // The steady reading moves to the "down" table at the next control period
+  // but one, as in polling mode. 255 * 40%
+  ASSERT_GE(fanA.size(), 3u);
+  EXPECT_EQ(fanA[2].first, 60u);
+  EXPECT_EQ(fanA[2].second, 102);
+
+  // Zone B has no sensor change until t=130, so its fan keeps the
+  // initial speed until the fetch right after that.
+  auto fanB = changes(eventDriven["fan_b"]);
+  ASSERT_EQ(fanB.size(), 2u);
+  EXPECT_EQ(fanB[1].first, 130u);
+}
+
+TEST_F(ControlLogicReplayTest, EventDrivenPidIntegratesSteadyReading) {
+  // sensor_a stays 10 degrees above the set point, so every control period
+  // adds ki * 10 percent, whether or not the reading changed.
+  const std::vector<TraceEvent> steadyTrace = {
+      {0, "sensor_a", 50},
+      {0, "sensor_b", 25},
+  };
+  auto polling = replay(false, makePidServiceConfig(), steadyTrace);
+  auto eventDriven = replay(true, makePidServiceConfig(), steadyTrace);
+  EXPECT_EQ(changes(polling["fan_a"]), changes(eventDriven["fan_a"]));
+
+  std::vector<int> controlPwms;
+  for (const auto& [time, pwm] : eventDriven["fan_a"]) {
+    if (time % kControlIntervalSec == 0) {
+      controlPwms.push_back(pwm);
+    }
+  }
+  ASSERT_EQ(controlPwms.size(), kReplayEndSec / kControlIntervalSec + 1);
+  for (size_t i = 1; i < controlPwms.size(); i++) {
+    EXPECT_GT(controlPwms[i], controlPwms[i - 1]) << "control period " << i;
+  }
+}
+
+TEST_F(ControlLogicReplayTest, EventDrivenAlarmsOnSteadyReading) {
+  // sensor_a goes out of range and above the minor alarm at t=40, and stays
+  // there. Both count control periods, not readings.
+  auto makeConfig = [] {
+    auto config = makeServiceConfig();
+    auto& sensor = config->sensors[0];
+    sensor.alarm.high_minor = 50;
+    sensor.alarm.high_minor_soak = 2 * kControlIntervalSec;
+    sensor.rangeCheck.enabled = true;
+    sensor.rangeCheck.rangeLow = 0;
+    sensor.rangeCheck.rangeHigh = 60;
+    sensor.rangeCheck.tolerance = 3;
+    sensor.rangeCheck.action = kRangeCheckActionShutdown;
+    return config;
+  };
+  const std::vector<TraceEvent> steadyTrace = {
+      {0, "sensor_a", 25},
+      {0, "sensor_b", 25},
+      {40, "sensor_a", 70},
+  };
+
+  for (bool eventDriven : {false, true}) {
+    auto config = makeConfig();
+    std::optional<uint64_t> shutdownAt, minorAlarmAt;
+    replay(
+        eventDriven, config, steadyTrace, [&](uint64_t now, const Bsp& bsp) {
+          if (!shutdownAt && bsp.getEmergencyState()) {
+            shutdownAt = now;
+          }
+          if (!minorAlarmAt &&
+              config->sensors[0].processedData.minorAlarmTriggered) {
+            minorAlarmAt = now;
+          }
+        });
+    // Out of range at the control periods at t=60, 90 and 120
+    ASSERT_TRUE(shutdownAt) << "event driven " << eventDriven;
+    EXPECT_EQ(*shutdownAt, 120u) << "event driven " << eventDriven;
+    EXPECT_EQ(config->sensors[0].rangeCheck.invalidCount, 4)
+        << "event driven " << eventDriven;
+    // Soaking from the control period at t=60
+    ASSERT_TRUE(minorAlarmAt) << "event driven " << eventDriven;
+    EXPECT_EQ(*minorAlarmAt, 120u) << "event driven " << eventDriven;
+  }
+}
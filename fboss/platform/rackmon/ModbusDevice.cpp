@@ -190,10 +190,41 @@ void ModbusDevice::setActive() {
   info_.mode = ModbusDeviceMode::ACTIVE;
 }
 
-ModbusDeviceRawData ModbusDevice::getRawData() {
+bool ModbusDeviceFilter::contains(const ModbusDeviceInfo& info) const {
+  if (addrFilter && addrFilter->find(info.deviceAddress) == addrFilter->end()) {
+    return false;
+  }
+  if (typeFilter && typeFilter->find(info.deviceType) == typeFilter->end()) {
+    return false;
+  }
+  return true;
+}
+
+bool ModbusRegisterFilter::contains(const RegisterStore& reg) const {
+  if (addrFilter && addrFilter->find(reg.regAddr()) == addrFilter->end()) {
+    return false;
+  }
+  if (nameFilter && nameFilter->find(reg.name()) == nameFilter->end()) {
+    return false;
+  }
+  return true;
+}
+
+ModbusDeviceRawData ModbusDevice::getRawData(
+    const ModbusRegisterFilter& filter) {
   std::unique_lock lk(registerListMutex_);
-  // Makes a deep copy.
-  return info_;
+  if (!filter) {
+    // Makes a deep copy.
+    return info_;
+  }
+  ModbusDeviceRawData data;
+  data.ModbusDeviceInfo::operator=(info_);
+  for (const auto& reg : info_.registerList) {
+    if (filter.contains(reg)) {
+      data.registerList.emplace_back(reg);
+    }
+  }
+  return data;
 }
 
 ModbusDeviceInfo ModbusDevice::getInfo() {
@@ -201,12 +232,16 @@ ModbusDeviceInfo ModbusDevice::getInfo() {
   return info_;
 }
 
-ModbusDeviceValueData ModbusDevice::getValueData() {
+ModbusDeviceValueData ModbusDevice::getValueData(
+    const ModbusRegisterFilter& filter,
+    bool latestValueOnly) {
   std::unique_lock lk(registerListMutex_);
   ModbusDeviceValueData data;
   data.ModbusDeviceInfo::operator=(info_);
   for (const auto& reg : info_.registerList) {
-    data.registerList.emplace_back(reg);
+    if (filter.contains(reg)) {
+      data.registerList.emplace_back(reg.getValue(latestValueOnly));
+    }
   }
   return data;
 }
@@ -3,6 +3,8 @@
 #include <nlohmann/json.hpp>
 #include <ctime>
 #include <iostream>
+#include <optional>
+#include <set>
 #include "Modbus.h"
 #include "ModbusCmds.h"
 #include "Register.h"
@@ -73,6 +75,27 @@ struct ModbusDeviceValueData : public ModbusDeviceInfo {
 };
 void to_json(nlohmann::json& j, const ModbusDeviceValueData& m);
 
+// Selects which devices to return monitored data for. Unset
+// fields match everything.
+struct ModbusDeviceFilter {
+  std::optional<std::set<uint8_t>> addrFilter{};
+  std::optional<std::set<std::string>> typeFilter{};
+
+  bool contains(const ModbusDeviceInfo& info) const;
+};
+
+// Selects which registers to return monitored data for. Unset
+// fields match everything.
+struct ModbusRegisterFilter {
+  std::optional<std::set<uint16_t>> addrFilter{};
+  std::optional<std::set<std::string>> nameFilter{};
+
+  bool contains(const RegisterStore& reg) const;
+  explicit operator bool() const {
+    return addrFilter || nameFilter;
+  }
+};
+
 class ModbusDevice {
   Modbus& interface_;
   int numCommandRetries_;
@@ -131,10 +154,14 @@ class ModbusDevice {
   ModbusDeviceInfo getInfo();
 
   // Returns raw monitor register data monitored for this device.
-  ModbusDeviceRawData getRawData();
+  ModbusDeviceRawData getRawData(const ModbusRegisterFilter& filter = {});
 
   // Returns value formatted register data monitored for this device.
-  ModbusDeviceValueData getValueData();
+  // Only registers matching the filter are interpreted, and if
+  // latestValueOnly is set, only their most recent reading.
+  ModbusDeviceValueData getValueData(
+      const ModbusRegisterFilter& filter = {},
+      bool latestValueOnly = false);
 };
 
 } // namespace rackmon
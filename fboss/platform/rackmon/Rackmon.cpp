@@ -303,22 +303,31 @@ std::vector<ModbusDeviceInfo> Rackmon::listDevices() const {
   return devices;
 }
 
-void Rackmon::getRawData(std::vector<ModbusDeviceRawData>& data) const {
+void Rackmon::getRawData(
+    std::vector<ModbusDeviceRawData>& data,
+    const ModbusDeviceFilter& devFilter,
+    const ModbusRegisterFilter& regFilter) const {
   data.clear();
   std::shared_lock lock(devicesMutex_);
-  std::transform(
-      devices_.begin(), devices_.end(), std::back_inserter(data), [](auto& kv) {
-        return kv.second->getRawData();
-      });
+  for (const auto& [addr, dev] : devices_) {
+    if (devFilter.contains(dev->getInfo())) {
+      data.emplace_back(dev->getRawData(regFilter));
+    }
+  }
 }
 
-void Rackmon::getValueData(std::vector<ModbusDeviceValueData>& data) const {
+void Rackmon::getValueData(
+    std::vector<ModbusDeviceValueData>& data,
+    const ModbusDeviceFilter& devFilter,
+    const ModbusRegisterFilter& regFilter,
+    bool latestValueOnly) const {
   data.clear();
   std::shared_lock lock(devicesMutex_);
-  std::transform(
-      devices_.begin(), devices_.end(), std::back_inserter(data), [](auto& kv) {
-        return kv.second->getValueData();
-      });
+  for (const auto& [addr, dev] : devices_) {
+    if (devFilter.contains(dev->getInfo())) {
+      data.emplace_back(dev->getValueData(regFilter, latestValueOnly));
+    }
+  }
 }
 
 std::string Rackmon::getProfileData() {
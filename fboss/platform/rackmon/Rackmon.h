@@ -155,10 +155,17 @@ class Rackmon {
   std::vector<ModbusDeviceInfo> listDevices() const;
 
   // Get monitored data
-  void getRawData(std::vector<ModbusDeviceRawData>& data) const;
+  void getRawData(
+      std::vector<ModbusDeviceRawData>& data,
+      const ModbusDeviceFilter& devFilter = {},
+      const ModbusRegisterFilter& regFilter = {}) const;
 
   // Get value data
-  void getValueData(std::vector<ModbusDeviceValueData>& data) const;
+  void getValueData(
+      std::vector<ModbusDeviceValueData>& data,
+      const ModbusDeviceFilter& devFilter = {},
+      const ModbusRegisterFilter& regFilter = {},
+      bool latestValueOnly = false) const;
 
   // Get profile data
   std::string getProfileData();
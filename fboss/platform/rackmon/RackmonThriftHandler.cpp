@@ -119,6 +119,32 @@ void ThriftHandler::getMonitorData(std::vector<RackmonMonitorData>& data) {
   }
 }
 
+void ThriftHandler::getMonitorDataEx(
+    std::vector<RackmonMonitorData>& data,
+    std::unique_ptr<MonitorDataFilter> filter) {
+  rackmon::ModbusDeviceFilter devFilter{};
+  rackmon::ModbusRegisterFilter regFilter{};
+  // Addresses convert like devAddress and regAddress of the other requests
+  if (const auto* devAddrs = filter->get_deviceFilter()) {
+    auto& addrs = devFilter.addrFilter.emplace();
+    for (int16_t devAddress : *devAddrs) {
+      addrs.insert(static_cast<uint8_t>(devAddress));
+    }
+  }
+  if (const auto* regAddrs = filter->get_registerFilter()) {
+    auto& addrs = regFilter.addrFilter.emplace();
+    for (int32_t regAddress : *regAddrs) {
+      addrs.insert(static_cast<uint16_t>(regAddress));
+    }
+  }
+  std::vector<rackmon::ModbusDeviceValueData> indata;
+  rackmond_.getValueData(
+      indata, devFilter, regFilter, filter->get_latestValueOnly());
+  for (auto& dev : indata) {
+    data.emplace_back(transformModbusDeviceValueData(dev));
+  }
+}
+
 void ThriftHandler::readHoldingRegisters(
     ReadWordRegistersResponse& response,
     std::unique_ptr<ReadWordRegistersRequest> request) {
@@ -187,11 +187,42 @@ Register::operator RegisterValue() const {
   return RegisterValue(value, desc, timestamp);
 }
 
-RegisterStore::operator RegisterStoreValue() const {
+void RegisterStore::load(int32_t slot, Register& reg) const {
+  auto begin = values_.begin() + size_t(slot) * desc_.length;
+  std::copy(begin, begin + desc_.length, reg.value.begin());
+  reg.timestamp = timestamps_[slot];
+}
+
+RegisterValue RegisterStore::decode(int32_t slot) const {
+  auto begin = values_.begin() + size_t(slot) * desc_.length;
+  std::vector<uint16_t> value(begin, begin + desc_.length);
+  return RegisterValue(value, desc_, timestamps_[slot]);
+}
+
+void RegisterStore::operator++() {
+  std::copy(
+      front_.value.begin(),
+      front_.value.end(),
+      values_.begin() + size_t(idx_) * desc_.length);
+  timestamps_[idx_] = front_.timestamp;
+  back_.value = front_.value;
+  back_.timestamp = front_.timestamp;
+  idx_ = (idx_ + 1) % timestamps_.size();
+  load(idx_, front_);
+}
+
+RegisterStoreValue RegisterStore::getValue(bool latestValueOnly) const {
   RegisterStoreValue ret(regAddr_, desc_.name);
-  for (const auto& reg : history_) {
-    if (reg) {
-      ret.history.emplace_back(reg);
+  if (latestValueOnly) {
+    int32_t last = idx_ == 0 ? timestamps_.size() - 1 : idx_ - 1;
+    if (isValid(last)) {
+      ret.history.emplace_back(decode(last));
+    }
+    return ret;
+  }
+  for (int32_t slot = 0; slot < int32_t(timestamps_.size()); slot++) {
+    if (isValid(slot)) {
+      ret.history.emplace_back(decode(slot));
     }
   }
   return ret;
@@ -324,7 +355,16 @@ void to_json(json& j, const RegisterStoreValue& m) {
 
 void to_json(json& j, const RegisterStore& m) {
   j["begin"] = m.regAddr_;
-  j["readings"] = m.history_;
+  j["readings"] = json::array();
+  for (size_t slot = 0; slot < m.timestamps_.size(); slot++) {
+    std::stringstream ss;
+    for (size_t i = 0; i < m.desc_.length; i++) {
+      ss << std::hex << std::setw(4) << std::setfill('0')
+         << m.values_[slot * m.desc_.length + i];
+    }
+    j["readings"].push_back(
+        {{"time", m.timestamps_[slot]}, {"data", ss.str()}});
+  }
 }
 
 void from_json(const json& j, WriteActionInfo& action) {
@@ -149,18 +149,36 @@ struct RegisterStore {
   const RegisterDescriptor& desc_;
   // Address of the register.
   uint16_t regAddr_;
-  // History of the register contents to keep. This is utilized as
-  // a circular buffer with idx pointing to the current slot to
-  // write.
-  std::vector<Register> history_;
+  // History of the register contents to keep. The raw words of all
+  // the slots are stored back to back (slot i starts at i * desc.length)
+  // with a parallel array of timestamps. This is utilized as a
+  // circular buffer with idx pointing to the current slot to write.
+  std::vector<uint16_t> values_;
+  std::vector<uint32_t> timestamps_;
   int32_t idx_ = 0;
   bool enabled_ = true;
+  // Staging copies of the next slot to write and the last written
+  // slot. Readers fill front() in place and commit it with operator++.
+  Register front_;
+  Register back_;
+
+  // Copies the contents of the given slot into the register.
+  void load(int32_t slot, Register& reg) const;
+  // Returns true if the given slot holds a valid reading.
+  bool isValid(int32_t slot) const {
+    return timestamps_[slot] != 0;
+  }
+  // Interprets the contents of the given slot.
+  RegisterValue decode(int32_t slot) const;
 
  public:
   explicit RegisterStore(const RegisterDescriptor& desc)
       : desc_(desc),
         regAddr_(desc.begin),
-        history_(desc.keep, Register(desc)) {}
+        values_(size_t(desc.keep) * desc.length),
+        timestamps_(desc.keep),
+        front_(desc),
+        back_(desc) {}
 
   bool isEnabled() {
     return enabled_;
@@ -174,16 +192,14 @@ struct RegisterStore {
 
   // Returns a reference to the last written value (Back of the list)
   Register& back() {
-    return idx_ == 0 ? history_.back() : history_[idx_ - 1];
+    return back_;
   }
   // Returns the front (Next to write) reference
   Register& front() {
-    return history_[idx_];
-  }
-  // Advances the front.
-  void operator++() {
-    idx_ = (idx_ + 1) % history_.size();
+    return front_;
   }
+  // Commits the front to the history and advances it.
+  void operator++();
 
   // register address accessor
   uint16_t regAddr() const {
@@ -197,8 +213,13 @@ struct RegisterStore {
   // Returns a string formatted representation of the historical record.
   operator std::string() const;
 
-  // Returns the historical record of the values
-  operator RegisterStoreValue() const;
+  // Returns the historical record of the values. Values are only
+  // interpreted here, so if latestValueOnly is set, just the most
+  // recent valid reading is decoded.
+  RegisterStoreValue getValue(bool latestValueOnly = false) const;
+  operator RegisterStoreValue() const {
+    return getValue();
+  }
 
   // Add the JSON conversion methods as friends.
   friend void to_json(nlohmann::json& j, const RegisterStore& m);
@@ -139,6 +139,17 @@ struct RackmonMonitorData {
   2: list<ModbusRegisterStore> regList;
 }
 
+/*
+ * Selects a subset of the monitored data. Unset filters match everything.
+ * Addresses have the types of ModbusDeviceInfo.devAddress and
+ * ModbusRegisterStore.regAddress.
+ */
+struct MonitorDataFilter {
+  1: optional set<i16> deviceFilter;
+  2: optional set<i32> registerFilter;
+  3: bool latestValueOnly = false;
+}
+
 enum RackmonControlRequest {
   /* Pause rackmond core loop. */
   PAUSE_RACKMOND = 0,
@@ -201,6 +212,14 @@ service RackmonCtrl {
     1: fboss.FbossBaseError error,
   );
 
+  /*
+   * Get the pre-fetched register values of the Modbus devices and
+   * registers selected by the filter.
+   */
+  list<RackmonMonitorData> getMonitorDataEx(
+    1: MonitorDataFilter filter,
+  ) throws (1: fboss.FbossBaseError error);
+
   /*
    * Send commands to control rackmond's behavior, such as pause/resume
    * rackmond's core loop.
@@ -3,6 +3,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <thread>
+#include <type_traits>
 
 using namespace std;
 using namespace testing;
@@ -504,6 +505,53 @@ TEST_F(ModbusDeviceTest, MonitorRawData) {
   EXPECT_EQ(data3["ranges"][0]["readings"][1]["data"], "62636465");
 }
 
+TEST_F(ModbusDeviceTest, MonitorDataFilter) {
+  EXPECT_CALL(
+      get_modbus(),
+      command(
+          encodeMsgContentEqual(0x320300000002_EM),
+          _,
+          19200,
+          ModbusTime::zero(),
+          ModbusTime::zero()))
+      .Times(2)
+      .WillOnce(SetMsgDecode<1>(0x32030461626364_EM))
+      .WillOnce(SetMsgDecode<1>(0x32030462636465_EM));
+
+  ModbusDevice dev(get_modbus(), 0x32, get_regmap());
+  dev.monitor();
+  dev.monitor();
+
+  ModbusRegisterFilter filter{};
+  filter.addrFilter = std::set<uint16_t>{0x10};
+  ModbusDeviceValueData data = dev.getValueData(filter);
+  EXPECT_EQ(data.deviceAddress, 0x32);
+  EXPECT_EQ(data.registerList.size(), 0);
+  ModbusDeviceRawData rawData = dev.getRawData(filter);
+  EXPECT_EQ(rawData.registerList.size(), 0);
+
+  filter.addrFilter = std::set<uint16_t>{0};
+  data = dev.getValueData(filter);
+  EXPECT_EQ(data.registerList.size(), 1);
+  EXPECT_EQ(data.registerList[0].history.size(), 2);
+  rawData = dev.getRawData(filter);
+  EXPECT_EQ(rawData.registerList.size(), 1);
+
+  data = dev.getValueData(filter, true);
+  EXPECT_EQ(data.registerList.size(), 1);
+  EXPECT_EQ(data.registerList[0].history.size(), 1);
+  EXPECT_EQ(data.registerList[0].history[0].value.strValue, "bcde");
+
+  // Only tests whether the filter is set, it is no integer
+  static_assert(!std::is_convertible_v<ModbusRegisterFilter, bool>);
+  EXPECT_TRUE(filter);
+  ModbusRegisterFilter nameFilter{};
+  EXPECT_FALSE(nameFilter);
+  nameFilter.nameFilter = std::set<std::string>{"MFG_MODEL"};
+  data = dev.getValueData(nameFilter, true);
+  EXPECT_EQ(data.registerList.size(), 1);
+}
+
 class MockModbusDevice : public ModbusDevice {
  public:
   MockModbusDevice(Modbus& m, uint8_t addr, const RegisterMap& rmap)
@@ -178,3 +178,72 @@ TEST(RegisterStoreTest, DataRetrievalConversions) {
   EXPECT_EQ(std::string(j2["readings"][0]["data"]), "30313233");
   EXPECT_EQ(std::string(j2["readings"][1]["data"]), "31323334");
 }
+
+TEST(RegisterStoreTest, LatestValueOnly) {
+  RegisterDescriptor desc{
+      0,
+      2,
+      "HELLO",
+      3,
+      false,
+      RegisterEndian::BIG,
+      RegisterValueType::STRING,
+      0};
+  RegisterStore reg(desc);
+
+  RegisterStoreValue val = reg.getValue(true);
+  EXPECT_EQ(val.history.size(), 0);
+
+  reg.front().value = {0x3031, 0x3233}; // "0123"
+  reg.front().timestamp = 0x1234;
+  ++reg;
+  reg.front().value = {0x3132, 0x3334}; // "1234"
+  reg.front().timestamp = 0x1235;
+  ++reg;
+  val = reg.getValue(true);
+  EXPECT_EQ(val.regAddr, 0);
+  EXPECT_EQ(val.name, "HELLO");
+  EXPECT_EQ(val.history.size(), 1);
+  EXPECT_EQ(val.history[0].value.strValue, "1234");
+  EXPECT_EQ(val.history[0].timestamp, 0x1235);
+
+  // Wrap around the circular buffer, latest should follow.
+  for (uint16_t i = 0; i < 3; i++) {
+    reg.front().value = {0x3030, uint16_t(0x3030 + i)};
+    reg.front().timestamp = 0x2000 + i;
+    ++reg;
+  }
+  val = reg.getValue(true);
+  EXPECT_EQ(val.history.size(), 1);
+  EXPECT_EQ(val.history[0].value.strValue, "0002");
+  EXPECT_EQ(val.history[0].timestamp, 0x2002);
+  EXPECT_EQ(reg.getValue().history.size(), 3);
+}
+
+TEST(RegisterStoreTest, FrontIsNotCommitted) {
+  RegisterDescriptor desc{
+      0,
+      1,
+      "HELLO",
+      2,
+      true,
+      RegisterEndian::BIG,
+      RegisterValueType::HEX,
+      0};
+  RegisterStore reg(desc);
+  reg.front().value = {0x1234};
+  reg.front().timestamp = 1;
+  ++reg;
+  EXPECT_EQ(reg.back().value, std::vector<uint16_t>({0x1234}));
+
+  // Modifying the front without advancing must not be visible.
+  reg.front().value = {0x5678};
+  reg.front().timestamp = 2;
+  RegisterStoreValue val = reg;
+  EXPECT_EQ(val.history.size(), 1);
+  EXPECT_EQ(val.history[0].value.hexValue, std::vector<uint8_t>({0x12, 0x34}));
+  nlohmann::json j = reg;
+  EXPECT_EQ(j["readings"].size(), 2);
+  EXPECT_EQ(std::string(j["readings"][0]["data"]), "1234");
+  EXPECT_EQ(std::string(j["readings"][1]["data"]), "0000");
+}
@@ -8,15 +8,29 @@
  *
  */
 #include "fboss/platform/sensor_service/SensorServiceImpl.h"
+#include <fb303/ServiceData.h>
+#include <fcntl.h>
 #include <folly/FileUtil.h>
+#include <folly/String.h>
 #include <folly/dynamic.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <folly/json.h>
 #include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <array>
+#include <chrono>
 #include <filesystem>
 #include "fboss/platform/helpers/Utils.h"
 #include "fboss/platform/sensor_service/GetSensorConfig.h"
 
+DEFINE_uint32(
+    sysfs_read_threads,
+    1,
+    "Number of threads used to read sysfs sensors in parallel, "
+    "1 reads them inline in the fetch thread");
+
 namespace {
 
 // The following are keys in sensor conf file
@@ -28,6 +42,11 @@ const std::string kSensorFieldName = "name";
 const std::string kMockLmsensorJasonData =
     "/etc/sensor_service/sensors_output.json";
 const std::string kLmsensorCommand = "sensors -j";
+
+// fb303 stat suffix for the per sensor sysfs read latency
+const std::string kReadLatencyUs = ".read_latency_us";
+// Large enough for any numeric sysfs attribute
+constexpr size_t kSysfsReadBufSize = 64;
 } // namespace
 namespace facebook::fboss::platform::sensor_service {
 using namespace facebook::fboss::platform::helpers;
@@ -80,6 +99,10 @@ void SensorServiceImpl::init() {
     }
   }
 
+  if (sensorSource_ == SensorSource::SYSFS) {
+    openSysfsSensors();
+  }
+
   for (auto& pair : *sensorTable_.sensorMapList()) {
     XLOG(INFO) << pair.first << ": ";
     for (auto& sensorPair : pair.second) {
@@ -179,20 +202,99 @@ void SensorServiceImpl::fetchSensorData() {
   }
 }
 
-void SensorServiceImpl::getSensorDataFromPath() {
-  auto dataTable = liveDataTable_.wlock();
+void SensorServiceImpl::openSysfsSensors() {
+  sysfsSensors_.clear();
+  for (const auto& [path, name] : sensorNameMap_) {
+    SysfsSensor sensor{name, path, folly::File()};
+    int fd = folly::openNoInt(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+      sensor.file = folly::File(fd, true /* ownsFd */);
+    } else {
+      XLOG(ERR) << "Can not open " << path << " for " << name
+                << ", will retry on next fetch";
+    }
+    sysfsSensors_.push_back(std::move(sensor));
+  }
 
+  if (FLAGS_sysfs_read_threads > 1) {
+    sysfsReadExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        FLAGS_sysfs_read_threads,
+        std::make_shared<folly::NamedThreadFactory>("SysfsSensorRead"));
+  }
+}
+
+std::optional<SensorLiveData> SensorServiceImpl::readSysfsSensor(
+    SysfsSensor& sensor,
+    int64_t timeStamp) {
+  if (!sensor.file) {
+    int fd = folly::openNoInt(sensor.path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      XLOG(DBG2) << "Can not open " << sensor.path << " for " << sensor.name;
+      return std::nullopt;
+    }
+    sensor.file = folly::File(fd, true /* ownsFd */);
+  }
+
+  std::array<char, kSysfsReadBufSize> buf;
+  auto start = std::chrono::steady_clock::now();
+  auto bytesRead =
+      folly::preadNoInt(sensor.file.fd(), buf.data(), buf.size(), 0);
+  auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  fb303::fbData->addStatValue(
+      sensor.name + kReadLatencyUs, latency.count(), fb303::AVG);
+
+  if (bytesRead <= 0) {
+    XLOG(ERR) << "Can not read data for " << sensor.name << " from "
+              << sensor.path;
+    // The device may have been rebound, reopen it on next fetch.
+    sensor.file.close();
+    return std::nullopt;
+  }
+  auto value = folly::tryTo<float>(
+      folly::trimWhitespace(folly::StringPiece(buf.data(), bytesRead)));
+  if (!value.hasValue()) {
+    XLOG(ERR) << "Invalid data for " << sensor.name << " from "
+              << sensor.path;
+    return std::nullopt;
+  }
+  XLOG(DBG4) << sensor.name << "(" << sensor.path << ")"
+             << " : " << *value << " read in " << latency.count() << "us";
+  return SensorLiveData{*value, timeStamp};
+}
+
+void SensorServiceImpl::getSensorDataFromPath() {
   auto now = helpers::nowInSecs();
-  for (const auto& [path, name] : sensorNameMap_) {
-    std::string sensorInput;
 
-    if (folly::readFile(path.c_str(), sensorInput)) {
-      (*dataTable)[name].value = folly::to<float>(sensorInput);
-      (*dataTable)[name].timeStamp = now;
-      XLOG(INFO) << name << "(" << path << ")"
-                 << " : " << (*dataTable)[name].value;
-    } else {
-      XLOG(INFO) << "Can not read data for " << name << " from " << path;
+  // Read all the sensors without holding the live data lock, so thrift
+  // readers are not blocked behind slow hwmon drivers.
+  std::vector<std::optional<SensorLiveData>> readings(sysfsSensors_.size());
+  auto readSensors = [this, &readings, now](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      readings[i] = readSysfsSensor(sysfsSensors_[i], now);
+    }
+  };
+  if (!sysfsReadExecutor_) {
+    readSensors(0, sysfsSensors_.size());
+  } else {
+    size_t numSensors = sysfsSensors_.size();
+    size_t batchSize = (numSensors + FLAGS_sysfs_read_threads - 1) /
+        FLAGS_sysfs_read_threads;
+    std::vector<folly::Future<folly::Unit>> batches;
+    for (size_t begin = 0; begin < numSensors; begin += batchSize) {
+      size_t end = std::min(begin + batchSize, numSensors);
+      batches.push_back(folly::via(
+          sysfsReadExecutor_.get(),
+          [&readSensors, begin, end]() { readSensors(begin, end); }));
+    }
+    folly::collectAll(std::move(batches)).get();
+  }
+
+  // Publish the sweep, the lock is only held to copy in the readings.
+  auto dataTable = liveDataTable_.wlock();
+  for (size_t i = 0; i < readings.size(); i++) {
+    if (readings[i].has_value()) {
+      (*dataTable)[sysfsSensors_[i].name] = *readings[i];
     }
   }
 }
@@ -10,12 +10,16 @@
 
 #pragma once
 
+#include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include "fboss/platform/sensor_service/if/gen-cpp2/sensor_config_types.h"
 #include "fboss/platform/sensor_service/if/gen-cpp2/sensor_service_types.h"
+#include "folly/File.h"
 #include "folly/Synchronized.h"
+#include "folly/executors/CPUThreadPoolExecutor.h"
 
 namespace facebook::fboss::platform::sensor_service {
 
@@ -41,6 +45,14 @@ struct SensorLiveData {
   int64_t timeStamp;
 };
 
+// A sysfs sensor attribute kept open across fetches. The value is
+// re-read with pread() at offset 0 on every fetch.
+struct SysfsSensor {
+  std::string name;
+  std::string path;
+  folly::File file;
+};
+
 class SensorServiceImpl {
  public:
   SensorServiceImpl() {
@@ -72,7 +84,17 @@ class SensorServiceImpl {
   folly::Synchronized<std::unordered_map<std::string, struct SensorLiveData>>
       liveDataTable_;
 
+  // Open sysfs sensor attributes, only populated for SYSFS source
+  std::vector<SysfsSensor> sysfsSensors_;
+
+  // Executor to read sysfs sensors in parallel, null if reads are inline
+  std::unique_ptr<folly::CPUThreadPoolExecutor> sysfsReadExecutor_;
+
   void init();
+  void openSysfsSensors();
+  std::optional<SensorLiveData> readSysfsSensor(
+      SysfsSensor& sensor,
+      int64_t timeStamp);
   void parseSensorJsonData(const std::string&);
   void getSensorDataFromPath();
 };
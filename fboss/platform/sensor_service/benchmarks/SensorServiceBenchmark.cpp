@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2004-present, Meta Platforms, Inc. and affiliates.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/FileUtil.h>
+#include <folly/experimental/TestUtil.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include <memory>
+#include <string>
+
+#include "fboss/platform/sensor_service/SensorServiceImpl.h"
+
+DECLARE_uint32(sysfs_read_threads);
+
+DEFINE_uint32(
+    num_fake_sensors,
+    512,
+    "Number of fake sysfs sensors to create in the fake sysfs tree");
+
+DEFINE_string(
+    fake_sysfs_root,
+    "/dev/shm",
+    "tmpfs backed directory to create the fake sysfs tree in");
+
+using namespace facebook::fboss::platform::sensor_service;
+
+namespace {
+
+// Fake hwmon tree of temperature inputs, with a sysfs sensor config
+// pointing at it.
+class FakeSysfsTree {
+ public:
+  FakeSysfsTree()
+      : dir_("sensor_service_bench", FLAGS_fake_sysfs_root) {
+    std::string sensors;
+    for (uint32_t i = 0; i < FLAGS_num_fake_sensors; i++) {
+      auto path = dir_.path() / folly::to<std::string>("temp", i, "_input");
+      folly::writeFile(folly::to<std::string>(40000 + i, "\n"), path.c_str());
+      sensors += folly::to<std::string>(
+          i == 0 ? "" : ",",
+          "\"SENSOR",
+          i,
+          "\" : {\"path\" : \"",
+          path.string(),
+          "\", \"type\" : 3}");
+    }
+    confPath_ = (dir_.path() / "sensor_service.json").string();
+    folly::writeFile(
+        folly::to<std::string>(
+            "{\"source\" : \"sysfs\", \"sensorMapList\" : {\"FAKE\" : {",
+            sensors,
+            "}}}"),
+        confPath_.c_str());
+  }
+
+  const std::string& confPath() const {
+    return confPath_;
+  }
+
+ private:
+  folly::test::TemporaryDirectory dir_;
+  std::string confPath_;
+};
+
+void benchmarkFetch(uint32_t iters, uint32_t readThreads) {
+  std::unique_ptr<FakeSysfsTree> tree;
+  std::unique_ptr<SensorServiceImpl> impl;
+  BENCHMARK_SUSPEND {
+    FLAGS_sysfs_read_threads = readThreads;
+    tree = std::make_unique<FakeSysfsTree>();
+    impl = std::make_unique<SensorServiceImpl>(tree->confPath());
+  }
+  for (uint32_t i = 0; i < iters; i++) {
+    impl->fetchSensorData();
+  }
+  BENCHMARK_SUSPEND {
+    folly::doNotOptimizeAway(impl->getAllSensorData());
+    impl.reset();
+    tree.reset();
+  }
+}
+
+} // namespace
+
+BENCHMARK(SysfsFetchInline, iters) {
+  benchmarkFetch(iters, 1);
+}
+
+BENCHMARK_RELATIVE(SysfsFetch4Threads, iters) {
+  benchmarkFetch(iters, 4);
+}
+
+BENCHMARK_RELATIVE(SysfsFetch16Threads, iters) {
+  benchmarkFetch(iters, 16);
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
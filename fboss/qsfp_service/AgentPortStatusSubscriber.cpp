@@ -0,0 +1,176 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/qsfp_service/AgentPortStatusSubscriber.h"
+
+#include "fboss/agent/Utils.h"
+#include "fboss/lib/thrift_service_client/ThriftServiceClient.h"
+
+#include <folly/logging/xlog.h>
+#include <thrift/lib/cpp/TApplicationException.h>
+
+DEFINE_bool(
+    subscribe_agent_port_status,
+    true,
+    "Long-poll wedge_agent for port status and config applied changes "
+    "instead of fetching them on every state machine refresh");
+
+DEFINE_int32(
+    agent_port_status_wait_ms,
+    10000,
+    "How long a single waitForPortStatusChanges() call waits on wedge_agent");
+
+DEFINE_int32(
+    agent_port_status_retry_ms,
+    1000,
+    "Delay before reconnecting to wedge_agent after a failed long-poll");
+
+namespace {
+// Extra time on top of the long-poll wait before the client gives up
+constexpr std::chrono::milliseconds kRpcTimeoutSlack(5000);
+// Delay before probing again a wedge_agent which doesn't support
+// waitForPortStatusChanges()
+constexpr std::chrono::milliseconds kUnsupportedRetryInterval(60000);
+} // namespace
+
+namespace facebook::fboss {
+
+AgentPortStatusSubscriber::AgentPortStatusSubscriber(
+    ClientFactory clientFactory)
+    : clientFactory_(std::move(clientFactory)) {
+  if (!clientFactory_) {
+    clientFactory_ = [](folly::EventBase* evb) {
+      return utils::createWedgeAgentClient(std::nullopt, std::nullopt, evb);
+    };
+  }
+}
+
+AgentPortStatusSubscriber::~AgentPortStatusSubscriber() {
+  stop();
+}
+
+void AgentPortStatusSubscriber::start() {
+  if (thread_) {
+    return;
+  }
+  thread_ = std::make_unique<std::thread>([this] {
+    initThread("AgentPortStatusSubscriber");
+    evb_.loopForever();
+  });
+  evb_.runInEventBaseThread([this] { poll(); });
+}
+
+void AgentPortStatusSubscriber::stop() {
+  if (!thread_) {
+    return;
+  }
+  evb_.runInEventBaseThreadAndWait([this] {
+    stopping_ = true;
+    // Destroying the client fails the outstanding long-poll
+    client_.reset();
+  });
+  evb_.terminateLoopSoon();
+  thread_->join();
+  thread_.reset();
+}
+
+std::shared_ptr<const AgentPortStatusSubscriber::Snapshot>
+AgentPortStatusSubscriber::getSnapshot() const {
+  return *snapshot_.rlock();
+}
+
+void AgentPortStatusSubscriber::poll() {
+  CHECK(evb_.isInEventBaseThread());
+  if (stopping_) {
+    return;
+  }
+  try {
+    if (!client_) {
+      client_ = clientFactory_(&evb_);
+    }
+    apache::thrift::RpcOptions options;
+    options.setTimeout(
+        std::chrono::milliseconds(FLAGS_agent_port_status_wait_ms) +
+        kRpcTimeoutSlack);
+    ++numRpcs_;
+    client_
+        ->semifuture_waitForPortStatusChanges(
+            options, mirror_.generation, FLAGS_agent_port_status_wait_ms)
+        .via(&evb_)
+        .thenValue([this](PortStatusChanges&& changes) {
+          if (stopping_) {
+            return;
+          }
+          supportedByAgent_ = true;
+          applyChanges(std::move(changes));
+          poll();
+        })
+        .thenError(
+            folly::tag_t<std::exception>{},
+            [this](const std::exception& ex) { handleError(ex); });
+  } catch (const std::exception& ex) {
+    handleError(ex);
+  }
+}
+
+void AgentPortStatusSubscriber::applyChanges(PortStatusChanges&& changes) {
+  if (inSync_ && *changes.generation() == mirror_.generation &&
+      !*changes.fullSync()) {
+    // Long-poll timed out without any change
+    return;
+  }
+  if (*changes.fullSync()) {
+    XLOG(INFO) << "Full port status sync from wedge_agent, "
+               << changes.portStatus()->size() << " ports";
+    mirror_.portStatus = std::move(*changes.portStatus());
+  } else {
+    XLOG(DBG2) << "Port status changes from wedge_agent: "
+               << changes.portStatus()->size() << " changed, "
+               << changes.removedPorts()->size() << " removed";
+    for (auto& [portID, status] : *changes.portStatus()) {
+      mirror_.portStatus[portID] = std::move(status);
+    }
+    for (auto portID : *changes.removedPorts()) {
+      mirror_.portStatus.erase(portID);
+    }
+  }
+  mirror_.generation = *changes.generation();
+  mirror_.configAppliedInfo = std::move(*changes.configAppliedInfo());
+  *snapshot_.wlock() = std::make_shared<const Snapshot>(mirror_);
+  inSync_ = true;
+}
+
+void AgentPortStatusSubscriber::handleError(const std::exception& ex) {
+  if (stopping_) {
+    return;
+  }
+  // We have retry mechanism to handle failure. No crash here
+  XLOG(WARN) << "Failed to call wedge_agent waitForPortStatusChanges(). "
+             << folly::exceptionStr(ex);
+  // Readers should behave as if wedge_agent is unreachable until we are back
+  // in sync. Keep mirror_ so that we can resume from its generation.
+  snapshot_.wlock()->reset();
+  inSync_ = false;
+  client_.reset();
+
+  auto retryMs = std::chrono::milliseconds(FLAGS_agent_port_status_retry_ms);
+  auto appEx = dynamic_cast<const apache::thrift::TApplicationException*>(&ex);
+  if (appEx &&
+      appEx->getType() ==
+          apache::thrift::TApplicationException::UNKNOWN_METHOD) {
+    if (supportedByAgent_.exchange(false)) {
+      XLOG(WARN) << "wedge_agent doesn't support waitForPortStatusChanges(), "
+                 << "falling back to fetching the port status";
+    }
+    retryMs = kUnsupportedRetryInterval;
+  }
+  evb_.runAfterDelay([this] { poll(); }, retryMs.count());
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/if/gen-cpp2/FbossCtrl.h"
+
+#include <folly/Synchronized.h>
+#include <folly/io/async/EventBase.h>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <thread>
+
+DECLARE_bool(subscribe_agent_port_status);
+
+namespace facebook::fboss {
+
+/*
+ * Mirrors the wedge_agent port status and config applied info in
+ * qsfp_service. A single persistent wedge_agent client long-polls
+ * waitForPortStatusChanges() on a dedicated thread and applies the returned
+ * changes, so that refreshStateMachines() reads the local snapshot and an idle
+ * agent costs no RPCs besides the outstanding long-poll.
+ */
+class AgentPortStatusSubscriber {
+ public:
+  using ClientFactory =
+      std::function<std::unique_ptr<FbossCtrlAsyncClient>(folly::EventBase*)>;
+
+  struct Snapshot {
+    int64_t generation{0};
+    std::map<int32_t, PortStatus> portStatus;
+    ConfigAppliedInfo configAppliedInfo;
+  };
+
+  // Default to connect to wedge_agent with utils::createWedgeAgentClient()
+  explicit AgentPortStatusSubscriber(ClientFactory clientFactory = nullptr);
+  ~AgentPortStatusSubscriber();
+
+  void start();
+  void stop();
+
+  // Latest wedge_agent state, or nullptr if we are not in sync with it
+  std::shared_ptr<const Snapshot> getSnapshot() const;
+
+  /*
+   * False once wedge_agent rejected waitForPortStatusChanges() as an unknown
+   * method, e.g. when it runs an older version. Callers should then fetch the
+   * port status and config applied info themselves. We keep probing less
+   * often in case wedge_agent gets upgraded.
+   */
+  bool isSupportedByAgent() const {
+    return supportedByAgent_.load();
+  }
+
+  // Number of waitForPortStatusChanges() calls issued so far
+  uint64_t getNumRpcs() const {
+    return numRpcs_.load();
+  }
+
+ private:
+  // Issue the next long-poll. Must be called from the evb_ thread.
+  void poll();
+  void applyChanges(PortStatusChanges&& changes);
+  void handleError(const std::exception& ex);
+
+  ClientFactory clientFactory_;
+  folly::EventBase evb_;
+  std::unique_ptr<std::thread> thread_;
+
+  // Only accessed from the evb_ thread
+  std::unique_ptr<FbossCtrlAsyncClient> client_;
+  Snapshot mirror_;
+  bool inSync_{false};
+  bool stopping_{false};
+
+  folly::Synchronized<std::shared_ptr<const Snapshot>> snapshot_;
+  std::atomic<bool> supportedByAgent_{true};
+  std::atomic<uint64_t> numRpcs_{0};
+};
+
+} // namespace facebook::fboss
@@ -67,6 +67,13 @@ void QsfpServiceHandler::getTransceiverInfo(
   manager_->getTransceiversInfo(info, std::move(ids));
 }
 
+void QsfpServiceHandler::getTransceiverInfoDeltas(
+    TransceiverInfoDeltas& deltas,
+    int64_t sinceGeneration) {
+  auto log = LOG_THRIFT_CALL(INFO);
+  manager_->getTransceiverInfoDeltas(deltas, sinceGeneration);
+}
+
 void QsfpServiceHandler::customizeTransceiver(
     int32_t idx,
     cfg::PortSpeed speed) {
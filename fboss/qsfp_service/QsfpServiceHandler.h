@@ -39,6 +39,13 @@ class QsfpServiceHandler
       std::map<int32_t, TransceiverInfo>& info,
       std::unique_ptr<std::vector<int32_t>> ids) override;
 
+  /*
+   * Returns only the transceiver fields changed after sinceGeneration
+   */
+  void getTransceiverInfoDeltas(
+      TransceiverInfoDeltas& deltas,
+      int64_t sinceGeneration) override;
+
   /*
    * Returns raw DOM page data for each passed in transceiver.
    */
@@ -13,6 +13,7 @@
 #include "fboss/lib/thrift_service_client/ThriftServiceClient.h"
 #include "fboss/qsfp_service/TransceiverStateMachineUpdate.h"
 #include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
+#include "fboss/qsfp_service/lib/TransceiverInfoDelta.h"
 
 using namespace std::chrono;
 
@@ -56,6 +57,13 @@ TransceiverManager::TransceiverManager(
     portInfo.tcvrID = utility::getTransceiverId(platformPort, chips);
     portToSwPortInfo_.emplace(portID, std::move(portInfo));
   }
+
+  auto initialGeneration =
+      duration_cast<milliseconds>(system_clock::now().time_since_epoch())
+          .count();
+  auto lockedDeltaState = tcvrInfoDeltaState_.wlock();
+  lockedDeltaState->initialGeneration = initialGeneration;
+  lockedDeltaState->generation = initialGeneration;
 }
 
 TransceiverManager::~TransceiverManager() {
@@ -197,10 +205,21 @@ void TransceiverManager::startThreads() {
       this->threadLoop(
           "TransceiverStateMachineUpdateThread", updateEventBase_.get());
     }));
+
+    if (FLAGS_subscribe_agent_port_status) {
+      agentPortStatusSubscriber_ =
+          std::make_unique<AgentPortStatusSubscriber>();
+      agentPortStatusSubscriber_->start();
+      XLOG(DBG2) << "Started AgentPortStatusSubscriber";
+    }
   }
 }
 
 void TransceiverManager::stopThreads() {
+  if (agentPortStatusSubscriber_) {
+    agentPortStatusSubscriber_->stop();
+    XLOG(DBG2) << "Stopped AgentPortStatusSubscriber";
+  }
   // We use runInEventBaseThread() to terminateLoopSoon() rather than calling it
   // directly here.  This ensures that any events already scheduled via
   // runInEventBaseThread() will have a chance to run.
@@ -556,6 +575,111 @@ TransceiverInfo TransceiverManager::getTransceiverInfo(TransceiverID id) {
   }
 }
 
+TransceiverManager::TransceiverInfoSource
+TransceiverManager::getTransceiverInfoSource(TransceiverID id) const {
+  TransceiverInfoSource source;
+  {
+    auto lockedTransceivers = transceivers_.rlock();
+    if (auto it = lockedTransceivers->find(id);
+        it != lockedTransceivers->end()) {
+      source.infoVersion = it->second->getTransceiverInfoVersion();
+    }
+  }
+  if (FLAGS_use_new_state_machine) {
+    source.stateMachineState = getCurrentState(id);
+  }
+  return source;
+}
+
+void TransceiverManager::updateTransceiverInfoDeltas(
+    const std::vector<TransceiverID>& tcvrIDs) {
+  std::map<TransceiverID, TransceiverInfoSource> publishedSources;
+  {
+    auto lockedDeltaState = tcvrInfoDeltaState_.rlock();
+    for (auto tcvrID : tcvrIDs) {
+      if (auto it = lockedDeltaState->tcvrs.find(tcvrID);
+          it != lockedDeltaState->tcvrs.end()) {
+        publishedSources.emplace(tcvrID, it->second.source);
+      }
+    }
+  }
+
+  // Build the new TransceiverInfo of the transceivers which changed, without
+  // holding tcvrInfoDeltaState_
+  std::map<TransceiverID, TransceiverInfoWithGeneration> latestInfo;
+  for (auto tcvrID : tcvrIDs) {
+    try {
+      // Taken before the info, so that a concurrent update is diffed again
+      // next time at worst
+      auto source = getTransceiverInfoSource(tcvrID);
+      if (auto it = publishedSources.find(tcvrID);
+          it != publishedSources.end() && it->second == source) {
+        continue;
+      }
+      auto info = getTransceiverInfo(tcvrID);
+      if (source.stateMachineState) {
+        info.stateMachineState() = *source.stateMachineState;
+      }
+      latestInfo[tcvrID] = {std::move(info), std::move(source), {}};
+    } catch (const std::exception& ex) {
+      // The module is still populating its data. Try again next refresh
+      XLOG(DBG2) << "Transceiver " << tcvrID
+                 << ": Skip updating TransceiverInfo deltas: " << ex.what();
+    }
+  }
+
+  auto lockedDeltaState = tcvrInfoDeltaState_.wlock();
+  auto generation = lockedDeltaState->generation + 1;
+  int numChangedFields = 0;
+  for (auto& [tcvrID, latest] : latestInfo) {
+    // A transceiver seen for the first time is compared against a default
+    // TransceiverInfo, which is also what clients start from.
+    auto& published = lockedDeltaState->tcvrs[tcvrID];
+    for (auto fieldId : diffTransceiverInfo(published.info, latest.info)) {
+      published.fieldGenerations[fieldId] = generation;
+      numChangedFields++;
+    }
+    published.info = std::move(latest.info);
+    published.source = std::move(latest.source);
+  }
+  lockedDeltaState->numDiffed += latestInfo.size();
+  if (numChangedFields > 0) {
+    lockedDeltaState->generation = generation;
+  }
+  XLOG(DBG3) << "TransceiverInfo generation " << lockedDeltaState->generation
+             << ": " << latestInfo.size() << " of " << tcvrIDs.size()
+             << " transceivers diffed, " << numChangedFields
+             << " fields changed";
+}
+
+void TransceiverManager::getTransceiverInfoDeltas(
+    TransceiverInfoDeltas& deltas,
+    int64_t sinceGeneration) {
+  auto lockedDeltaState = tcvrInfoDeltaState_.rlock();
+  // The client either has nothing yet, or got its generation from another
+  // qsfp_service instance. Either way it needs everything.
+  bool fullSync = sinceGeneration < lockedDeltaState->initialGeneration ||
+      sinceGeneration > lockedDeltaState->generation;
+  deltas.generation() = lockedDeltaState->generation;
+  deltas.fullSync() = fullSync;
+  for (const auto& [tcvrID, published] : lockedDeltaState->tcvrs) {
+    std::vector<int16_t> fieldIds;
+    if (fullSync) {
+      fieldIds = allTransceiverInfoFields();
+    } else {
+      for (const auto& [fieldId, generation] : published.fieldGenerations) {
+        if (generation > sinceGeneration) {
+          fieldIds.push_back(fieldId);
+        }
+      }
+    }
+    if (!fieldIds.empty()) {
+      deltas.deltas()[tcvrID] =
+          makeTransceiverInfoDelta(published.info, std::move(fieldIds));
+    }
+  }
+}
+
 void TransceiverManager::programTransceiver(
     TransceiverID id,
     bool needResetDataPath) {
@@ -648,12 +772,22 @@ void TransceiverManager::updateTransceiverPortStatus() noexcept {
   steady_clock::time_point begin = steady_clock::now();
   std::map<int32_t, PortStatus> newPortToPortStatus;
   try {
-    // Then call wedge_agent getPortStatus() to get current port status
-    auto wedgeAgentClient = utils::createWedgeAgentClient();
-    wedgeAgentClient->sync_getPortStatus(newPortToPortStatus, {});
+    if (agentPortStatusSubscriber_ &&
+        agentPortStatusSubscriber_->isSupportedByAgent()) {
+      // Use the latest port status mirrored from wedge_agent
+      auto snapshot = agentPortStatusSubscriber_->getSnapshot();
+      if (!snapshot) {
+        throw FbossError("Not in sync with wedge_agent port status");
+      }
+      newPortToPortStatus = snapshot->portStatus;
+    } else {
+      // Then call wedge_agent getPortStatus() to get current port status
+      auto wedgeAgentClient = utils::createWedgeAgentClient();
+      wedgeAgentClient->sync_getPortStatus(newPortToPortStatus, {});
+    }
   } catch (const std::exception& ex) {
     // We have retry mechanism to handle failure. No crash here
-    XLOG(WARN) << "Failed to call wedge_agent getPortStatus(). "
+    XLOG(WARN) << "Failed to get wedge_agent port status. "
                << folly::exceptionStr(ex);
     if (overrideAgentPortStatusForTesting_.empty()) {
       return;
@@ -913,13 +1047,22 @@ void TransceiverManager::triggerAgentConfigChangeEvent() {
     return;
   }
 
-  auto wedgeAgentClient = utils::createWedgeAgentClient();
   ConfigAppliedInfo newConfigAppliedInfo;
   try {
-    wedgeAgentClient->sync_getConfigAppliedInfo(newConfigAppliedInfo);
+    if (agentPortStatusSubscriber_ &&
+        agentPortStatusSubscriber_->isSupportedByAgent()) {
+      auto snapshot = agentPortStatusSubscriber_->getSnapshot();
+      if (!snapshot) {
+        throw FbossError("Not in sync with wedge_agent config applied info");
+      }
+      newConfigAppliedInfo = snapshot->configAppliedInfo;
+    } else {
+      auto wedgeAgentClient = utils::createWedgeAgentClient();
+      wedgeAgentClient->sync_getConfigAppliedInfo(newConfigAppliedInfo);
+    }
   } catch (const std::exception& ex) {
     // We have retry mechanism to handle failure. No crash here
-    XLOG(WARN) << "Failed to call wedge_agent getConfigAppliedInfo(). "
+    XLOG(WARN) << "Failed to get wedge_agent config applied info. "
                << folly::exceptionStr(ex);
 
     // For testing only, if overrideAgentConfigAppliedInfoForTesting_ is set,
@@ -1616,24 +1759,40 @@ std::vector<TransceiverID> TransceiverManager::refreshTransceivers(
     const std::unordered_set<TransceiverID>& transceivers) {
   std::vector<TransceiverID> transceiverIds;
   std::vector<folly::Future<folly::Unit>> futs;
+  size_t nTransceivers;
 
-  auto lockedTransceivers = transceivers_.rlock();
-  auto nTransceivers =
-      transceivers.empty() ? lockedTransceivers->size() : transceivers.size();
-  XLOG(INFO) << "Start refreshing " << nTransceivers << " transceivers...";
-
-  for (const auto& transceiver : *lockedTransceivers) {
-    TransceiverID id = TransceiverID(transceiver.second->getID());
-    if (!transceivers.empty() && transceivers.find(id) == transceivers.end()) {
-      continue;
+  {
+    auto lockedTransceivers = transceivers_.rlock();
+    nTransceivers =
+        transceivers.empty() ? lockedTransceivers->size() : transceivers.size();
+    XLOG(INFO) << "Start refreshing " << nTransceivers << " transceivers...";
+
+    for (const auto& transceiver : *lockedTransceivers) {
+      TransceiverID id = TransceiverID(transceiver.second->getID());
+      if (!transceivers.empty() &&
+          transceivers.find(id) == transceivers.end()) {
+        continue;
+      }
+      XLOG(DBG3) << "Fired to refresh TransceiverID=" << id;
+      transceiverIds.push_back(id);
+      futs.push_back(transceiver.second->futureRefresh());
     }
-    XLOG(DBG3) << "Fired to refresh TransceiverID=" << id;
-    transceiverIds.push_back(id);
-    futs.push_back(transceiver.second->futureRefresh());
-  }
 
-  folly::collectAll(futs.begin(), futs.end()).wait();
+    folly::collectAll(futs.begin(), futs.end()).wait();
+  }
   XLOG(INFO) << "Finished refreshing " << nTransceivers << " transceivers";
+
+  if (transceivers.empty()) {
+    // Also cover the transceivers which were removed from transceivers_, so
+    // that the clients learn they are no longer present.
+    std::vector<TransceiverID> allTcvrIDs;
+    for (int idx = 0; idx < getNumQsfpModules(); idx++) {
+      allTcvrIDs.push_back(TransceiverID(idx));
+    }
+    updateTransceiverInfoDeltas(allTcvrIDs);
+  } else {
+    updateTransceiverInfoDeltas(transceiverIds);
+  }
   return transceiverIds;
 }
 } // namespace facebook::fboss
@@ -21,6 +21,7 @@
 #include "fboss/lib/phy/gen-cpp2/prbs_types.h"
 #include "fboss/lib/platforms/PlatformMode.h"
 #include "fboss/lib/usb/TransceiverPlatformApi.h"
+#include "fboss/qsfp_service/AgentPortStatusSubscriber.h"
 #include "fboss/qsfp_service/QsfpConfig.h"
 #include "fboss/qsfp_service/TransceiverStateMachineUpdate.h"
 #include "fboss/qsfp_service/module/Transceiver.h"
@@ -264,6 +265,11 @@ class TransceiverManager {
       std::optional<OverrideTcvrToPortAndProfile> overrideTcvrToPortAndProfile =
           std::nullopt) = 0;
 
+  // Number of TransceiverInfo diffed to find the changed fields
+  uint64_t getNumTransceiverInfoDiffedForTesting() const {
+    return tcvrInfoDeltaState_.rlock()->numDiffed;
+  }
+
   Transceiver* overrideTransceiverForTesting(
       TransceiverID id,
       std::unique_ptr<Transceiver> overrideTcvr);
@@ -272,6 +278,13 @@ class TransceiverManager {
   // with present filed is false.
   TransceiverInfo getTransceiverInfo(TransceiverID id);
 
+  // Only return the TransceiverInfo fields changed after sinceGeneration.
+  // If sinceGeneration is 0, or wasn't handed out by this qsfp_service
+  // instance, all the fields of all the transceivers are returned.
+  void getTransceiverInfoDeltas(
+      TransceiverInfoDeltas& deltas,
+      int64_t sinceGeneration);
+
   // Function to convert port name string to software port id
   std::optional<PortID> getPortIDByPortName(const std::string& portName);
 
@@ -491,7 +504,7 @@ class TransceiverManager {
   void triggerAgentConfigChangeEvent();
 
   // Update the cached PortStatus of TransceiverToPortInfo using wedge_agent
-  // getPortStatus() results
+  // port status
   void updateTransceiverPortStatus() noexcept;
 
   std::set<TransceiverID> getPresentTransceivers() const;
@@ -510,6 +523,26 @@ class TransceiverManager {
   void setWarmBootState();
   void setCanWarmBoot();
 
+  // What a published TransceiverInfo was built from. A refresh only rebuilds
+  // and diffs the TransceiverInfo of the transceivers where this changed.
+  struct TransceiverInfoSource {
+    // Transceiver::getTransceiverInfoVersion(), unset for a transceiver
+    // missing from transceivers_
+    std::optional<uint64_t> infoVersion;
+    std::optional<TransceiverStateMachineState> stateMachineState;
+
+    bool operator==(const TransceiverInfoSource& other) const {
+      return infoVersion == other.infoVersion &&
+          stateMachineState == other.stateMachineState;
+    }
+  };
+
+  // Record the latest TransceiverInfo of the specified transceivers, and bump
+  // the generation of the fields which changed since the last refresh.
+  // Transceivers whose TransceiverInfoSource is unchanged are skipped.
+  void updateTransceiverInfoDeltas(const std::vector<TransceiverID>& tcvrIDs);
+  TransceiverInfoSource getTransceiverInfoSource(TransceiverID id) const;
+
   // TEST ONLY
   // This private map is an override of agent getPortStatus()
   std::map<int32_t, PortStatus> overrideAgentPortStatusForTesting_;
@@ -531,6 +564,15 @@ class TransceiverManager {
   std::unique_ptr<std::thread> updateThread_;
   std::unique_ptr<folly::EventBase> updateEventBase_;
 
+  /*
+   * Mirror of wedge_agent port status and config applied info, kept up to
+   * date by long-polling wedge_agent. Only set if
+   * FLAGS_subscribe_agent_port_status is true. Otherwise, or while
+   * wedge_agent doesn't support the long-poll, we fetch them from wedge_agent
+   * on every refreshStateMachines().
+   */
+  std::unique_ptr<AgentPortStatusSubscriber> agentPortStatusSubscriber_;
+
   // TODO(joseph5wu) Will add heartbeat watchdog later
 
   // A global flag to indicate whether the service is exiting.
@@ -553,9 +595,10 @@ class TransceiverManager {
 
   /*
    * A ConfigAppliedInfo to keep track of the last wedge_agent config applied
-   * info. refreshStateMachines() will routinely call wedge_agent thrift api to
-   * getConfigAppliedInfo() thrift api, and then we can use that to tell
-   * whether there's a config change. This will probably:
+   * info. refreshStateMachines() will routinely check the latest one (from
+   * agentPortStatusSubscriber_, or wedge_agent getConfigAppliedInfo() thrift
+   * api), and then we can use that to tell whether there's a config change.
+   * This will probably:
    * 1) introduce an updated iphy port profile change, like reloading config
    * with new speed;
    * 2) agent coldboot to reset iphy
@@ -569,6 +612,27 @@ class TransceiverManager {
    */
   bool canWarmBoot_{false};
 
+  /*
+   * The last TransceiverInfo of every transceiver, with the generation each
+   * field last changed at. Used to serve getTransceiverInfoDeltas().
+   * Generations start from the wall clock time (in ms) at construction, so
+   * that a generation from a previous qsfp_service instance is always below
+   * initialGeneration.
+   */
+  struct TransceiverInfoWithGeneration {
+    TransceiverInfo info;
+    TransceiverInfoSource source;
+    std::unordered_map<int16_t, int64_t> fieldGenerations;
+  };
+  struct TransceiverInfoDeltaState {
+    int64_t initialGeneration{0};
+    int64_t generation{0};
+    std::map<TransceiverID, TransceiverInfoWithGeneration> tcvrs;
+    // Number of TransceiverInfo rebuilt and diffed, for tests
+    uint64_t numDiffed{0};
+  };
+  folly::Synchronized<TransceiverInfoDeltaState> tcvrInfoDeltaState_;
+
   friend class TransceiverStateMachineTest;
 };
 } // namespace facebook::fboss
@@ -23,6 +23,13 @@ service QsfpService extends phy.FbossCommonPhyCtrl {
   map<i32, transceiver.TransceiverInfo> getTransceiverInfo(
     1: list<i32> idx,
   ) throws (1: fboss.FbossBaseError error);
+  /*
+   * Get only the TransceiverInfo fields which changed after sinceGeneration.
+   * Pass the generation of the previous reply, or 0 for a full snapshot.
+   */
+  transceiver.TransceiverInfoDeltas getTransceiverInfoDeltas(
+    1: i64 sinceGeneration,
+  ) throws (1: fboss.FbossBaseError error);
   /*
    * Customise the transceiver based on the speed at which it should run
    */
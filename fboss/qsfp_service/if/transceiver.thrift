@@ -366,6 +366,26 @@ struct TransceiverInfo {
   28: optional VdmDiagsStats vdmDiagsStatsForOds;
 }
 
+/*
+ * The part of a TransceiverInfo which changed since a given generation.
+ * Only the fields listed in changedFields (TransceiverInfo field ids) are
+ * meaningful in info. A listed optional field left unset in info was cleared.
+ */
+struct TransceiverInfoDelta {
+  1: TransceiverInfo info;
+  2: list<i16> changedFields;
+}
+
+struct TransceiverInfoDeltas {
+  // The generation the client is up to date with, once this is applied
+  1: i64 generation;
+  // The requested generation could not be served incrementally (first
+  // request, or qsfp_service restarted). deltas carries every field of every
+  // transceiver, and the client should drop what it had cached.
+  2: bool fullSync = false;
+  3: map<i32, TransceiverInfoDelta> deltas;
+}
+
 typedef binary (cpp2.type = "folly::IOBuf") IOBuf
 
 struct RawDOMData {
@@ -10,6 +10,7 @@
 #include "fboss/qsfp_service/lib/QsfpCache.h"
 
 #include "fboss/qsfp_service/lib/QsfpClient.h"
+#include "fboss/qsfp_service/lib/TransceiverInfoDelta.h"
 
 #include "fboss/lib/AlertLogger.h"
 
@@ -36,8 +37,7 @@ void QsfpCache::init(folly::EventBase* evb, const PortMapThrift& ports) {
   initialized_.store(true, std::memory_order_release);
 
   portsChanged(ports);
-
-  syncAllPresentTransceivers();
+  folly::via(evb_).then(&QsfpCache::maybeSyncTransceivers, this);
 
   attachEventBase(evb);
   scheduleTimeout(kLivenessCheckInterval);
@@ -150,12 +150,15 @@ folly::Future<folly::Unit> QsfpCache::doSync(PortMapThrift&& toSync) {
   auto onSuccess = [this,
                     gen = incrementGen(),
                     oldAliveSince = remoteAliveSince_](auto&& tcvrs) {
+    // The transceivers in the reply are not cached: tcvrs_ is only updated
+    // from the deltas, which are fetched next, so that an older snapshot
+    // never overwrites newer deltas.
     XLOG(DBG1) << "Got " << tcvrs.size() << " transceivers from qsfp_service";
-    updateCache(tcvrs);
     if (remoteAliveSince_ == oldAliveSince || oldAliveSince < 0) {
       // no restart occurred in middle of request, store gen
       remoteGen_ = gen;
     }
+    return syncTransceiverDeltas();
   };
 
   // lock out other request attempts
@@ -182,14 +185,6 @@ folly::Future<folly::Unit> QsfpCache::doSync(PortMapThrift&& toSync) {
       });
 }
 
-void QsfpCache::updateCache(const TcvrMapThrift& tcvrs) {
-  tcvrs_.withWLock([&tcvrs](auto& lockedTcvrs) {
-    for (const auto& item : tcvrs) {
-      lockedTcvrs[TransceiverID(item.first)] = item.second;
-    }
-  });
-}
-
 std::optional<TransceiverInfo> QsfpCache::getIf(TransceiverID tcvrId) {
   if (!initialized_.load(std::memory_order_acquire)) {
     throw std::runtime_error("Cache not yet initialized...");
@@ -239,7 +234,9 @@ QsfpCache::getAllTransceivers() const {
 }
 
 void QsfpCache::timeoutExpired() noexcept {
-  confirmAlive().then(&QsfpCache::maybeSync, this);
+  confirmAlive()
+      .then(&QsfpCache::maybeSync, this)
+      .then(&QsfpCache::maybeSyncTransceivers, this);
   scheduleTimeout(kLivenessCheckInterval);
 }
 
@@ -258,33 +255,84 @@ uint32_t QsfpCache::incrementGen() {
   return ++gen;
 }
 
-void QsfpCache::syncAllPresentTransceivers() {
-  // Ask qsfp_service to get all the transceivers info
-  QsfpClient::createClient(evb_)
-      .thenValue([](auto&& client) {
-        // use empty list to fetch all transceivers
-        std::vector<int32_t> ids;
+void QsfpCache::maybeSyncTransceivers() {
+  DCHECK(evb_);
+  CHECK(evb_->isInEventBaseThread());
+
+  if (activeReq_.has_value() && !activeReq_->isFulfilled()) {
+    // The active request fetches the transceiver deltas when it's done
+    XLOG(DBG3) << "Already an active outstanding request to qsfp_service";
+    return;
+  }
+
+  XLOG(DBG4) << "Starting new transceiver deltas request";
+  activeReq_ = folly::SharedPromise<folly::Unit>();
+  syncTransceiverDeltas()
+      .thenError(
+          folly::tag_t<std::exception>{},
+          [](const std::exception& e) {
+            XLOG(ERR) << PlatformAlert() << "Exception talking to qsfp_service,"
+                      << " when trying to sync transceiver info deltas: "
+                      << e.what();
+          })
+      .ensure([this]() {
+        activeReq_->setValue();
+        XLOG(DBG4) << "Finished transceiver deltas request";
+      });
+}
+
+folly::Future<folly::Unit> QsfpCache::syncTransceiverDeltas() {
+  CHECK(evb_->isInEventBaseThread());
+
+  // Ask qsfp_service only for what changed since the last generation we
+  // applied. With tcvrGen_ == 0 this fetches all the transceivers.
+  return QsfpClient::createClient(evb_)
+      .thenValue([sinceGen = tcvrGen_.load()](auto&& client) {
         auto options = QsfpClient::getRpcOptions();
-        return client->future_getTransceiverInfo(options, ids);
-      })
-      .thenValue([this](auto&& tcvrs) mutable {
-        // sync transceivers map with results
-        auto writableTcvrs = this->tcvrs_.wlock();
-        for (auto& [id, info] : tcvrs) {
-          // Only store present transceivers
-          if (*info.present()) {
-            writableTcvrs->emplace(TransceiverID(id), info);
-          }
-        }
-        XLOG(DBG1) << "Got " << writableTcvrs->size()
-                   << " present transceivers from qsfp_service";
+        return client->future_getTransceiverInfoDeltas(options, sinceGen);
       })
-      .thenError(folly::tag_t<std::exception>{}, [](const std::exception& e) {
-        XLOG(ERR) << PlatformAlert() << "Exception talking to qsfp_service,"
-                  << " when trying to sync all transceiver info: " << e.what();
+      .via(evb_)
+      .thenValue([this](TransceiverInfoDeltas&& deltas) {
+        applyTransceiverDeltas(deltas);
       });
 }
 
+void QsfpCache::applyTransceiverDeltas(const TransceiverInfoDeltas& deltas) {
+  CHECK(evb_->isInEventBaseThread());
+
+  bool fullSync = *deltas.fullSync();
+  if (!fullSync && *deltas.generation() < tcvrGen_) {
+    // A newer reply was already applied
+    XLOG(DBG2) << "Ignoring stale transceiver deltas of generation "
+               << *deltas.generation() << ", already at " << tcvrGen_;
+    return;
+  }
+  if (fullSync) {
+    remoteTcvrs_.clear();
+  }
+
+  auto lockedTcvrs = tcvrs_.wlock();
+  if (fullSync) {
+    lockedTcvrs->clear();
+  }
+  for (const auto& [id, delta] : *deltas.deltas()) {
+    auto tcvrID = TransceiverID(id);
+    auto& remoteTcvr = remoteTcvrs_[tcvrID];
+    applyTransceiverInfoDelta(remoteTcvr, delta);
+    if (auto it = lockedTcvrs->find(tcvrID); it != lockedTcvrs->end()) {
+      applyTransceiverInfoDelta(it->second, delta);
+    } else if (*remoteTcvr.present()) {
+      // Only start caching transceivers once they are present
+      lockedTcvrs->emplace(tcvrID, remoteTcvr);
+    }
+  }
+  tcvrGen_ = *deltas.generation();
+  XLOG(DBG1) << "Applied " << deltas.deltas()->size()
+             << " transceiver deltas from qsfp_service"
+             << (fullSync ? " (full sync)" : "") << ", generation "
+             << tcvrGen_;
+}
+
 AutoInitQsfpCache::AutoInitQsfpCache() {
   init(&evb_);
   thread_.reset(new std::thread([=] { evb_.loopForever(); }));
@@ -53,6 +53,17 @@
  * qsfp_service. This request has all ports s.t the generation number
  * for the latest change to that port is > remoteGen_.
  *
+ * Transceiver updates
+ * -------------------
+ * The cached transceivers are only updated from getTransceiverInfoDeltas,
+ * which returns the TransceiverInfo fields which changed since the last
+ * generation we applied. The first call, or any call after qsfp_service
+ * restarted, returns a full snapshot. The transceivers in the syncPorts
+ * reply are ignored, as they could be older than the deltas already
+ * applied. Instead every syncPorts request fetches the deltas once it
+ * succeeds, and so does every liveness check which didn't need to sync
+ * any port, as part of the single active request.
+ *
  * Detecting restarts
  * ------------------
  * We also need to handle potential restarts of the qsfp_service. In
@@ -131,15 +142,17 @@ class QsfpCache : private folly::AsyncTimeout {
   // checks qsfp_service is alive and detects restarts
   folly::Future<folly::Unit> confirmAlive();
 
-  /* Called after successful sync to update transceivers in to our
-   * cache.
-   */
-  void updateCache(const TcvrMapThrift& tcvrs);
-
   // gets a new unique generation number
   uint32_t incrementGen();
 
-  void syncAllPresentTransceivers();
+  /* Makes a getTransceiverInfoDeltas call if there is no active request,
+   * which would make it anyway.
+   */
+  void maybeSyncTransceivers();
+
+  // Fetch the transceiver changes since tcvrGen_ and apply them
+  folly::Future<folly::Unit> syncTransceiverDeltas();
+  void applyTransceiverDeltas(const TransceiverInfoDeltas& deltas);
 
   struct PortCacheValue {
     PortStatus port;
@@ -148,6 +161,11 @@ class QsfpCache : private folly::AsyncTimeout {
 
   folly::Synchronized<std::unordered_map<TransceiverID, TransceiverInfo>>
       tcvrs_;
+  // qsfp_service's view of every transceiver (including absent ones) as of
+  // tcvrGen_, which deltas are applied to. Only accessed on evb_.
+  std::unordered_map<TransceiverID, TransceiverInfo> remoteTcvrs_;
+  // TransceiverInfo generation that remoteTcvrs_ is synced to
+  std::atomic<int64_t> tcvrGen_{0};
   folly::Synchronized<boost::container::flat_map<PortID, PortCacheValue>>
       ports_;
 
@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/qsfp_service/lib/TransceiverInfoDelta.h"
+
+#include <folly/logging/xlog.h>
+
+namespace facebook {
+namespace fboss {
+
+/*
+ * Every TransceiverInfo field as (field id, name). Must be kept in sync with
+ * transceiver.thrift: a field missing here is never published as a delta.
+ */
+#define TRANSCEIVER_INFO_FIELDS(FIELD, OPTIONAL_FIELD)    \
+  FIELD(1, present)                                       \
+  FIELD(2, transceiver)                                   \
+  FIELD(3, port)                                          \
+  OPTIONAL_FIELD(4, sensor)                               \
+  OPTIONAL_FIELD(5, thresholds)                           \
+  OPTIONAL_FIELD(9, vendor)                               \
+  OPTIONAL_FIELD(10, cable)                               \
+  FIELD(12, channels)                                     \
+  OPTIONAL_FIELD(13, settings)                            \
+  OPTIONAL_FIELD(14, stats)                               \
+  OPTIONAL_FIELD(15, signalFlag)                          \
+  OPTIONAL_FIELD(16, extendedSpecificationComplianceCode) \
+  OPTIONAL_FIELD(17, transceiverManagementInterface)      \
+  OPTIONAL_FIELD(18, identifier)                          \
+  OPTIONAL_FIELD(19, status)                              \
+  OPTIONAL_FIELD(20, mediaLaneSignals)                    \
+  OPTIONAL_FIELD(21, hostLaneSignals)                     \
+  OPTIONAL_FIELD(22, timeCollected)                       \
+  OPTIONAL_FIELD(23, remediationCounter)                  \
+  OPTIONAL_FIELD(24, vdmDiagsStats)                       \
+  OPTIONAL_FIELD(25, eepromCsumValid)                     \
+  OPTIONAL_FIELD(26, moduleMediaInterface)                \
+  OPTIONAL_FIELD(27, stateMachineState)                   \
+  OPTIONAL_FIELD(28, vdmDiagsStatsForOds)
+
+#define FIELD_ID(id, name) id,
+
+#define FIELD_DIFF(id, name)                \
+  if (*oldInfo.name() != *newInfo.name()) { \
+    changed.push_back(id);                  \
+  }
+#define OPTIONAL_FIELD_DIFF(id, name)                                 \
+  if (oldInfo.name().to_optional() != newInfo.name().to_optional()) { \
+    changed.push_back(id);                                            \
+  }
+
+#define FIELD_COPY(id, name)  \
+  case id:                    \
+    to.name() = *from.name(); \
+    break;
+#define OPTIONAL_FIELD_COPY(id, name) \
+  case id:                            \
+    if (from.name()) {                \
+      to.name() = *from.name();       \
+    } else {                          \
+      to.name().reset();              \
+    }                                 \
+    break;
+
+const std::vector<int16_t>& allTransceiverInfoFields() {
+  static const std::vector<int16_t> kFields = {
+      TRANSCEIVER_INFO_FIELDS(FIELD_ID, FIELD_ID)};
+  return kFields;
+}
+
+std::vector<int16_t> diffTransceiverInfo(
+    const TransceiverInfo& oldInfo,
+    const TransceiverInfo& newInfo) {
+  std::vector<int16_t> changed;
+  TRANSCEIVER_INFO_FIELDS(FIELD_DIFF, OPTIONAL_FIELD_DIFF)
+  return changed;
+}
+
+void copyTransceiverInfoFields(
+    const TransceiverInfo& from,
+    TransceiverInfo& to,
+    const std::vector<int16_t>& fieldIds) {
+  for (auto fieldId : fieldIds) {
+    switch (fieldId) {
+      TRANSCEIVER_INFO_FIELDS(FIELD_COPY, OPTIONAL_FIELD_COPY)
+      default:
+        // A newer qsfp_service may know about more fields than we do
+        XLOG(DBG2) << "Ignoring unknown TransceiverInfo field " << fieldId;
+        break;
+    }
+  }
+}
+
+TransceiverInfoDelta makeTransceiverInfoDelta(
+    const TransceiverInfo& info,
+    std::vector<int16_t> fieldIds) {
+  TransceiverInfoDelta delta;
+  copyTransceiverInfoFields(info, *delta.info(), fieldIds);
+  delta.changedFields() = std::move(fieldIds);
+  return delta;
+}
+
+void applyTransceiverInfoDelta(
+    TransceiverInfo& info,
+    const TransceiverInfoDelta& delta) {
+  copyTransceiverInfoFields(*delta.info(), info, *delta.changedFields());
+}
+
+#undef TRANSCEIVER_INFO_FIELDS
+#undef FIELD_ID
+#undef FIELD_DIFF
+#undef OPTIONAL_FIELD_DIFF
+#undef FIELD_COPY
+#undef OPTIONAL_FIELD_COPY
+
+} // namespace fboss
+} // namespace facebook
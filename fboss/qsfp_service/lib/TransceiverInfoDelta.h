@@ -0,0 +1,52 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <vector>
+
+#include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
+
+/*
+ * Field level diff of TransceiverInfo, used by qsfp_service to publish only
+ * the fields which changed between two refreshes (getTransceiverInfoDeltas)
+ * and by QsfpCache to apply them on top of its cached copy.
+ *
+ * Fields are identified by their TransceiverInfo thrift field id.
+ */
+namespace facebook {
+namespace fboss {
+
+// Field ids of all the TransceiverInfo fields
+const std::vector<int16_t>& allTransceiverInfoFields();
+
+// Field ids of the fields whose value differs between oldInfo and newInfo
+std::vector<int16_t> diffTransceiverInfo(
+    const TransceiverInfo& oldInfo,
+    const TransceiverInfo& newInfo);
+
+// Copy the given fields from `from` to `to`. Optional fields unset in `from`
+// are reset in `to`.
+void copyTransceiverInfoFields(
+    const TransceiverInfo& from,
+    TransceiverInfo& to,
+    const std::vector<int16_t>& fieldIds);
+
+// Build a delta carrying the given fields of info
+TransceiverInfoDelta makeTransceiverInfoDelta(
+    const TransceiverInfo& info,
+    std::vector<int16_t> fieldIds);
+
+// Apply a delta created by makeTransceiverInfoDelta() on top of info
+void applyTransceiverInfoDelta(
+    TransceiverInfo& info,
+    const TransceiverInfoDelta& delta);
+
+} // namespace fboss
+} // namespace facebook
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
+#include "fboss/qsfp_service/lib/TransceiverInfoDelta.h"
+
+using namespace facebook::fboss;
+
+namespace {
+TransceiverInfo makeTransceiverInfo() {
+  TransceiverInfo info;
+  info.present() = true;
+  info.transceiver() = TransceiverType::QSFP;
+  info.port() = 3;
+  GlobalSensors sensors;
+  sensors.temp()->value() = 40.5;
+  sensors.vcc()->value() = 3.3;
+  info.sensor() = sensors;
+  Vendor vendor;
+  vendor.name() = "vendor";
+  vendor.serialNumber() = "abc123";
+  info.vendor() = vendor;
+  for (int i = 0; i < 4; i++) {
+    Channel channel;
+    channel.channel() = i;
+    info.channels()->push_back(channel);
+  }
+  info.timeCollected() = 100;
+  return info;
+}
+} // namespace
+
+TEST(TransceiverInfoDeltaTest, noChange) {
+  auto info = makeTransceiverInfo();
+  EXPECT_TRUE(diffTransceiverInfo(info, info).empty());
+}
+
+TEST(TransceiverInfoDeltaTest, onlyChangedFields) {
+  auto oldInfo = makeTransceiverInfo();
+  auto newInfo = oldInfo;
+  newInfo.sensor()->temp()->value() = 41.0;
+  newInfo.timeCollected() = 110;
+
+  auto changed = diffTransceiverInfo(oldInfo, newInfo);
+  EXPECT_EQ(changed, std::vector<int16_t>({4, 22}));
+
+  // The delta only carries the changed fields
+  auto delta = makeTransceiverInfoDelta(newInfo, changed);
+  EXPECT_FALSE(delta.info()->vendor().has_value());
+  EXPECT_TRUE(delta.info()->channels()->empty());
+
+  applyTransceiverInfoDelta(oldInfo, delta);
+  EXPECT_EQ(oldInfo, newInfo);
+}
+
+TEST(TransceiverInfoDeltaTest, clearedOptionalField) {
+  auto oldInfo = makeTransceiverInfo();
+  auto newInfo = oldInfo;
+  newInfo.vendor().reset();
+
+  auto changed = diffTransceiverInfo(oldInfo, newInfo);
+  EXPECT_EQ(changed, std::vector<int16_t>({9}));
+  applyTransceiverInfoDelta(
+      oldInfo, makeTransceiverInfoDelta(newInfo, changed));
+  EXPECT_FALSE(oldInfo.vendor().has_value());
+  EXPECT_EQ(oldInfo, newInfo);
+}
+
+TEST(TransceiverInfoDeltaTest, fullSnapshot) {
+  // A client starts from a default TransceiverInfo
+  auto info = makeTransceiverInfo();
+  TransceiverInfo clientInfo;
+  applyTransceiverInfoDelta(
+      clientInfo, makeTransceiverInfoDelta(info, allTransceiverInfoFields()));
+  EXPECT_EQ(clientInfo, info);
+}
+
+TEST(TransceiverInfoDeltaTest, unknownFieldIgnored) {
+  auto info = makeTransceiverInfo();
+  auto delta = makeTransceiverInfoDelta(info, {3});
+  // Field from a newer qsfp_service
+  delta.changedFields()->push_back(1000);
+  TransceiverInfo clientInfo;
+  applyTransceiverInfoDelta(clientInfo, delta);
+  EXPECT_EQ(*clientInfo.port(), 3);
+}
@@ -199,6 +199,7 @@ bool QsfpModule::detectPresenceLocked() {
     info.transceiver() = type();
     info.port() = qsfpImpl_->getNum();
     *info_.wlock() = info;
+    ++infoVersion_;
   }
   return currentQsfpStatus;
 }
@@ -295,6 +296,7 @@ void QsfpModule::updateCachedTransceiverInfoLocked(ModuleStatus moduleStatus) {
   snapshot.transceiverInfo_ref() = info;
   snapshots_.wlock()->addSnapshot(snapshot);
   *info_.wlock() = info;
+  ++infoVersion_;
 }
 
 bool QsfpModule::safeToCustomize() const {
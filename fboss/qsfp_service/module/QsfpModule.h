@@ -8,6 +8,7 @@
  *
  */
 #pragma once
+#include <atomic>
 #include <cstdint>
 #include <mutex>
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
@@ -101,6 +102,10 @@ class QsfpModule : public Transceiver {
    */
   TransceiverInfo getTransceiverInfo() override;
 
+  uint64_t getTransceiverInfoVersion() const override {
+    return infoVersion_;
+  }
+
   void transceiverPortsChanged(
       const std::map<uint32_t, PortStatus>& ports) override;
 
@@ -324,6 +329,8 @@ class QsfpModule : public Transceiver {
 
   folly::Synchronized<TransceiverSnapshotCache> snapshots_;
   folly::Synchronized<std::optional<TransceiverInfo>> info_;
+  // Bumped after every update of info_
+  std::atomic<uint64_t> infoVersion_{0};
   /*
    * qsfpModuleMutex_ is held around all the read and writes to the qsfpModule
    *
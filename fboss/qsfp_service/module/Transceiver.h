@@ -65,6 +65,12 @@ class Transceiver {
    */
   virtual TransceiverInfo getTransceiverInfo() = 0;
 
+  /*
+   * Changes whenever the TransceiverInfo returned by getTransceiverInfo()
+   * may have changed
+   */
+  virtual uint64_t getTransceiverInfoVersion() const = 0;
+
   /*
    * Return raw page data from the qsfp DOM
    */
@@ -0,0 +1,288 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/qsfp_service/AgentPortStatusSubscriber.h"
+
+#include "fboss/lib/thrift_service_client/ThriftServiceClient.h"
+
+#include <folly/IPAddressV6.h>
+#include <gtest/gtest.h>
+#include <thrift/lib/cpp/TApplicationException.h>
+#include <thrift/lib/cpp2/util/ScopedServerInterfaceThread.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+DECLARE_int32(agent_port_status_wait_ms);
+DECLARE_int32(agent_port_status_retry_ms);
+
+namespace facebook::fboss {
+
+namespace {
+
+constexpr int kNumPorts = 32;
+constexpr int kNumRefreshCycles = 20;
+constexpr auto kRefreshInterval = std::chrono::milliseconds(10);
+
+/*
+ * A wedge_agent which only serves the port status related calls and counts
+ * how many of them it received.
+ */
+class FakeAgent : public FbossCtrlSvIf {
+ public:
+  explicit FakeAgent(int64_t initialGeneration)
+      : initialGeneration_(initialGeneration), generation_(initialGeneration) {
+    for (int port = 1; port <= kNumPorts; port++) {
+      PortStatus status;
+      status.enabled() = true;
+      status.up() = false;
+      ports_[port] = {status, generation_};
+    }
+    configAppliedInfo_.lastAppliedInMs() = initialGeneration;
+  }
+
+  void getPortStatus(
+      std::map<int32_t, PortStatus>& portStatus,
+      std::unique_ptr<std::vector<int32_t>> /* ports */) override {
+    ++numRpcs_;
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (const auto& [port, entry] : ports_) {
+      portStatus[port] = entry.first;
+    }
+  }
+
+  void getConfigAppliedInfo(ConfigAppliedInfo& configAppliedInfo) override {
+    ++numRpcs_;
+    std::lock_guard<std::mutex> guard(mutex_);
+    configAppliedInfo = configAppliedInfo_;
+  }
+
+  void waitForPortStatusChanges(
+      PortStatusChanges& changes,
+      int64_t sinceGeneration,
+      int32_t timeoutMs) override {
+    ++numRpcs_;
+    if (!supportsWaitForPortStatusChanges_) {
+      // What a wedge_agent without waitForPortStatusChanges() replies
+      throw apache::thrift::TApplicationException(
+          apache::thrift::TApplicationException::UNKNOWN_METHOD,
+          "Method name waitForPortStatusChanges not found");
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (sinceGeneration == generation_) {
+      changed_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&] {
+        return stopped_ || sinceGeneration != generation_;
+      });
+    }
+    bool fullSync =
+        sinceGeneration < initialGeneration_ || sinceGeneration > generation_;
+    changes.generation() = generation_;
+    changes.fullSync() = fullSync;
+    changes.configAppliedInfo() = configAppliedInfo_;
+    for (const auto& [port, entry] : ports_) {
+      if (fullSync || entry.second > sinceGeneration) {
+        changes.portStatus()[port] = entry.first;
+      }
+    }
+  }
+
+  void setPortUp(int32_t port, bool up) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    ports_[port] = {ports_[port].first, ++generation_};
+    ports_[port].first.up() = up;
+    changed_.notify_all();
+  }
+
+  // Release the blocked long-polls so that the server can stop
+  void stop() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stopped_ = true;
+    changed_.notify_all();
+  }
+
+  int getNumRpcs() const {
+    return numRpcs_.load();
+  }
+
+  void setSupportsWaitForPortStatusChanges(bool supported) {
+    supportsWaitForPortStatusChanges_ = supported;
+  }
+
+ private:
+  std::atomic<int> numRpcs_{0};
+  std::atomic<bool> supportsWaitForPortStatusChanges_{true};
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  bool stopped_{false};
+  const int64_t initialGeneration_;
+  int64_t generation_;
+  // port -> <status, generation of the last change>
+  std::map<int32_t, std::pair<PortStatus, int64_t>> ports_;
+  ConfigAppliedInfo configAppliedInfo_;
+};
+
+} // namespace
+
+class AgentPortStatusSubscriberTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    FLAGS_agent_port_status_wait_ms = 60000;
+    FLAGS_agent_port_status_retry_ms = 10;
+    startAgent(1000);
+  }
+
+  void TearDown() override {
+    subscriber_.reset();
+    stopAgent();
+  }
+
+  void startAgent(int64_t initialGeneration) {
+    agent_ = std::make_shared<FakeAgent>(initialGeneration);
+    server_ =
+        std::make_unique<apache::thrift::ScopedServerInterfaceThread>(agent_);
+    agentPort_ = server_->getAddress().getPort();
+  }
+
+  void stopAgent() {
+    agent_->stop();
+    server_.reset();
+  }
+
+  std::unique_ptr<FbossCtrlAsyncClient> createClient(
+      folly::EventBase* evb = nullptr) {
+    return utils::createWedgeAgentClient(
+        folly::IPAddressV6("::1"), agentPort_.load(), evb);
+  }
+
+  void startSubscriber() {
+    subscriber_ = std::make_unique<AgentPortStatusSubscriber>(
+        [this](folly::EventBase* evb) { return createClient(evb); });
+    subscriber_->start();
+  }
+
+  // Wait until pred() is true, and return how long it took
+  template <typename Predicate>
+  std::chrono::milliseconds waitFor(Predicate pred) {
+    auto begin = std::chrono::steady_clock::now();
+    while (!pred()) {
+      if (std::chrono::steady_clock::now() - begin > std::chrono::seconds(10)) {
+        throw std::runtime_error("Timed out waiting for condition");
+      }
+      /* sleep override */
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - begin);
+  }
+
+  template <typename Predicate>
+  std::chrono::milliseconds waitForSnapshot(Predicate pred) {
+    return waitFor([this, &pred] {
+      auto snapshot = subscriber_->getSnapshot();
+      return snapshot && pred(*snapshot);
+    });
+  }
+
+  std::shared_ptr<FakeAgent> agent_;
+  std::unique_ptr<apache::thrift::ScopedServerInterfaceThread> server_;
+  // Read by the subscriber thread while the agent restarts
+  std::atomic<int> agentPort_{0};
+  std::unique_ptr<AgentPortStatusSubscriber> subscriber_;
+};
+
+TEST_F(AgentPortStatusSubscriberTest, idleRefreshCyclesIssueNoRpc) {
+  // What refreshStateMachines() used to do on every cycle
+  for (int i = 0; i < kNumRefreshCycles; i++) {
+    auto client = createClient();
+    std::map<int32_t, PortStatus> portStatus;
+    client->sync_getPortStatus(portStatus, {});
+    ConfigAppliedInfo configAppliedInfo;
+    client->sync_getConfigAppliedInfo(configAppliedInfo);
+    /* sleep override */
+    std::this_thread::sleep_for(kRefreshInterval);
+  }
+  auto pollingRpcs = agent_->getNumRpcs();
+  EXPECT_EQ(pollingRpcs, 2 * kNumRefreshCycles);
+
+  startSubscriber();
+  waitForSnapshot([](const auto& snapshot) {
+    return snapshot.portStatus.size() == static_cast<size_t>(kNumPorts);
+  });
+  for (int i = 0; i < kNumRefreshCycles; i++) {
+    auto snapshot = subscriber_->getSnapshot();
+    ASSERT_TRUE(snapshot);
+    EXPECT_EQ(snapshot->portStatus.size(), static_cast<size_t>(kNumPorts));
+    EXPECT_EQ(*snapshot->configAppliedInfo.lastAppliedInMs(), 1000);
+    /* sleep override */
+    std::this_thread::sleep_for(kRefreshInterval);
+  }
+  // The initial full sync plus the outstanding long-poll
+  EXPECT_EQ(agent_->getNumRpcs() - pollingRpcs, 2);
+  EXPECT_EQ(subscriber_->getNumRpcs(), 2u);
+}
+
+TEST_F(AgentPortStatusSubscriberTest, changesArriveWithoutWaitingForTimeout) {
+  startSubscriber();
+  waitForSnapshot([](const auto& snapshot) {
+    return snapshot.portStatus.size() == static_cast<size_t>(kNumPorts);
+  });
+
+  for (int port = 1; port <= 4; port++) {
+    agent_->setPortUp(port, true);
+    auto latency = waitForSnapshot([port](const auto& snapshot) {
+      return *snapshot.portStatus.at(port).up();
+    });
+    // Way less than the long-poll timeout
+    EXPECT_LT(latency.count(), FLAGS_agent_port_status_wait_ms / 10);
+  }
+  auto snapshot = subscriber_->getSnapshot();
+  for (int port = 1; port <= kNumPorts; port++) {
+    EXPECT_EQ(*snapshot->portStatus.at(port).up(), port <= 4);
+  }
+  // One long-poll per change plus the initial full sync and the outstanding
+  // one
+  waitFor([this] { return subscriber_->getNumRpcs() >= 6; });
+  EXPECT_EQ(subscriber_->getNumRpcs(), 6u);
+}
+
+TEST_F(AgentPortStatusSubscriberTest, resyncAfterAgentRestart) {
+  startSubscriber();
+  waitForSnapshot([](const auto& snapshot) {
+    return snapshot.portStatus.size() == static_cast<size_t>(kNumPorts);
+  });
+
+  // Agent going away makes the snapshot unusable
+  stopAgent();
+  waitFor([this] { return subscriber_->getSnapshot() == nullptr; });
+
+  // A restarted agent hands out generations above the ones we have seen, so
+  // that we get a full sync once we reconnect
+  startAgent(2000);
+  agent_->setPortUp(1, true);
+  waitForSnapshot([](const auto& snapshot) {
+    return *snapshot.portStatus.at(1).up() &&
+        *snapshot.configAppliedInfo.lastAppliedInMs() == 2000;
+  });
+}
+
+TEST_F(AgentPortStatusSubscriberTest, agentWithoutLongPoll) {
+  agent_->setSupportsWaitForPortStatusChanges(false);
+  startSubscriber();
+  waitFor([this] { return !subscriber_->isSupportedByAgent(); });
+  EXPECT_EQ(subscriber_->getSnapshot(), nullptr);
+
+  // No retry storm against an agent which can't serve the long-poll
+  /* sleep override */
+  std::this_thread::sleep_for(
+      10 * std::chrono::milliseconds(FLAGS_agent_port_status_retry_ms));
+  EXPECT_EQ(subscriber_->getNumRpcs(), 1u);
+}
+
+} // namespace facebook::fboss
@@ -3,6 +3,7 @@
 #include "fboss/qsfp_service/test/TransceiverManagerTestHelper.h"
 
 #include "fboss/lib/CommonFileUtils.h"
+#include "fboss/qsfp_service/lib/TransceiverInfoDelta.h"
 
 namespace facebook::fboss {
 
@@ -22,6 +23,64 @@ TEST_F(TransceiverManagerTest, getPortNameToModuleMap) {
       std::out_of_range);
 }
 
+TEST_F(TransceiverManagerTest, getTransceiverInfoDeltas) {
+  // init() already refreshed all the transceivers once. A new client gets
+  // the full snapshot of every transceiver, present or not.
+  TransceiverInfoDeltas full;
+  transceiverManager_->getTransceiverInfoDeltas(full, 0);
+  EXPECT_TRUE(*full.fullSync());
+  EXPECT_EQ(
+      full.deltas()->size(),
+      static_cast<size_t>(transceiverManager_->getNumQsfpModules()));
+  for (const auto& [id, delta] : *full.deltas()) {
+    TransceiverInfo info;
+    applyTransceiverInfoDelta(info, delta);
+    auto expected = transceiverManager_->getTransceiverInfo(TransceiverID(id));
+    EXPECT_EQ(*info.present(), *expected.present());
+    EXPECT_EQ(*info.port(), *expected.port());
+  }
+
+  // Nothing changed since that generation
+  TransceiverInfoDeltas noChange;
+  transceiverManager_->getTransceiverInfoDeltas(noChange, *full.generation());
+  EXPECT_FALSE(*noChange.fullSync());
+  EXPECT_EQ(*noChange.generation(), *full.generation());
+  EXPECT_TRUE(noChange.deltas()->empty());
+
+  // Generations from another qsfp_service instance get a full snapshot
+  for (auto generation : {int64_t(1), *full.generation() + 1}) {
+    TransceiverInfoDeltas otherInstance;
+    transceiverManager_->getTransceiverInfoDeltas(otherInstance, generation);
+    EXPECT_TRUE(*otherInstance.fullSync());
+    EXPECT_EQ(otherInstance.deltas()->size(), full.deltas()->size());
+  }
+}
+
+TEST_F(TransceiverManagerTest, getTransceiverInfoDeltasSkipsUnchanged) {
+  gflags::FlagSaver flagSaver;
+  TransceiverInfoDeltas before;
+  transceiverManager_->getTransceiverInfoDeltas(before, 0);
+  auto numDiffed =
+      transceiverManager_->getNumTransceiverInfoDiffedForTesting();
+
+  // Within the data refresh interval the modules keep their cached
+  // TransceiverInfo, so a refresh doesn't rebuild or diff any of them
+  gflags::SetCommandLineOption("qsfp_data_refresh_interval", "3600");
+  transceiverManager_->refreshTransceivers();
+  EXPECT_EQ(
+      numDiffed, transceiverManager_->getNumTransceiverInfoDiffedForTesting());
+  TransceiverInfoDeltas after;
+  transceiverManager_->getTransceiverInfoDeltas(after, *before.generation());
+  EXPECT_EQ(*after.generation(), *before.generation());
+  EXPECT_TRUE(after.deltas()->empty());
+
+  // Refreshing the data again updates (and so diffs) the present ones
+  gflags::SetCommandLineOption("qsfp_data_refresh_interval", "0");
+  transceiverManager_->refreshTransceivers();
+  EXPECT_GT(
+      transceiverManager_->getNumTransceiverInfoDiffedForTesting(), numDiffed);
+}
+
 TEST_F(TransceiverManagerTest, coldBootTest) {
   auto verifyColdBootLogic = [this]() {
     // Delete the existing wedge manager and create a new one
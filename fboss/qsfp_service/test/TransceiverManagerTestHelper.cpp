@@ -29,6 +29,11 @@ void TransceiverManagerTestHelper::SetUp() {
   gflags::SetCommandLineOptionWithMode(
       "qsfp_data_refresh_interval", "0", gflags::SET_FLAGS_DEFAULT);
 
+  // Tests fake wedge_agent with overrideAgentPortStatusForTesting_ instead of
+  // talking to a real one
+  gflags::SetCommandLineOptionWithMode(
+      "subscribe_agent_port_status", "0", gflags::SET_FLAGS_DEFAULT);
+
   // Create a wedge manager
   transceiverManager_ =
       std::make_unique<MockWedgeManager>(numModules, numPortsPerModule);